@@ -0,0 +1,70 @@
+#include <null_gl_context.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/renderer.h>
+#include <platform/input/timing.h>
+
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+// Measures drawing 10k circles per frame, like a debug overlay. With a few
+// distinct radii every circle is a cache hit, with fresh random radii every
+// frame nearly every circle has to be computed.
+
+constexpr int NUM_FRAMES = 100;
+constexpr int NUM_CIRCLES = 10000;
+
+struct Circle {
+	glm::vec2 center;
+	float radius;
+};
+
+static std::vector<Circle> make_circles(std::mt19937* rng, bool few_radii) {
+	std::uniform_real_distribution<float> coordinate(0.0f, 800.0f);
+	std::uniform_real_distribution<float> radius(1.0f, 32.0f);
+	std::vector<Circle> circles;
+	for (int i = 0; i < NUM_CIRCLES; i++) {
+		circles.push_back(Circle {
+			.center = { coordinate(*rng), coordinate(*rng) },
+			.radius = few_radii ? (float)(2 + i % 16 * 2) : radius(*rng),
+		});
+	}
+	return circles;
+}
+
+static void run_benchmark(const char* name, bool few_radii) {
+	benchmark::NullOpenGLContext gl_context;
+	platform::Renderer renderer(&gl_context);
+	const platform::ShaderProgram shader_program = {};
+	std::mt19937 rng(1234);
+
+	uint64_t draw_ns = 0;
+	size_t num_vertices = 0;
+	for (int frame = 0; frame < NUM_FRAMES; frame++) {
+		const std::vector<Circle> circles = make_circles(&rng, few_radii);
+
+		platform::Timer timer;
+		for (size_t i = 0; i < circles.size(); i++) {
+			if (i % 2 == 0) {
+				renderer.draw_circle(circles[i].center, circles[i].radius, platform::Color::green);
+			}
+			else {
+				renderer.draw_circle_fill(circles[i].center, circles[i].radius, platform::Color::red);
+			}
+		}
+		draw_ns += timer.elapsed_ns();
+
+		renderer.render(shader_program);
+		num_vertices = renderer.debug_data().num_vertices;
+	}
+
+	printf("%-14s %10zu %12.2f\n", name, num_vertices, (double)draw_ns / NUM_FRAMES / 1000.0);
+}
+
+int main() {
+	printf("%-14s %10s %12s\n", "radii", "vertices", "draw us");
+	run_benchmark("16 radii", true);
+	run_benchmark("random radii", false);
+	return 0;
+}
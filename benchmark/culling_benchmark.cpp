@@ -0,0 +1,67 @@
+#include <fixtures.h>
+#include <null_gl_context.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/renderer.h>
+#include <platform/input/timing.h>
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Measures drawing a scene of 10k text nodes and rects spread over an area
+// four times the size of the window in each direction, so most of it is
+// off-screen. Without a clip rect everything is turned into vertices.
+
+constexpr int NUM_FRAMES = 100;
+constexpr int NUM_NODES = 10000;
+constexpr glm::vec2 WINDOW_SIZE = { 800.0f, 600.0f };
+
+static void run_benchmark(const char* name, bool use_clip_rect) {
+	benchmark::NullOpenGLContext gl_context;
+	platform::Renderer renderer(&gl_context);
+	const platform::ShaderProgram shader_program = {};
+	const platform::Font font = benchmark::make_font(platform::Texture { .id = 100, .size = { 128, 128 } });
+
+	std::vector<std::string> texts;
+	std::vector<glm::vec2> positions;
+	for (int i = 0; i < NUM_NODES; i++) {
+		texts.push_back("Text node " + std::to_string(i));
+		positions.push_back(glm::vec2 { (float)(i % 100) / 100.0f, (float)(i / 100) / 100.0f } * WINDOW_SIZE * 4.0f - WINDOW_SIZE * 1.5f);
+	}
+
+	uint64_t draw_ns = 0;
+	uint64_t render_ns = 0;
+	size_t num_vertices = 0;
+	size_t num_culled = 0;
+	for (int frame = 0; frame < NUM_FRAMES; frame++) {
+		platform::Timer draw_timer;
+		if (use_clip_rect) {
+			renderer.push_clip_rect({ { 0.0f, 0.0f }, WINDOW_SIZE });
+		}
+		for (int i = 0; i < NUM_NODES; i++) {
+			renderer.draw_rect_fill({ positions[i], positions[i] + glm::vec2 { 90.0f, 14.0f } }, platform::Color::black);
+			renderer.draw_text(font, texts[i], positions[i], platform::Color::white);
+		}
+		if (use_clip_rect) {
+			renderer.pop_clip_rect();
+		}
+		draw_ns += draw_timer.elapsed_ns();
+
+		platform::Timer render_timer;
+		renderer.render(shader_program);
+		render_ns += render_timer.elapsed_ns();
+		num_vertices += renderer.debug_data().num_vertices;
+		num_culled += renderer.debug_data().num_culled;
+	}
+
+	printf("%-12s %10zu %10zu %10.2f %10.2f\n", name, num_vertices / NUM_FRAMES, num_culled / NUM_FRAMES, (double)draw_ns / NUM_FRAMES / 1000.0, (double)render_ns / NUM_FRAMES / 1000.0);
+}
+
+int main() {
+	printf("%-12s %10s %10s %10s %10s\n", "culling", "vertices", "culled", "draw us", "render us");
+	run_benchmark("none", false);
+	run_benchmark("clip rect", true);
+	return 0;
+}
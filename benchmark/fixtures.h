@@ -0,0 +1,28 @@
+#pragma once
+
+#include <platform/graphics/font.h>
+#include <platform/graphics/texture.h>
+
+#include <stddef.h>
+
+namespace benchmark {
+
+	// Font with 8x12 glyphs laid out in rows of 16 in a 128x128 atlas, so
+	// the benchmarks draw text without loading a font file
+	inline platform::Font make_font(platform::Texture atlas) {
+		platform::Font font = {};
+		font.atlas = atlas;
+		font.size = 16;
+		font.line_height = 18;
+		for (size_t i = 0; i < platform::Font::NUM_GLYPHS; i++) {
+			font.glyphs[i] = platform::Glyph {
+				.atlas_pos = { (int)(i % 16) * 8, (int)(i / 16) * 12 },
+				.size = { 8, 12 },
+				.bearing = { 0, 12 },
+				.advance = 9,
+			};
+		}
+		return font;
+	}
+
+} // namespace benchmark
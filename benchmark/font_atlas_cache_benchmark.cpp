@@ -0,0 +1,85 @@
+#include <null_gl_context.h>
+
+#include <platform/graphics/font.h>
+#include <platform/graphics/font_atlas_cache.h>
+#include <platform/input/timing.h>
+
+#include <filesystem>
+#include <stdio.h>
+#include <vector>
+
+// Measures adding the fonts loaded at startup, like the engine's and
+// editor's fonts. Cold runs start from an empty atlas cache, so they
+// rasterize with FreeType and store what they bake, warm runs load
+// everything from the cache. Takes font paths, the test font by default.
+
+constexpr int NUM_RUNS = 10;
+constexpr uint8_t FONT_SIZES[] = { 13, 16 };
+
+static double run_startup(const std::vector<const char*>& font_paths, const std::filesystem::path& cache_directory, bool is_warm) {
+	benchmark::NullOpenGLContext gl_context;
+	uint64_t total_ns = 0;
+	for (int run = 0; run < NUM_RUNS; run++) {
+		if (!is_warm) {
+			std::filesystem::remove_all(cache_directory);
+		}
+		platform::FontAtlasCache cache(cache_directory);
+		platform::Timer timer;
+		for (const char* font_path : font_paths) {
+			for (uint8_t size : FONT_SIZES) {
+				platform::free_font(&gl_context, platform::add_font(&gl_context, font_path, size, &cache).value());
+			}
+		}
+		total_ns += timer.elapsed_ns();
+	}
+	return (double)total_ns / NUM_RUNS / 1'000'000.0;
+}
+
+static double run_uncached(const std::vector<const char*>& font_paths) {
+	benchmark::NullOpenGLContext gl_context;
+	uint64_t total_ns = 0;
+	for (int run = 0; run < NUM_RUNS; run++) {
+		platform::Timer timer;
+		for (const char* font_path : font_paths) {
+			for (uint8_t size : FONT_SIZES) {
+				platform::free_font(&gl_context, platform::add_font(&gl_context, font_path, size).value());
+			}
+		}
+		total_ns += timer.elapsed_ns();
+	}
+	return (double)total_ns / NUM_RUNS / 1'000'000.0;
+}
+
+int main(int argc, char** argv) {
+	std::vector<const char*> font_paths;
+	for (int i = 1; i < argc; i++) {
+		font_paths.push_back(argv[i]);
+	}
+	if (font_paths.empty()) {
+		font_paths.push_back("test/platform/test_data/test_font.ttf");
+	}
+	if (!platform::initialize_fonts()) {
+		return 1;
+	}
+	benchmark::NullOpenGLContext gl_context;
+	for (const char* font_path : font_paths) {
+		if (!platform::add_font(&gl_context, font_path, FONT_SIZES[0])) {
+			printf("Could not load %s\n", font_path);
+			return 1;
+		}
+	}
+
+	const std::filesystem::path cache_directory = std::filesystem::temp_directory_path() / "font_atlas_cache_benchmark";
+	printf("%zu fonts in %zu sizes\n", font_paths.size(), std::size(FONT_SIZES));
+	printf("%-12s %10s %8s\n", "startup", "ms", "speedup");
+	const double uncached_ms = run_uncached(font_paths);
+	printf("%-12s %10.2f %8.2f\n", "no cache", uncached_ms, 1.0);
+	const double cold_ms = run_startup(font_paths, cache_directory, false);
+	printf("%-12s %10.2f %8.2f\n", "cold cache", cold_ms, uncached_ms / cold_ms);
+	const double warm_ms = run_startup(font_paths, cache_directory, true);
+	printf("%-12s %10.2f %8.2f\n", "warm cache", warm_ms, uncached_ms / warm_ms);
+
+	std::filesystem::remove_all(cache_directory);
+	platform::shutdown_fonts();
+	return 0;
+}
@@ -0,0 +1,74 @@
+#include <platform/graphics/font.h>
+#include <platform/graphics/font_baker.h>
+#include <platform/input/timing.h>
+
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+// Measures baking one font file in many sizes, like a resource manifest
+// declaring a font per size. Loading a face and generating each atlas in
+// turn is how fonts used to be loaded, baking splits glyph ranges over
+// threads. Takes a font path, larger fonts take longer to rasterize.
+
+constexpr int NUM_RUNS = 5;
+constexpr uint8_t MIN_SIZE = 8;
+constexpr uint8_t MAX_SIZE = 72;
+constexpr uint8_t SIZE_STEP = 4;
+
+static std::vector<platform::FontBakeRequest> make_requests(const char* font_path) {
+	std::vector<platform::FontBakeRequest> requests;
+	for (int size = MIN_SIZE; size <= MAX_SIZE; size += SIZE_STEP) {
+		requests.push_back({ .path = font_path, .size = (uint8_t)size });
+	}
+	return requests;
+}
+
+static double run_sequential(const std::vector<platform::FontBakeRequest>& requests) {
+	uint64_t total_ns = 0;
+	for (int run = 0; run < NUM_RUNS; run++) {
+		platform::Timer timer;
+		for (const platform::FontBakeRequest& request : requests) {
+			platform::FontFace face = platform::load_font_face(request.path).value();
+			platform::generate_font_atlas(face, request.size);
+		}
+		total_ns += timer.elapsed_ns();
+	}
+	return (double)total_ns / NUM_RUNS / 1'000'000.0;
+}
+
+static double run_baked(const std::vector<platform::FontBakeRequest>& requests, size_t num_threads) {
+	uint64_t total_ns = 0;
+	for (int run = 0; run < NUM_RUNS; run++) {
+		platform::Timer timer;
+		platform::bake_font_atlases(requests, { .num_threads = num_threads });
+		total_ns += timer.elapsed_ns();
+	}
+	return (double)total_ns / NUM_RUNS / 1'000'000.0;
+}
+
+int main(int argc, char** argv) {
+	const char* font_path = argc > 1 ? argv[1] : "test/platform/test_data/test_font.ttf";
+	if (!platform::initialize_fonts()) {
+		return 1;
+	}
+	const std::vector<platform::FontBakeRequest> requests = make_requests(font_path);
+	if (!platform::bake_font_atlases({ requests[0] })[0].has_value()) {
+		printf("Could not load %s\n", font_path);
+		return 1;
+	}
+
+	printf("%zu sizes, %u hardware threads\n", requests.size(), std::thread::hardware_concurrency());
+	printf("%-12s %10s %8s\n", "loading", "ms", "speedup");
+	const double sequential_ms = run_sequential(requests);
+	printf("%-12s %10.2f %8.2f\n", "sequential", sequential_ms, 1.0);
+	for (size_t num_threads = 1; num_threads <= std::max(std::thread::hardware_concurrency(), 8u); num_threads *= 2) {
+		const double baked_ms = run_baked(requests, num_threads);
+		char name[32];
+		snprintf(name, sizeof(name), "%zu threads", num_threads);
+		printf("%-12s %10.2f %8.2f\n", name, baked_ms, sequential_ms / baked_ms);
+	}
+
+	platform::shutdown_fonts();
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <fixtures.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/frame_pipeline.h>
+#include <platform/graphics/render_executor.h>
+#include <platform/graphics/renderer.h>
+#include <platform/graphics/software_gl_context.h>
+#include <platform/input/timing.h>
+
+#include <optional>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Measures frames of 5k text nodes drawn with the software rasterizer, so
+// that it runs without a GPU. Most nodes are outside the canvas, to keep
+// rasterizing in the same ballpark as recording. Serially, each frame is recorded and then
+// rasterized. With the frame pipeline, the next frame is recorded while
+// the last one is rasterized on the render thread, so frame times should
+// approach the slower of the two when there are cores to spare.
+
+constexpr int NUM_FRAMES = 60;
+constexpr int NUM_TEXT_NODES = 5000;
+constexpr int CANVAS_WIDTH = 640;
+constexpr int CANVAS_HEIGHT = 360;
+
+static void run_benchmark(const char* name, size_t max_frames_in_flight) {
+	platform::SoftwareOpenGLContext gl_context(CANVAS_WIDTH, CANVAS_HEIGHT);
+	const platform::ShaderProgram shader_program = gl_context.add_shader_program("", "").value();
+	const std::vector<unsigned char> atlas_pixels(128 * 128 * 4, 255);
+	const platform::Font font = benchmark::make_font(gl_context.add_texture(atlas_pixels.data(), 128, 128));
+	const platform::Canvas canvas = gl_context.add_canvas(CANVAS_WIDTH, CANVAS_HEIGHT);
+
+	platform::Renderer renderer(&gl_context);
+	platform::GLRenderExecutor gl_executor(&gl_context);
+	std::optional<platform::FramePipeline> pipeline;
+	if (max_frames_in_flight > 0) {
+		pipeline.emplace(&gl_executor, max_frames_in_flight);
+		renderer.set_executor(&*pipeline);
+	}
+
+	uint64_t record_ns = 0;
+	uint64_t submit_wait_ns = 0;
+	uint64_t execute_ns = 0;
+	platform::Timer frame_timer;
+	for (int frame = 0; frame < NUM_FRAMES; frame++) {
+		platform::Timer record_timer;
+		for (int i = 0; i < NUM_TEXT_NODES; i++) {
+			const glm::vec2 pos = { (float)(i % 200) * 80.0f, (float)((i / 200 + frame) % 50) * 12.0f };
+			renderer.draw_text(font, "Text node " + std::to_string(i), pos, platform::Color::white);
+		}
+		renderer.set_render_canvas(canvas);
+		record_ns += record_timer.elapsed_ns();
+
+		platform::Timer render_timer;
+		renderer.render(shader_program);
+		if (pipeline) {
+			submit_wait_ns += pipeline->stats().submit_wait_ns;
+			execute_ns += pipeline->stats().execute_ns;
+		}
+		else {
+			execute_ns += render_timer.elapsed_ns();
+		}
+		renderer.reset_render_canvas();
+	}
+	if (pipeline) {
+		pipeline->flush();
+	}
+	const uint64_t frame_ns = frame_timer.elapsed_ns();
+
+	printf("%-12s %10.2f %10.2f %10.2f %10.2f\n", name, (double)record_ns / NUM_FRAMES / 1e6, (double)execute_ns / NUM_FRAMES / 1e6, (double)submit_wait_ns / NUM_FRAMES / 1e6, (double)frame_ns / NUM_FRAMES / 1e6);
+}
+
+int main() {
+	printf("%-12s %10s %10s %10s %10s\n", "pipeline", "record ms", "execute ms", "wait ms", "frame ms");
+	run_benchmark("serial", 0);
+	run_benchmark("1 in flight", 1);
+	run_benchmark("2 in flight", 2);
+	return 0;
+}
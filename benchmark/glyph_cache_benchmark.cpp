@@ -0,0 +1,98 @@
+#include <null_gl_context.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/glyph_cache.h>
+#include <platform/graphics/renderer.h>
+#include <platform/input/timing.h>
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Measures drawing CJK-heavy text through the glyph cache. The first frame
+// rasterizes every glyph it draws, later frames only look them up. Changing
+// text misses the text run cache every frame but still hits the glyph
+// cache. Takes a font path, since the test font has few non-ascii glyphs.
+
+constexpr int NUM_FRAMES = 100;
+constexpr int NUM_TEXT_NODES = 2000;
+constexpr int CHARS_PER_NODE = 8;
+constexpr char32_t FIRST_CODEPOINT = 0x4E00; // CJK unified ideographs
+constexpr int NUM_CODEPOINTS = 3000;
+
+static void append_utf8(std::string* text, char32_t codepoint) {
+	if (codepoint < 0x800) {
+		text->push_back((char)(0xC0 | (codepoint >> 6)));
+	}
+	else {
+		text->push_back((char)(0xE0 | (codepoint >> 12)));
+		text->push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+	}
+	text->push_back((char)(0x80 | (codepoint & 0x3F)));
+}
+
+static std::vector<std::string> make_texts(int frame) {
+	std::vector<std::string> texts;
+	for (int i = 0; i < NUM_TEXT_NODES; i++) {
+		std::string text;
+		for (int j = 0; j < CHARS_PER_NODE; j++) {
+			append_utf8(&text, FIRST_CODEPOINT + (char32_t)((i * CHARS_PER_NODE + j + frame * 7) % NUM_CODEPOINTS));
+		}
+		texts.push_back(std::move(text));
+	}
+	return texts;
+}
+
+static void run_benchmark(const char* name, const char* font_path, bool change_text) {
+	benchmark::NullOpenGLContext gl_context;
+	platform::Renderer renderer(&gl_context);
+	const platform::ShaderProgram shader_program = {};
+	std::expected<platform::Font, std::string> font = platform::add_font(&gl_context, font_path, 16);
+	if (!font) {
+		printf("Could not load %s: %s\n", font_path, font.error().c_str());
+		return;
+	}
+
+	std::vector<std::string> texts = make_texts(0);
+	uint64_t cold_ns = 0;
+	uint64_t warm_ns = 0;
+	for (int frame = 0; frame < NUM_FRAMES; frame++) {
+		if (change_text && frame > 0) {
+			texts = make_texts(frame);
+		}
+
+		platform::Timer timer;
+		for (int i = 0; i < NUM_TEXT_NODES; i++) {
+			const glm::vec2 pos = { (float)(i % 8) * 140.0f, (float)(i / 8 % 60) * 18.0f };
+			renderer.draw_text(*font, texts[i], pos, platform::Color::white);
+		}
+		const uint64_t draw_ns = timer.elapsed_ns();
+		if (frame == 0) {
+			cold_ns = draw_ns;
+		}
+		else {
+			warm_ns += draw_ns;
+		}
+
+		renderer.render(shader_program);
+	}
+
+	const platform::GlyphCacheStats stats = font->glyph_cache->stats();
+	printf("%-14s %12.2f %12.2f %8zu %6zu %8zu\n", name, (double)cold_ns / 1000.0, (double)warm_ns / (NUM_FRAMES - 1) / 1000.0, stats.num_glyphs, stats.num_pages, stats.num_page_updates);
+	platform::free_font(&gl_context, *font);
+}
+
+int main(int argc, char** argv) {
+	const char* font_path = argc > 1 ? argv[1] : "test/platform/test_data/test_font.ttf";
+	if (!platform::initialize_fonts()) {
+		return 1;
+	}
+
+	printf("%-14s %12s %12s %8s %6s %8s\n", "text", "cold us", "warm us", "glyphs", "pages", "updates");
+	run_benchmark("same text", font_path, false);
+	run_benchmark("changing text", font_path, true);
+
+	platform::shutdown_fonts();
+	return 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <platform/graphics/gl_context.h>
+
+#include <stddef.h>
+#include <vector>
+
+namespace benchmark {
+
+	// OpenGL context that doesn't call into OpenGL, so that the renderer can
+	// be run without a window. Counts the bytes that would be uploaded.
+	class NullOpenGLContext : public platform::OpenGLContext {
+	public:
+		NullOpenGLContext()
+			: platform::OpenGLContext(SDL_GLContext { nullptr }) {}
+
+		platform::Texture add_texture(const unsigned char*, int width, int height, platform::TextureWrapping, platform::TextureFilter) override {
+			return platform::Texture { .id = ++m_next_id, .size = { (float)width, (float)height } };
+		}
+		void update_texture(platform::Texture, glm::ivec2, glm::ivec2 size, const unsigned char*) override {
+			uploaded_bytes += (size_t)size.x * size.y * 4;
+		}
+		void free_texture(platform::Texture) override {}
+		platform::IndexBuffer add_index_buffer(const std::vector<uint32_t>& indices) override {
+			return platform::IndexBuffer { .id = ++m_next_id, .num_indices = indices.size() };
+		}
+		void free_index_buffer(platform::IndexBuffer) override {}
+		platform::VertexBuffer add_vertex_buffer(const std::vector<platform::Vertex>& vertices) override {
+			uploaded_bytes += vertices.size() * sizeof(platform::Vertex);
+			return platform::VertexBuffer { .id = ++m_next_id, .num_vertices = vertices.size(), .vertex_format = platform::VertexFormat::Standard };
+		}
+		platform::VertexBuffer add_packed_vertex_buffer(const std::vector<platform::PackedVertex>& vertices) override {
+			uploaded_bytes += vertices.size() * sizeof(platform::PackedVertex);
+			return platform::VertexBuffer { .id = ++m_next_id, .num_vertices = vertices.size(), .vertex_format = platform::VertexFormat::Packed };
+		}
+		void free_vertex_buffer(platform::VertexBuffer) override {}
+
+		void bind_shader_program(const platform::ShaderProgram&) override {}
+		void unbind_shader_program() override {}
+		void set_projection(const platform::ShaderProgram&, glm::mat4) override {}
+		void reserve_vertex_stream(size_t) override {}
+		void upload_vertices(const platform::ShaderProgram&, const std::vector<platform::Vertex>& vertices) override {
+			uploaded_bytes += vertices.size() * sizeof(platform::Vertex);
+		}
+		void upload_packed_vertices(const platform::ShaderProgram&, const std::vector<platform::PackedVertex>& vertices) override {
+			uploaded_bytes += vertices.size() * sizeof(platform::PackedVertex);
+		}
+		void upload_quad_instances(const platform::ShaderProgram&, const std::vector<platform::QuadInstance>& instances) override {
+			uploaded_bytes += instances.size() * sizeof(platform::QuadInstance);
+		}
+		void bind_vertex_buffer(const platform::ShaderProgram&, platform::VertexBuffer) override {}
+		void bind_streamed_vertices(const platform::ShaderProgram&) override {}
+		void fence_vertices() override {}
+		platform::StreamingBufferStats vertex_stream_stats() const override {
+			return {};
+		}
+		void set_uv_scale(const platform::ShaderProgram&, float) override {}
+		void set_distance_field(const platform::ShaderProgram&, bool) override {}
+		void bind_texture(platform::Texture) override {}
+		void bind_canvas(platform::Canvas) override {}
+		void unbind_canvas() override {}
+		void set_scissor(platform::ScissorRect) override {}
+		void disable_scissor() override {}
+		void draw_arrays(GLenum, GLint, GLsizei) override {}
+		void draw_elements(GLenum, platform::IndexBuffer, GLsizei, GLint) override {}
+		void draw_quad_instances(const platform::ShaderProgram&, GLint, GLsizei, float) override {}
+
+		size_t uploaded_bytes = 0;
+
+	private:
+		GLuint m_next_id = 0;
+	};
+
+} // namespace benchmark
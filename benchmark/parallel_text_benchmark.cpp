@@ -0,0 +1,93 @@
+#include <fixtures.h>
+#include <null_gl_context.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/render_capture.h>
+#include <platform/graphics/render_executor.h>
+#include <platform/graphics/renderer.h>
+#include <platform/input/timing.h>
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Measures how recording 10k text nodes scales with the number of draw
+// threads, and checks that every thread count records the same commands.
+
+constexpr int NUM_FRAMES = 100;
+constexpr int NUM_TEXT_NODES = 10000;
+constexpr size_t MIN_TEXT_NODES_PER_THREAD = 64;
+
+struct TextNode {
+	std::string text;
+	glm::vec2 position;
+};
+
+// Keeps the first recorded frame so thread counts can be compared
+class CapturingRenderExecutor : public platform::IRenderExecutor {
+public:
+	void execute(const platform::ShaderProgram& /*shader_program*/, const platform::RenderCommandList& command_list) override {
+		if (first_frame.empty()) {
+			first_frame = platform::serialize_command_list(command_list);
+		}
+	}
+
+	std::vector<uint8_t> first_frame;
+};
+
+static std::vector<TextNode> make_text_nodes() {
+	std::vector<TextNode> text_nodes;
+	for (int i = 0; i < NUM_TEXT_NODES; i++) {
+		text_nodes.push_back(TextNode {
+			.text = "Text node " + std::to_string(i),
+			.position = { (float)(i % 8) * 100.0f, (float)(i / 8 % 60) * 10.0f },
+		});
+	}
+	return text_nodes;
+}
+
+static std::vector<uint8_t> run_benchmark(size_t num_threads, const std::vector<TextNode>& text_nodes) {
+	benchmark::NullOpenGLContext gl_context;
+	CapturingRenderExecutor executor;
+	platform::Renderer renderer(&gl_context);
+	const platform::ShaderProgram shader_program = {};
+	const unsigned char atlas_data[4] = {};
+	const platform::Font font = benchmark::make_font(gl_context.add_texture(atlas_data, 128, 128, platform::TextureWrapping::ClampToEdge, platform::TextureFilter::Nearest));
+	renderer.set_executor(&executor);
+	renderer.set_max_draw_threads(num_threads);
+
+	uint64_t draw_ns = 0;
+	uint64_t render_ns = 0;
+	for (int frame = 0; frame < NUM_FRAMES; frame++) {
+		platform::Timer timer;
+		renderer.draw_parallel(text_nodes.size(), MIN_TEXT_NODES_PER_THREAD, [&](platform::DrawRecorder* recorder, size_t first, size_t last) {
+			for (size_t i = first; i < last; i++) {
+				recorder->draw_text(font, text_nodes[i].text, text_nodes[i].position, platform::Color::white);
+			}
+		});
+		draw_ns += timer.elapsed_ns();
+		renderer.render(shader_program);
+		render_ns += renderer.debug_data().render_ns;
+	}
+
+	printf("%-8zu %10zu %12.2f %12.2f\n",
+		num_threads,
+		renderer.debug_data().num_vertices,
+		(double)draw_ns / NUM_FRAMES / 1000.0,
+		(double)render_ns / NUM_FRAMES / 1000.0);
+	return executor.first_frame;
+}
+
+int main() {
+	const std::vector<TextNode> text_nodes = make_text_nodes();
+
+	printf("%-8s %10s %12s %12s\n", "threads", "vertices", "draw us", "render us");
+	const std::vector<uint8_t> single_threaded = run_benchmark(1, text_nodes);
+	bool identical = true;
+	for (size_t num_threads : { 2, 4, 8 }) {
+		identical = run_benchmark(num_threads, text_nodes) == single_threaded && identical;
+	}
+	printf("%s\n", identical ? "output identical for all thread counts" : "OUTPUT DIFFERS BETWEEN THREAD COUNTS");
+	return identical ? 0 : 1;
+}
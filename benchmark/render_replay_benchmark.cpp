@@ -0,0 +1,84 @@
+#include <fixtures.h>
+#include <null_gl_context.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/render_capture.h>
+#include <platform/graphics/render_executor.h>
+#include <platform/graphics/renderer.h>
+#include <platform/input/timing.h>
+
+#include <filesystem>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+// Replays a frame captured with F12 in the engine, or a generated frame if
+// no capture is given, and reports the CPU cost of submitting it.
+//
+// usage: render_replay_benchmark [capture file] [num replays]
+
+static void draw_frame(platform::Renderer* renderer, const platform::Font& font) {
+	const std::string line = "The quick brown fox jumps over the lazy dog 0123456789";
+	for (int i = 0; i < 50; i++) {
+		renderer->draw_text(font, line, { 0.0f, (float)(i * font.line_height) }, platform::Color::white);
+		renderer->draw_rect({ { 0.0f, (float)(i * font.line_height) }, { 400.0f, (float)((i + 1) * font.line_height) } }, platform::Color::dark_grey);
+	}
+}
+
+static void run_benchmark(const char* name, int num_replays, platform::IRenderExecutor* executor, const platform::RenderCommandList& command_list) {
+	const platform::ShaderProgram shader_program = { .vertex_format = command_list.vertex_format };
+	platform::Timer timer;
+	for (int i = 0; i < num_replays; i++) {
+		executor->execute(shader_program, command_list);
+	}
+	printf("%-24s %10.2f us/frame\n", name, (double)timer.elapsed_ns() / num_replays / 1000.0);
+}
+
+int main(int argc, char** argv) {
+	std::filesystem::path capture_path = argc > 1 ? argv[1] : std::filesystem::temp_directory_path() / "generated_render_capture.bin";
+	const int num_replays = argc > 2 ? atoi(argv[2]) : 1000;
+
+	benchmark::NullOpenGLContext gl_context;
+
+	/* Generate frame */
+	if (argc <= 1) {
+		platform::Renderer renderer(&gl_context);
+		platform::NullRenderExecutor null_executor;
+		platform::CaptureRenderExecutor capture_executor(&null_executor);
+		renderer.set_executor(&capture_executor);
+		const unsigned char atlas_data[4] = {};
+		const platform::Font font = benchmark::make_font(gl_context.add_texture(atlas_data, 128, 128, platform::TextureWrapping::ClampToEdge, platform::TextureFilter::Nearest));
+
+		// measure recording and submitting while we're at it
+		platform::Timer timer;
+		for (int i = 0; i < num_replays; i++) {
+			draw_frame(&renderer, font);
+			renderer.render(platform::ShaderProgram {});
+		}
+		printf("%-24s %10.2f us/frame\n", "record + null executor", (double)timer.elapsed_ns() / num_replays / 1000.0);
+
+		capture_executor.capture_next(capture_path);
+		draw_frame(&renderer, font);
+		renderer.render(platform::ShaderProgram {});
+	}
+
+	/* Load capture */
+	std::expected<platform::RenderCommandList, platform::RenderCaptureError> command_list = platform::load_render_capture(capture_path);
+	if (!command_list) {
+		fprintf(stderr, "Failed to load capture \"%s\" (error %d)\n", capture_path.string().c_str(), (int)command_list.error());
+		return 1;
+	}
+	printf("Replaying \"%s\": %zu commands, %zu vertices\n",
+		capture_path.string().c_str(),
+		command_list->commands.size(),
+		command_list->vertices.size() + command_list->packed_vertices.size());
+
+	/* Replay */
+	platform::NullRenderExecutor null_executor;
+	run_benchmark("null executor", num_replays, &null_executor, command_list.value());
+
+	platform::GLRenderExecutor gl_executor(&gl_context);
+	run_benchmark("gl executor, null gl", num_replays, &gl_executor, command_list.value());
+
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include <fixtures.h>
+#include <null_gl_context.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/renderer.h>
+#include <platform/input/timing.h>
+
+#include <optional>
+#include <stdio.h>
+#include <string>
+
+// Measures drawing 2k lines of text that don't change between frames,
+// redrawn every frame versus recorded once into a static batch. Half of
+// the frame is dynamic content drawn either way.
+
+constexpr int NUM_FRAMES = 100;
+constexpr int NUM_LINES = 2000;
+
+template <typename Drawer>
+static void draw_static_text(Drawer* drawer, const platform::Font& font) {
+	for (int i = 0; i < NUM_LINES; i++) {
+		drawer->draw_text(font, "Static line " + std::to_string(i), { (float)(i % 8) * 100.0f, (float)(i / 8) * 18.0f }, platform::Color::white);
+	}
+}
+
+static void draw_dynamic_text(platform::Renderer* renderer, const platform::Font& font, int frame) {
+	for (int i = 0; i < NUM_LINES; i++) {
+		renderer->draw_text(font, "Frame " + std::to_string(frame + i), { (float)(i % 8) * 100.0f, (float)(i / 8) * 18.0f }, platform::Color::red);
+	}
+}
+
+static void run_benchmark(const char* name, bool use_static_batch) {
+	benchmark::NullOpenGLContext gl_context;
+	platform::Renderer renderer(&gl_context);
+	const platform::ShaderProgram shader_program = {};
+	const platform::Font font = benchmark::make_font(platform::Texture { .id = 100, .size = { 128, 128 } });
+
+	std::optional<platform::StaticBatch> batch;
+	if (use_static_batch) {
+		platform::DrawRecorder recorder = renderer.make_static_batch_recorder();
+		draw_static_text(&recorder, font);
+		batch = renderer.add_static_batch(recorder);
+	}
+
+	uint64_t frame_ns = 0;
+	gl_context.uploaded_bytes = 0;
+	for (int frame = 0; frame < NUM_FRAMES; frame++) {
+		platform::Timer timer;
+		if (batch) {
+			renderer.draw_static_batch(batch.value());
+		}
+		else {
+			draw_static_text(&renderer, font);
+		}
+		draw_dynamic_text(&renderer, font, frame);
+		renderer.render(shader_program);
+		frame_ns += timer.elapsed_ns();
+	}
+
+	const platform::RenderDebugData debug_data = renderer.debug_data();
+	printf("%-14s %10zu %10zu %14zu %12.2f\n", name, debug_data.num_vertices, debug_data.num_static_vertices, gl_context.uploaded_bytes / NUM_FRAMES, (double)frame_ns / NUM_FRAMES / 1000.0);
+}
+
+int main() {
+	printf("%-14s %10s %10s %14s %12s\n", "static text", "vertices", "static", "bytes/frame", "frame us");
+	run_benchmark("redrawn", false);
+	run_benchmark("static batch", true);
+	return 0;
+}
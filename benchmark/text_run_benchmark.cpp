@@ -0,0 +1,83 @@
+#include <fixtures.h>
+#include <null_gl_context.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/renderer.h>
+#include <platform/input/timing.h>
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Measures drawing a text-heavy scene of 10k text nodes. Drawing glyph by
+// glyph is how draw_text used to work, cached runs are how it works now.
+// Changing text misses the cache every frame.
+
+constexpr int NUM_FRAMES = 100;
+constexpr int NUM_TEXT_NODES = 10000;
+
+enum class DrawMode {
+	PerGlyph,
+	CachedRuns,
+	ChangingText,
+};
+
+static void draw_per_glyph(platform::Renderer* renderer, const platform::Font& font, const std::string& text, glm::vec2 pos) {
+	glm::vec2 pen = pos;
+	for (char character : text) {
+		const platform::Glyph& glyph = font.glyphs[character];
+		if (character != ' ') {
+			renderer->draw_character(font, character, { pen.x + glyph.bearing.x, pen.y - glyph.bearing.y }, platform::Color::white);
+		}
+		pen.x += glyph.advance;
+	}
+}
+
+static void run_benchmark(const char* name, DrawMode draw_mode) {
+	benchmark::NullOpenGLContext gl_context;
+	platform::Renderer renderer(&gl_context);
+	const platform::ShaderProgram shader_program = {};
+	const platform::Font font = benchmark::make_font(platform::Texture { .id = 100, .size = { 128, 128 } });
+
+	std::vector<std::string> texts;
+	for (int i = 0; i < NUM_TEXT_NODES; i++) {
+		texts.push_back("Text node " + std::to_string(i));
+	}
+
+	uint64_t draw_ns = 0;
+	platform::TextRunCacheStats text_runs;
+	for (int frame = 0; frame < NUM_FRAMES; frame++) {
+		if (draw_mode == DrawMode::ChangingText) {
+			for (int i = 0; i < NUM_TEXT_NODES; i++) {
+				texts[i] = "Text node " + std::to_string(frame * NUM_TEXT_NODES + i);
+			}
+		}
+
+		platform::Timer timer;
+		for (int i = 0; i < NUM_TEXT_NODES; i++) {
+			const glm::vec2 pos = { (float)(i % 8) * 100.0f, (float)(i / 8 % 60) * 10.0f };
+			if (draw_mode == DrawMode::PerGlyph) {
+				draw_per_glyph(&renderer, font, texts[i], pos);
+			}
+			else {
+				renderer.draw_text(font, texts[i], pos, platform::Color::white);
+			}
+		}
+		draw_ns += timer.elapsed_ns();
+
+		renderer.render(shader_program);
+		text_runs.num_hits += renderer.debug_data().text_runs.num_hits;
+		text_runs.num_misses += renderer.debug_data().text_runs.num_misses;
+	}
+
+	printf("%-14s %10zu %10zu %12.2f\n", name, text_runs.num_hits / NUM_FRAMES, text_runs.num_misses / NUM_FRAMES, (double)draw_ns / NUM_FRAMES / 1000.0);
+}
+
+int main() {
+	printf("%-14s %10s %10s %12s\n", "text", "hits", "misses", "draw us");
+	run_benchmark("per glyph", DrawMode::PerGlyph);
+	run_benchmark("cached runs", DrawMode::CachedRuns);
+	run_benchmark("changing text", DrawMode::ChangingText);
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include <fixtures.h>
+#include <null_gl_context.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/renderer.h>
+#include <platform/input/timing.h>
+
+#include <stdio.h>
+#include <string>
+
+// Compares how many bytes are uploaded per frame with the standard and the
+// packed vertex format, and with instanced quads, for a frame that is mostly
+// text like the editor.
+
+constexpr int NUM_FRAMES = 1000;
+constexpr int NUM_TEXT_LINES = 50;
+constexpr int NUM_RECTS = 200;
+
+static void draw_frame(platform::Renderer* renderer, const platform::Font& font) {
+	const std::string line = "The quick brown fox jumps over the lazy dog 0123456789";
+	for (int i = 0; i < NUM_TEXT_LINES; i++) {
+		renderer->draw_text(font, line, { 0.0f, (float)(i * font.line_height) }, platform::Color::white);
+	}
+	for (int i = 0; i < NUM_RECTS; i++) {
+		const float x = (float)(i % 20) * 16.0f;
+		const float y = (float)(i / 20) * 16.0f;
+		renderer->draw_rect_fill({ { x, y }, { x + 12.0f, y + 12.0f } }, platform::Color::dark_grey);
+	}
+}
+
+static void run_benchmark(const char* name, platform::VertexFormat vertex_format, platform::QuadMode quad_mode) {
+	benchmark::NullOpenGLContext gl_context;
+	platform::Renderer renderer(&gl_context, vertex_format, quad_mode);
+	const platform::ShaderProgram shader_program = { .vertex_format = vertex_format, .quad_instances = platform::QuadInstanceProgram {} };
+	const unsigned char atlas_data[4] = {};
+	const platform::Font font = benchmark::make_font(gl_context.add_texture(atlas_data, 128, 128, platform::TextureWrapping::ClampToEdge, platform::TextureFilter::Nearest));
+
+	size_t num_vertices = 0;
+	size_t num_quad_instances = 0;
+	uint64_t total_ns = 0;
+	for (int frame = 0; frame < NUM_FRAMES; frame++) {
+		draw_frame(&renderer, font);
+		renderer.render(shader_program);
+		num_vertices = renderer.debug_data().num_vertices;
+		num_quad_instances = renderer.debug_data().num_quad_instances;
+		total_ns += renderer.debug_data().render_ns;
+	}
+
+	printf("%-18s %10zu %10zu %14zu %12.2f\n",
+		name,
+		num_vertices,
+		num_quad_instances,
+		gl_context.uploaded_bytes / NUM_FRAMES,
+		(double)total_ns / NUM_FRAMES / 1000.0);
+}
+
+int main() {
+	printf("%-18s %10s %10s %14s %12s\n", "format", "vertices", "instances", "bytes/frame", "render us");
+	run_benchmark("standard", platform::VertexFormat::Standard, platform::QuadMode::Vertices);
+	run_benchmark("packed", platform::VertexFormat::Packed, platform::QuadMode::Vertices);
+	run_benchmark("standard+instanced", platform::VertexFormat::Standard, platform::QuadMode::Instanced);
+	run_benchmark("packed+instanced", platform::VertexFormat::Packed, platform::QuadMode::Instanced);
+	return 0;
+}
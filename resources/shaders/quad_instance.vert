@@ -0,0 +1,26 @@
+#version 450 core
+
+// One QuadInstance per instance, drawn as a 4 vertex triangle strip. The
+// corner comes from gl_VertexID, in the same order as quad.h:
+//
+// 0 ---- 2
+// |    / |
+// |  /   |
+// 1 ---- 3
+//
+layout (location = 0) in vec4 in_pos; // corners 0 and 3
+layout (location = 1) in vec4 in_texture_uv; // uv of corners 0 and 3
+layout (location = 2) in vec4 in_color;
+
+uniform mat4 projection;
+uniform float uv_scale = 1.0; // instances store uv / uv_scale
+
+out vec4 vertex_color;
+out vec2 texture_uv;
+
+void main() {
+    vec2 corner = vec2(gl_VertexID >> 1, gl_VertexID & 1);
+    gl_Position = projection * vec4(mix(in_pos.xy, in_pos.zw, corner), 0.0, 1.0);
+    vertex_color = in_color;
+    texture_uv = mix(in_texture_uv.xy, in_texture_uv.zw, corner) * uv_scale;
+}
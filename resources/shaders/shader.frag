@@ -6,8 +6,14 @@ in vec2 texture_uv;
 layout(location = 0) out vec4 frag_color;
 
 uniform sampler2D in_texture;
+uniform bool distance_field = false; // texture alpha is a signed distance to glyph edges, with the edge at 0.5
 
 void main() {
-    frag_color = texture(in_texture, texture_uv) * vertex_color;
+    vec4 texel = texture(in_texture, texture_uv);
+    if (distance_field) {
+        // antialias over about a screen pixel, at any scale
+        float edge_width = fwidth(texel.a);
+        texel.a = smoothstep(0.5 - edge_width / 2.0, 0.5 + edge_width / 2.0, texel.a);
+    }
+    frag_color = texel * vertex_color;
 }
-
@@ -0,0 +1,107 @@
+#include <core/distance_transform.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace core {
+
+	// Lower envelope of the parabolas (q - p)^2 + f[p], for every p where
+	// f[p] is finite, sampled at each q. `v` holds the roots of the
+	// parabolas on the envelope and `z` the boundaries between them.
+	static void distance_transform_1d(const float* f, int n, float* d, int* v, float* z) {
+		constexpr float INF = std::numeric_limits<float>::infinity();
+
+		/* Build envelope */
+		int k = -1;
+		for (int q = 0; q < n; q++) {
+			if (f[q] >= DISTANCE_TRANSFORM_INFINITY) {
+				continue;
+			}
+			const float fq = f[q] + (float)(q * q);
+			float s = -INF;
+			while (k >= 0) {
+				// where the new parabola crosses the rightmost one, which
+				// is hidden if that's left of where it starts
+				s = (fq - (f[v[k]] + (float)(v[k] * v[k]))) / (float)(2 * (q - v[k]));
+				if (s > z[k]) {
+					break;
+				}
+				k--;
+			}
+			k++;
+			v[k] = q;
+			z[k] = k == 0 ? -INF : s;
+		}
+
+		if (k < 0) {
+			std::fill(d, d + n, DISTANCE_TRANSFORM_INFINITY);
+			return;
+		}
+		z[k + 1] = INF;
+
+		/* Sample envelope */
+		int j = 0;
+		for (int q = 0; q < n; q++) {
+			while (z[j + 1] < (float)q) {
+				j++;
+			}
+			d[q] = (float)((q - v[j]) * (q - v[j])) + f[v[j]];
+		}
+	}
+
+	std::vector<float> squared_distance_transform(std::span<const uint8_t> is_feature, glm::ivec2 size) {
+		const size_t width = (size_t)size.x;
+		const size_t height = (size_t)size.y;
+		std::vector<float> distances(width * height);
+		for (size_t i = 0; i < distances.size(); i++) {
+			distances[i] = is_feature[i] ? 0.0f : DISTANCE_TRANSFORM_INFINITY;
+		}
+
+		const size_t max_length = std::max(width, height);
+		std::vector<float> line(max_length);
+		std::vector<float> transformed(max_length);
+		std::vector<int> roots(max_length);
+		std::vector<float> boundaries(max_length + 1);
+
+		/* Columns */
+		for (size_t x = 0; x < width; x++) {
+			for (size_t y = 0; y < height; y++) {
+				line[y] = distances[y * width + x];
+			}
+			distance_transform_1d(line.data(), (int)height, transformed.data(), roots.data(), boundaries.data());
+			for (size_t y = 0; y < height; y++) {
+				distances[y * width + x] = transformed[y];
+			}
+		}
+
+		/* Rows */
+		for (size_t y = 0; y < height; y++) {
+			float* row = distances.data() + y * width;
+			std::copy(row, row + width, line.begin());
+			distance_transform_1d(line.data(), (int)width, row, roots.data(), boundaries.data());
+		}
+
+		return distances;
+	}
+
+	std::vector<float> signed_distance_field(std::span<const uint8_t> coverage, glm::ivec2 size, uint8_t threshold) {
+		const size_t num_cells = (size_t)size.x * size.y;
+		std::vector<uint8_t> is_inside(num_cells);
+		std::vector<uint8_t> is_outside(num_cells);
+		for (size_t i = 0; i < num_cells; i++) {
+			is_inside[i] = coverage[i] >= threshold;
+			is_outside[i] = !is_inside[i];
+		}
+
+		const std::vector<float> to_inside = squared_distance_transform(is_inside, size);
+		const std::vector<float> to_outside = squared_distance_transform(is_outside, size);
+
+		std::vector<float> distances(num_cells);
+		for (size_t i = 0; i < num_cells; i++) {
+			distances[i] = is_inside[i] ? std::sqrt(to_outside[i]) - 0.5f : 0.5f - std::sqrt(to_inside[i]);
+		}
+		return distances;
+	}
+
+} // namespace core
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include <span>
+#include <stdint.h>
+#include <vector>
+
+namespace core {
+
+	// Squared distance of cells with no feature cell in the grid
+	constexpr float DISTANCE_TRANSFORM_INFINITY = 1e20f;
+
+	// Squared euclidean distance from the center of each cell in a grid of
+	// `size` cells, stored in rows, to the center of the nearest cell where
+	// `is_feature` is nonzero.
+	//
+	// Exact, using the separable transform by Felzenszwalb and Huttenlocher:
+	// a 1D transform down every column and then along every row, each
+	// taking the lower envelope of parabolas rooted at the cells, so it's
+	// linear in the number of cells. Columns are copied into a contiguous
+	// scratch line so that both passes read memory in order.
+	std::vector<float> squared_distance_transform(std::span<const uint8_t> is_feature, glm::ivec2 size);
+
+	// Signed distance in cells from the center of each cell to the edge of
+	// the shape made of cells with `coverage >= threshold`, positive inside.
+	// The edge lies halfway between inside and outside cells, so cells
+	// next to it are 0.5 away.
+	std::vector<float> signed_distance_field(std::span<const uint8_t> coverage, glm::ivec2 size, uint8_t threshold = 128);
+
+} // namespace core
@@ -0,0 +1,52 @@
+#include <core/radix_sort.h>
+
+#include <array>
+#include <utility>
+
+namespace core {
+
+	void radix_sort(std::vector<SortKey>* keys, std::vector<SortKey>* scratch) {
+		constexpr size_t DIGIT_BITS = 8;
+		constexpr size_t NUM_BUCKETS = 1 << DIGIT_BITS;
+		constexpr size_t NUM_PASSES = 64 / DIGIT_BITS;
+
+		if (keys->size() < 2) {
+			return;
+		}
+
+		/* Count digits for all passes at once */
+		std::array<std::array<size_t, NUM_BUCKETS>, NUM_PASSES> counts = {};
+		for (const SortKey& sort_key : *keys) {
+			for (size_t pass = 0; pass < NUM_PASSES; pass++) {
+				counts[pass][(sort_key.key >> (pass * DIGIT_BITS)) & (NUM_BUCKETS - 1)]++;
+			}
+		}
+
+		scratch->resize(keys->size());
+		for (size_t pass = 0; pass < NUM_PASSES; pass++) {
+			std::array<size_t, NUM_BUCKETS>& count = counts[pass];
+
+			// all keys share this digit, order would be unchanged
+			const size_t first_digit = (keys->front().key >> (pass * DIGIT_BITS)) & (NUM_BUCKETS - 1);
+			if (count[first_digit] == keys->size()) {
+				continue;
+			}
+
+			// compute bucket offsets
+			size_t offset = 0;
+			for (size_t& bucket : count) {
+				size_t bucket_size = bucket;
+				bucket = offset;
+				offset += bucket_size;
+			}
+
+			// scatter into buckets, preserving relative order
+			for (const SortKey& sort_key : *keys) {
+				const size_t digit = (sort_key.key >> (pass * DIGIT_BITS)) & (NUM_BUCKETS - 1);
+				(*scratch)[count[digit]++] = sort_key;
+			}
+			std::swap(*keys, *scratch);
+		}
+	}
+
+} // namespace core
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace core {
+
+	struct SortKey {
+		uint64_t key;
+		uint32_t index; // index of the sorted element
+	};
+
+	// Stable least significant digit radix sort, sorting 8 bits per pass.
+	// Passes where all keys have the same digit are skipped, so keys that only
+	// use a few of their bits are sorted in correspondingly few passes.
+	//
+	// `scratch` is used as temporary storage, pass the same vector between
+	// calls to avoid reallocating it.
+	void radix_sort(std::vector<SortKey>* keys, std::vector<SortKey>* scratch);
+
+} // namespace core
@@ -0,0 +1,114 @@
+#include <core/skyline_packer.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace core {
+
+	SkylinePacker::SkylinePacker(glm::ivec2 size)
+		: m_size(size) {
+		m_skyline.push_back(Segment { .x = 0, .y = 0, .width = size.x });
+	}
+
+	std::optional<glm::ivec2> SkylinePacker::pack(glm::ivec2 size) {
+		if (size.x < 0 || size.y < 0 || size.x > m_size.x || size.y > m_size.y) {
+			return {};
+		}
+
+		/* Find lowest fit */
+		// Ties go to the narrowest segment, which wastes the least of the
+		// space next to it
+		std::optional<size_t> best_index;
+		int best_top = std::numeric_limits<int>::max();
+		int best_width = std::numeric_limits<int>::max();
+		for (size_t i = 0; i < m_skyline.size(); i++) {
+			std::optional<int> y = _fit(i, size);
+			if (!y) {
+				continue;
+			}
+			const int top = *y + size.y;
+			if (top < best_top || (top == best_top && m_skyline[i].width < best_width)) {
+				best_index = i;
+				best_top = top;
+				best_width = m_skyline[i].width;
+			}
+		}
+		if (!best_index) {
+			return {};
+		}
+
+		/* Place */
+		const glm::ivec2 pos = { m_skyline[*best_index].x, best_top - size.y };
+		if (size.x > 0) {
+			_add_segment(*best_index, pos, size);
+		}
+		m_packed_area += (int64_t)size.x * size.y;
+		return pos;
+	}
+
+	glm::ivec2 SkylinePacker::size() const {
+		return m_size;
+	}
+
+	int64_t SkylinePacker::packed_area() const {
+		return m_packed_area;
+	}
+
+	float SkylinePacker::occupancy() const {
+		const int64_t area = (int64_t)m_size.x * m_size.y;
+		return area > 0 ? (float)((double)m_packed_area / (double)area) : 0.0f;
+	}
+
+	// Returns the y a rectangle would be placed at if its left edge is at
+	// the start of the segment, or empty if it doesn't fit there
+	std::optional<int> SkylinePacker::_fit(size_t segment_index, glm::ivec2 size) const {
+		const int x = m_skyline[segment_index].x;
+		if (x + size.x > m_size.x) {
+			return {};
+		}
+
+		int y = 0;
+		int remaining_width = size.x;
+		for (size_t i = segment_index; i < m_skyline.size(); i++) {
+			y = std::max(y, m_skyline[i].y);
+			if (y + size.y > m_size.y) {
+				return {};
+			}
+			remaining_width -= m_skyline[i].width;
+			if (remaining_width <= 0) {
+				break;
+			}
+		}
+		return y;
+	}
+
+	void SkylinePacker::_add_segment(size_t segment_index, glm::ivec2 pos, glm::ivec2 size) {
+		m_skyline.insert(m_skyline.begin() + segment_index, Segment { .x = pos.x, .y = pos.y + size.y, .width = size.x });
+
+		/* Shrink segments now under the new one */
+		const int right = pos.x + size.x;
+		size_t i = segment_index + 1;
+		while (i < m_skyline.size() && m_skyline[i].x < right) {
+			const int segment_right = m_skyline[i].x + m_skyline[i].width;
+			if (segment_right <= right) {
+				m_skyline.erase(m_skyline.begin() + i);
+				continue;
+			}
+			m_skyline[i].width = segment_right - right;
+			m_skyline[i].x = right;
+			break;
+		}
+
+		/* Merge neighbours of equal height */
+		for (size_t j = 0; j + 1 < m_skyline.size();) {
+			if (m_skyline[j].y == m_skyline[j + 1].y) {
+				m_skyline[j].width += m_skyline[j + 1].width;
+				m_skyline.erase(m_skyline.begin() + j + 1);
+			}
+			else {
+				j++;
+			}
+		}
+	}
+
+} // namespace core
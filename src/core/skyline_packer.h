@@ -0,0 +1,45 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include <optional>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace core {
+
+	// Packs rectangles into a fixed size area, e.g. images into a texture
+	// atlas.
+	//
+	// Keeps the skyline, the top edge of what's been packed so far, and
+	// places each rectangle where it leaves the skyline lowest. Packing
+	// rectangles sorted by decreasing height wastes the least space.
+	class SkylinePacker {
+	public:
+		explicit SkylinePacker(glm::ivec2 size);
+
+		// Returns the top left corner of the packed rectangle, or empty if
+		// there's no room left for it
+		std::optional<glm::ivec2> pack(glm::ivec2 size);
+
+		glm::ivec2 size() const;
+		int64_t packed_area() const;
+		float occupancy() const; // fraction of the area that's packed
+
+	private:
+		struct Segment {
+			int x;
+			int y; // height of the skyline
+			int width;
+		};
+
+		std::optional<int> _fit(size_t segment_index, glm::ivec2 size) const;
+		void _add_segment(size_t segment_index, glm::ivec2 pos, glm::ivec2 size);
+
+		glm::ivec2 m_size;
+		std::vector<Segment> m_skyline; // ordered left to right, covering the whole width
+		int64_t m_packed_area = 0;
+	};
+
+} // namespace core
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <type_traits>
 #include <variant>
 
 namespace core {
@@ -10,15 +11,10 @@ namespace core {
 		TaggedVariant() = default;
 
 		template <typename T>
-		TaggedVariant(const T& t)
-			: std::variant<First, Types...>(t)
-			, m_tag(T::TAG) {
-		}
-
-		template <typename T>
+			requires(!std::is_same_v<std::remove_cvref_t<T>, TaggedVariant>)
 		TaggedVariant(T&& t)
-			: std::variant<First, Types...>(std::move(t))
-			, m_tag(T::TAG) {
+			: std::variant<First, Types...>(std::forward<T>(t))
+			, m_tag(std::remove_cvref_t<T>::TAG) {
 		}
 
 		Tag tag() const {
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace core::utf8 {
+
+	constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+	// Decodes the codepoint starting at `*it` and moves `*it` past it.
+	// Invalid, overlong and truncated sequences decode to
+	// REPLACEMENT_CHARACTER and skip a single byte, so decoding always
+	// makes progress.
+	inline char32_t next_codepoint(const char** it, const char* end) {
+		const uint8_t* bytes = (const uint8_t*)*it;
+		const uint8_t first = bytes[0];
+
+		/* ASCII */
+		if (first < 0x80) {
+			*it += 1;
+			return first;
+		}
+
+		/* Multi byte */
+		int length;
+		char32_t codepoint;
+		char32_t min_codepoint; // smaller values are overlong encodings
+		if ((first & 0xE0) == 0xC0) {
+			length = 2;
+			codepoint = first & 0x1F;
+			min_codepoint = 0x80;
+		}
+		else if ((first & 0xF0) == 0xE0) {
+			length = 3;
+			codepoint = first & 0x0F;
+			min_codepoint = 0x800;
+		}
+		else if ((first & 0xF8) == 0xF0) {
+			length = 4;
+			codepoint = first & 0x07;
+			min_codepoint = 0x10000;
+		}
+		else {
+			*it += 1;
+			return REPLACEMENT_CHARACTER;
+		}
+
+		if (end - *it < length) {
+			*it += 1;
+			return REPLACEMENT_CHARACTER;
+		}
+		for (int i = 1; i < length; i++) {
+			if ((bytes[i] & 0xC0) != 0x80) {
+				*it += 1;
+				return REPLACEMENT_CHARACTER;
+			}
+			codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+		}
+
+		const bool is_surrogate = codepoint >= 0xD800 && codepoint <= 0xDFFF;
+		if (codepoint < min_codepoint || codepoint > 0x10FFFF || is_surrogate) {
+			*it += 1;
+			return REPLACEMENT_CHARACTER;
+		}
+		*it += length;
+		return codepoint;
+	}
+
+} // namespace core::utf8
@@ -0,0 +1,88 @@
+#include <core/worker_pool.h>
+
+#include <algorithm>
+
+namespace core {
+
+	WorkerPool::WorkerPool(size_t num_threads)
+		: m_num_threads(std::max<size_t>(num_threads, 1)) {
+	}
+
+	WorkerPool::~WorkerPool() {
+		_stop_threads();
+	}
+
+	void WorkerPool::run(size_t num_jobs, const std::function<void(size_t)>& job) {
+		if (num_jobs == 0) {
+			return;
+		}
+		if (m_threads.empty()) {
+			_start_threads();
+		}
+
+		std::unique_lock lock(m_mutex);
+		m_job = &job;
+		m_num_jobs = num_jobs;
+		m_next_job = 0;
+		m_num_finished_jobs = 0;
+		m_jobs_available.notify_all();
+		m_jobs_done.wait(lock, [this]() { return m_num_finished_jobs == m_num_jobs; });
+
+		m_job = nullptr;
+		m_num_jobs = 0;
+		m_next_job = 0;
+	}
+
+	void WorkerPool::resize(size_t num_threads) {
+		num_threads = std::max<size_t>(num_threads, 1);
+		if (num_threads != m_num_threads) {
+			_stop_threads();
+			m_num_threads = num_threads;
+		}
+	}
+
+	size_t WorkerPool::num_threads() const {
+		return m_num_threads;
+	}
+
+	void WorkerPool::_start_threads() {
+		m_threads.reserve(m_num_threads);
+		for (size_t i = 0; i < m_num_threads; i++) {
+			m_threads.push_back(std::thread([this]() { _run_worker_thread(); }));
+		}
+	}
+
+	void WorkerPool::_stop_threads() {
+		{
+			std::lock_guard lock(m_mutex);
+			m_is_stopping = true;
+		}
+		m_jobs_available.notify_all();
+		for (std::thread& thread : m_threads) {
+			thread.join();
+		}
+		m_threads.clear();
+		m_is_stopping = false;
+	}
+
+	void WorkerPool::_run_worker_thread() {
+		std::unique_lock lock(m_mutex);
+		while (true) {
+			m_jobs_available.wait(lock, [this]() { return m_is_stopping || m_next_job < m_num_jobs; });
+			if (m_is_stopping) {
+				return;
+			}
+
+			const std::function<void(size_t)>* job = m_job;
+			const size_t index = m_next_job++;
+			lock.unlock();
+			(*job)(index);
+			lock.lock();
+
+			if (++m_num_finished_jobs == m_num_jobs) {
+				m_jobs_done.notify_one();
+			}
+		}
+	}
+
+} // namespace core
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stddef.h>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+	// Runs batches of jobs on threads that are kept between batches, so work
+	// that is split up every frame doesn't start new threads every frame.
+	//
+	// Threads are started by the first batch run after the pool is made or
+	// resized, and stopped when it's resized or destroyed. Batches are run
+	// from one thread at a time.
+	class WorkerPool {
+	public:
+		explicit WorkerPool(size_t num_threads);
+		~WorkerPool();
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		// Calls `job(index)` for every index below `num_jobs` on the pool's
+		// threads, and blocks until all of them have returned. The calling
+		// thread only waits, so it doesn't run jobs itself.
+		void run(size_t num_jobs, const std::function<void(size_t)>& job);
+
+		void resize(size_t num_threads);
+		size_t num_threads() const;
+
+	private:
+		void _start_threads();
+		void _stop_threads();
+		void _run_worker_thread();
+
+		size_t m_num_threads;
+		std::vector<std::thread> m_threads;
+		std::mutex m_mutex;
+		std::condition_variable m_jobs_available;
+		std::condition_variable m_jobs_done;
+		const std::function<void(size_t)>* m_job = nullptr; // of the running batch
+		size_t m_num_jobs = 0;
+		size_t m_next_job = 0;
+		size_t m_num_finished_jobs = 0;
+		bool m_is_stopping = false;
+	};
+
+} // namespace core
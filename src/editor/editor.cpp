@@ -408,7 +408,7 @@ namespace editor {
 
 		/* Scene Window */
 		if (ImGui::Begin(SCENE_WINDOW)) {
-			m_scene_window.update(&engine->scene_graph(), gl_context, input, &commands);
+			m_scene_window.update(&engine->scene_graph(), &engine->systems().text, gl_context, input, &commands);
 		}
 		ImGui::End();
 
@@ -416,7 +416,7 @@ namespace editor {
 	}
 
 	void Editor::render(const engine::Engine& engine, platform::OpenGLContext* gl_context, platform::Renderer* renderer) const {
-		m_scene_window.render(gl_context, engine.systems().text, m_system_font_id, renderer);
+		m_scene_window.render(gl_context, engine.scene_graph(), engine.systems().text, m_system_font_id, renderer);
 	}
 
 } // namespace editor
@@ -1,13 +1,26 @@
 #include <editor/ui/scene_window.h>
 
+#include <core/hash.h>
+#include <platform/debug/logging.h>
 #include <platform/input/input.h>
 
 #include <imgui/imgui.h>
 
+#include <cmath>
+
 namespace editor {
 
 	constexpr int GRID_SIZE = 32;
 
+	// Draw layers, keeps the painter's order when the renderer sorts draws
+	enum class DrawLayer : uint16_t {
+		Background,
+		Content,
+		Outline,
+		Overlay,
+		Text,
+	};
+
 	static float zoom_index_to_scale(int zoom_index) {
 		constexpr int min_zoom = -12;
 		constexpr int max_zoom = 12;
@@ -150,6 +163,7 @@ namespace editor {
 
 	void SceneWindow::update(
 		engine::SceneGraph* /* scene_graph */,
+		engine::TextSystem* text_system,
 		platform::OpenGLContext* gl_context,
 		const platform::Input& input,
 		std::vector<EditorCommand>* commands
@@ -178,6 +192,12 @@ namespace editor {
 				m_scene.scaled_canvas_rect.set_position((scene_window_size - m_scene.scaled_canvas_rect.size()) / 2.0f);
 			}
 			waited = true;
+
+			// Visible part
+			m_visible_size = glm::min(scene_window_size, m_canvas.texture.size);
+
+			// Fonts for zoomed text
+			_add_distance_field_fonts(text_system, gl_context);
 		}
 
 		// Render scene texture
@@ -204,100 +224,257 @@ namespace editor {
 		}
 	}
 
-	// Render the scene itself, which is inside the scene window
+	// Adds a distance field font for each font scene text is drawn with,
+	// so that zoomed text can be drawn at its zoomed size instead of in the
+	// scene canvas, which is scaled and would blur or pixelate it
+	void SceneWindow::_add_distance_field_fonts(engine::TextSystem* text_system, platform::OpenGLContext* gl_context) {
+		for (const auto& [node_id, text_node] : text_system->text_nodes()) {
+			const engine::FontID font_id = text_node.font_id;
+			if (m_distance_field_fonts.contains(font_id)) {
+				continue;
+			}
+			const platform::Font& font = text_system->fonts().at(font_id);
+			if (font.distance_field) {
+				m_distance_field_fonts.insert({ font_id, font_id });
+				continue;
+			}
+
+			// fonts that can't be added are drawn in the scene canvas at any zoom
+			const uint8_t font_size = (uint8_t)font.size;
+			const std::string font_path = text_system->font_path(font_id);
+			std::expected<engine::FontID, std::string> distance_field_font = text_system->add_font(gl_context, font_path.c_str(), font_size, platform::FontAtlasMode::DistanceField);
+			if (!distance_field_font) {
+				LOG_ERROR("Could not add distance field font for %s: %s", font_path.c_str(), distance_field_font.error().c_str());
+			}
+			m_distance_field_fonts.insert({ font_id, distance_field_font.value_or(font_id) });
+		}
+	}
+
+	// Distance field font to draw scene text in `font_id` with when zoomed,
+	// null if it's drawn in the scene canvas
+	static const platform::Font* zoomed_text_font(
+		const EditorScene& editor_scene,
+		const engine::TextSystem& text_system,
+		const std::unordered_map<engine::FontID, engine::FontID>& distance_field_fonts,
+		engine::FontID font_id
+	) {
+		if (editor_scene.zoom_index == 0) {
+			return nullptr;
+		}
+		auto it = distance_field_fonts.find(font_id);
+		if (it == distance_field_fonts.end()) {
+			return nullptr;
+		}
+		const platform::Font& font = text_system.fonts().at(it->second);
+		return font.distance_field ? &font : nullptr;
+	}
+
+	static void add_rect_to_hash(size_t* hash, const core::Rect& rect) {
+		core::hash::add_to_hash(hash, rect.top_left.x);
+		core::hash::add_to_hash(hash, rect.top_left.y);
+		core::hash::add_to_hash(hash, rect.bottom_right.x);
+		core::hash::add_to_hash(hash, rect.bottom_right.y);
+	}
+
+	// Render the checkered grid tile, repeated behind the scene
+	static void render_grid(platform::Renderer* renderer) {
+		glm::vec4 dark = platform::Color::rgba(138, 83, 83, 255);
+		glm::vec4 light = platform::Color::rgba(167, 107, 107, 255);
+		renderer->draw_rect_fill({ { 0, 0 }, { GRID_SIZE * 2, GRID_SIZE * 2 } }, dark);
+		renderer->draw_rect_fill({ { GRID_SIZE, 0 }, { 2 * GRID_SIZE, GRID_SIZE } }, light);
+		renderer->draw_rect_fill({ { 0, GRID_SIZE }, { GRID_SIZE, 2 * GRID_SIZE } }, light);
+	}
+
+	// Render the scene itself, which is inside the scene window. Draws
+	// outside `visible_rect` can't be seen and are culled.
 	static void render_scene_view(
 		const EditorScene& editor_scene,
+		core::Rect visible_rect,
 		platform::OpenGLContext* gl_context,
 		const engine::TextSystem& text_system,
+		const std::unordered_map<engine::FontID, engine::FontID>& distance_field_fonts,
 		platform::Renderer* renderer
 	) {
 		const glm::vec2 scene_canvas_size = editor_scene.canvas.texture.size;
+		renderer->push_clip_rect(visible_rect);
 
 		// Clear scene
+		renderer->push_draw_layer((uint16_t)DrawLayer::Background);
 		renderer->draw_rect_fill({ { 0.0f, 0.0f }, scene_canvas_size }, platform::Color::light_grey);
+		renderer->pop_draw_layer();
 
 		/* Render grid */
 		{
 			// Blur when zoomed out
 			gl_context->set_texture_filter(editor_scene.grid_canvas.texture, editor_scene.zoom_index < 0 ? platform::TextureFilter::Linear : platform::TextureFilter::Nearest);
 
-			renderer->push_draw_canvas(editor_scene.grid_canvas);
-			{
-				glm::vec4 dark = platform::Color::rgba(138, 83, 83, 255);
-				glm::vec4 light = platform::Color::rgba(167, 107, 107, 255);
-				renderer->draw_rect_fill({ { 0, 0 }, { GRID_SIZE * 2, GRID_SIZE * 2 } }, dark);
-				renderer->draw_rect_fill({ { GRID_SIZE, 0 }, { 2 * GRID_SIZE, GRID_SIZE } }, light);
-				renderer->draw_rect_fill({ { 0, GRID_SIZE }, { GRID_SIZE, 2 * GRID_SIZE } }, light);
-			}
-			renderer->pop_draw_canvas();
-
 			core::FlipRect uv = { { 0, 0 }, scene_canvas_size / (float)GRID_SIZE };
+			renderer->push_draw_layer((uint16_t)DrawLayer::Content);
 			renderer->draw_texture_clipped(editor_scene.grid_canvas.texture, { { 0, 0 }, scene_canvas_size }, uv);
+			renderer->pop_draw_layer();
 		}
 
 		// Coordinate Axes
 		// (If zoomed out, axes are rendered on top of the scene view instead of inside the scene to make sure they're always crisp)
 		if (editor_scene.zoom_index >= 0) {
+			renderer->push_draw_layer((uint16_t)DrawLayer::Overlay);
 			renderer->draw_line({ 0.0f, scene_canvas_size.y / 2.0f }, { scene_canvas_size.x + 1.0f, scene_canvas_size.y / 2.0f }, platform::Color::red); // horizontal
 			renderer->draw_line({ scene_canvas_size.x / 2.0f, 0.0f }, { scene_canvas_size.x / 2.0f, scene_canvas_size.y + 1.0f }, platform::Color::green); // vertical
+			renderer->pop_draw_layer();
 		}
 
 		/* Render scene */
 		{
 			glm::vec2 canvas_center = scene_canvas_size / 2.0f;
 			for (const auto& [node_id, text_node] : text_system.text_nodes()) {
-				const platform::Font& font = text_system.fonts().at(text_node.font_id);
-				renderer->draw_text(font, text_node.text, canvas_center + text_node.position, platform::Color::white);
+				// zoomed text is drawn by render_zoomed_text instead
+				if (!zoomed_text_font(editor_scene, text_system, distance_field_fonts, text_node.font_id)) {
+					const platform::Font& font = text_system.fonts().at(text_node.font_id);
+					renderer->push_draw_layer((uint16_t)DrawLayer::Text);
+					renderer->draw_text(font, text_node.text, canvas_center + text_node.position, platform::Color::white);
+					renderer->pop_draw_layer();
+				}
 				const bool is_selected = false; // TODO: determine if node is selected
 				if (is_selected) {
+					renderer->push_draw_layer((uint16_t)DrawLayer::Outline);
 					renderer->draw_rect(text_node.rect + canvas_center, platform::Color::white);
+					renderer->pop_draw_layer();
 				}
 			}
 		}
+
+		renderer->pop_clip_rect();
+	}
+
+	// Render scene text at its zoomed size on top of the scaled scene
+	// canvas, with distance field fonts so it stays sharp at any zoom
+	static void render_zoomed_text(
+		const EditorScene& editor_scene,
+		core::Rect visible_rect,
+		const engine::TextSystem& text_system,
+		const std::unordered_map<engine::FontID, engine::FontID>& distance_field_fonts,
+		platform::Renderer* renderer
+	) {
+		const core::Rect& scaled_rect = editor_scene.scaled_canvas_rect;
+		const core::Rect clip_rect = { glm::max(visible_rect.top_left, scaled_rect.top_left), glm::min(visible_rect.bottom_right, scaled_rect.bottom_right) };
+		if (clip_rect.top_left.x >= clip_rect.bottom_right.x || clip_rect.top_left.y >= clip_rect.bottom_right.y) {
+			return;
+		}
+
+		const float zoom = zoom_index_to_scale(editor_scene.zoom_index);
+		const glm::vec2 canvas_center = editor_scene.canvas_size / 2.0f;
+		renderer->push_clip_rect(clip_rect);
+		renderer->push_draw_layer((uint16_t)DrawLayer::Text);
+		for (const auto& [node_id, text_node] : text_system.text_nodes()) {
+			if (const platform::Font* font = zoomed_text_font(editor_scene, text_system, distance_field_fonts, text_node.font_id)) {
+				const size_t zoomed_size = std::max<size_t>(1, (size_t)std::lround((float)font->size * zoom));
+				const glm::vec2 pos = scaled_rect.top_left + (canvas_center + text_node.position) * zoom;
+				renderer->draw_text(platform::scale_font(*font, zoomed_size), text_node.text, pos, platform::Color::white);
+			}
+		}
+		renderer->pop_draw_layer();
+		renderer->pop_clip_rect();
 	}
 
 	void SceneWindow::render(
 		platform::OpenGLContext* gl_context,
+		const engine::SceneGraph& scene_graph,
 		const engine::TextSystem& text_system,
 		engine::FontID system_font_id,
 		platform::Renderer* renderer
 	) const {
-		/* Render scene canvas */
-		renderer->push_draw_canvas(m_scene.canvas);
-		render_scene_view(m_scene, gl_context, text_system, renderer);
-		renderer->pop_draw_canvas();
-
-		/* Render scene canvas to imgui canvas */
-		renderer->push_draw_canvas(m_canvas);
-		{
-			const core::Rect scaled_rect = m_scene.scaled_canvas_rect;
-
-			/* Background*/
-			const glm::vec4 background_color = platform::Color::rgba(35, 20, 20, 255);
-			renderer->draw_rect_fill(core::Rect { glm::vec2 { 0.0f, 0.0f }, m_canvas.texture.size }, background_color); // background
-
-			/* Canvas */
-			const glm::vec2 offset = { 1.0f, 1.0f };
-			const glm::vec4 outline_color = platform::Color::rgba(65, 65, 44, 255);
-			renderer->draw_texture(m_scene.canvas.texture, scaled_rect); // render canvas
-			renderer->draw_rect(scaled_rect, outline_color); // outline
-			renderer->draw_rect({ scaled_rect.top_left - offset, scaled_rect.bottom_right + offset }, outline_color);
-
-			/* Coordinate axes */
-			// If we're zoomed out, we render on top of the texture to make sure the lines are crisp
-			if (m_scene.zoom_index < 0) {
-				const core::Rect rect = scaled_rect;
-				const core::Rect half_rect = scaled_rect / 2.0f;
-				renderer->draw_line({ rect.top_left.x, half_rect.bottom_right.y }, { rect.bottom_right.x, half_rect.bottom_right.y }, platform::Color::red);
-				renderer->draw_line({ half_rect.bottom_right.x, rect.top_left.y }, { half_rect.bottom_right.x, rect.bottom_right.y }, platform::Color::green);
-			}
+		// The part of the scene canvas that shows in the scene window
+		const core::Rect visible_rect = { { 0.0f, 0.0f }, m_visible_size };
+		const glm::vec2 scene_scale = m_scene.scaled_canvas_rect.size() / m_scene.canvas.texture.size;
+		const core::Rect visible_scene_rect = (visible_rect - m_scene.scaled_canvas_rect.top_left) / scene_scale;
+
+		/* Versions */
+		// Passes are only redrawn when what they show changed, so an idle
+		// editor doesn't redraw the scene every frame
+		size_t view_version = 0; // zoom, drag and window size
+		core::hash::add_to_hash(&view_version, m_scene.zoom_index);
+		add_rect_to_hash(&view_version, m_scene.scaled_canvas_rect);
+		add_rect_to_hash(&view_version, visible_rect);
+		size_t scene_version = view_version;
+		core::hash::add_to_hash(&scene_version, scene_graph.version());
+		core::hash::add_to_hash(&scene_version, text_system.version());
+		size_t scene_window_version = view_version;
+		core::hash::add_to_hash(&scene_window_version, text_system.version()); // system font
+
+		/* Declare passes */
+		constexpr uint64_t grid_version = 1; // the grid never changes
+		m_render_graph.add_pass({
+			.name = "grid",
+			.target = m_scene.grid_canvas,
+			.version = grid_version,
+			.draw = render_grid,
+		});
+		m_render_graph.add_pass({
+			.name = "scene",
+			.target = m_scene.canvas,
+			.inputs = { m_scene.grid_canvas },
+			.version = scene_version,
+			.draw = [&](platform::Renderer* pass_renderer) { render_scene_view(m_scene, visible_scene_rect, gl_context, text_system, m_distance_field_fonts, pass_renderer); },
+		});
+		m_render_graph.add_pass({
+			.name = "scene window",
+			.target = m_canvas,
+			.inputs = { m_scene.canvas },
+			.version = scene_window_version,
+			.draw = [&](platform::Renderer* pass_renderer) {
+				const core::Rect scaled_rect = m_scene.scaled_canvas_rect;
+
+				// Only the visible part of the canvas is drawn, so it doesn't
+				// cost more to fill when the monitor is larger than the window
+				pass_renderer->push_clip_rect(visible_rect);
+
+				/* Background*/
+				const glm::vec4 background_color = platform::Color::rgba(35, 20, 20, 255);
+				pass_renderer->push_draw_layer((uint16_t)DrawLayer::Background);
+				pass_renderer->draw_rect_fill(core::Rect { glm::vec2 { 0.0f, 0.0f }, m_canvas.texture.size }, background_color); // background
+				pass_renderer->pop_draw_layer();
+
+				/* Canvas */
+				const glm::vec2 offset = { 1.0f, 1.0f };
+				const glm::vec4 outline_color = platform::Color::rgba(65, 65, 44, 255);
+				pass_renderer->push_draw_layer((uint16_t)DrawLayer::Content);
+				pass_renderer->draw_texture(m_scene.canvas.texture, scaled_rect); // render canvas
+				pass_renderer->pop_draw_layer();
+				pass_renderer->push_draw_layer((uint16_t)DrawLayer::Outline);
+				pass_renderer->draw_rect(scaled_rect, outline_color); // outline
+				pass_renderer->draw_rect({ scaled_rect.top_left - offset, scaled_rect.bottom_right + offset }, outline_color);
+				pass_renderer->pop_draw_layer();
+
+				/* Zoomed text */
+				render_zoomed_text(m_scene, visible_rect, text_system, m_distance_field_fonts, pass_renderer);
+
+				/* Coordinate axes */
+				// If we're zoomed out, we render on top of the texture to make sure the lines are crisp
+				if (m_scene.zoom_index < 0) {
+					const core::Rect rect = scaled_rect;
+					const core::Rect half_rect = scaled_rect / 2.0f;
+					pass_renderer->push_draw_layer((uint16_t)DrawLayer::Overlay);
+					pass_renderer->draw_line({ rect.top_left.x, half_rect.bottom_right.y }, { rect.bottom_right.x, half_rect.bottom_right.y }, platform::Color::red);
+					pass_renderer->draw_line({ half_rect.bottom_right.x, rect.top_left.y }, { half_rect.bottom_right.x, rect.bottom_right.y }, platform::Color::green);
+					pass_renderer->pop_draw_layer();
+				}
 
-			// Print zoom
-			const platform::Font& system_font = text_system.fonts().at(system_font_id);
-			std::string zoom_text = std::format("{:.1f}%", 100 * zoom_index_to_scale(m_scene.zoom_index));
-			renderer->draw_text(system_font, zoom_text.c_str(), { 5, 20 }, { 1.0f, 1.0f, 1.0f, 0.75f });
+				// Print zoom
+				const platform::Font& system_font = text_system.fonts().at(system_font_id);
+				std::string zoom_text = std::format("{:.1f}%", 100 * zoom_index_to_scale(m_scene.zoom_index));
+				pass_renderer->push_draw_layer((uint16_t)DrawLayer::Text);
+				pass_renderer->draw_text(system_font, zoom_text.c_str(), { 5, 20 }, { 1.0f, 1.0f, 1.0f, 0.75f });
+				pass_renderer->pop_draw_layer();
+
+				pass_renderer->pop_clip_rect();
+			},
+		});
+
+		/* Render passes */
+		std::expected<void, platform::RenderGraphError> result = m_render_graph.execute(renderer);
+		if (!result) {
+			LOG_ERROR("Could not render scene window, passes depend on each other");
 		}
-		renderer->pop_draw_canvas();
 	}
 
 } // namespace editor
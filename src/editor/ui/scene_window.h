@@ -3,10 +3,13 @@
 #include <editor/editor_command.h>
 #include <engine/state/scene_graph.h>
 #include <platform/graphics/font.h>
+#include <platform/graphics/render_graph.h>
 #include <platform/graphics/renderer.h>
 
 #include <glm/vec2.hpp>
 
+#include <unordered_map>
+
 namespace platform {
 	struct Input;
 	class OpenGLContext;
@@ -30,6 +33,7 @@ namespace editor {
 
 		void update(
 			engine::SceneGraph* scene_graph,
+			engine::TextSystem* text_system,
 			platform::OpenGLContext* gl_context,
 			const platform::Input& input,
 			std::vector<EditorCommand>* commands
@@ -37,15 +41,21 @@ namespace editor {
 
 		void render(
 			platform::OpenGLContext* gl_context,
+			const engine::SceneGraph& scene_graph,
 			const engine::TextSystem& text_system,
 			engine::FontID system_font_id,
 			platform::Renderer* renderer
 		) const;
 
 	private:
+		void _add_distance_field_fonts(engine::TextSystem* text_system, platform::OpenGLContext* gl_context);
+
 		EditorScene m_scene; // the content of the scene window, the scene itself
 		platform::Canvas m_canvas; // used to render ImGui::Image
+		glm::vec2 m_visible_size = { 0.0f, 0.0f }; // part of m_canvas shown in the scene window, drawing is clipped to it
 		bool m_position_initialized = false; // used to center scene view once we know ImGui window size
+		mutable platform::RenderGraph m_render_graph; // remembers which canvases are up to date between frames
+		std::unordered_map<engine::FontID, engine::FontID> m_distance_field_fonts; // by the scene font they're made from, to draw zoomed text with
 	};
 
 } // namespace editor
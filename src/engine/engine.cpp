@@ -5,11 +5,11 @@
 #include <platform/debug/logging.h>
 #include <platform/file/config.h>
 #include <platform/file/file.h>
+#include <platform/os/win32.h>
 
 #include <imgui/imgui.h>
 
 #include <filesystem>
-#include <numeric>
 #include <vector>
 
 namespace engine {
@@ -49,20 +49,57 @@ namespace engine {
 
 		ImGui::SeparatorText("Render Debug");
 		{
-			debug_ui->frame_render_deltas.push_back((float)input.renderer_debug_data.render_ns / 1000000.0f);
+			debug_ui->render_stats.add_frame(input.renderer_debug_data);
 			debug_ui->second_counter_ms += input.delta_ms;
 			if (debug_ui->second_counter_ms >= 1000) {
 				debug_ui->second_counter_ms = 0;
-				debug_ui->render_delta_avg_ms = std::accumulate(debug_ui->frame_render_deltas.begin(), debug_ui->frame_render_deltas.end(), 0.0f) / debug_ui->frame_render_deltas.size();
+				debug_ui->render_ns_summary = debug_ui->render_stats.summarize(platform::RenderStat::RenderNs);
 			}
 
 			ImGui::Text("Draw calls: %zu", input.renderer_debug_data.num_draw_calls);
-			ImGui::Text("Num vertices: %zu", input.renderer_debug_data.num_vertices);
-			ImGui::Text("Render ms: %2.2f", debug_ui->render_delta_avg_ms);
+			ImGui::Text("Sections: %zu (%zu before merging)", input.renderer_debug_data.num_sections, input.renderer_debug_data.num_raw_sections);
+			ImGui::Text("Culled: %zu", input.renderer_debug_data.num_culled);
+			ImGui::Text("Binds: %zu textures, %zu canvases, %zu programs", input.renderer_debug_data.num_texture_binds, input.renderer_debug_data.num_canvas_binds, input.renderer_debug_data.num_program_binds);
+			ImGui::Text("Num vertices: %zu (%zu static)", input.renderer_debug_data.num_vertices, input.renderer_debug_data.num_static_vertices);
+			ImGui::Text("Vertex bytes: %zu", input.renderer_debug_data.num_vertex_bytes);
+			ImGui::Text("Quad instances: %zu (%zu bytes)", input.renderer_debug_data.num_quad_instances, input.renderer_debug_data.num_quad_instance_bytes);
+			{
+				const platform::TextRunCacheStats& text_runs = input.renderer_debug_data.text_runs;
+				ImGui::Text("Text runs: %zu hits, %zu misses, %zu evicted, %zu incomplete", text_runs.num_hits, text_runs.num_misses, text_runs.num_evictions, text_runs.num_incomplete);
+			}
+			{
+				const platform::StreamingBufferStats& stream = input.renderer_debug_data.vertex_stream;
+				ImGui::Text("Vertex stream: %zu KB (%zu KB per frame)", stream.capacity / 1024, stream.frame_capacity / 1024);
+				ImGui::Text("Vertex stream waits: %zu, resizes: %zu", stream.num_fence_waits, stream.num_resizes);
+			}
+			for (const platform::RenderPassStats& pass : input.renderer_debug_data.passes) {
+				if (pass.skipped) {
+					ImGui::Text("Pass \"%s\": skipped (%zu frames)", pass.name.c_str(), pass.num_skipped_frames);
+				}
+				else {
+					ImGui::Text("Pass \"%s\": %2.3f ms", pass.name.c_str(), (float)pass.record_ns / 1000000.0f);
+				}
+			}
+			{
+				const platform::RenderStatSummary& summary = debug_ui->render_ns_summary;
+				ImGui::Text("Render ms: %2.2f p50, %2.2f p95, %2.2f p99, %2.2f worst", summary.p50 / 1000000.0, summary.p95 / 1000000.0, summary.p99 / 1000000.0, summary.worst / 1000000.0);
+			}
+			if (ImGui::Button("Export render stats")) {
+				const platform::RenderStatsHistory& stats = debug_ui->render_stats;
+				if (stats.save("render_stats.csv", platform::RenderStatsFormat::Csv) && stats.save("render_stats.json", platform::RenderStatsFormat::Json)) {
+					LOG_INFO("Saved stats of the last %zu frames to render_stats.csv and render_stats.json", stats.num_frames());
+				}
+				else {
+					LOG_ERROR("Could not save render stats");
+				}
+			}
 		}
 	}
 
 	Engine::Engine(platform::OpenGLContext* gl_context) {
+		// baked next to the config, so fonts are only rasterized on the first run
+		m_systems.text.set_atlas_cache(platform::application_path().parent_path() / "font_cache");
+
 		// add fake elements
 		const char* arial_font_path = "C:/windows/Fonts/Arial.ttf";
 		FontID arial_font_16 = core::unwrap(m_systems.text.add_font(gl_context, arial_font_path, 16), [&](std::string error) {
@@ -139,15 +176,25 @@ namespace engine {
 	}
 
 	void Engine::render(platform::Renderer* renderer) const {
+		// cull text outside the window
+		renderer->push_clip_rect({ { 0.0f, 0.0f }, m_window_resolution });
+
 		// clear
 		renderer->draw_rect_fill({ { 0.0f, 0.0f }, m_window_resolution }, platform::Color::black);
 
-		// render text
-		glm::vec2 window_center = m_window_resolution / 2.0f;
-		for (const auto& [node_id, text_node] : m_systems.text.text_nodes()) {
-			const platform::Font& font = m_systems.text.fonts().at(text_node.font_id);
-			renderer->draw_text(font, text_node.text, window_center + text_node.position, platform::Color::white);
-		}
+		// render text, on worker threads when there are many nodes
+		constexpr size_t MIN_TEXT_NODES_PER_THREAD = 512;
+		const glm::vec2 window_center = m_window_resolution / 2.0f;
+		const auto& text_nodes = m_systems.text.text_nodes().data();
+		renderer->draw_parallel(text_nodes.size(), MIN_TEXT_NODES_PER_THREAD, [&](platform::DrawRecorder* recorder, size_t first, size_t last) {
+			for (size_t i = first; i < last; i++) {
+				const auto& [node_id, text_node] = text_nodes[i];
+				const platform::Font& font = m_systems.text.fonts().at(text_node.font_id);
+				recorder->draw_text(font, text_node.text, window_center + text_node.position, platform::Color::white);
+			}
+		});
+
+		renderer->pop_clip_rect();
 	}
 
 	void Engine::shutdown(platform::OpenGLContext* gl_context) {
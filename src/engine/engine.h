@@ -1,12 +1,12 @@
 #pragma once
 
-#include <core/container/ring_buffer.h>
 #include <engine/state/project_state.h>
 #include <engine/state/scene_graph.h>
 #include <engine/system/hot_reloading.h>
 #include <engine/system/text_system.h>
 #include <engine/system/timeline_system.h>
 #include <platform/graphics/font.h>
+#include <platform/graphics/render_stats.h>
 #include <platform/graphics/renderer.h>
 #include <platform/input/input.h>
 #include <platform/platform_api.h>
@@ -29,10 +29,10 @@ namespace engine {
 		bool show_debug_ui = false;
 		int resolution_index = 0;
 
-		// frame rate measurement
+		// render time measurement
 		uint64_t second_counter_ms = 0;
-		core::RingBuffer<float, 60> frame_render_deltas;
-		float render_delta_avg_ms = 0.0f;
+		platform::RenderStatsHistory render_stats;
+		platform::RenderStatSummary render_ns_summary; // updated once per second
 	};
 
 	// TODO: move this out into its own header
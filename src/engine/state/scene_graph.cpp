@@ -39,6 +39,7 @@ namespace engine {
 		GraphNodeID node_id = GraphNodeID(m_next_id++);
 		m_tree.append_child(position, GraphNode { .id = node_id, .type = GraphNodeType::Text });
 		m_text_ids.insert({ node_id, text_id });
+		m_version++;
 		return node_id;
 	}
 
@@ -55,6 +56,7 @@ namespace engine {
 
 		Tree::iterator next_node = get_post_remove_node(node);
 		m_tree.erase(node);
+		m_version++;
 
 		return next_node;
 	}
@@ -67,6 +69,10 @@ namespace engine {
 		return it->second;
 	}
 
+	uint64_t SceneGraph::version() const {
+		return m_version;
+	}
+
 	void SceneGraph::_remove_node(Tree::iterator node) {
 		switch (node->type) {
 			case GraphNodeType::Root:
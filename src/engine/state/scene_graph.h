@@ -8,6 +8,7 @@
 #include <kpeeters/tree.hpp>
 
 #include <optional>
+#include <stdint.h>
 #include <unordered_map>
 #include <vector>
 
@@ -43,12 +44,16 @@ namespace engine {
 
 		std::optional<TextID> text_id(GraphNodeID node_id);
 
+		// Changes whenever nodes are added or removed
+		uint64_t version() const;
+
 	private:
 		void _remove_node(Tree::iterator node);
 
 		int m_next_id = 1;
 		kpeeters::tree<GraphNode> m_tree;
 		std::unordered_map<GraphNodeID, TextID> m_text_ids;
+		uint64_t m_version = 0;
 	};
 
 } // namespace engine
@@ -6,17 +6,44 @@ namespace engine {
 
 	void TextSystem::shutdown(platform::OpenGLContext* gl_context) {
 		for (const auto& [id, font] : m_fonts) {
+			if (!font.distance_field) {
+				platform::free_font(gl_context, font);
+			}
+		}
+		for (const auto& [path, font] : m_distance_field_atlases) {
 			platform::free_font(gl_context, font);
 		}
 	}
 
-	std::expected<FontID, std::string> TextSystem::add_font(platform::OpenGLContext* gl_context, const char* font_path, uint8_t font_size) {
-		std::expected<platform::Font, std::string> font = platform::add_font(gl_context, font_path, font_size);
+	void TextSystem::set_atlas_cache(std::filesystem::path directory) {
+		m_atlas_cache.emplace(std::move(directory));
+	}
+
+	std::expected<FontID, std::string> TextSystem::add_font(platform::OpenGLContext* gl_context, const char* font_path, uint8_t font_size, platform::FontAtlasMode mode) {
+		platform::FontAtlasCache* atlas_cache = m_atlas_cache ? &m_atlas_cache.value() : nullptr;
+		std::expected<platform::Font, std::string> font;
+		if (mode == platform::FontAtlasMode::DistanceField) {
+			auto atlas = m_distance_field_atlases.find(font_path);
+			if (atlas == m_distance_field_atlases.end()) {
+				const platform::FontAtlasSettings settings = { .mode = platform::FontAtlasMode::DistanceField };
+				std::expected<platform::BakedFont, std::string> baked = platform::load_or_bake_font(atlas_cache, font_path, DISTANCE_FIELD_ATLAS_SIZE, settings);
+				if (!baked.has_value()) {
+					return std::unexpected(baked.error());
+				}
+				atlas = m_distance_field_atlases.insert({ font_path, platform::create_font_from_atlas(gl_context, baked->atlas) }).first;
+			}
+			font = platform::scale_font(atlas->second, font_size);
+		}
+		else {
+			font = platform::add_font(gl_context, font_path, font_size, atlas_cache);
+		}
 		if (!font.has_value()) {
 			return std::unexpected(font.error());
 		}
 		const FontID id = FontID(m_next_font_id++);
 		m_fonts.insert({ id, font.value() });
+		m_font_paths.insert({ id, font_path });
+		m_version++;
 		return id;
 	}
 
@@ -32,12 +59,14 @@ namespace engine {
 		};
 
 		m_nodes.insert({ id, node });
+		m_version++;
 
 		return id;
 	}
 
 	void TextSystem::remove_text_node(TextID text_id) {
 		m_nodes.erase(text_id);
+		m_version++;
 	}
 
 	const core::vector_map<TextID, TextNode>& TextSystem::text_nodes() const {
@@ -48,8 +77,17 @@ namespace engine {
 		return m_fonts;
 	}
 
+	const std::string& TextSystem::font_path(FontID id) const {
+		return m_font_paths.at(id);
+	}
+
 	void TextSystem::set_position(TextID id, glm::vec2 position) {
 		m_nodes[id].position = position;
+		m_version++;
+	}
+
+	uint64_t TextSystem::version() const {
+		return m_version;
 	}
 
 } // namespace engine
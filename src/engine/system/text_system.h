@@ -4,11 +4,16 @@
 #include <core/newtype.h>
 #include <core/rect.h>
 #include <platform/graphics/font.h>
+#include <platform/graphics/font_atlas_cache.h>
 
 #include <glm/vec2.hpp>
 
 #include <expected>
+#include <filesystem>
+#include <optional>
+#include <stdint.h>
 #include <string>
+#include <unordered_map>
 
 namespace engine {
 	DEFINE_NEWTYPE(FontID, int);
@@ -34,6 +39,8 @@ namespace engine {
 
 	class TextSystem {
 	public:
+		static constexpr uint8_t DISTANCE_FIELD_ATLAS_SIZE = 32;
+
 		TextSystem() = default;
 
 		TextSystem(const TextSystem&) = delete;
@@ -41,20 +48,40 @@ namespace engine {
 
 		void shutdown(platform::OpenGLContext* gl_context);
 
-		std::expected<FontID, std::string> add_font(platform::OpenGLContext* gl_context, const char* font_path, uint8_t font_size);
+		// Fonts added after this are loaded from baked atlases in
+		// `directory` when they've been added before, skipping FreeType
+		void set_atlas_cache(std::filesystem::path directory);
+
+		// Distance field fonts of the same file share one atlas, generated
+		// on first use and drawn scaled to each size
+		std::expected<FontID, std::string> add_font(
+			platform::OpenGLContext* gl_context,
+			const char* font_path,
+			uint8_t font_size,
+			platform::FontAtlasMode mode = platform::FontAtlasMode::Coverage
+		);
 		TextID add_text_node(FontID font, const std::string& text = "", glm::vec2 position = { 0.0f, 0.0f });
 		void remove_text_node(TextID text_id);
 
 		const core::vector_map<TextID, TextNode>& text_nodes() const;
 		const core::vector_map<FontID, platform::Font>& fonts() const;
+		const std::string& font_path(FontID id) const;
 
 		void set_position(TextID id, glm::vec2 position);
 
+		// Changes whenever fonts or text nodes change, so that anything
+		// drawn from them can be kept until it does
+		uint64_t version() const;
+
 	private:
 		int m_next_font_id = 0;
 		int m_next_text_id = 0;
 		core::vector_map<FontID, platform::Font> m_fonts;
+		core::vector_map<FontID, std::string> m_font_paths;
+		std::unordered_map<std::string, platform::Font> m_distance_field_atlases; // by font path, at DISTANCE_FIELD_ATLAS_SIZE
+		std::optional<platform::FontAtlasCache> m_atlas_cache;
 		core::vector_map<TextID, TextNode> m_nodes;
+		uint64_t m_version = 0;
 	};
 
 } // namespace engine
@@ -52,9 +52,9 @@ static void set_viewport_to_center_canvas(int window_width, int window_height, i
 	glViewport((window_width - canvas_width) / 2, (window_height - canvas_height) / 2, canvas_width, canvas_height);
 }
 
-static void set_normalized_device_coordinate_projection(platform::Renderer* renderer, const platform::ShaderProgram& shader_program) {
+static void set_normalized_device_coordinate_projection(platform::Renderer* renderer) {
 	glm::mat4 projection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
-	renderer->set_projection(shader_program, projection);
+	renderer->set_projection(projection);
 }
 
 static void set_imgui_style_win32_like() {
@@ -296,18 +296,30 @@ int main(int argc, char** argv) {
 	/* Read shader sources */
 	const char* vertex_shader_path = "resources/shaders/shader.vert";
 	const char* fragment_shader_path = "resources/shaders/shader.frag";
+	const char* quad_instance_shader_path = "resources/shaders/quad_instance.vert";
 	std::string vertex_shader_src = core::unwrap(platform::read_file_to_string(vertex_shader_path), [&] {
 		ABORT("Failed to open vertex shader \"%s\"", vertex_shader_path);
 	});
 	std::string fragment_shader_src = core::unwrap(platform::read_file_to_string(fragment_shader_path), [&] {
 		ABORT("Failed to open fragment shader \"%s\"", fragment_shader_path);
 	});
+	std::string quad_instance_shader_src = core::unwrap(platform::read_file_to_string(quad_instance_shader_path), [&] {
+		ABORT("Failed to open vertex shader \"%s\"", quad_instance_shader_path);
+	});
 
 	/* Initialize Renderer */
-	platform::Renderer renderer = platform::Renderer(&gl_context);
-	platform::ShaderProgram shader_program = core::unwrap(gl_context.add_shader_program(vertex_shader_src.c_str(), fragment_shader_src.c_str()), [](platform::ShaderProgramError error) {
+	const platform::VertexFormat vertex_format = cmd_args.use_packed_vertices ? platform::VertexFormat::Packed : platform::VertexFormat::Standard;
+	const platform::QuadMode quad_mode = cmd_args.use_instanced_quads ? platform::QuadMode::Instanced : platform::QuadMode::Vertices;
+	platform::Renderer renderer = platform::Renderer(&gl_context, vertex_format, quad_mode);
+	platform::GLRenderExecutor gl_executor = platform::GLRenderExecutor(&gl_context);
+	platform::CaptureRenderExecutor capture_executor = platform::CaptureRenderExecutor(&gl_executor); // press F12 to capture a frame
+	renderer.set_executor(&capture_executor);
+	platform::ShaderProgram shader_program = core::unwrap(gl_context.add_shader_program(vertex_shader_src.c_str(), fragment_shader_src.c_str(), vertex_format), [](platform::ShaderProgramError error) {
 		ABORT("Renderer::add_program() returned %s", core::util::enum_to_string(error));
 	});
+	shader_program.quad_instances = core::unwrap(gl_context.add_quad_instance_program(quad_instance_shader_src.c_str(), fragment_shader_src.c_str()), [](platform::ShaderProgramError error) {
+		ABORT("OpenGLContext::add_quad_instance_program() returned %s", core::util::enum_to_string(error));
+	});
 
 	/* Load engine DLL */
 	platform::EngineLibraryLoader library_loader;
@@ -579,10 +591,17 @@ int main(int argc, char** argv) {
 
 			/* Render to canvas */
 			{
+				if (input.keyboard.key_pressed_now(SDLK_F12)) {
+					capture_executor.capture_next("render_capture.bin");
+				}
+
 				if (editor && run_mode == platform::RunMode::Editor) {
+					// the editor puts its draws in layers, so they can be sorted
+					renderer.set_draw_order(platform::DrawOrder::Sorted);
 					library.render_editor(*editor, *engine, &gl_context, &renderer);
 				}
 				else {
+					renderer.set_draw_order(platform::DrawOrder::Submission);
 					library.render_engine(*engine, &renderer);
 				}
 
@@ -601,7 +620,7 @@ int main(int argc, char** argv) {
 				else {
 					set_viewport_to_center_canvas(window.size().x, window.size().y, (int)window_canvas.texture.size.x, (int)window_canvas.texture.size.y);
 				}
-				set_normalized_device_coordinate_projection(&renderer, shader_program);
+				set_normalized_device_coordinate_projection(&renderer);
 				renderer.draw_texture(window_canvas.texture, core::Rect { { -1.0f, 1.0f }, { 1.0f, -1.0f } });
 				renderer.render(shader_program);
 			}
@@ -628,6 +647,8 @@ int main(int argc, char** argv) {
 	library.shutdown_editor(editor, &gl_context);
 	library.shutdown_engine(engine, &gl_context);
 	gl_context.free_shader_program(shader_program);
+	gl_executor.shutdown(&gl_context);
+	renderer.shutdown(&gl_context);
 	platform::shutdown(sdl_gl_context);
 	window.destroy();
 
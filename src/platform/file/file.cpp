@@ -17,7 +17,7 @@ namespace platform {
 	}
 
 	std::optional<std::vector<uint8_t>> read_file_bytes(const std::filesystem::path& path) {
-		std::ifstream file(path);
+		std::ifstream file(path, std::ios::binary);
 		if (!file.is_open()) {
 			return {};
 		}
@@ -2,23 +2,93 @@
 
 #include <core/future.h>
 #include <platform/debug/logging.h>
+#include <platform/file/file.h>
+#include <platform/graphics/font_atlas_cache.h>
+#include <platform/graphics/font_baker.h>
+#include <platform/input/timing.h>
+
+#include <unordered_map>
 
 namespace platform {
 
+	std::vector<std::expected<FontAtlas, ResourceLoadError>> IResourceFileIO::load_fonts(const std::vector<FontDeclaration>& fonts) {
+		std::vector<std::expected<FontAtlas, ResourceLoadError>> atlases;
+		for (const FontDeclaration& font_decl : fonts) {
+			atlases.push_back(load_font(font_decl.path, font_decl.size));
+		}
+		return atlases;
+	}
+
 	std::expected<FontAtlas, ResourceLoadError> ResourceFileIO::load_font(std::filesystem::path font_path, uint8_t font_size) {
-		std::expected<FontFace, std::string> font_face = load_font_face(font_path);
-		if (font_face.has_value()) {
-			return generate_font_atlas(font_face.value(), font_size);
+		return load_fonts({ FontDeclaration { .path = font_path, .size = font_size } })[0];
+	}
+
+	ResourceFileIO::ResourceFileIO(FontAtlasCache* atlas_cache)
+		: m_atlas_cache(atlas_cache) {
+	}
+
+	std::vector<std::expected<FontAtlas, ResourceLoadError>> ResourceFileIO::load_fonts(const std::vector<FontDeclaration>& fonts) {
+		/* Cached atlases */
+		// each file is read and hashed once, however many sizes it's in
+		std::vector<std::optional<uint64_t>> keys(fonts.size());
+		std::vector<std::optional<FontAtlas>> cached(fonts.size());
+		if (m_atlas_cache) {
+			std::unordered_map<std::string, std::optional<uint64_t>> file_hashes;
+			for (size_t i = 0; i < fonts.size(); i++) {
+				auto [file_hash, inserted] = file_hashes.try_emplace(fonts[i].path.string());
+				if (inserted) {
+					if (std::optional<std::vector<uint8_t>> font_file = read_file_bytes(fonts[i].path)) {
+						file_hash->second = hash_font_file(*font_file);
+					}
+				}
+				if (!file_hash->second) {
+					continue; // reported when baking
+				}
+				keys[i] = font_atlas_cache_key(*file_hash->second, fonts[i].size, {}, false);
+				if (std::optional<BakedFont> font = m_atlas_cache->load(*keys[i])) {
+					cached[i] = std::move(font->atlas);
+				}
+			}
 		}
-		else {
+
+		/* Bake */
+		// Baked off the global FreeType library, which isn't safe to use
+		// from loader threads
+		std::vector<FontBakeRequest> requests;
+		for (size_t i = 0; i < fonts.size(); i++) {
+			if (!cached[i]) {
+				requests.push_back(FontBakeRequest { .path = fonts[i].path, .size = fonts[i].size });
+			}
+		}
+		std::vector<std::expected<FontAtlas, std::string>> baked;
+		if (!requests.empty()) {
+			baked = bake_font_atlases(requests);
+		}
+
+		std::vector<std::expected<FontAtlas, ResourceLoadError>> atlases;
+		size_t next_baked = 0;
+		for (size_t i = 0; i < fonts.size(); i++) {
+			if (cached[i]) {
+				atlases.push_back(std::move(cached[i].value()));
+				continue;
+			}
+			std::expected<FontAtlas, std::string>& baked_atlas = baked[next_baked++];
+			if (baked_atlas.has_value()) {
+				if (keys[i]) {
+					m_atlas_cache->store(*keys[i], BakedFont { .atlas = baked_atlas.value() });
+				}
+				atlases.push_back(std::move(baked_atlas.value()));
+				continue;
+			}
 			std::string error_msg = std::format(
 				"Couldn't load font! path = \"{}\", size = {}. error: {}",
-				font_path.string(),
-				font_size,
-				font_face.error()
+				fonts[i].path.string(),
+				fonts[i].size,
+				baked_atlas.error()
 			);
-			return std::unexpected(ResourceLoadError { error_msg, font_path });
+			atlases.push_back(std::unexpected(ResourceLoadError { error_msg, fonts[i].path }));
 		}
+		return atlases;
 	}
 
 	std::expected<Image, ResourceLoadError> ResourceFileIO::load_image(std::filesystem::path image_path) {
@@ -36,8 +106,9 @@ namespace platform {
 		}
 	}
 
-	ResourceLoader::ResourceLoader(IResourceFileIO* file_io)
-		: m_file_io(file_io) {
+	ResourceLoader::ResourceLoader(IResourceFileIO* file_io, ResourceUploadBudget upload_budget)
+		: m_file_io(file_io)
+		, m_upload_budget(upload_budget) {
 	}
 
 	std::shared_ptr<const ResourceLoadPayload> ResourceLoader::load_manifest(const ResourceManifest& manifest) {
@@ -46,45 +117,87 @@ namespace platform {
 			.num_requested_images = manifest.images.size(),
 		});
 
-		m_jobs.push_back(ResourceLoadJob {
-			.font_batch = core::batch_async(std::launch::async, manifest.fonts, [file_io = m_file_io](const FontDeclaration& font_decl) -> LoadFontResult {
-				std::expected<FontAtlas, ResourceLoadError> result = file_io->load_font(font_decl.path, font_decl.size);
-				if (result.has_value()) {
-					return NamedFontAtlas { .name = font_decl.name, .atlas = result.value() };
-				}
-				return std::unexpected(result.error());
-			}),
-			.image_batch = core::batch_async(std::launch::async, manifest.images, [file_io = m_file_io](const ImageDeclaration& image_decl) -> LoadImageResult {
-				std::expected<Image, ResourceLoadError> result = file_io->load_image(image_decl.path);
-				if (result.has_value()) {
-					return NamedImage { .name = image_decl.name, .image = std::move(result.value()) };
+		auto load_image = [file_io = m_file_io](const ImageDeclaration& image_decl) -> LoadImageResult {
+			std::expected<Image, ResourceLoadError> result = file_io->load_image(image_decl.path);
+			if (result.has_value()) {
+				return NamedImage { .name = image_decl.name, .image = std::move(result.value()) };
+			}
+			return std::unexpected(result.error());
+		};
+
+		ResourceLoadJob job = {
+			.fonts = std::async(std::launch::async, [file_io = m_file_io, fonts = manifest.fonts]() {
+				std::vector<LoadFontResult> results;
+				std::vector<std::expected<FontAtlas, ResourceLoadError>> atlases = file_io->load_fonts(fonts);
+				for (size_t i = 0; i < fonts.size(); i++) {
+					if (atlases[i].has_value()) {
+						results.push_back(NamedFontAtlas { .name = fonts[i].name, .atlas = std::move(atlases[i].value()) });
+					}
+					else {
+						results.push_back(std::unexpected(atlases[i].error()));
+					}
 				}
-				return std::unexpected(result.error());
+				return results;
 			}),
 			.payload = progress,
-		});
+		};
+
+		if (manifest.image_atlas) {
+			// Images are loaded in parallel, then packed together once all
+			// are loaded, off the main thread
+			job.packed_images = std::async(std::launch::async, [image_batch = core::batch_async(std::launch::async, manifest.images, load_image), settings = *manifest.image_atlas]() mutable {
+				PackedImages packed;
+				for (LoadImageResult& result : core::get_all_batch_values(image_batch)) {
+					if (result.has_value()) {
+						packed.images.push_back(std::move(result.value()));
+					}
+					else {
+						packed.errors.push_back(result.error());
+					}
+				}
 
+				std::vector<const Image*> images;
+				for (const NamedImage& named_image : packed.images) {
+					images.push_back(&named_image.image);
+				}
+				packed.atlases = pack_image_atlases(images, settings);
+				return packed;
+			});
+		}
+		else {
+			job.image_batch = core::batch_async(std::launch::async, manifest.images, load_image);
+		}
+
+		m_jobs.push_back(std::move(job));
 		return progress;
 	}
 
 	void ResourceLoader::update(OpenGLContext* gl_context) {
 		for (ResourceLoadJob& job : m_jobs) {
-			_process_fonts(&job.font_batch, &job.payload->fonts, gl_context, job.payload.get());
-			_process_images(&job.image_batch, &job.payload->textures, gl_context, job.payload.get());
+			_queue_fonts(&job);
+			_queue_images(&job);
+			_queue_packed_images(&job);
 		}
+		_upload(gl_context);
 		std::erase_if(m_jobs, [](const ResourceLoadJob& job) { return job.payload->is_done(); });
 	}
 
-	void ResourceLoader::_process_fonts(
-		std::vector<std::future<LoadFontResult>>* font_batch,
-		core::vector_map<std::string, Font>* fonts,
-		OpenGLContext* gl_context,
-		ResourceLoadPayload* payload
-	) {
-		for (const LoadFontResult& result : core::get_ready_batch_values(*font_batch)) {
+	size_t ResourceLoader::num_pending_uploads() const {
+		return m_uploads.size();
+	}
+
+	void ResourceLoader::_queue_fonts(ResourceLoadJob* job) {
+		if (!core::future_is_ready(job->fonts)) {
+			return;
+		}
+		ResourceLoadPayload* payload = job->payload.get();
+		for (const LoadFontResult& result : job->fonts.get()) {
 			if (result.has_value()) {
-				const auto& [name, atlas] = result.value();
-				fonts->insert({ name, create_font_from_atlas(gl_context, atlas) });
+				const NamedFontAtlas& named_atlas = result.value();
+				payload->num_decoded_resources++;
+				_queue_upload(job->payload, named_atlas.atlas.pixels.size() * sizeof(RGBA), [named_atlas](OpenGLContext* gl_context, ResourceLoadPayload* payload) {
+					payload->fonts.insert({ named_atlas.name, create_font_from_atlas(gl_context, named_atlas.atlas) });
+				});
 			}
 			else {
 				payload->errors.push_back(result.error());
@@ -92,17 +205,12 @@ namespace platform {
 		}
 	}
 
-	void ResourceLoader::_process_images(
-		std::vector<std::future<LoadImageResult>>* image_batch,
-		core::vector_map<std::string, Texture>* textures,
-		OpenGLContext* gl_context,
-		ResourceLoadPayload* payload
-	) {
-		for (const LoadImageResult& result : core::get_ready_batch_values(*image_batch)) {
+	void ResourceLoader::_queue_images(ResourceLoadJob* job) {
+		ResourceLoadPayload* payload = job->payload.get();
+		for (LoadImageResult& result : core::get_ready_batch_values(job->image_batch)) {
 			if (result.has_value()) {
-				const auto& [name, image] = result.value();
-				Texture texture = gl_context->add_texture(image.data.get(), image.width, image.height);
-				textures->insert({ name, texture });
+				payload->num_decoded_resources++;
+				_queue_image_upload(job->payload, std::move(result.value()));
 			}
 			else {
 				payload->errors.push_back(result.error());
@@ -110,4 +218,74 @@ namespace platform {
 		}
 	}
 
+	void ResourceLoader::_queue_packed_images(ResourceLoadJob* job) {
+		if (!core::future_is_ready(job->packed_images)) {
+			return;
+		}
+		ResourceLoadPayload* payload = job->payload.get();
+		auto packed = std::make_shared<PackedImages>(job->packed_images.get());
+		payload->num_decoded_resources += packed->images.size();
+		payload->errors.insert(payload->errors.end(), packed->errors.begin(), packed->errors.end());
+
+		/* Atlases */
+		for (size_t i = 0; i < packed->atlases.atlases.size(); i++) {
+			const ImageAtlas& atlas = packed->atlases.atlases[i];
+			_queue_upload(job->payload, atlas.pixels.size(), [this, packed, i](OpenGLContext* gl_context, ResourceLoadPayload* payload) {
+				const ImageAtlas& atlas = packed->atlases.atlases[i];
+				payload->atlases.push_back(gl_context->add_texture(atlas.pixels.data(), atlas.size.x, atlas.size.y));
+			});
+		}
+		// queued after the atlases, so they're uploaded when it runs
+		_queue_upload(job->payload, 0, [packed](OpenGLContext*, ResourceLoadPayload* payload) {
+			for (size_t i = 0; i < packed->images.size(); i++) {
+				if (const std::optional<AtlasRegion>& region = packed->atlases.regions[i]) {
+					payload->textures.insert({ packed->images[i].name, payload->atlases[region->atlas_index] });
+					payload->uvs.insert({ packed->images[i].name, region->uv });
+				}
+			}
+		});
+
+		/* Images too large to pack */
+		for (size_t i = 0; i < packed->images.size(); i++) {
+			if (!packed->atlases.regions[i]) {
+				_queue_image_upload(job->payload, std::move(packed->images[i]));
+			}
+		}
+	}
+
+	void ResourceLoader::_queue_upload(const std::shared_ptr<ResourceLoadPayload>& payload, size_t num_bytes, std::function<void(OpenGLContext*, ResourceLoadPayload*)> upload) {
+		payload->num_pending_upload_bytes += num_bytes;
+		m_uploads.push_back(PendingUpload { .payload = payload, .num_bytes = num_bytes, .upload = std::move(upload) });
+	}
+
+	void ResourceLoader::_queue_image_upload(const std::shared_ptr<ResourceLoadPayload>& payload, NamedImage named_image) {
+		const size_t num_bytes = (size_t)named_image.image.width * named_image.image.height * 4;
+		auto image = std::make_shared<NamedImage>(std::move(named_image)); // shared, since uploads must be copyable
+		_queue_upload(payload, num_bytes, [this, image](OpenGLContext* gl_context, ResourceLoadPayload* payload) {
+			payload->textures.insert({ image->name, gl_context->add_texture(image->image.data.get(), image->image.width, image->image.height) });
+			payload->uvs.insert({ image->name, core::FlipRect { { 0.0f, 0.0f }, { 1.0f, 1.0f } } });
+		});
+	}
+
+	void ResourceLoader::_upload(OpenGLContext* gl_context) {
+		Timer timer;
+		size_t num_uploads = 0;
+		size_t num_bytes = 0;
+		while (!m_uploads.empty()) {
+			const bool is_over_budget = num_bytes + m_uploads.front().num_bytes > m_upload_budget.max_bytes_per_frame ||
+				timer.elapsed_ns() >= m_upload_budget.max_ns_per_frame;
+			if (num_uploads > 0 && is_over_budget) {
+				break;
+			}
+			PendingUpload upload = std::move(m_uploads.front());
+			m_uploads.pop_front();
+
+			upload.upload(gl_context, upload.payload.get());
+			upload.payload->num_pending_upload_bytes -= upload.num_bytes;
+			upload.payload->num_uploaded_bytes += upload.num_bytes;
+			num_bytes += upload.num_bytes;
+			num_uploads++;
+		}
+	}
+
 } // namespace platform
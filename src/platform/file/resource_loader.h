@@ -4,12 +4,16 @@
 #include <platform/graphics/font.h>
 #include <platform/graphics/gl_context.h>
 #include <platform/graphics/image.h>
+#include <platform/graphics/image_atlas.h>
 #include <platform/graphics/texture.h>
 
+#include <deque>
 #include <expected>
 #include <filesystem>
+#include <functional>
 #include <future>
 #include <memory>
+#include <optional>
 #include <stdint.h>
 #include <string>
 #include <vector>
@@ -30,6 +34,7 @@ namespace platform {
 	struct ResourceManifest {
 		std::vector<FontDeclaration> fonts;
 		std::vector<ImageDeclaration> images;
+		std::optional<ImageAtlasSettings> image_atlas; // packs images into shared atlases if set, saving texture switches when drawing them
 	};
 
 	struct ResourceLoadError {
@@ -45,7 +50,12 @@ namespace platform {
 		size_t num_requested_images = 0;
 		core::vector_map<std::string, platform::Font> fonts;
 		core::vector_map<std::string, platform::Texture> textures;
+		core::vector_map<std::string, core::FlipRect> uvs; // part of each texture showing the image, all of it unless packed into an atlas
+		std::vector<platform::Texture> atlases; // shared by the textures of packed images
 		std::vector<ResourceLoadError> errors;
+		size_t num_decoded_resources = 0; // read and decoded, including those not yet uploaded
+		size_t num_pending_upload_bytes = 0; // decoded and waiting to be uploaded
+		size_t num_uploaded_bytes = 0;
 
 		size_t total_num_resources() const {
 			return num_requested_fonts + num_requested_images;
@@ -55,10 +65,15 @@ namespace platform {
 			return fonts.size() + textures.size();
 		}
 
+		// Uploaded and ready to use
 		bool is_done() const {
 			return num_loaded_resources() == total_num_resources();
 		}
 
+		bool is_decoded() const {
+			return num_decoded_resources + errors.size() == total_num_resources();
+		}
+
 		bool has_errors() const {
 			return !errors.empty();
 		}
@@ -68,21 +83,48 @@ namespace platform {
 	public:
 		virtual ~IResourceFileIO() {}
 		virtual std::expected<platform::FontAtlas, ResourceLoadError> load_font(std::filesystem::path font_path, uint8_t font_size) = 0;
+		// Loads every font of a manifest, one load_font at a time unless overridden
+		virtual std::vector<std::expected<platform::FontAtlas, ResourceLoadError>> load_fonts(const std::vector<FontDeclaration>& fonts);
 		virtual std::expected<platform::Image, ResourceLoadError> load_image(std::filesystem::path image_path) = 0;
 	};
 
+	// Bakes fonts with bake_font_atlases, so each file is read once and
+	// sizes are rasterized in parallel. With an atlas cache, only fonts
+	// missing from it are baked, and are then stored in it.
 	class ResourceFileIO : public IResourceFileIO {
+	public:
+		ResourceFileIO() = default;
+		explicit ResourceFileIO(FontAtlasCache* atlas_cache);
+
 		std::expected<platform::FontAtlas, ResourceLoadError> load_font(std::filesystem::path font_path, uint8_t font_size) override;
+		std::vector<std::expected<platform::FontAtlas, ResourceLoadError>> load_fonts(const std::vector<FontDeclaration>& fonts) override;
 		std::expected<platform::Image, ResourceLoadError> load_image(std::filesystem::path image_path) override;
+
+	private:
+		FontAtlasCache* m_atlas_cache = nullptr;
+	};
+
+	struct ResourceUploadBudget {
+		size_t max_bytes_per_frame = 16 * 1024 * 1024;
+		uint64_t max_ns_per_frame = 4'000'000;
 	};
 
+	// Loads resources in a manifest on worker threads, then uploads them
+	// from the main thread as they finish.
+	//
+	// Uploads are queued and spread over frames, each frame uploading until
+	// the byte or time budget is spent, so loading a large manifest doesn't
+	// stall a single frame. At least one upload is done per frame, even if
+	// it's larger than the budget.
 	class ResourceLoader {
 	public:
-		ResourceLoader(IResourceFileIO* file_io);
+		ResourceLoader(IResourceFileIO* file_io, ResourceUploadBudget upload_budget = {});
 
 		std::shared_ptr<const ResourceLoadPayload> load_manifest(const ResourceManifest& manifest);
 		void update(platform::OpenGLContext* gl_context);
 
+		size_t num_pending_uploads() const;
+
 	private:
 		struct NamedFontAtlas {
 			std::string name;
@@ -94,28 +136,36 @@ namespace platform {
 		};
 		using LoadFontResult = std::expected<NamedFontAtlas, ResourceLoadError>;
 		using LoadImageResult = std::expected<NamedImage, ResourceLoadError>;
+		struct PackedImages {
+			std::vector<NamedImage> images;
+			PackedImageAtlases atlases; // with a region per image
+			std::vector<ResourceLoadError> errors;
+		};
 
 		struct ResourceLoadJob {
-			std::vector<std::future<LoadFontResult>> font_batch;
+			std::future<std::vector<LoadFontResult>> fonts; // baked together
 			std::vector<std::future<LoadImageResult>> image_batch;
+			std::future<PackedImages> packed_images; // used instead of image_batch when packing atlases
 			std::shared_ptr<ResourceLoadPayload> payload;
 		};
 
+		struct PendingUpload {
+			std::shared_ptr<ResourceLoadPayload> payload;
+			size_t num_bytes;
+			std::function<void(platform::OpenGLContext*, ResourceLoadPayload*)> upload;
+		};
+
+		void _queue_fonts(ResourceLoadJob* job);
+		void _queue_images(ResourceLoadJob* job);
+		void _queue_packed_images(ResourceLoadJob* job);
+		void _queue_upload(const std::shared_ptr<ResourceLoadPayload>& payload, size_t num_bytes, std::function<void(platform::OpenGLContext*, ResourceLoadPayload*)> upload);
+		void _queue_image_upload(const std::shared_ptr<ResourceLoadPayload>& payload, NamedImage named_image);
+		void _upload(platform::OpenGLContext* gl_context);
+
 		IResourceFileIO* m_file_io;
+		ResourceUploadBudget m_upload_budget;
 		std::vector<ResourceLoadJob> m_jobs;
-
-		static void _process_fonts(
-			std::vector<std::future<LoadFontResult>>* font_batch,
-			core::vector_map<std::string, platform::Font>* fonts,
-			platform::OpenGLContext* gl_context,
-			ResourceLoadPayload* payload
-		);
-		static void _process_images(
-			std::vector<std::future<LoadImageResult>>* image_batch,
-			core::vector_map<std::string, platform::Texture>* textures,
-			platform::OpenGLContext* gl_context,
-			ResourceLoadPayload* payload
-		);
+		std::deque<PendingUpload> m_uploads;
 	};
 
 } // namespace platform
@@ -0,0 +1,107 @@
+#include <platform/graphics/circle_cache.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace platform {
+
+	static std::vector<glm::vec2> circle_octant_points(float radius) {
+		/* Compute points in first octant */
+		//              90°
+		//         , - ~ ~ ~ - ,
+		//     , '       |       ' , 45°
+		//   ,           |       ⟋   ,
+		//  ,            |    ⟋       ,
+		// ,             | ⟋           ,
+		// ,             o             ,
+		// ,                           ,
+		//  ,                         ,
+		//   ,                       ,
+		//     ,                  , '
+		//       ' - , _ _ _ ,  '
+		std::vector<glm::vec2> quadrant_points;
+		{
+			const double radius_squared = (double)radius * radius;
+			glm::vec2 point = { 0.0f, radius };
+			while (point.x <= point.y) {
+				quadrant_points.push_back(point);
+
+				glm::vec2 mid_point = { point.x + 1, point.y - 0.5f };
+				if ((double)mid_point.x * mid_point.x + (double)mid_point.y * mid_point.y > radius_squared) {
+					point.y -= 1;
+				}
+				point.x += 1;
+			}
+		}
+		return quadrant_points;
+	}
+
+	static std::vector<glm::vec2> circle_span_points(const std::vector<glm::vec2>& octant_points) {
+		/* Get points of upper half circle */
+		std::vector<glm::vec2> half_circle_points;
+		for (const glm::vec2& point : octant_points) {
+			float x = point.x;
+			float y = point.y;
+			half_circle_points.push_back(glm::vec2 { x, y });
+			half_circle_points.push_back(glm::vec2 { y, x });
+			half_circle_points.push_back(glm::vec2 { -x, y });
+			half_circle_points.push_back(glm::vec2 { -y, x });
+		}
+
+		/* Remove points with overlapping x-coordinates to avoid overdraw */
+		{
+			std::vector<glm::vec2>& p = half_circle_points;
+			std::sort(p.begin(), p.end(), [](const glm::vec2& lhs, const glm::vec2& rhs) { return lhs.x < rhs.x; });
+			p.erase(std::unique(p.begin(), p.end(), [](const glm::vec2& lhs, const glm::vec2& rhs) { return lhs.x == rhs.x; }), p.end());
+		}
+		return half_circle_points;
+	}
+
+	CircleCache::CircleCache(size_t max_points)
+		: m_max_points(max_points) {
+	}
+
+	const std::vector<glm::vec2>& CircleCache::octant_points(float radius) {
+		return _table(radius).octant_points;
+	}
+
+	const std::vector<glm::vec2>& CircleCache::span_points(float radius) {
+		CircleTable* table = &_table(radius);
+		if (!table->has_span_points) {
+			std::vector<glm::vec2> span_points = circle_span_points(table->octant_points);
+			_reserve(span_points.size());
+			table = &_table(radius); // in case the cache was cleared
+			table->span_points = std::move(span_points);
+			table->has_span_points = true;
+		}
+		return table->span_points;
+	}
+
+	size_t CircleCache::num_tables() const {
+		return m_tables.size();
+	}
+
+	size_t CircleCache::num_points() const {
+		return m_num_points;
+	}
+
+	CircleTable& CircleCache::_table(float radius) {
+		const uint32_t key = std::bit_cast<uint32_t>(radius);
+		if (auto it = m_tables.find(key); it != m_tables.end()) {
+			return it->second;
+		}
+
+		std::vector<glm::vec2> octant_points = circle_octant_points(radius);
+		_reserve(octant_points.size());
+		return m_tables.emplace(key, CircleTable { .octant_points = std::move(octant_points) }).first->second;
+	}
+
+	void CircleCache::_reserve(size_t num_points) {
+		if (m_num_points + num_points > m_max_points) {
+			m_tables.clear();
+			m_num_points = 0;
+		}
+		m_num_points += num_points;
+	}
+
+} // namespace platform
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace platform {
+
+	// Points of a circle with a given radius, relative to its center
+	struct CircleTable {
+		// first octant from 90° to 45°, mirrored to draw the outline
+		std::vector<glm::vec2> octant_points;
+		// upper half circle with one point per x, in order of x, drawn as
+		// vertical lines mirrored through the center to fill the circle.
+		// Computed the first time a filled circle needs it.
+		std::vector<glm::vec2> span_points;
+		bool has_span_points = false;
+	};
+
+	// Circle tables by radius, so that drawing many circles of the same few
+	// sizes doesn't recompute them.
+	//
+	// Memory is bounded by the total number of points stored. When adding a
+	// table would exceed it, the whole cache is cleared first, which keeps
+	// lookups cheap and is rare when radii repeat between frames.
+	class CircleCache {
+	public:
+		explicit CircleCache(size_t max_points = 64 * 1024);
+
+		// References are valid until the next call to either function
+		const std::vector<glm::vec2>& octant_points(float radius);
+		const std::vector<glm::vec2>& span_points(float radius);
+
+		size_t num_tables() const;
+		size_t num_points() const;
+
+	private:
+		CircleTable& _table(float radius);
+		void _reserve(size_t num_points);
+
+		size_t m_max_points;
+		size_t m_num_points = 0;
+		std::unordered_map<uint32_t, CircleTable> m_tables; // by radius bits
+	};
+
+} // namespace platform
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <core/rect.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CULL_RECT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace platform {
+
+	// Bounds that draws are tested against before they emit vertices.
+	//
+	// The bounds are stored as (max x, max y, -min x, -min y), so that
+	// testing a rect against them is a single 4-wide compare.
+	class CullRect {
+	public:
+		explicit CullRect(core::Rect rect) {
+			m_bounds[0] = std::max(rect.top_left.x, rect.bottom_right.x);
+			m_bounds[1] = std::max(rect.top_left.y, rect.bottom_right.y);
+			m_bounds[2] = -std::min(rect.top_left.x, rect.bottom_right.x);
+			m_bounds[3] = -std::min(rect.top_left.y, rect.bottom_right.y);
+		}
+
+		core::Rect rect() const {
+			return core::Rect { { -m_bounds[2], -m_bounds[3] }, { m_bounds[0], m_bounds[1] } };
+		}
+
+		// False if the rect spanned by the corners, given in any order, lies
+		// entirely outside. Rects only touching the edge are outside.
+		bool overlaps(glm::vec2 corner0, glm::vec2 corner1) const {
+#ifdef CULL_RECT_SSE2
+			const __m128 corners = _mm_setr_ps(corner0.x, corner0.y, corner1.x, corner1.y);
+			const __m128 swapped = _mm_shuffle_ps(corners, corners, _MM_SHUFFLE(1, 0, 3, 2));
+			const __m128 min = _mm_min_ps(corners, swapped);
+			const __m128 negated_max = _mm_xor_ps(_mm_max_ps(corners, swapped), _mm_set1_ps(-0.0f));
+			const __m128 lhs = _mm_movelh_ps(min, negated_max); // min x, min y, -max x, -max y
+			return _mm_movemask_ps(_mm_cmplt_ps(lhs, _mm_load_ps(m_bounds))) == 0xF;
+#else
+			return std::min(corner0.x, corner1.x) < m_bounds[0] &&
+				std::min(corner0.y, corner1.y) < m_bounds[1] &&
+				-std::max(corner0.x, corner1.x) < m_bounds[2] &&
+				-std::max(corner0.y, corner1.y) < m_bounds[3];
+#endif
+		}
+
+	private:
+		alignas(16) float m_bounds[4];
+	};
+
+} // namespace platform
@@ -0,0 +1,536 @@
+#include <platform/graphics/draw_recorder.h>
+
+#include <core/utf8.h>
+#include <platform/graphics/glyph_cache.h>
+#include <platform/graphics/quad.h>
+
+#include <algorithm>
+#include <span>
+
+namespace platform {
+
+	bool canvases_are_equal(const std::optional<Canvas>& lhs, const std::optional<Canvas>& rhs) {
+		if (lhs.has_value() != rhs.has_value()) {
+			return false;
+		}
+		return !lhs.has_value() || lhs->framebuffer == rhs->framebuffer;
+	}
+
+	bool scissors_are_equal(const std::optional<core::Rect>& lhs, const std::optional<core::Rect>& rhs) {
+		if (lhs.has_value() != rhs.has_value()) {
+			return false;
+		}
+		return !lhs.has_value() || (lhs->top_left == rhs->top_left && lhs->bottom_right == rhs->bottom_right);
+	}
+
+	static bool mode_is_mergeable(GLenum mode) {
+		// Independent primitives can be concatenated, but e.g. two line loops
+		// would be joined together into one if drawn in a single call.
+		return mode == GL_POINTS || mode == GL_LINES || mode == GL_TRIANGLES;
+	}
+
+	DrawRecorder::DrawRecorder(Texture white_texture, QuadMode quad_mode)
+		: m_white_texture(white_texture)
+		, m_quad_mode(quad_mode) {
+	}
+
+	void DrawRecorder::push_draw_canvas(Canvas canvas) {
+		m_draw_canvas_stack.push_back(canvas);
+		_update_cull_rect();
+	}
+	void DrawRecorder::pop_draw_canvas() {
+		// When sorting, canvases are drawn in the order they were finished so
+		// that nested canvases are done before they're sampled.
+		_add_canvas_pass(m_draw_canvas_stack.back().framebuffer);
+		m_draw_canvas_stack.pop_back();
+		_update_cull_rect();
+	}
+
+	void DrawRecorder::push_draw_layer(uint16_t layer) {
+		m_draw_layer_stack.push_back(layer);
+	}
+	void DrawRecorder::pop_draw_layer() {
+		m_draw_layer_stack.pop_back();
+	}
+
+	void DrawRecorder::push_clip_rect(core::Rect rect) {
+		m_clip_rect_stack.push_back(rect);
+		_update_cull_rect();
+	}
+	void DrawRecorder::pop_clip_rect() {
+		m_clip_rect_stack.pop_back();
+		_update_cull_rect();
+	}
+
+	void DrawRecorder::draw_point(glm::vec2 point, glm::vec4 color) {
+		if (!_is_visible(point, point)) {
+			return;
+		}
+		m_vertices.push_back(Vertex { .pos = point, .color = color });
+		_push_section(VertexSection { .mode = GL_POINTS, .length = 1, .texture = m_white_texture, .scissor = _scissor_for(point, point) });
+	}
+
+	void DrawRecorder::draw_line(glm::vec2 start, glm::vec2 end, glm::vec4 color) {
+		if (!_is_visible(start, end)) {
+			return;
+		}
+		m_vertices.push_back(Vertex { .pos = start, .color = color });
+		m_vertices.push_back(Vertex { .pos = end, .color = color });
+		_push_section(VertexSection { .mode = GL_LINES, .length = 2, .texture = m_white_texture, .scissor = _scissor_for(start, end) });
+	}
+
+	void DrawRecorder::draw_rect(core::Rect quad, glm::vec4 color) {
+		if (!_is_visible(quad.top_left, quad.bottom_right)) {
+			return;
+		}
+
+		// (x0, y0) ---- (x1, y0)
+		//     |            |
+		//     |            |
+		// (x0, y1) ---- (x1, y1)
+		float x0 = quad.top_left.x;
+		float y0 = quad.top_left.y;
+		float x1 = quad.bottom_right.x;
+		float y1 = quad.bottom_right.y;
+
+		m_vertices.push_back(Vertex { .pos = { x0, y0 }, .color = color });
+		m_vertices.push_back(Vertex { .pos = { x0, y1 }, .color = color });
+		m_vertices.push_back(Vertex { .pos = { x1, y1 }, .color = color });
+		m_vertices.push_back(Vertex { .pos = { x1, y0 }, .color = color });
+
+		_push_section(VertexSection { .mode = GL_LINE_LOOP, .length = 4, .texture = m_white_texture, .scissor = _scissor_for(quad.top_left, quad.bottom_right) });
+	}
+
+	void DrawRecorder::draw_rect_fill(core::Rect quad, glm::vec4 color) {
+		if (!_is_visible(quad.top_left, quad.bottom_right)) {
+			return;
+		}
+
+		// (x0, y0) ---- (x1, y0)
+		//     |            |
+		//     |            |
+		// (x0, y1) ---- (x1, y1)
+		glm::vec2 pos0 = quad.top_left;
+		glm::vec2 pos1 = quad.bottom_right;
+		if (m_clip_rect) {
+			glm::vec2 uv0 = {};
+			glm::vec2 uv1 = {};
+			_clip_quad(&pos0, &pos1, &uv0, &uv1);
+		}
+		float x0 = pos0.x;
+		float y0 = pos0.y;
+		float x1 = pos1.x;
+		float y1 = pos1.y;
+
+		// quad, see quad.h for vertex order
+		m_vertices.push_back(Vertex { .pos = { x0, y0 }, .color = color });
+		m_vertices.push_back(Vertex { .pos = { x0, y1 }, .color = color });
+		m_vertices.push_back(Vertex { .pos = { x1, y0 }, .color = color });
+		m_vertices.push_back(Vertex { .pos = { x1, y1 }, .color = color });
+
+		// sections
+		_push_section(VertexSection { .mode = GL_TRIANGLES, .length = VERTICES_PER_QUAD, .texture = m_white_texture, .indexed = true });
+	}
+
+	void DrawRecorder::draw_circle(glm::vec2 center, float radius, glm::vec4 color) {
+		if (!_is_visible(center - radius, center + radius)) {
+			return;
+		}
+
+		const std::vector<glm::vec2>& octant_points = m_circle_cache.octant_points(radius);
+		for (const glm::vec2& point : octant_points) {
+			float x = point.x;
+			float y = point.y;
+			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { x, y }, .color = color });
+			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { y, x }, .color = color });
+			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { y, -x }, .color = color });
+			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { x, -y }, .color = color });
+			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { -x, -y }, .color = color });
+			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { -y, -x }, .color = color });
+			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { -y, x }, .color = color });
+			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { -x, y }, .color = color });
+		}
+
+		_push_section(VertexSection { .mode = GL_POINTS, .length = 8 * (GLsizei)octant_points.size(), .texture = m_white_texture, .scissor = _scissor_for(center - radius, center + radius) });
+	}
+
+	void DrawRecorder::draw_circle_fill(glm::vec2 center, float radius, glm::vec4 color) {
+		if (!_is_visible(center - radius, center + radius)) {
+			return;
+		}
+
+		/* Draw vertical lines */
+		const std::vector<glm::vec2>& span_points = m_circle_cache.span_points(radius);
+		for (const glm::vec2& point : span_points) {
+			float x = point.x;
+			float y = point.y;
+			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { x, y }, .color = color });
+			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { x, -y }, .color = color });
+		}
+		_push_section(VertexSection { .mode = GL_LINES, .length = 2 * (GLsizei)span_points.size(), .texture = m_white_texture, .scissor = _scissor_for(center - radius, center + radius) });
+	}
+
+	void DrawRecorder::draw_texture(Texture texture, core::Rect quad) {
+		core::FlipRect uv = {
+			.bottom_left = { 0.0f, 0.0f },
+			.top_right = { 1.0f, 1.0f }
+		};
+		draw_texture_clipped(texture, quad, uv);
+	}
+
+	void DrawRecorder::draw_texture_clipped(Texture texture, core::Rect quad, core::FlipRect uv) {
+		glm::vec4 white = { 1.0f, 1.0f, 1.0f, 1.0f };
+		draw_texture_clipped_with_color(texture, quad, uv, white);
+	}
+
+	void DrawRecorder::draw_texture_clipped_with_color(Texture texture, core::Rect quad, core::FlipRect uv, glm::vec4 color) {
+		if (!_is_visible(quad.top_left, quad.bottom_right)) {
+			return;
+		}
+
+		// (x0, y0) ---- (x1, y0)
+		//     |            |
+		//     |            |
+		// (x0, y1) ---- (x1, y1)
+		glm::vec2 pos0 = quad.top_left;
+		glm::vec2 pos1 = quad.bottom_right;
+
+		// (u0, v1) ---- (u1, v1)
+		//     |            |
+		//     |            |
+		// (u0, v0) ---- (u1, v0)
+		glm::vec2 uv0 = { uv.bottom_left.x, uv.top_right.y }; // at pos0
+		glm::vec2 uv1 = { uv.top_right.x, uv.bottom_left.y }; // at pos1
+
+		if (m_clip_rect) {
+			_clip_quad(&pos0, &pos1, &uv0, &uv1);
+		}
+		float x0 = pos0.x;
+		float y0 = pos0.y;
+		float x1 = pos1.x;
+		float y1 = pos1.y;
+		float u0 = uv0.x;
+		float v0 = uv1.y;
+		float u1 = uv1.x;
+		float v1 = uv0.y;
+
+		if (m_quad_mode == QuadMode::Instanced) {
+			m_quads.push_back(Quad { .pos0 = { x0, y0 }, .pos1 = { x1, y1 }, .uv0 = { u0, v1 }, .uv1 = { u1, v0 }, .color = color });
+			_push_section(VertexSection { .mode = GL_TRIANGLES, .length = 1, .texture = texture, .instanced = true });
+			return;
+		}
+
+		// quad, see quad.h for vertex order
+		m_vertices.push_back(Vertex { .pos = { x0, y0 }, .color = color, .uv = { u0, v1 } });
+		m_vertices.push_back(Vertex { .pos = { x0, y1 }, .color = color, .uv = { u0, v0 } });
+		m_vertices.push_back(Vertex { .pos = { x1, y0 }, .color = color, .uv = { u1, v1 } });
+		m_vertices.push_back(Vertex { .pos = { x1, y1 }, .color = color, .uv = { u1, v0 } });
+
+		// sections
+		_push_section(VertexSection { .mode = GL_TRIANGLES, .length = VERTICES_PER_QUAD, .texture = texture, .indexed = true });
+	}
+
+	void DrawRecorder::draw_character(const Font& font, char character, glm::vec2 pos, glm::vec4 color) {
+		if ((unsigned char)character >= Font::NUM_GLYPHS) {
+			return; // not ascii, see draw_text
+		}
+		const platform::Glyph& glyph = font.glyphs[(unsigned char)character];
+
+		float u0 = glyph.atlas_pos.x / (float)font.atlas.size.x;
+		float v0 = 1 - (glyph.atlas_pos.y + glyph.size.y) / (float)font.atlas.size.y;
+		float u1 = u0 + glyph.size.x / (float)font.atlas.size.x;
+		float v1 = v0 + glyph.size.y / (float)font.atlas.size.y;
+
+		// distance fields need their own section, drawn like text
+		if (font.distance_field) {
+			const GlyphQuad glyph_quad = {
+				.pos0 = { 0.0f, 0.0f },
+				.pos1 = glm::vec2 { glyph.size } * font.scale,
+				.uv0 = { u0, v1 },
+				.uv1 = { u1, v0 },
+				.texture = font.atlas,
+			};
+			_draw_glyph_quads(&glyph_quad, &glyph_quad + 1, pos, color, true);
+			return;
+		}
+
+		core::Rect quad = {
+			.top_left = { pos.x, pos.y },
+			.bottom_right = { pos.x + glyph.size.x, pos.y + glyph.size.y }
+		};
+
+		core::FlipRect uv = {
+			.bottom_left = { u0, v0 },
+			.top_right = { u1, v1 }
+		};
+
+		draw_texture_clipped_with_color(font.atlas, quad, uv, color);
+	}
+
+	void DrawRecorder::draw_text(const Font& font, const std::string& text, glm::vec2 pos, glm::vec4 color) {
+		// one section per run of glyphs in the same texture, i.e. the font
+		// atlas or a glyph cache page, where only the atlas can be a
+		// distance field
+		bool is_complete;
+		const std::vector<GlyphQuad>& glyph_quads = m_text_run_cache.quads(font, text, &is_complete);
+		m_missed_glyphs = m_missed_glyphs || !is_complete;
+		for (size_t first = 0; first < glyph_quads.size();) {
+			size_t last = first + 1;
+			while (last < glyph_quads.size() && glyph_quads[last].texture.id == glyph_quads[first].texture.id) {
+				last++;
+			}
+			const bool distance_field = font.distance_field && glyph_quads[first].texture.id == font.atlas.id;
+			_draw_glyph_quads(glyph_quads.data() + first, glyph_quads.data() + last, pos, color, distance_field);
+			first = last;
+		}
+	}
+
+	void DrawRecorder::draw_text_centered(const Font& font, const std::string& text, glm::vec2 pos, glm::vec4 color) {
+		glm::vec2 box_size = { 0.0f, 0.0f };
+		box_size.y = (float)font.line_height;
+
+		const char* it = text.data();
+		const char* end = text.data() + text.size();
+		while (it != end) {
+			bool is_missed;
+			if (std::optional<CachedGlyph> glyph = find_glyph(font, core::utf8::next_codepoint(&it, end), &is_missed)) {
+				box_size.x += glyph->glyph.advance * font.scale;
+			}
+			m_missed_glyphs = m_missed_glyphs || is_missed;
+		}
+
+		draw_text(font, text, pos - box_size / 2.0f, color);
+	}
+
+	// Draws glyph quads in [first, last), which share a texture
+	void DrawRecorder::_draw_glyph_quads(const GlyphQuad* first, const GlyphQuad* last, glm::vec2 pos, glm::vec4 color, bool distance_field) {
+		const Texture texture = first->texture;
+		const size_t num_glyph_quads = (size_t)(last - first);
+
+		if (m_quad_mode == QuadMode::Instanced) {
+			const size_t first_quad = m_quads.size();
+			for (const GlyphQuad& glyph_quad : std::span(first, last)) {
+				glm::vec2 pos0 = pos + glyph_quad.pos0;
+				glm::vec2 pos1 = pos + glyph_quad.pos1;
+				if (!_is_visible(pos0, pos1)) {
+					continue;
+				}
+				glm::vec2 uv0 = glyph_quad.uv0;
+				glm::vec2 uv1 = glyph_quad.uv1;
+				if (m_clip_rect) {
+					_clip_quad(&pos0, &pos1, &uv0, &uv1);
+				}
+				m_quads.push_back(Quad { .pos0 = pos0, .pos1 = pos1, .uv0 = uv0, .uv1 = uv1, .color = color });
+			}
+			const size_t num_visible = m_quads.size() - first_quad;
+			if (num_visible > 0) {
+				_push_section(VertexSection { .mode = GL_TRIANGLES, .length = (GLsizei)num_visible, .texture = texture, .instanced = true, .distance_field = distance_field });
+			}
+			return;
+		}
+
+		// quads, see quad.h for vertex order. Room is made for every glyph and
+		// then shrunk to the ones not culled.
+		const size_t first_vertex = m_vertices.size();
+		m_vertices.resize(first_vertex + num_glyph_quads * VERTICES_PER_QUAD);
+		Vertex* vertex = m_vertices.data() + first_vertex;
+		for (const GlyphQuad& glyph_quad : std::span(first, last)) {
+			glm::vec2 pos0 = pos + glyph_quad.pos0;
+			glm::vec2 pos1 = pos + glyph_quad.pos1;
+			if (!_is_visible(pos0, pos1)) {
+				continue;
+			}
+			glm::vec2 uv0 = glyph_quad.uv0;
+			glm::vec2 uv1 = glyph_quad.uv1;
+			if (m_clip_rect) {
+				_clip_quad(&pos0, &pos1, &uv0, &uv1);
+			}
+			*vertex++ = Vertex { .pos = { pos0.x, pos0.y }, .color = color, .uv = { uv0.x, uv0.y } };
+			*vertex++ = Vertex { .pos = { pos0.x, pos1.y }, .color = color, .uv = { uv0.x, uv1.y } };
+			*vertex++ = Vertex { .pos = { pos1.x, pos0.y }, .color = color, .uv = { uv1.x, uv0.y } };
+			*vertex++ = Vertex { .pos = { pos1.x, pos1.y }, .color = color, .uv = { uv1.x, uv1.y } };
+		}
+		const size_t num_visible_vertices = (size_t)(vertex - (m_vertices.data() + first_vertex));
+		m_vertices.resize(first_vertex + num_visible_vertices);
+		if (num_visible_vertices > 0) {
+			_push_section(VertexSection { .mode = GL_TRIANGLES, .length = (GLsizei)num_visible_vertices, .texture = texture, .indexed = true, .distance_field = distance_field });
+		}
+	}
+
+	void DrawRecorder::draw_static_batch(StaticBatch batch) {
+		// no vertices here, the batch's own are drawn in its place, scissored
+		// since they can't be clipped
+		_push_section(VertexSection { .mode = GL_TRIANGLES, .length = 0, .texture = m_white_texture, .static_batch = batch.id, .scissor = m_clip_rect });
+	}
+
+	void DrawRecorder::append(const DrawRecorder& other) {
+		m_vertices.insert(m_vertices.end(), other.m_vertices.begin(), other.m_vertices.end());
+		m_quads.insert(m_quads.end(), other.m_quads.begin(), other.m_quads.end());
+		m_num_raw_sections += other.m_num_raw_sections;
+		m_num_culled += other.m_num_culled;
+		m_missed_glyphs = m_missed_glyphs || other.m_missed_glyphs;
+
+		// The first section may continue the last one here, just like when
+		// pushed directly
+		auto first = other.m_sections.begin();
+		if (first != other.m_sections.end() && !m_sections.empty()) {
+			VertexSection& last = m_sections.back();
+			if (last.layer == first->layer && sections_are_mergeable(last, *first)) {
+				last.length += first->length;
+				++first;
+			}
+		}
+		m_sections.insert(m_sections.end(), first, other.m_sections.end());
+
+		for (GLuint framebuffer : other.m_canvas_pass_order) {
+			_add_canvas_pass(framebuffer);
+		}
+	}
+
+	void DrawRecorder::clear() {
+		m_vertices.clear();
+		m_quads.clear();
+		m_sections.clear();
+		m_num_raw_sections = 0;
+		m_num_culled = 0;
+		m_missed_glyphs = false;
+		m_canvas_pass_order.clear();
+	}
+
+	size_t DrawRecorder::num_vertices() const {
+		return m_vertices.size();
+	}
+
+	size_t DrawRecorder::num_quads() const {
+		return m_quads.size();
+	}
+
+	size_t DrawRecorder::num_culled() const {
+		return m_num_culled;
+	}
+
+	bool DrawRecorder::missed_glyphs() const {
+		return m_missed_glyphs;
+	}
+
+	std::optional<Canvas> DrawRecorder::_current_draw_canvas() {
+		return m_draw_canvas_stack.empty() ? std::nullopt : std::make_optional(m_draw_canvas_stack.back());
+	}
+
+	bool DrawRecorder::sections_are_mergeable(const VertexSection& lhs, const VertexSection& rhs) {
+		return mode_is_mergeable(rhs.mode) &&
+			lhs.static_batch == 0 && rhs.static_batch == 0 &&
+			lhs.mode == rhs.mode &&
+			lhs.texture.id == rhs.texture.id &&
+			lhs.indexed == rhs.indexed &&
+			lhs.instanced == rhs.instanced &&
+			lhs.distance_field == rhs.distance_field &&
+			canvases_are_equal(lhs.canvas, rhs.canvas) &&
+			scissors_are_equal(lhs.scissor, rhs.scissor);
+	}
+
+	uint16_t DrawRecorder::_current_draw_layer() {
+		return m_draw_layer_stack.empty() ? 0 : m_draw_layer_stack.back();
+	}
+
+	void DrawRecorder::_update_cull_rect() {
+		// Pixels are only touched inside the canvas, but lines and points are
+		// rasterized up to half a pixel out, so keep a margin
+		constexpr float MARGIN = 1.0f;
+
+		m_clip_rect.reset();
+		if (!m_clip_rect_stack.empty()) {
+			const core::Rect& clip_rect = m_clip_rect_stack.back();
+			m_clip_rect = core::Rect {
+				.top_left = glm::min(clip_rect.top_left, clip_rect.bottom_right),
+				.bottom_right = glm::max(clip_rect.top_left, clip_rect.bottom_right),
+			};
+		}
+
+		std::optional<core::Rect> bounds;
+		if (std::optional<Canvas> canvas = _current_draw_canvas()) {
+			bounds = core::Rect { { 0.0f, 0.0f }, canvas->texture.size };
+		}
+		if (m_clip_rect) {
+			bounds = bounds ? core::Rect { glm::max(bounds->top_left, m_clip_rect->top_left), glm::min(bounds->bottom_right, m_clip_rect->bottom_right) } : *m_clip_rect;
+		}
+
+		if (!bounds) {
+			m_cull_rect.reset();
+			return;
+		}
+		m_cull_rect = CullRect(core::Rect { bounds->top_left - MARGIN, glm::max(bounds->top_left, bounds->bottom_right) + MARGIN });
+	}
+
+	bool DrawRecorder::_is_visible(glm::vec2 corner0, glm::vec2 corner1) {
+		if (!m_cull_rect || m_cull_rect->overlaps(corner0, corner1)) {
+			return true;
+		}
+		m_num_culled += 1;
+		return false;
+	}
+
+	std::optional<core::Rect> DrawRecorder::_scissor_for(glm::vec2 corner0, glm::vec2 corner1) const {
+		if (!m_clip_rect) {
+			return {};
+		}
+		const glm::vec2 min = glm::min(corner0, corner1);
+		const glm::vec2 max = glm::max(corner0, corner1);
+		const bool is_inside = min.x >= m_clip_rect->top_left.x && min.y >= m_clip_rect->top_left.y &&
+			max.x <= m_clip_rect->bottom_right.x && max.y <= m_clip_rect->bottom_right.y;
+		return is_inside ? std::nullopt : m_clip_rect;
+	}
+
+	// Clips an axis aligned quad to the clip rect, moving each uv along with
+	// its corner. The corners may be in any order.
+	void DrawRecorder::_clip_quad(glm::vec2* pos0, glm::vec2* pos1, glm::vec2* uv0, glm::vec2* uv1) const {
+		for (int axis = 0; axis < 2; axis++) {
+			const float p0 = (*pos0)[axis];
+			const float p1 = (*pos1)[axis];
+			const float clipped0 = std::clamp(p0, m_clip_rect->top_left[axis], m_clip_rect->bottom_right[axis]);
+			const float clipped1 = std::clamp(p1, m_clip_rect->top_left[axis], m_clip_rect->bottom_right[axis]);
+			if (clipped0 == p0 && clipped1 == p1) {
+				continue;
+			}
+
+			const float uv_start = (*uv0)[axis];
+			const float uv_per_pixel = p1 != p0 ? ((*uv1)[axis] - uv_start) / (p1 - p0) : 0.0f;
+			(*uv0)[axis] = uv_start + (clipped0 - p0) * uv_per_pixel;
+			(*uv1)[axis] = uv_start + (clipped1 - p0) * uv_per_pixel;
+			(*pos0)[axis] = clipped0;
+			(*pos1)[axis] = clipped1;
+		}
+	}
+
+	void DrawRecorder::_copy_draw_state(const DrawRecorder& other) {
+		m_draw_canvas_stack = other.m_draw_canvas_stack;
+		m_draw_layer_stack = other.m_draw_layer_stack;
+		m_clip_rect_stack = other.m_clip_rect_stack;
+		_update_cull_rect();
+	}
+
+	void DrawRecorder::_push_section(VertexSection section) {
+		section.canvas = _current_draw_canvas();
+		section.layer = _current_draw_layer();
+		m_num_raw_sections += 1;
+
+		// Merge with previous section if they can be drawn with a single draw call
+		if (!m_sections.empty()) {
+			VertexSection& last = m_sections.back();
+			if (last.layer == section.layer && sections_are_mergeable(last, section)) {
+				last.length += section.length;
+				return;
+			}
+		}
+
+		m_sections.push_back(section);
+	}
+
+
+	void DrawRecorder::_add_canvas_pass(GLuint framebuffer) {
+		if (std::find(m_canvas_pass_order.begin(), m_canvas_pass_order.end(), framebuffer) == m_canvas_pass_order.end()) {
+			m_canvas_pass_order.push_back(framebuffer);
+		}
+	}
+
+} // namespace platform
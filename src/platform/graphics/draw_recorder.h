@@ -0,0 +1,133 @@
+#pragma once
+
+#include <core/rect.h>
+#include <platform/graphics/canvas.h>
+#include <platform/graphics/circle_cache.h>
+#include <platform/graphics/cull_rect.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/static_batch.h>
+#include <platform/graphics/text_run_cache.h>
+#include <platform/graphics/texture.h>
+#include <platform/graphics/vertex.h>
+
+#include <SDL2/SDL_opengl.h>
+#include <glm/glm.hpp>
+
+#include <optional>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace platform {
+
+	struct VertexSection {
+		GLenum mode;
+		GLsizei length;
+		Texture texture;
+		std::optional<Canvas> canvas;
+		uint16_t layer;
+		bool indexed; // quads drawn with the shared quad index buffer
+		bool instanced; // quads drawn as instances, length is the number of quads
+		bool distance_field; // texture alpha is thresholded as a distance field, see Font::distance_field
+		uint32_t static_batch; // id of a static batch drawn instead of vertices, 0 if none
+		std::optional<core::Rect> scissor; // clip rect to scissor to, for draws crossing it that can't be clipped on the CPU
+	};
+
+	bool canvases_are_equal(const std::optional<Canvas>& lhs, const std::optional<Canvas>& rhs);
+	bool scissors_are_equal(const std::optional<core::Rect>& lhs, const std::optional<core::Rect>& rhs);
+
+	// Turns draw calls into vertices and sections for the Renderer.
+	//
+	// The Renderer records into its own DrawRecorder, but separate recorders
+	// can be filled on worker threads (see Renderer::make_recorder) and then
+	// submitted in a fixed order. Submitting merges sections exactly like
+	// drawing directly would, so the output doesn't depend on how draws were
+	// split between recorders. Pushes and pops of canvases, layers and clip
+	// rects must be balanced within a recorder.
+	//
+	// Draws entirely outside the current canvas and clip rect are dropped
+	// before emitting any vertices. Culling is conservative, what's kept is
+	// still clipped by the GPU. Textured and filled quads crossing the clip
+	// rect are clipped on the CPU, with their uvs adjusted to match, while
+	// other draws crossing it are drawn with a GL scissor rect. Clip rects
+	// are in canvas pixels, so there's no scissor rect for draws without a
+	// canvas or render canvas, whose coordinates are given by the caller's
+	// projection. Lines, outlines and circles crossing a clip rect on the
+	// default framebuffer are culled but not clipped.
+	class DrawRecorder {
+	public:
+		explicit DrawRecorder(Texture white_texture, QuadMode quad_mode = QuadMode::Vertices);
+
+		void push_draw_canvas(Canvas canvas);
+		void pop_draw_canvas();
+
+		void push_draw_layer(uint16_t layer);
+		void pop_draw_layer();
+
+		// Clips draws to `rect`, within the current canvas
+		void push_clip_rect(core::Rect rect);
+		void pop_clip_rect();
+
+		void draw_point(glm::vec2 point, glm::vec4 color);
+		void draw_line(glm::vec2 start, glm::vec2 end, glm::vec4 color);
+		void draw_rect(core::Rect quad, glm::vec4 color);
+		void draw_rect_fill(core::Rect quad, glm::vec4 color);
+		void draw_circle(glm::vec2 center, float radius, glm::vec4 color);
+		void draw_circle_fill(glm::vec2 center, float radius, glm::vec4 color);
+
+		void draw_texture(Texture texture, core::Rect quad);
+		void draw_texture_clipped(Texture texture, core::Rect quad, core::FlipRect uv);
+		void draw_texture_clipped_with_color(Texture texture, core::Rect quad, core::FlipRect uv, glm::vec4 color);
+
+		void draw_character(const Font& font, char character, glm::vec2 pos, glm::vec4 color);
+		void draw_text(const Font& font, const std::string& text, glm::vec2 pos, glm::vec4 color);
+		void draw_text_centered(const Font& font, const std::string& text, glm::vec2 pos, glm::vec4 color);
+
+		void draw_static_batch(StaticBatch batch);
+
+		// Appends what `other` recorded, as if it had been drawn here
+		void append(const DrawRecorder& other);
+		void clear();
+
+		size_t num_vertices() const;
+		size_t num_quads() const;
+		size_t num_culled() const;
+		// Whether text was drawn without glyphs its glyph cache can only add
+		// on another thread, see GlyphCache::glyph
+		bool missed_glyphs() const;
+
+		static bool sections_are_mergeable(const VertexSection& lhs, const VertexSection& rhs);
+
+	private:
+		friend class Renderer;
+
+		std::optional<Canvas> _current_draw_canvas();
+		uint16_t _current_draw_layer();
+		void _update_cull_rect();
+		bool _is_visible(glm::vec2 corner0, glm::vec2 corner1);
+		std::optional<core::Rect> _scissor_for(glm::vec2 corner0, glm::vec2 corner1) const;
+		void _clip_quad(glm::vec2* pos0, glm::vec2* pos1, glm::vec2* uv0, glm::vec2* uv1) const;
+		void _copy_draw_state(const DrawRecorder& other);
+		void _push_section(VertexSection section);
+		void _draw_glyph_quads(const GlyphQuad* first, const GlyphQuad* last, glm::vec2 pos, glm::vec4 color, bool distance_field);
+		void _add_canvas_pass(GLuint framebuffer);
+
+		Texture m_white_texture;
+		QuadMode m_quad_mode;
+		std::vector<Vertex> m_vertices;
+		std::vector<Quad> m_quads; // textured quads with QuadMode::Instanced
+		std::vector<VertexSection> m_sections;
+		size_t m_num_raw_sections = 0; // sections pushed before merging
+		std::vector<Canvas> m_draw_canvas_stack;
+		std::vector<uint16_t> m_draw_layer_stack;
+		std::vector<core::Rect> m_clip_rect_stack;
+		std::optional<CullRect> m_cull_rect; // no culling if empty
+		std::optional<core::Rect> m_clip_rect; // top of the clip rect stack, with ordered corners
+		size_t m_num_culled = 0; // draws and glyphs dropped by culling
+		bool m_missed_glyphs = false;
+		std::vector<GLuint> m_canvas_pass_order; // framebuffers in the order they're finished drawing to
+		CircleCache m_circle_cache;
+		TextRunCache m_text_run_cache;
+	};
+
+} // namespace platform
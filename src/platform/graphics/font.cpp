@@ -1,13 +1,36 @@
 #include <platform/graphics/font.h>
 
+#include <core/distance_transform.h>
+#include <core/skyline_packer.h>
+#include <core/utf8.h>
 #include <cstring>
 #include <platform/debug/assert.h>
 #include <platform/debug/logging.h>
+#include <platform/graphics/font_atlas_cache.h>
 #include <platform/graphics/gl_context.h>
+#include <platform/graphics/glyph_cache.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 
 namespace platform {
 
 	static FT_Library g_ft;
+	static std::atomic<uint64_t> g_next_font_generation = 1;
+
+	RGBA glyph_pixel(uint8_t coverage) {
+		// Multiply alpha by some amount to match how the reference font arial.ttf renders in MS Paint
+		// Without this it seems like we end up rendering the font too dark.
+		const uint8_t alpha = (uint8_t)std::min(std::roundf(coverage * 1.3f), 255.0f);
+		return RGBA { .r = 0xFF, .g = 0xFF, .b = 0xFF, .a = alpha };
+	}
+
+	RGBA distance_field_pixel(float distance, int spread) {
+		// edge at half alpha, saturating `spread` pixels to either side
+		const float alpha = std::clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+		return RGBA { .r = 0xFF, .g = 0xFF, .b = 0xFF, .a = (uint8_t)std::roundf(alpha * 255.0f) };
+	}
 
 	void set_ft(FT_Library ft) {
 		g_ft = ft;
@@ -41,69 +64,195 @@ namespace platform {
 		return FontFace(face);
 	}
 
-	FontAtlas generate_font_atlas(const FontFace& face, uint8_t size) {
-		ASSERT(size > 0, "Can't create a font with size zero!");
-		FontAtlas atlas;
-		atlas.size = size;
+	static int round_up_to_power_of_two(int value) {
+		int power = 1;
+		while (power < value) {
+			power *= 2;
+		}
+		return power;
+	}
+
+	// Packs glyphs sorted by decreasing height at the given atlas width and
+	// returns the atlas height they need. Empty if a glyph is wider than
+	// the atlas.
+	static std::optional<int> pack_glyphs_at_width(const std::vector<glm::ivec2>& sizes, const std::vector<size_t>& order, int width, std::vector<glm::ivec2>* positions) {
+		int max_height = 0; // stacking every glyph always fits
+		for (glm::ivec2 size : sizes) {
+			max_height += size.y;
+		}
 
-		/* Set font size */
-		int pixels_per_point = 64;
+		core::SkylinePacker packer(glm::ivec2 { width, std::max(max_height, 1) });
+		int height = 0;
+		for (size_t index : order) {
+			std::optional<glm::ivec2> pos = packer.pack(sizes[index]);
+			if (!pos) {
+				return {};
+			}
+			(*positions)[index] = *pos;
+			height = std::max(height, pos->y + sizes[index].y);
+		}
+		return height;
+	}
+
+	// Glyph grown by `spread` on every side, with the alpha of its distance
+	// field in place of coverage
+	static GlyphBitmap generate_distance_field(const GlyphBitmap& bitmap, int spread) {
+		const glm::ivec2 size = bitmap.glyph.size + 2 * spread;
+		std::vector<uint8_t> coverage((size_t)size.x * size.y, 0);
+		for (int row = 0; row < bitmap.glyph.size.y; row++) {
+			const uint8_t* src = bitmap.coverage.data() + (size_t)row * bitmap.glyph.size.x;
+			std::copy(src, src + bitmap.glyph.size.x, coverage.begin() + (ptrdiff_t)(row + spread) * size.x + spread);
+		}
+
+		const std::vector<float> distances = core::signed_distance_field(coverage, size);
+		for (size_t i = 0; i < coverage.size(); i++) {
+			coverage[i] = distance_field_pixel(distances[i], spread).a;
+		}
+
+		Glyph glyph = bitmap.glyph;
+		glyph.size = size;
+		glyph.bearing += glm::ivec2 { -spread, spread };
+		return GlyphBitmap { .glyph = glyph, .coverage = std::move(coverage) };
+	}
+
+	int set_font_size(const FontFace& face, uint8_t size) {
+		ASSERT(size > 0, "Can't create a font with size zero!");
+		constexpr int pixels_per_point = 64;
 		FT_Set_Char_Size(face.get(), 0, size * pixels_per_point, 96, 96);
+		return (face->size->metrics.ascender - face->size->metrics.descender) / pixels_per_point;
+	}
 
-		/* Calculate atlas dimensions to be a square */
-		uint32_t glyph_height = (1 + (face->size->metrics.height / pixels_per_point));
-		uint32_t glyph_width = glyph_height / 2; // assume 2:1 ratio
-		uint32_t columns = (uint32_t)roundf(sqrtf((float)Font::NUM_GLYPHS * (float)glyph_height / (float)glyph_width));
-		uint32_t rows = (uint32_t)roundf((float)Font::NUM_GLYPHS / (float)columns);
-		atlas.width = columns * glyph_width;
-		atlas.height = rows * glyph_height;
-
-		/* Save line spacing */
-		atlas.line_height = (face->size->metrics.ascender - face->size->metrics.descender) / pixels_per_point;
-
-		/* Compute glyphs */
-		std::vector<uint8_t> monochrome_pixels = std::vector<uint8_t>(atlas.width * atlas.height);
-		glm::ivec2 pen = { 0, 1 };
-		for (int i = ' '; i < Font::NUM_GLYPHS; i++) {
-			// load character
+	void rasterize_glyphs(const FontFace& face, int first, int last, GlyphBitmap* glyphs) {
+		constexpr int pixels_per_point = 64;
+		for (int i = first; i < last; i++) {
 			FT_Load_Char(face.get(), i, FT_LOAD_RENDER);
-			FT_Bitmap* bmp = &face->glyph->bitmap;
+			const FT_Bitmap* bmp = &face->glyph->bitmap;
 
-			// render current glyph
+			GlyphBitmap& glyph = glyphs[i];
+			glyph.coverage.resize((size_t)bmp->width * bmp->rows);
 			for (uint32_t row = 0; row < bmp->rows; row++) {
-				for (uint32_t col = 0; col < bmp->width; col++) {
-					uint32_t x = pen.x + col;
-					uint32_t y = pen.y + row;
-					monochrome_pixels[y * atlas.width + x] = bmp->buffer[row * bmp->pitch + col];
-				}
+				memcpy(glyph.coverage.data() + (size_t)row * bmp->width, bmp->buffer + (ptrdiff_t)row * bmp->pitch, bmp->width);
 			}
+			glyph.glyph = Glyph {
+				.atlas_pos = { 0, 0 },
+				.size = { bmp->width, bmp->rows },
+				.bearing = { face->glyph->bitmap_left, face->glyph->bitmap_top },
+				.advance = (int)(face->glyph->advance.x / pixels_per_point),
+			};
+		}
+	}
 
-			// save glyph info
-			atlas.glyphs[i].atlas_pos = pen;
-			atlas.glyphs[i].size = { bmp->width, bmp->rows };
-			atlas.glyphs[i].bearing = { face->glyph->bitmap_left, face->glyph->bitmap_top };
-			atlas.glyphs[i].advance = face->glyph->advance.x / pixels_per_point;
-
-			// move pen
-			pen.x += bmp->width + 1;
-			if (pen.x + bmp->width >= atlas.width) {
-				pen.x = 0;
-				pen.y += face->size->metrics.height / pixels_per_point + 2;
+	FontAtlas generate_font_atlas(const FontFace& face, uint8_t size, const FontAtlasSettings& settings) {
+		RasterizedFont font = {
+			.size = size,
+			.line_height = set_font_size(face, size),
+			.glyphs = std::vector<GlyphBitmap>(Font::NUM_GLYPHS),
+		};
+		rasterize_glyphs(face, ' ', Font::NUM_GLYPHS, font.glyphs.data());
+		return pack_font_atlas(font, settings);
+	}
+
+	FontAtlas pack_font_atlas(const RasterizedFont& font, const FontAtlasSettings& settings) {
+		ASSERT(font.glyphs.size() == Font::NUM_GLYPHS, "Expected a glyph per ascii value");
+		FontAtlas atlas;
+		atlas.size = font.size;
+		atlas.line_height = font.line_height;
+		atlas.distance_field = settings.mode == FontAtlasMode::DistanceField;
+
+		/* Distance fields */
+		// stored as alpha values in the coverage of the glyph bitmaps
+		std::vector<GlyphBitmap> distance_fields;
+		if (atlas.distance_field) {
+			distance_fields.reserve(Font::NUM_GLYPHS);
+			for (const GlyphBitmap& bitmap : font.glyphs) {
+				const bool is_empty = bitmap.glyph.size.x == 0 || bitmap.glyph.size.y == 0;
+				distance_fields.push_back(is_empty ? bitmap : generate_distance_field(bitmap, settings.distance_field_spread));
+			}
+		}
+		const std::vector<GlyphBitmap>& glyphs = atlas.distance_field ? distance_fields : font.glyphs;
+
+		std::vector<glm::ivec2> packed_sizes(Font::NUM_GLYPHS, { 0, 0 }); // including padding, zero for empty glyphs
+		for (size_t i = 0; i < Font::NUM_GLYPHS; i++) {
+			atlas.glyphs[i] = glyphs[i].glyph;
+			if (atlas.glyphs[i].size.x > 0 && atlas.glyphs[i].size.y > 0) {
+				packed_sizes[i] = atlas.glyphs[i].size + settings.padding;
+			}
+		}
+
+		/* Pack */
+		// Tries widths from a square upwards and keeps the smallest atlas.
+		// Padding goes to the right and below each glyph.
+		std::vector<size_t> order;
+		int64_t packed_area = 0;
+		int min_width = 1;
+		for (size_t i = 0; i < Font::NUM_GLYPHS; i++) {
+			if (packed_sizes[i].x > 0) {
+				order.push_back(i);
+				packed_area += (int64_t)packed_sizes[i].x * packed_sizes[i].y;
+				min_width = std::max(min_width, packed_sizes[i].x);
+			}
+		}
+		std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+			if (packed_sizes[lhs].y != packed_sizes[rhs].y) {
+				return packed_sizes[lhs].y > packed_sizes[rhs].y;
+			}
+			return packed_sizes[lhs].x > packed_sizes[rhs].x;
+		});
+
+		const int square_width = std::max(min_width, (int)std::ceil(std::sqrt((double)packed_area)));
+		std::vector<int> widths;
+		if (settings.power_of_two) {
+			for (int width = round_up_to_power_of_two(min_width); width <= round_up_to_power_of_two(2 * square_width); width *= 2) {
+				widths.push_back(width);
+			}
+		}
+		else {
+			constexpr int NUM_WIDTHS = 16;
+			for (int i = 0; i < NUM_WIDTHS; i++) {
+				widths.push_back(square_width + square_width * i / NUM_WIDTHS);
+			}
+		}
+
+		std::vector<glm::ivec2> positions(Font::NUM_GLYPHS);
+		std::vector<glm::ivec2> best_positions(Font::NUM_GLYPHS);
+		glm::ivec2 best_size = { 0, 0 };
+		for (int width : widths) {
+			std::optional<int> height = pack_glyphs_at_width(packed_sizes, order, width, &positions);
+			if (!height) {
+				continue;
+			}
+			const glm::ivec2 atlas_size = settings.power_of_two
+				? glm::ivec2 { width, round_up_to_power_of_two(std::max(*height, 1)) }
+				: glm::ivec2 { width, std::max(*height, 1) };
+			// ties go to the squarer atlas, keeping either side from
+			// growing past texture size limits
+			const int64_t area = (int64_t)atlas_size.x * atlas_size.y;
+			const int64_t best_area = (int64_t)best_size.x * best_size.y;
+			const bool is_squarer = std::max(atlas_size.x, atlas_size.y) < std::max(best_size.x, best_size.y);
+			if (best_size.x == 0 || area < best_area || (area == best_area && is_squarer)) {
+				best_size = atlas_size;
+				best_positions.swap(positions);
 			}
 		}
+		ASSERT(best_size.x > 0, "Glyphs don't fit in any atlas width");
+		atlas.width = best_size.x;
+		atlas.height = best_size.y;
+		atlas.occupancy = (float)((double)packed_area / ((double)atlas.width * atlas.height));
 
 		/* Generate pixel data */
-		atlas.pixels = std::vector<RGBA>(atlas.width * atlas.height);
-		for (size_t y = 0; y < atlas.height; y++) {
-			size_t inv_y = (atlas.height - 1) - y;
-			for (size_t x = 0; x < atlas.width; x++) {
-				// Multiply alpha by some amount to match how the reference font arial.ttf renders in MS Paint
-				// Without this it seems like we end up rendering the font too dark.
-				uint8_t alpha = (uint8_t)std::min(std::roundf(monochrome_pixels[y * atlas.width + x] * 1.3f), 255.0f);
-				atlas.pixels[inv_y * atlas.width + x].r = 0xFF;
-				atlas.pixels[inv_y * atlas.width + x].g = 0xFF;
-				atlas.pixels[inv_y * atlas.width + x].b = 0xFF;
-				atlas.pixels[inv_y * atlas.width + x].a = alpha;
+		// rows are flipped, so the bottom row of the atlas comes first
+		atlas.pixels = std::vector<RGBA>((size_t)atlas.width * atlas.height, glyph_pixel(0));
+		for (size_t i : order) {
+			Glyph& glyph = atlas.glyphs[i];
+			glyph.atlas_pos = best_positions[i];
+			for (int row = 0; row < glyph.size.y; row++) {
+				const size_t inv_y = (atlas.height - 1) - (size_t)(glyph.atlas_pos.y + row);
+				for (int col = 0; col < glyph.size.x; col++) {
+					const uint8_t value = glyphs[i].coverage[(size_t)row * glyph.size.x + col];
+					atlas.pixels[inv_y * atlas.width + glyph.atlas_pos.x + col] = atlas.distance_field
+						? RGBA { .r = 0xFF, .g = 0xFF, .b = 0xFF, .a = value }
+						: glyph_pixel(value);
+				}
 			}
 		}
 
@@ -111,41 +260,62 @@ namespace platform {
 	}
 
 	Font create_font_from_atlas(OpenGLContext* gl_context, const FontAtlas& atlas) {
-		Texture texture = gl_context->add_texture((uint8_t*)atlas.pixels.data(), atlas.width, atlas.height);
+		// distance fields are interpolated between texels when scaled
+		const TextureFilter filter = atlas.distance_field ? TextureFilter::Linear : TextureFilter::Nearest;
+		Texture texture = gl_context->add_texture((uint8_t*)atlas.pixels.data(), atlas.width, atlas.height, TextureWrapping::ClampToEdge, filter);
 		Font font;
 		std::memcpy(font.glyphs, atlas.glyphs, sizeof(Glyph) * Font::NUM_GLYPHS);
 		font.atlas = texture;
 		font.size = atlas.size;
 		font.line_height = atlas.line_height;
+		font.distance_field = atlas.distance_field;
+		font.generation = g_next_font_generation.fetch_add(1, std::memory_order_relaxed);
 		return font;
 	}
 
-	std::expected<Font, std::string> add_font(OpenGLContext* gl_context, const char* font_path, uint8_t font_size) {
-		std::expected<FontFace, std::string> face = load_font_face(font_path);
-		if (!face.has_value()) {
-			return std::unexpected(face.error());
+	std::expected<Font, std::string> add_font(OpenGLContext* gl_context, const char* font_path, uint8_t font_size, FontAtlasCache* atlas_cache) {
+		std::expected<BakedFont, std::string> baked = load_or_bake_font(atlas_cache, font_path, font_size, {}, true);
+		if (!baked.has_value()) {
+			return std::unexpected(baked.error());
 		}
-		FontAtlas atlas = generate_font_atlas(face.value(), font_size);
+		const FontAtlas& atlas = baked->atlas;
 		Texture texture = gl_context->add_texture((uint8_t*)atlas.pixels.data(), atlas.width, atlas.height);
 		Font font;
 		std::memcpy(font.glyphs, atlas.glyphs, sizeof(Glyph) * Font::NUM_GLYPHS);
 		font.atlas = texture;
 		font.size = atlas.size;
 		font.line_height = atlas.line_height;
+		font.generation = g_next_font_generation.fetch_add(1, std::memory_order_relaxed);
+		font.glyph_cache = std::make_shared<GlyphCache>(gl_context, font_path, font_size, baked->latin_glyphs);
 		return font;
 	}
 
+	Font scale_font(const Font& font, size_t size) {
+		ASSERT(font.distance_field, "Only distance field fonts can be scaled");
+		ASSERT(size > 0, "Can't scale a font to size zero!");
+		const float atlas_size = font.size / font.scale;
+		Font scaled = font;
+		scaled.size = size;
+		scaled.scale = size / atlas_size;
+		scaled.line_height = (int)std::roundf(font.line_height / font.scale * scaled.scale);
+		return scaled;
+	}
+
 	void free_font(OpenGLContext* gl_context, const Font& font) {
 		gl_context->free_texture(font.atlas);
+		if (font.glyph_cache) {
+			font.glyph_cache->free_pages(gl_context);
+		}
 	}
 
 	core::Rect get_text_bounding_box(const Font& font, const std::string& text) {
-		glm::vec2 pen = { 0.0f, 0.0f };
 		float width = 0.0f;
-		const char* chars = text.data();
-		for (char character = *chars; character != '\0'; character = *(++chars)) {
-			const Glyph& glyph = font.glyphs[character];
-			width += glyph.advance;
+		const char* it = text.data();
+		const char* end = text.data() + text.size();
+		while (it != end) {
+			if (std::optional<CachedGlyph> glyph = find_glyph(font, core::utf8::next_codepoint(&it, end))) {
+				width += glyph->glyph.advance * font.scale;
+			}
 		}
 		return core::Rect {
 			.top_left = { 0.0f, -(float)font.size - 1.0f },
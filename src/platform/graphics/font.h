@@ -12,13 +12,18 @@
 
 #include <expected>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <stddef.h>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace platform {
 
+	class FontAtlasCache;
+	class GlyphCache;
+
 	class FontFace : public core::ResourceHandle<FT_Face, FT_Error(FT_Face)> {
 	public:
 		FontFace() = default;
@@ -65,6 +70,20 @@ namespace platform {
 		uint8_t a;
 	};
 
+	enum class FontAtlasMode {
+		Coverage, // alpha is how much of each pixel glyphs cover
+		DistanceField, // alpha is the signed distance to glyph edges, for drawing at any scale
+	};
+
+	struct FontAtlasSettings {
+		int padding = 1; // empty pixels between glyphs
+		bool power_of_two = false; // round width and height up to powers of two
+		FontAtlasMode mode = FontAtlasMode::Coverage;
+		// Pixels of distance stored on either side of glyph edges with
+		// FontAtlasMode::DistanceField, which glyphs grow by on every side
+		int distance_field_spread = 4;
+	};
+
 	struct FontAtlas {
 		static constexpr size_t NUM_GLYPHS = 127;
 		Glyph glyphs[NUM_GLYPHS]; // indexed using ascii values
@@ -73,6 +92,20 @@ namespace platform {
 		unsigned int width = 1;
 		unsigned int height = 1;
 		int line_height = 0; // measured from baseline
+		float occupancy = 0.0f; // fraction of pixels covered by glyphs, including padding
+		bool distance_field = false; // generated with FontAtlasMode::DistanceField
+	};
+
+	// Glyph rasterized by FreeType, before being packed into an atlas
+	struct GlyphBitmap {
+		Glyph glyph; // without an atlas_pos
+		std::vector<uint8_t> coverage; // rows from the top
+	};
+
+	struct RasterizedFont {
+		size_t size = 1;
+		int line_height = 0; // measured from baseline
+		std::vector<GlyphBitmap> glyphs; // indexed using ascii values
 	};
 
 	struct Font {
@@ -81,8 +114,17 @@ namespace platform {
 		platform::Texture atlas;
 		size_t size;
 		int line_height; // measured from baseline
+		std::shared_ptr<GlyphCache> glyph_cache; // glyphs outside ascii, none for fonts created from an atlas
+		bool distance_field = false; // atlas alpha is a distance, thresholded when drawn
+		float scale = 1.0f; // of the glyph metrics, for distance field fonts drawn at another size than their atlas
+		uint64_t generation = 0; // unique to each added atlas, since texture ids are reused after free_font
 	};
 
+	// Atlas pixel for a glyph bitmap's coverage value
+	RGBA glyph_pixel(uint8_t coverage);
+	// Atlas pixel for a signed distance to a glyph's edge, in pixels
+	RGBA distance_field_pixel(float distance, int spread);
+
 	void set_ft(FT_Library ft);
 	FT_Library get_ft();
 
@@ -90,9 +132,23 @@ namespace platform {
 	void shutdown_fonts();
 
 	std::expected<FontFace, std::string> load_font_face(std::filesystem::path path);
-	FontAtlas generate_font_atlas(const FontFace& face, uint8_t size);
+	// Rasterizes the ascii glyphs and packs them into an atlas as small as
+	// fits them. Distance field atlases are best generated at a size around
+	// 32, larger sizes keep finer details and smaller ones save memory.
+	FontAtlas generate_font_atlas(const FontFace& face, uint8_t size, const FontAtlasSettings& settings = {});
+
+	// Steps of generate_font_atlas, for rasterizing glyphs of several
+	// sizes in parallel. Setting the size returns the line height.
+	int set_font_size(const FontFace& face, uint8_t size);
+	void rasterize_glyphs(const FontFace& face, int first, int last, GlyphBitmap* glyphs);
+	FontAtlas pack_font_atlas(const RasterizedFont& font, const FontAtlasSettings& settings = {});
 	Font create_font_from_atlas(OpenGLContext* gl_context, const FontAtlas& atlas);
-	std::expected<Font, std::string> add_font(OpenGLContext* gl_context, const char* font_path, uint8_t font_size);
+	// Loads the atlas and the glyph cache's Latin-1 glyphs from `atlas_cache`
+	// if it has them, without FreeType, and stores them there otherwise
+	std::expected<Font, std::string> add_font(OpenGLContext* gl_context, const char* font_path, uint8_t font_size, FontAtlasCache* atlas_cache = nullptr);
+	// Same font drawn at another size, sharing the atlas. Only for distance
+	// field fonts, which stay sharp when scaled.
+	Font scale_font(const Font& font, size_t size);
 	void free_font(OpenGLContext* gl_context, const Font& font);
 
 	core::Rect get_text_bounding_box(const Font& font, const std::string& text);
@@ -0,0 +1,316 @@
+#include <platform/graphics/font_atlas_cache.h>
+
+#include <platform/file/file.h>
+#include <platform/graphics/glyph_cache.h>
+
+#include <freetype/freetype.h>
+
+#include <bit>
+#include <fstream>
+#include <string.h>
+#include <type_traits>
+
+namespace platform {
+
+	constexpr uint32_t FONT_ATLAS_MAGIC = 0x4C544146; // "FATL"
+	constexpr uint32_t FONT_ATLAS_VERSION = 1;
+
+	constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325;
+	constexpr uint64_t FNV_PRIME = 0x100000001B3;
+	constexpr uint64_t WORD_MULTIPLIER_0 = 0x9E3779B97F4A7C15;
+	constexpr uint64_t WORD_MULTIPLIER_1 = 0xC2B2AE3D27D4EB4F;
+	constexpr size_t NUM_HASH_LANES = 4;
+
+	// 64 bit FNV-1a, which unlike std::hash is the same in every build
+	static uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+		const uint8_t* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < size; i++) {
+			hash = (hash ^ bytes[i]) * FNV_PRIME;
+		}
+		return hash;
+	}
+
+	static uint64_t mix_word(uint64_t lane, uint64_t word) {
+		return std::rotl(lane ^ (word * WORD_MULTIPLIER_1), 31) * WORD_MULTIPLIER_0;
+	}
+
+	template <typename T>
+	static uint64_t add_to_key(uint64_t key, const T& value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		return fnv1a(key, &value, sizeof(T));
+	}
+
+	template <typename T>
+	static void write_value(std::vector<uint8_t>* bytes, const T& value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		const uint8_t* first = (const uint8_t*)&value;
+		bytes->insert(bytes->end(), first, first + sizeof(T));
+	}
+
+	template <typename T>
+	static void write_array(std::vector<uint8_t>* bytes, const std::vector<T>& values) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		write_value(bytes, (uint64_t)values.size());
+		const uint8_t* first = (const uint8_t*)values.data();
+		bytes->insert(bytes->end(), first, first + values.size() * sizeof(T));
+	}
+
+	class ByteReader {
+	public:
+		ByteReader(std::span<const uint8_t> bytes)
+			: m_bytes(bytes) {
+		}
+
+		template <typename T>
+		bool read_value(T* value) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			if (m_offset + sizeof(T) > m_bytes.size()) {
+				return false;
+			}
+			memcpy(value, m_bytes.data() + m_offset, sizeof(T));
+			m_offset += sizeof(T);
+			return true;
+		}
+
+		template <typename T>
+		bool read_array(std::vector<T>* values) {
+			uint64_t size;
+			if (!read_value(&size) || size > (m_bytes.size() - m_offset) / sizeof(T)) {
+				return false;
+			}
+			values->resize(size);
+			memcpy(values->data(), m_bytes.data() + m_offset, size * sizeof(T));
+			m_offset += size * sizeof(T);
+			return true;
+		}
+
+	private:
+		std::span<const uint8_t> m_bytes;
+		size_t m_offset = 0;
+	};
+
+	std::vector<uint8_t> serialize_baked_font(const BakedFont& font) {
+		const FontAtlas& atlas = font.atlas;
+		std::vector<uint8_t> bytes;
+
+		/* Header */
+		write_value(&bytes, FONT_ATLAS_MAGIC);
+		write_value(&bytes, FONT_ATLAS_VERSION);
+
+		/* Atlas */
+		write_value(&bytes, (uint64_t)atlas.size);
+		write_value(&bytes, (uint32_t)atlas.width);
+		write_value(&bytes, (uint32_t)atlas.height);
+		write_value(&bytes, (int32_t)atlas.line_height);
+		write_value(&bytes, atlas.occupancy);
+		write_value(&bytes, (uint8_t)atlas.distance_field);
+		write_value(&bytes, atlas.glyphs);
+		std::vector<uint8_t> alpha(atlas.pixels.size());
+		for (size_t i = 0; i < atlas.pixels.size(); i++) {
+			alpha[i] = atlas.pixels[i].a;
+		}
+		write_array(&bytes, alpha);
+
+		/* Latin-1 glyphs */
+		write_value(&bytes, (uint64_t)font.latin_glyphs.size());
+		for (const GlyphBitmap& bitmap : font.latin_glyphs) {
+			write_value(&bytes, bitmap.glyph);
+			write_array(&bytes, bitmap.coverage);
+		}
+
+		return bytes;
+	}
+
+	std::expected<BakedFont, FontAtlasCacheError> deserialize_baked_font(std::span<const uint8_t> bytes) {
+		ByteReader reader(bytes);
+		BakedFont font;
+		FontAtlas& atlas = font.atlas;
+
+		/* Header */
+		uint32_t magic;
+		uint32_t version;
+		if (!reader.read_value(&magic) || magic != FONT_ATLAS_MAGIC) {
+			return std::unexpected(FontAtlasCacheError::InvalidHeader);
+		}
+		if (!reader.read_value(&version) || version != FONT_ATLAS_VERSION) {
+			return std::unexpected(FontAtlasCacheError::UnsupportedVersion);
+		}
+
+		/* Atlas */
+		uint64_t size;
+		uint32_t width;
+		uint32_t height;
+		int32_t line_height;
+		uint8_t distance_field;
+		std::vector<uint8_t> alpha;
+		if (!reader.read_value(&size) || !reader.read_value(&width) || !reader.read_value(&height) || !reader.read_value(&line_height)
+			|| !reader.read_value(&atlas.occupancy) || !reader.read_value(&distance_field) || !reader.read_value(&atlas.glyphs) || !reader.read_array(&alpha)) {
+			return std::unexpected(FontAtlasCacheError::UnexpectedEndOfData);
+		}
+		if (alpha.size() != (size_t)width * height) {
+			return std::unexpected(FontAtlasCacheError::InvalidGlyphData);
+		}
+		atlas.size = size;
+		atlas.width = width;
+		atlas.height = height;
+		atlas.line_height = line_height;
+		atlas.distance_field = distance_field != 0;
+		atlas.pixels.resize(alpha.size());
+		for (size_t i = 0; i < alpha.size(); i++) {
+			atlas.pixels[i] = RGBA { .r = 0xFF, .g = 0xFF, .b = 0xFF, .a = alpha[i] };
+		}
+
+		/* Latin-1 glyphs */
+		uint64_t num_latin_glyphs;
+		if (!reader.read_value(&num_latin_glyphs)) {
+			return std::unexpected(FontAtlasCacheError::UnexpectedEndOfData);
+		}
+		if (num_latin_glyphs != 0 && num_latin_glyphs != GlyphCache::LATIN_END - GlyphCache::LATIN_FIRST) {
+			return std::unexpected(FontAtlasCacheError::InvalidGlyphData);
+		}
+		font.latin_glyphs.resize(num_latin_glyphs);
+		for (GlyphBitmap& bitmap : font.latin_glyphs) {
+			if (!reader.read_value(&bitmap.glyph) || !reader.read_array(&bitmap.coverage)) {
+				return std::unexpected(FontAtlasCacheError::UnexpectedEndOfData);
+			}
+			if (bitmap.glyph.size.x < 0 || bitmap.glyph.size.y < 0 || bitmap.coverage.size() != (size_t)bitmap.glyph.size.x * bitmap.glyph.size.y) {
+				return std::unexpected(FontAtlasCacheError::InvalidGlyphData);
+			}
+		}
+
+		return font;
+	}
+
+	// Hashing the font file is most of the time a cache hit takes, so
+	// it's hashed a word at a time in independent lanes, which keeps
+	// several multiplies in flight. The bytes left over go through FNV-1a.
+	uint64_t hash_font_file(std::span<const uint8_t> font_file) {
+		constexpr size_t BLOCK_SIZE = NUM_HASH_LANES * sizeof(uint64_t);
+		uint64_t lanes[NUM_HASH_LANES];
+		for (size_t lane = 0; lane < NUM_HASH_LANES; lane++) {
+			lanes[lane] = FNV_OFFSET_BASIS + lane;
+		}
+		const size_t num_blocks = font_file.size() / BLOCK_SIZE;
+		for (size_t block = 0; block < num_blocks; block++) {
+			for (size_t lane = 0; lane < NUM_HASH_LANES; lane++) {
+				uint64_t word;
+				memcpy(&word, font_file.data() + block * BLOCK_SIZE + lane * sizeof(uint64_t), sizeof(uint64_t));
+				lanes[lane] = mix_word(lanes[lane], word);
+			}
+		}
+
+		uint64_t hash = add_to_key(FNV_OFFSET_BASIS, (uint64_t)font_file.size());
+		for (uint64_t lane : lanes) {
+			hash = add_to_key(hash, lane);
+		}
+		const size_t tail = num_blocks * BLOCK_SIZE;
+		return fnv1a(hash, font_file.data() + tail, font_file.size() - tail);
+	}
+
+	uint64_t font_atlas_cache_key(uint64_t font_file_hash, uint8_t size, const FontAtlasSettings& settings, bool latin_glyphs) {
+		// glyphs rasterized by another FreeType version may differ
+		uint64_t key = add_to_key(FNV_OFFSET_BASIS, font_file_hash);
+		key = add_to_key(key, FONT_ATLAS_VERSION);
+		key = add_to_key(key, (int32_t)FREETYPE_MAJOR);
+		key = add_to_key(key, (int32_t)FREETYPE_MINOR);
+		key = add_to_key(key, (int32_t)FREETYPE_PATCH);
+		key = add_to_key(key, size);
+		key = add_to_key(key, (int32_t)settings.padding);
+		key = add_to_key(key, (uint8_t)settings.power_of_two);
+		key = add_to_key(key, (int32_t)settings.mode);
+		key = add_to_key(key, (int32_t)settings.distance_field_spread);
+		key = add_to_key(key, (uint8_t)latin_glyphs);
+		return key;
+	}
+
+	FontAtlasCache::FontAtlasCache(std::filesystem::path directory)
+		: m_directory(std::move(directory)) {
+	}
+
+	std::optional<BakedFont> FontAtlasCache::load(uint64_t key) {
+		std::optional<BakedFont> font;
+		if (std::optional<std::vector<uint8_t>> bytes = read_file_bytes(entry_path(key))) {
+			if (std::expected<BakedFont, FontAtlasCacheError> deserialized = deserialize_baked_font(*bytes)) {
+				font = std::move(deserialized.value());
+			}
+		}
+
+		std::lock_guard lock(m_mutex);
+		if (font) {
+			m_stats.num_hits += 1;
+		}
+		else {
+			m_stats.num_misses += 1;
+		}
+		return font;
+	}
+
+	bool FontAtlasCache::store(uint64_t key, const BakedFont& font) {
+		const std::vector<uint8_t> bytes = serialize_baked_font(font);
+		const std::filesystem::path path = entry_path(key);
+		std::filesystem::path temp_path = path;
+		temp_path += ".tmp";
+
+		std::lock_guard lock(m_mutex);
+		std::error_code error;
+		std::filesystem::create_directories(m_directory, error);
+		{
+			std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+			if (!file.write((const char*)bytes.data(), (std::streamsize)bytes.size())) {
+				return false;
+			}
+		}
+		std::filesystem::rename(temp_path, path, error);
+		if (error) {
+			std::filesystem::remove(temp_path, error);
+			return false;
+		}
+		m_stats.num_stores += 1;
+		return true;
+	}
+
+	std::filesystem::path FontAtlasCache::entry_path(uint64_t key) const {
+		constexpr char digits[] = "0123456789abcdef";
+		std::string name(16, '0');
+		for (int i = 15; i >= 0; i--) {
+			name[(size_t)i] = digits[key & 0xF];
+			key >>= 4;
+		}
+		return m_directory / (name + ".fontatlas");
+	}
+
+	FontAtlasCacheStats FontAtlasCache::stats() const {
+		std::lock_guard lock(m_mutex);
+		return m_stats;
+	}
+
+	std::expected<BakedFont, std::string> load_or_bake_font(FontAtlasCache* cache, const std::filesystem::path& path, uint8_t size, const FontAtlasSettings& settings, bool latin_glyphs) {
+		/* Load */
+		std::optional<uint64_t> key;
+		if (cache) {
+			std::optional<std::vector<uint8_t>> font_file = read_file_bytes(path);
+			if (!font_file) {
+				return std::unexpected("Couldn't read font file");
+			}
+			key = font_atlas_cache_key(hash_font_file(*font_file), size, settings, latin_glyphs);
+			if (std::optional<BakedFont> font = cache->load(*key)) {
+				return std::move(font.value());
+			}
+		}
+
+		/* Bake */
+		std::expected<FontFace, std::string> face = load_font_face(path);
+		if (!face.has_value()) {
+			return std::unexpected(face.error());
+		}
+		BakedFont font = { .atlas = generate_font_atlas(face.value(), size, settings) };
+		if (latin_glyphs) {
+			font.latin_glyphs = rasterize_latin_glyphs(face.value(), size);
+		}
+		if (cache) {
+			cache->store(*key, font);
+		}
+		return font;
+	}
+
+} // namespace platform
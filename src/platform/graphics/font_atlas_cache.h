@@ -0,0 +1,81 @@
+#pragma once
+
+#include <platform/graphics/font.h>
+
+#include <expected>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace platform {
+
+	enum class FontAtlasCacheError {
+		InvalidHeader,
+		UnsupportedVersion,
+		UnexpectedEndOfData,
+		InvalidGlyphData,
+	};
+
+	// A font baked at one size: its atlas, and for fonts with a glyph
+	// cache the Latin-1 glyphs the cache starts with
+	struct BakedFont {
+		FontAtlas atlas;
+		std::vector<GlyphBitmap> latin_glyphs; // as given by rasterize_latin_glyphs, empty if not baked
+	};
+
+	// Atlas pixels are stored as their alpha only, since they're all white
+	std::vector<uint8_t> serialize_baked_font(const BakedFont& font);
+	std::expected<BakedFont, FontAtlasCacheError> deserialize_baked_font(std::span<const uint8_t> bytes);
+
+	// Keys are made from the contents of the font file rather than its
+	// path, so an edited font file misses. Hashes are stable between runs
+	// and builds.
+	uint64_t hash_font_file(std::span<const uint8_t> font_file);
+	uint64_t font_atlas_cache_key(uint64_t font_file_hash, uint8_t size, const FontAtlasSettings& settings, bool latin_glyphs);
+
+	struct FontAtlasCacheStats {
+		size_t num_hits = 0;
+		size_t num_misses = 0;
+		size_t num_stores = 0;
+	};
+
+	// Baked fonts stored as files in a directory, so fonts baked in an
+	// earlier run are loaded without FreeType.
+	//
+	// Each entry is a file named after its key. Entries are written to a
+	// temporary file and renamed into place, so a partially written entry
+	// is never loaded. Entries that fail to load, e.g. ones written by an
+	// older format version, count as misses and are overwritten by the
+	// next store. Safe to use from several threads.
+	class FontAtlasCache {
+	public:
+		explicit FontAtlasCache(std::filesystem::path directory);
+
+		std::optional<BakedFont> load(uint64_t key);
+		bool store(uint64_t key, const BakedFont& font);
+
+		std::filesystem::path entry_path(uint64_t key) const;
+		FontAtlasCacheStats stats() const;
+
+	private:
+		std::filesystem::path m_directory;
+		mutable std::mutex m_mutex; // guards the stats and writing entries
+		FontAtlasCacheStats m_stats;
+	};
+
+	// Loads the font at `path` from the cache, or bakes it with FreeType
+	// and stores it there on a miss. Only bakes if there's no cache.
+	std::expected<BakedFont, std::string> load_or_bake_font(
+		FontAtlasCache* cache,
+		const std::filesystem::path& path,
+		uint8_t size,
+		const FontAtlasSettings& settings = {},
+		bool latin_glyphs = false
+	);
+
+} // namespace platform
@@ -0,0 +1,158 @@
+#include <platform/graphics/font_baker.h>
+
+#include <platform/file/file.h>
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <optional>
+#include <thread>
+
+namespace platform {
+
+	struct FontFile {
+		std::filesystem::path path;
+		std::vector<uint8_t> bytes;
+	};
+
+	struct RasterizeTask {
+		size_t request_index;
+		int first_glyph;
+		int last_glyph;
+	};
+
+	// Calls `work` on `num_threads` threads, or on this one if there's
+	// only one
+	template <typename F>
+	static void run_on_threads(size_t num_threads, F&& work) {
+		if (num_threads <= 1) {
+			work();
+			return;
+		}
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < num_threads; i++) {
+			threads.emplace_back(work);
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+	}
+
+	std::vector<std::expected<FontAtlas, std::string>> bake_font_atlases(
+		const std::vector<FontBakeRequest>& requests,
+		const FontBakeSettings& settings,
+		FontBakeStats* stats
+	) {
+		std::vector<std::optional<std::string>> errors(requests.size());
+
+		/* Read files */
+		std::vector<FontFile> files;
+		std::vector<size_t> file_indices(requests.size()); // per request
+		for (size_t i = 0; i < requests.size(); i++) {
+			auto it = std::find_if(files.begin(), files.end(), [&](const FontFile& file) { return file.path == requests[i].path; });
+			if (it != files.end()) {
+				file_indices[i] = (size_t)(it - files.begin());
+				continue;
+			}
+			std::optional<std::vector<uint8_t>> bytes = read_file_bytes(requests[i].path);
+			file_indices[i] = files.size();
+			files.push_back(FontFile { .path = requests[i].path, .bytes = bytes.value_or(std::vector<uint8_t> {}) });
+		}
+		for (size_t i = 0; i < requests.size(); i++) {
+			if (files[file_indices[i]].bytes.empty()) {
+				errors[i] = std::format("Couldn't read font file \"{}\"", requests[i].path.string());
+			}
+		}
+
+		/* Split into tasks */
+		const int glyphs_per_task = std::max(settings.glyphs_per_task, 1);
+		std::vector<RasterizeTask> tasks;
+		std::vector<RasterizedFont> fonts(requests.size());
+		for (size_t i = 0; i < requests.size(); i++) {
+			if (errors[i]) {
+				continue;
+			}
+			fonts[i] = RasterizedFont { .size = requests[i].size, .glyphs = std::vector<GlyphBitmap>(Font::NUM_GLYPHS) };
+			for (int first = ' '; first < (int)Font::NUM_GLYPHS; first += glyphs_per_task) {
+				tasks.push_back(RasterizeTask {
+					.request_index = i,
+					.first_glyph = first,
+					.last_glyph = std::min(first + glyphs_per_task, (int)Font::NUM_GLYPHS),
+				});
+			}
+		}
+
+		const size_t num_threads = std::clamp<size_t>(
+			settings.num_threads > 0 ? settings.num_threads : std::thread::hardware_concurrency(),
+			1,
+			std::max<size_t>(tasks.size(), 1)
+		);
+
+		/* Rasterize */
+		// Tasks write disjoint glyphs of their font, and the first task of
+		// each font writes its line height. Errors are per task, so no two
+		// threads write the same one.
+		std::vector<std::optional<std::string>> task_errors(tasks.size());
+		std::atomic<size_t> next_task = 0;
+		run_on_threads(num_threads, [&]() {
+			FT_Library library;
+			if (FT_Error error = FT_Init_FreeType(&library); error != FT_Err_Ok) {
+				for (size_t task_index = next_task++; task_index < tasks.size(); task_index = next_task++) {
+					task_errors[task_index] = std::format("FT_Init_FreeType failed: {}", FT_Error_String(error));
+				}
+				return;
+			}
+
+			{
+				std::vector<std::optional<FontFace>> faces(files.size()); // opened when first used
+				for (size_t task_index = next_task++; task_index < tasks.size(); task_index = next_task++) {
+					const RasterizeTask& task = tasks[task_index];
+					const FontFile& file = files[file_indices[task.request_index]];
+					std::optional<FontFace>& face = faces[file_indices[task.request_index]];
+					if (!face) {
+						FT_Face ft_face;
+						if (FT_Error error = FT_New_Memory_Face(library, file.bytes.data(), (FT_Long)file.bytes.size(), 0, &ft_face); error != FT_Err_Ok) {
+							task_errors[task_index] = std::format("Couldn't load font \"{}\": {}", file.path.string(), FT_Error_String(error));
+							continue;
+						}
+						face = FontFace(ft_face);
+					}
+
+					RasterizedFont& font = fonts[task.request_index];
+					const int line_height = set_font_size(*face, requests[task.request_index].size);
+					if (task.first_glyph == ' ') {
+						font.line_height = line_height;
+					}
+					rasterize_glyphs(*face, task.first_glyph, task.last_glyph, font.glyphs.data());
+				}
+			} // faces are done before their library
+
+			FT_Done_FreeType(library);
+		});
+		for (size_t task_index = 0; task_index < tasks.size(); task_index++) {
+			if (task_errors[task_index] && !errors[tasks[task_index].request_index]) {
+				errors[tasks[task_index].request_index] = task_errors[task_index];
+			}
+		}
+
+		/* Pack */
+		std::vector<std::expected<FontAtlas, std::string>> atlases(requests.size(), std::unexpected(std::string {}));
+		std::atomic<size_t> next_request = 0;
+		run_on_threads(std::min(num_threads, std::max<size_t>(requests.size(), 1)), [&]() {
+			for (size_t i = next_request++; i < requests.size(); i = next_request++) {
+				if (errors[i]) {
+					atlases[i] = std::unexpected(*errors[i]);
+				}
+				else {
+					atlases[i] = pack_font_atlas(fonts[i], settings.atlas);
+				}
+			}
+		});
+
+		if (stats) {
+			*stats = FontBakeStats { .num_files_read = files.size(), .num_tasks = tasks.size(), .num_threads = num_threads };
+		}
+		return atlases;
+	}
+
+} // namespace platform
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <platform/graphics/font.h>
+
+#include <expected>
+#include <filesystem>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace platform {
+
+	struct FontBakeRequest {
+		std::filesystem::path path;
+		uint8_t size = 1;
+	};
+
+	struct FontBakeSettings {
+		FontAtlasSettings atlas;
+		size_t num_threads = 0; // hardware concurrency if zero
+		int glyphs_per_task = 24; // ascii glyphs rasterized by each task
+	};
+
+	struct FontBakeStats {
+		size_t num_files_read = 0;
+		size_t num_tasks = 0;
+		size_t num_threads = 0;
+	};
+
+	// Generates font atlases for several fonts and sizes on worker threads.
+	//
+	// Each font file is read once and parsed once per worker. FreeType
+	// libraries can't be shared between threads, so every worker has its
+	// own, along with faces for the files it has rasterized glyphs from.
+	// Glyph ranges of every size are rasterized in parallel, then each
+	// size's glyphs are packed into an atlas, also in parallel.
+	//
+	// Atlases are the same as generate_font_atlas would give.
+	std::vector<std::expected<FontAtlas, std::string>> bake_font_atlases(
+		const std::vector<FontBakeRequest>& requests,
+		const FontBakeSettings& settings = {},
+		FontBakeStats* stats = nullptr
+	);
+
+} // namespace platform
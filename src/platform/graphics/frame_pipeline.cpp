@@ -0,0 +1,113 @@
+#include <platform/graphics/frame_pipeline.h>
+
+#include <platform/debug/assert.h>
+#include <platform/input/timing.h>
+
+#include <utility>
+
+namespace platform {
+
+	FramePipeline::FramePipeline(IRenderExecutor* executor, size_t max_frames_in_flight)
+		: m_executor(executor)
+		, m_packets(max_frames_in_flight) {
+		ASSERT(max_frames_in_flight >= 1, "Frame pipeline needs room for at least one frame");
+		m_render_thread = std::thread([this]() { _run_render_thread(); });
+	}
+
+	FramePipeline::~FramePipeline() {
+		flush();
+
+		// Wake the render thread with one more frame, which it stops at
+		// instead of executing
+		m_is_stopping.store(true, std::memory_order_release);
+		m_num_submitted.fetch_add(1, std::memory_order_release);
+		m_num_submitted.notify_one();
+		m_render_thread.join();
+	}
+
+	void FramePipeline::execute(const ShaderProgram& shader_program, const RenderCommandList& command_list) {
+		RenderCommandList copy = command_list;
+		submit(shader_program, &copy);
+	}
+
+	void FramePipeline::submit(const ShaderProgram& shader_program, RenderCommandList* command_list) {
+		const uint64_t frame = m_num_submitted.load(std::memory_order_relaxed);
+
+		/* Wait for a free packet */
+		Timer wait_timer;
+		uint64_t num_executed = m_num_executed.load(std::memory_order_acquire);
+		while (frame - num_executed >= m_packets.size()) {
+			m_num_executed.wait(num_executed, std::memory_order_acquire);
+			num_executed = m_num_executed.load(std::memory_order_acquire);
+		}
+		m_submit_wait_ns = wait_timer.elapsed_ns();
+
+		/* Read stats */
+		// The render thread is at most on the frames after the last executed
+		// one, which don't reuse its packet before this one is handed over
+		if (num_executed > 0) {
+			m_vertex_stream_stats = m_packets[(num_executed - 1) % m_packets.size()].vertex_stream;
+		}
+
+		/* Hand over packet */
+		// The caller gets the executed frame's list back, to reuse its memory
+		FramePacket& packet = m_packets[frame % m_packets.size()];
+		packet.shader_program = shader_program;
+		std::swap(packet.command_list, *command_list);
+		m_num_submitted.store(frame + 1, std::memory_order_release);
+		m_num_submitted.notify_one();
+	}
+
+	void FramePipeline::flush() {
+		const uint64_t num_submitted = m_num_submitted.load(std::memory_order_relaxed);
+		uint64_t num_executed = m_num_executed.load(std::memory_order_acquire);
+		while (num_executed < num_submitted) {
+			m_num_executed.wait(num_executed, std::memory_order_acquire);
+			num_executed = m_num_executed.load(std::memory_order_acquire);
+		}
+	}
+
+	StreamingBufferStats FramePipeline::vertex_stream_stats() const {
+		return m_vertex_stream_stats;
+	}
+
+	size_t FramePipeline::max_frames_in_flight() const {
+		return m_packets.size();
+	}
+
+	FramePipelineStats FramePipeline::stats() const {
+		return FramePipelineStats {
+			.submit_wait_ns = m_submit_wait_ns,
+			.idle_ns = m_idle_ns.load(std::memory_order_relaxed),
+			.execute_ns = m_execute_ns.load(std::memory_order_relaxed),
+			.num_executed_frames = (size_t)m_num_executed.load(std::memory_order_acquire),
+		};
+	}
+
+	void FramePipeline::_run_render_thread() {
+		for (uint64_t frame = 0;; frame++) {
+			/* Wait for frame */
+			Timer idle_timer;
+			uint64_t num_submitted = m_num_submitted.load(std::memory_order_acquire);
+			while (num_submitted == frame) {
+				m_num_submitted.wait(num_submitted, std::memory_order_acquire);
+				num_submitted = m_num_submitted.load(std::memory_order_acquire);
+			}
+			if (m_is_stopping.load(std::memory_order_acquire)) {
+				return;
+			}
+			m_idle_ns.store(idle_timer.elapsed_ns(), std::memory_order_relaxed);
+
+			/* Execute frame */
+			Timer execute_timer;
+			FramePacket& packet = m_packets[frame % m_packets.size()];
+			m_executor->execute(packet.shader_program, packet.command_list);
+			packet.vertex_stream = m_executor->vertex_stream_stats();
+			m_execute_ns.store(execute_timer.elapsed_ns(), std::memory_order_relaxed);
+
+			m_num_executed.store(frame + 1, std::memory_order_release);
+			m_num_executed.notify_one();
+		}
+	}
+
+} // namespace platform
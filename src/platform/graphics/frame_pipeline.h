@@ -0,0 +1,75 @@
+#pragma once
+
+#include <platform/graphics/render_command.h>
+#include <platform/graphics/render_executor.h>
+#include <platform/graphics/shader_program.h>
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace platform {
+
+	struct FramePipelineStats {
+		uint64_t submit_wait_ns = 0; // last submit blocked on a full pipeline
+		uint64_t idle_ns = 0; // render thread waiting for the last executed frame
+		uint64_t execute_ns = 0; // render thread executing the last executed frame
+		size_t num_executed_frames = 0;
+	};
+
+	// Executes command lists on a render thread, so the next frame can be
+	// recorded while the last one is drawn.
+	//
+	// Submitted command lists are swapped into one of `max_frames_in_flight`
+	// frame packets, which the render thread hands to the wrapped executor
+	// in order. The packets are handed over with a pair of atomic counters,
+	// without locks. Submitting blocks while `max_frames_in_flight` frames
+	// are waiting or executing, which bounds the latency from recording a
+	// frame to drawing it.
+	//
+	// The wrapped executor only runs on the render thread, so an OpenGL
+	// context it draws with must be current there and not on the thread
+	// recording frames. Its vertex stream stats are read on the render
+	// thread after each frame and reported from the next submit.
+	class FramePipeline : public IRenderExecutor {
+	public:
+		explicit FramePipeline(IRenderExecutor* executor, size_t max_frames_in_flight = 1);
+		~FramePipeline();
+		FramePipeline(const FramePipeline&) = delete;
+		FramePipeline& operator=(const FramePipeline&) = delete;
+
+		// Copies the command list, use submit to avoid the copy
+		void execute(const ShaderProgram& shader_program, const RenderCommandList& command_list) override;
+		void submit(const ShaderProgram& shader_program, RenderCommandList* command_list) override;
+		StreamingBufferStats vertex_stream_stats() const override;
+
+		// Blocks until every submitted frame has been executed
+		void flush();
+
+		size_t max_frames_in_flight() const;
+		FramePipelineStats stats() const;
+
+	private:
+		struct FramePacket {
+			ShaderProgram shader_program;
+			RenderCommandList command_list;
+			StreamingBufferStats vertex_stream; // written by the render thread after executing
+		};
+
+		void _run_render_thread();
+
+		IRenderExecutor* m_executor;
+		std::vector<FramePacket> m_packets;
+		std::atomic<uint64_t> m_num_submitted = 0; // written by the submitting thread
+		std::atomic<uint64_t> m_num_executed = 0; // written by the render thread
+		std::atomic<bool> m_is_stopping = false;
+		std::atomic<uint64_t> m_idle_ns = 0;
+		std::atomic<uint64_t> m_execute_ns = 0;
+		uint64_t m_submit_wait_ns = 0;
+		StreamingBufferStats m_vertex_stream_stats; // of the last frame executed before the last submit
+		std::thread m_render_thread;
+	};
+
+} // namespace platform
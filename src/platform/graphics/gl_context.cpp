@@ -6,8 +6,66 @@
 #include <platform/debug/logging.h>
 #include <platform/graphics/vertex.h>
 
+#include <string.h>
+
 namespace platform {
 
+	class GLStreamingBufferBackend : public IStreamingBufferBackend {
+	public:
+		~GLStreamingBufferBackend() {
+			_free_buffer();
+		}
+
+		void resize(size_t capacity) override {
+			_free_buffer();
+
+			// Persistently mapped, so writes don't need to map/unmap or
+			// reallocate driver storage each frame
+			const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glCreateBuffers(1, &m_buffer);
+			glNamedBufferStorage(m_buffer, capacity, nullptr, flags);
+			m_mapped = (unsigned char*)glMapNamedBufferRange(m_buffer, 0, capacity, flags);
+		}
+
+		void write(size_t offset, const void* data, size_t size) override {
+			memcpy(m_mapped + offset, data, size);
+		}
+
+		uint64_t insert_fence() override {
+			return (uint64_t)(uintptr_t)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		void wait_fence(uint64_t fence) override {
+			GLsync sync = (GLsync)(uintptr_t)fence;
+			const GLuint64 timeout_ns = 1000000;
+			GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_ns);
+			while (result == GL_TIMEOUT_EXPIRED) {
+				result = glClientWaitSync(sync, 0, timeout_ns);
+			}
+			if (result == GL_WAIT_FAILED) {
+				LOG_ERROR("glClientWaitSync failed");
+			}
+			glDeleteSync(sync);
+		}
+
+		GLuint buffer() const {
+			return m_buffer;
+		}
+
+	private:
+		void _free_buffer() {
+			if (m_buffer) {
+				glUnmapNamedBuffer(m_buffer);
+				glDeleteBuffers(1, &m_buffer);
+				m_buffer = 0;
+				m_mapped = nullptr;
+			}
+		}
+
+		GLuint m_buffer = 0;
+		unsigned char* m_mapped = nullptr;
+	};
+
 	static int _wrapping_mode_to_gl_int(TextureWrapping wrapping) {
 		switch (wrapping) {
 			case TextureWrapping::Repeat:
@@ -58,6 +116,13 @@ namespace platform {
 		return texture;
 	}
 
+	void OpenGLContext::update_texture(Texture texture, glm::ivec2 pos, glm::ivec2 size, const unsigned char* data) {
+		glBindTexture(GL_TEXTURE_2D, texture.id);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, data);
+		glBindTexture(GL_TEXTURE_2D, NULL);
+	}
+
 	void OpenGLContext::set_texture_wrapping(Texture texture, TextureWrapping wrapping) {
 		const int wrapping_int = _wrapping_mode_to_gl_int(wrapping);
 		glBindTexture(GL_TEXTURE_2D, texture.id);
@@ -117,7 +182,13 @@ namespace platform {
 		glDeleteTextures(1, &canvas.texture.id);
 	}
 
-	std::expected<ShaderProgram, ShaderProgramError> OpenGLContext::add_shader_program(const char* vertex_src, const char* fragment_src) {
+	static void set_vertex_attribute(GLuint vao, GLuint index, GLint size, GLenum type, GLboolean normalized, size_t offset) {
+		glVertexArrayAttribFormat(vao, index, size, type, normalized, (GLuint)offset);
+		glVertexArrayAttribBinding(vao, index, 0);
+		glEnableVertexArrayAttrib(vao, index);
+	}
+
+	static std::expected<GLuint, ShaderProgramError> link_shader_program(const char* vertex_src, const char* fragment_src) {
 		GLuint shader_program_id = glCreateProgram();
 		GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
 		GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
@@ -161,70 +232,272 @@ namespace platform {
 		}
 		glDeleteShader(vertex_shader);
 		glDeleteShader(fragment_shader);
+		return shader_program_id;
+	}
 
-		/* Create VAO and VBO */
-		GLuint vao = 0;
-		GLuint vbo = 0;
-		glGenVertexArrays(1, &vao);
-		glGenBuffers(1, &vbo);
+	std::expected<ShaderProgram, ShaderProgramError> OpenGLContext::add_shader_program(const char* vertex_src, const char* fragment_src, VertexFormat vertex_format) {
+		std::expected<GLuint, ShaderProgramError> linked = link_shader_program(vertex_src, fragment_src);
+		if (!linked) {
+			return std::unexpected(linked.error());
+		}
+		const GLuint shader_program_id = linked.value();
 
-		glBindVertexArray(vao);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		/* Create VAO */
+		// The vertex buffer is bound when uploading, see _stream_vertices
+		GLuint vao = 0;
+		glCreateVertexArrays(1, &vao);
 
 		/* Configure vertex attributes */
-		// position
-		glVertexAttribPointer(
-			0,
-			sizeof(Vertex::pos) / sizeof(float),
-			GL_FLOAT,
-			GL_FALSE,
-			sizeof(Vertex),
-			(void*)(0)
-		);
-		glEnableVertexAttribArray(0);
-		// color
-		glVertexAttribPointer(
-			1,
-			sizeof(Vertex::color) / sizeof(float),
-			GL_FLOAT,
-			GL_FALSE,
-			sizeof(Vertex),
-			(void*)(sizeof(Vertex::pos))
-		);
-		glEnableVertexAttribArray(1);
-		// texture coordinates
-		glVertexAttribPointer(
-			2,
-			sizeof(Vertex::uv) / sizeof(float),
-			GL_FLOAT,
-			GL_FALSE,
-			sizeof(Vertex),
-			(void*)(sizeof(Vertex::pos) + sizeof(Vertex::color))
-		);
-		glEnableVertexAttribArray(2);
+		switch (vertex_format) {
+			case VertexFormat::Standard:
+				set_vertex_attribute(vao, 0, sizeof(Vertex::pos) / sizeof(float), GL_FLOAT, GL_FALSE, offsetof(Vertex, pos));
+				set_vertex_attribute(vao, 1, sizeof(Vertex::color) / sizeof(float), GL_FLOAT, GL_FALSE, offsetof(Vertex, color));
+				set_vertex_attribute(vao, 2, sizeof(Vertex::uv) / sizeof(float), GL_FLOAT, GL_FALSE, offsetof(Vertex, uv));
+				break;
+
+			case VertexFormat::Packed:
+				set_vertex_attribute(vao, 0, sizeof(PackedVertex::pos) / sizeof(float), GL_FLOAT, GL_FALSE, offsetof(PackedVertex, pos));
+				// color, normalized from RGBA8
+				set_vertex_attribute(vao, 1, sizeof(PackedVertex::color), GL_UNSIGNED_BYTE, GL_TRUE, offsetof(PackedVertex, color));
+				// texture coordinates, normalized from 16-bit
+				set_vertex_attribute(vao, 2, sizeof(PackedVertex::uv) / sizeof(uint16_t), GL_UNSIGNED_SHORT, GL_TRUE, offsetof(PackedVertex, uv));
+				break;
+		}
 
 		/* Load locations */
 		GLint projection_uniform = glGetUniformLocation(shader_program_id, "projection");
+		GLint uv_scale_uniform = glGetUniformLocation(shader_program_id, "uv_scale");
+		GLint distance_field_uniform = glGetUniformLocation(shader_program_id, "distance_field");
 
 		/* Unbind */
 		glUseProgram(NULL);
-		glBindBuffer(GL_ARRAY_BUFFER, NULL);
-		glBindVertexArray(NULL);
 
 		return ShaderProgram {
 			.id = shader_program_id,
 			.vao = vao,
-			.vbo = vbo,
+			.vertex_format = vertex_format,
+			.uniforms {
+				.projection = projection_uniform,
+				.uv_scale = uv_scale_uniform,
+				.distance_field = distance_field_uniform,
+			},
+		};
+	}
+
+	std::expected<QuadInstanceProgram, ShaderProgramError> OpenGLContext::add_quad_instance_program(const char* vertex_src, const char* fragment_src) {
+		std::expected<GLuint, ShaderProgramError> linked = link_shader_program(vertex_src, fragment_src);
+		if (!linked) {
+			return std::unexpected(linked.error());
+		}
+		const GLuint shader_program_id = linked.value();
+
+		/* Create VAO */
+		// One QuadInstance per instance, the corners come from gl_VertexID
+		GLuint vao = 0;
+		glCreateVertexArrays(1, &vao);
+		glVertexArrayBindingDivisor(vao, 0, 1);
+
+		/* Configure instance attributes */
+		// corners 0 and 3
+		set_vertex_attribute(vao, 0, 4, GL_FLOAT, GL_FALSE, offsetof(QuadInstance, pos0));
+		// texture coordinates of corners 0 and 3, normalized from 16-bit
+		set_vertex_attribute(vao, 1, 4, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(QuadInstance, uv));
+		// color, normalized from RGBA8
+		set_vertex_attribute(vao, 2, sizeof(QuadInstance::color), GL_UNSIGNED_BYTE, GL_TRUE, offsetof(QuadInstance, color));
+
+		/* Load locations */
+		GLint projection_uniform = glGetUniformLocation(shader_program_id, "projection");
+		GLint uv_scale_uniform = glGetUniformLocation(shader_program_id, "uv_scale");
+		GLint distance_field_uniform = glGetUniformLocation(shader_program_id, "distance_field");
+
+		/* Unbind */
+		glUseProgram(NULL);
+
+		return QuadInstanceProgram {
+			.id = shader_program_id,
+			.vao = vao,
 			.uniforms {
 				.projection = projection_uniform,
+				.uv_scale = uv_scale_uniform,
+				.distance_field = distance_field_uniform,
 			},
 		};
 	}
 
 	void OpenGLContext::free_shader_program(const ShaderProgram& shader_program) {
+		if (shader_program.quad_instances) {
+			glDeleteVertexArrays(1, &shader_program.quad_instances->vao);
+			glDeleteProgram(shader_program.quad_instances->id);
+		}
 		glDeleteVertexArrays(1, &shader_program.vao);
-		glDeleteBuffers(1, &shader_program.vbo);
 		glDeleteProgram(shader_program.id);
 	}
 
+	IndexBuffer OpenGLContext::add_index_buffer(const std::vector<uint32_t>& indices) {
+		// element array bindings are part of the VAO state, so use DSA to
+		// avoid touching whatever VAO is currently bound
+		GLuint buffer_id;
+		glCreateBuffers(1, &buffer_id);
+		glNamedBufferData(buffer_id, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+		return IndexBuffer { buffer_id, indices.size() };
+	}
+
+	void OpenGLContext::free_index_buffer(IndexBuffer index_buffer) {
+		glDeleteBuffers(1, &index_buffer.id);
+	}
+
+	static VertexBuffer add_static_vertex_buffer(const void* data, size_t num_vertices, size_t stride, VertexFormat vertex_format) {
+		GLuint buffer_id;
+		glCreateBuffers(1, &buffer_id);
+		glNamedBufferData(buffer_id, num_vertices * stride, data, GL_STATIC_DRAW);
+		return VertexBuffer { .id = buffer_id, .num_vertices = num_vertices, .vertex_format = vertex_format };
+	}
+
+	VertexBuffer OpenGLContext::add_vertex_buffer(const std::vector<Vertex>& vertices) {
+		return add_static_vertex_buffer(vertices.data(), vertices.size(), sizeof(Vertex), VertexFormat::Standard);
+	}
+
+	VertexBuffer OpenGLContext::add_packed_vertex_buffer(const std::vector<PackedVertex>& vertices) {
+		return add_static_vertex_buffer(vertices.data(), vertices.size(), sizeof(PackedVertex), VertexFormat::Packed);
+	}
+
+	void OpenGLContext::free_vertex_buffer(VertexBuffer vertex_buffer) {
+		glDeleteBuffers(1, &vertex_buffer.id);
+	}
+
+	void OpenGLContext::bind_shader_program(const ShaderProgram& shader_program) {
+		glUseProgram(shader_program.id);
+		glBindVertexArray(shader_program.vao);
+	}
+
+	void OpenGLContext::unbind_shader_program() {
+		glBindVertexArray(NULL);
+		glUseProgram(NULL);
+	}
+
+	void OpenGLContext::set_projection(const ShaderProgram& shader_program, glm::mat4 projection) {
+		glUseProgram(shader_program.id);
+		glUniformMatrix4fv(shader_program.uniforms.projection, 1, GL_FALSE, &projection[0][0]);
+		if (shader_program.quad_instances) {
+			const QuadInstanceProgram& quad_instances = shader_program.quad_instances.value();
+			glProgramUniformMatrix4fv(quad_instances.id, quad_instances.uniforms.projection, 1, GL_FALSE, &projection[0][0]);
+		}
+	}
+
+	void OpenGLContext::reserve_vertex_stream(size_t size) {
+		_vertex_stream()->reserve(size);
+	}
+
+	void OpenGLContext::upload_vertices(const ShaderProgram& shader_program, const std::vector<Vertex>& vertices) {
+		m_streamed_vertices = _stream_vertices(shader_program.vao, vertices.data(), vertices.size() * sizeof(Vertex), sizeof(Vertex));
+	}
+
+	void OpenGLContext::upload_packed_vertices(const ShaderProgram& shader_program, const std::vector<PackedVertex>& vertices) {
+		m_streamed_vertices = _stream_vertices(shader_program.vao, vertices.data(), vertices.size() * sizeof(PackedVertex), sizeof(PackedVertex));
+	}
+
+	void OpenGLContext::upload_quad_instances(const ShaderProgram& shader_program, const std::vector<QuadInstance>& instances) {
+		ASSERT(shader_program.quad_instances, "Uploading quad instances for a shader program without a quad instance program");
+		const VertexBinding binding = _stream_vertices(shader_program.quad_instances->vao, instances.data(), instances.size() * sizeof(QuadInstance), sizeof(QuadInstance));
+		// a push that grew the stream deleted the buffer the vertices were
+		// in, so never bind its name again. Reserving the frame's range up
+		// front keeps this from happening between uploads and draws.
+		if (binding.buffer != m_streamed_vertices.buffer) {
+			m_streamed_vertices = VertexBinding { .buffer = binding.buffer, .offset = 0, .stride = m_streamed_vertices.stride };
+		}
+	}
+
+	void OpenGLContext::bind_vertex_buffer(const ShaderProgram& shader_program, VertexBuffer vertex_buffer) {
+		ASSERT(vertex_buffer.vertex_format == shader_program.vertex_format, "Vertex buffer format does not match shader program");
+		const GLsizei stride = vertex_buffer.vertex_format == VertexFormat::Standard ? sizeof(Vertex) : sizeof(PackedVertex);
+		glVertexArrayVertexBuffer(shader_program.vao, 0, vertex_buffer.id, 0, stride);
+	}
+
+	void OpenGLContext::bind_streamed_vertices(const ShaderProgram& shader_program) {
+		glVertexArrayVertexBuffer(shader_program.vao, 0, m_streamed_vertices.buffer, m_streamed_vertices.offset, m_streamed_vertices.stride);
+	}
+
+	void OpenGLContext::fence_vertices() {
+		if (m_vertex_stream) {
+			m_vertex_stream->fence();
+		}
+	}
+
+	StreamingBufferStats OpenGLContext::vertex_stream_stats() const {
+		return m_vertex_stream ? m_vertex_stream->stats() : StreamingBufferStats {};
+	}
+
+	void OpenGLContext::set_uv_scale(const ShaderProgram& shader_program, float uv_scale) {
+		glUniform1f(shader_program.uniforms.uv_scale, uv_scale);
+	}
+
+	void OpenGLContext::set_distance_field(const ShaderProgram& shader_program, bool enabled) {
+		glUniform1i(shader_program.uniforms.distance_field, enabled);
+		if (shader_program.quad_instances) {
+			glProgramUniform1i(shader_program.quad_instances->id, shader_program.quad_instances->uniforms.distance_field, enabled);
+		}
+	}
+
+	void OpenGLContext::bind_texture(Texture texture) {
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, texture.id);
+	}
+
+	void OpenGLContext::bind_canvas(Canvas canvas) {
+		glBindFramebuffer(GL_FRAMEBUFFER, canvas.framebuffer);
+		glViewport(0, 0, (int)canvas.texture.size.x, (int)canvas.texture.size.y);
+	}
+
+	void OpenGLContext::unbind_canvas() {
+		glBindFramebuffer(GL_FRAMEBUFFER, NULL);
+	}
+
+	void OpenGLContext::set_scissor(ScissorRect rect) {
+		glEnable(GL_SCISSOR_TEST);
+		glScissor(rect.pos.x, rect.pos.y, rect.size.x, rect.size.y);
+	}
+
+	void OpenGLContext::disable_scissor() {
+		glDisable(GL_SCISSOR_TEST);
+	}
+
+	void OpenGLContext::draw_arrays(GLenum mode, GLint first, GLsizei count) {
+		glDrawArrays(mode, first, count);
+	}
+
+	void OpenGLContext::draw_elements(GLenum mode, IndexBuffer index_buffer, GLsizei count, GLint base_vertex) {
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer.id);
+		glDrawElementsBaseVertex(mode, count, GL_UNSIGNED_INT, (void*)0, base_vertex);
+	}
+
+	void OpenGLContext::draw_quad_instances(const ShaderProgram& shader_program, GLint first, GLsizei count, float uv_scale) {
+		// Switch to the instance program for the draw, then back so that the
+		// next vertex draw doesn't need to rebind
+		const QuadInstanceProgram& quad_instances = shader_program.quad_instances.value();
+		glUseProgram(quad_instances.id);
+		glBindVertexArray(quad_instances.vao);
+		glUniform1f(quad_instances.uniforms.uv_scale, uv_scale);
+		glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, count, (GLuint)first);
+		glUseProgram(shader_program.id);
+		glBindVertexArray(shader_program.vao);
+	}
+
+	StreamingBuffer* OpenGLContext::_vertex_stream() {
+		if (!m_vertex_stream) {
+			const size_t num_frames = 3;
+			const size_t initial_frame_capacity = 1024 * 1024;
+			m_vertex_stream_backend = std::make_unique<GLStreamingBufferBackend>();
+			m_vertex_stream.emplace(m_vertex_stream_backend.get(), num_frames, initial_frame_capacity);
+		}
+		return &m_vertex_stream.value();
+	}
+
+	OpenGLContext::VertexBinding OpenGLContext::_stream_vertices(GLuint vao, const void* data, size_t size, size_t stride) {
+		// Align to the vertex stride so the offset is a whole number of vertices
+		const size_t offset = _vertex_stream()->push(data, size, stride);
+		const GLuint buffer = static_cast<GLStreamingBufferBackend*>(m_vertex_stream_backend.get())->buffer();
+		glVertexArrayVertexBuffer(vao, 0, buffer, offset, (GLsizei)stride);
+		return VertexBinding { .buffer = buffer, .offset = offset, .stride = (GLsizei)stride };
+	}
+
 } // namespace platform
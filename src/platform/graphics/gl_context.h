@@ -1,10 +1,21 @@
 #pragma once
 
 #include <platform/graphics/canvas.h>
+#include <platform/graphics/index_buffer.h>
+#include <platform/graphics/scissor_rect.h>
 #include <platform/graphics/shader_program.h>
+#include <platform/graphics/streaming_buffer.h>
 #include <platform/graphics/texture.h>
+#include <platform/graphics/vertex.h>
+#include <platform/graphics/vertex_buffer.h>
+
+#include <glm/glm.hpp>
 
 #include <expected>
+#include <memory>
+#include <optional>
+#include <stdint.h>
+#include <vector>
 
 typedef void* SDL_GLContext; // from SDL_video.h
 
@@ -29,6 +40,9 @@ namespace platform {
 			TextureWrapping wrapping = TextureWrapping::ClampToEdge,
 			TextureFilter filter = TextureFilter::Nearest
 		);
+		// Replaces the RGBA pixels of the `size` region at `pos`, with rows
+		// from the bottom like add_texture
+		virtual void update_texture(Texture texture, glm::ivec2 pos, glm::ivec2 size, const unsigned char* data);
 		virtual void set_texture_wrapping(Texture texture, TextureWrapping wrapping);
 		virtual void set_texture_filter(Texture texture, TextureFilter filter);
 		virtual void free_texture(Texture texture);
@@ -36,8 +50,59 @@ namespace platform {
 		virtual Canvas add_canvas(int width, int height, TextureWrapping wrapping = TextureWrapping::ClampToEdge, TextureFilter filter = TextureFilter::Nearest);
 		virtual void free_canvas(Canvas canvas);
 
-		virtual std::expected<ShaderProgram, ShaderProgramError> add_shader_program(const char* vertex_src, const char* fragment_src);
+		virtual std::expected<ShaderProgram, ShaderProgramError> add_shader_program(const char* vertex_src, const char* fragment_src, VertexFormat vertex_format = VertexFormat::Standard);
+		// Set as `ShaderProgram::quad_instances` to draw with QuadMode::Instanced
+		virtual std::expected<QuadInstanceProgram, ShaderProgramError> add_quad_instance_program(const char* vertex_src, const char* fragment_src);
 		virtual void free_shader_program(const ShaderProgram& shader_program);
+
+		virtual IndexBuffer add_index_buffer(const std::vector<uint32_t>& indices);
+		virtual void free_index_buffer(IndexBuffer index_buffer);
+
+		virtual VertexBuffer add_vertex_buffer(const std::vector<Vertex>& vertices);
+		virtual VertexBuffer add_packed_vertex_buffer(const std::vector<PackedVertex>& vertices);
+		virtual void free_vertex_buffer(VertexBuffer vertex_buffer);
+
+		virtual void bind_shader_program(const ShaderProgram& shader_program);
+		virtual void unbind_shader_program();
+		virtual void set_projection(const ShaderProgram& shader_program, glm::mat4 projection);
+		// Makes room for the uploads of one frame, `size` bytes plus a stride
+		// per upload, so that no upload moves or overwrites an earlier one
+		// before it's drawn
+		virtual void reserve_vertex_stream(size_t size);
+		virtual void upload_vertices(const ShaderProgram& shader_program, const std::vector<Vertex>& vertices);
+		virtual void upload_packed_vertices(const ShaderProgram& shader_program, const std::vector<PackedVertex>& vertices);
+		virtual void upload_quad_instances(const ShaderProgram& shader_program, const std::vector<QuadInstance>& instances);
+		// Draws read from `vertex_buffer` until the streamed vertices are bound again
+		virtual void bind_vertex_buffer(const ShaderProgram& shader_program, VertexBuffer vertex_buffer);
+		virtual void bind_streamed_vertices(const ShaderProgram& shader_program);
+		virtual void fence_vertices();
+		virtual StreamingBufferStats vertex_stream_stats() const;
+		virtual void set_uv_scale(const ShaderProgram& shader_program, float uv_scale);
+		// Also sets it for the quad instance program
+		virtual void set_distance_field(const ShaderProgram& shader_program, bool enabled);
+		virtual void bind_texture(Texture texture);
+		virtual void bind_canvas(Canvas canvas);
+		virtual void unbind_canvas();
+		virtual void set_scissor(ScissorRect rect);
+		virtual void disable_scissor();
+		virtual void draw_arrays(GLenum mode, GLint first, GLsizei count);
+		virtual void draw_elements(GLenum mode, IndexBuffer index_buffer, GLsizei count, GLint base_vertex);
+		virtual void draw_quad_instances(const ShaderProgram& shader_program, GLint first, GLsizei count, float uv_scale);
+
+	private:
+		struct VertexBinding {
+			GLuint buffer;
+			size_t offset;
+			GLsizei stride;
+		};
+
+		StreamingBuffer* _vertex_stream();
+		VertexBinding _stream_vertices(GLuint vao, const void* data, size_t size, size_t stride);
+
+		// created on first upload, so that nothing is allocated when mocked
+		std::unique_ptr<IStreamingBufferBackend> m_vertex_stream_backend;
+		std::optional<StreamingBuffer> m_vertex_stream;
+		VertexBinding m_streamed_vertices = {}; // last vertex upload, bound again after drawing a vertex buffer
 	};
 
 } // namespace platform
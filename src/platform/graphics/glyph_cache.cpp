@@ -0,0 +1,198 @@
+#include <platform/graphics/glyph_cache.h>
+
+#include <platform/debug/assert.h>
+#include <platform/graphics/gl_context.h>
+
+#include <string.h>
+
+namespace platform {
+
+	constexpr int GLYPH_PADDING = 1; // keeps filtering from sampling neighbouring glyphs
+
+	std::optional<CachedGlyph> find_glyph(const Font& font, char32_t codepoint, bool* is_missed) {
+		if (is_missed) {
+			*is_missed = false;
+		}
+		if (codepoint < Font::NUM_GLYPHS) {
+			return CachedGlyph { .glyph = font.glyphs[codepoint], .texture = font.atlas };
+		}
+		if (!font.glyph_cache) {
+			return {};
+		}
+		return font.glyph_cache->glyph(codepoint, is_missed);
+	}
+
+	// Empty if FreeType can't load the glyph
+	static std::optional<GlyphBitmap> rasterize_glyph(const FontFace& face, char32_t codepoint) {
+		constexpr int pixels_per_point = 64;
+		if (FT_Load_Char(face.get(), codepoint, FT_LOAD_RENDER) != FT_Err_Ok) {
+			return {};
+		}
+		const FT_GlyphSlot slot = face->glyph;
+		const FT_Bitmap& bmp = slot->bitmap;
+		GlyphBitmap bitmap = {
+			.glyph = Glyph {
+				.atlas_pos = { 0, 0 },
+				.size = { (int)bmp.width, (int)bmp.rows },
+				.bearing = { slot->bitmap_left, slot->bitmap_top },
+				.advance = (int)(slot->advance.x / pixels_per_point),
+			},
+			.coverage = std::vector<uint8_t>((size_t)bmp.width * bmp.rows),
+		};
+		for (uint32_t row = 0; row < bmp.rows; row++) {
+			memcpy(bitmap.coverage.data() + (size_t)row * bmp.width, bmp.buffer + (ptrdiff_t)row * bmp.pitch, bmp.width);
+		}
+		return bitmap;
+	}
+
+	std::vector<GlyphBitmap> rasterize_latin_glyphs(const FontFace& face, uint8_t size) {
+		set_font_size(face, size);
+		std::vector<GlyphBitmap> glyphs(GlyphCache::LATIN_END - GlyphCache::LATIN_FIRST);
+		for (char32_t codepoint = GlyphCache::LATIN_FIRST; codepoint < GlyphCache::LATIN_END; codepoint++) {
+			glyphs[codepoint - GlyphCache::LATIN_FIRST] = rasterize_glyph(face, codepoint).value_or(GlyphBitmap {});
+		}
+		return glyphs;
+	}
+
+	GlyphCache::GlyphCache(OpenGLContext* gl_context, FontFace face, uint8_t size, int page_size)
+		: GlyphCache(gl_context, std::filesystem::path(), size, rasterize_latin_glyphs(face, size), page_size) {
+		m_face = std::move(face);
+	}
+
+	GlyphCache::GlyphCache(OpenGLContext* gl_context, std::filesystem::path font_path, uint8_t size, const std::vector<GlyphBitmap>& latin_glyphs, int page_size)
+		: m_gl_context(gl_context)
+		, m_size(size)
+		, m_page_size(page_size)
+		, m_owner_thread(std::this_thread::get_id())
+		, m_font_path(std::move(font_path)) {
+		ASSERT(latin_glyphs.size() == m_latin_glyphs.size(), "Expected a glyph per Latin-1 codepoint");
+		std::lock_guard lock(m_mutex);
+		for (size_t i = 0; i < m_latin_glyphs.size(); i++) {
+			m_latin_glyphs[i] = _pack_glyph(latin_glyphs[i]).value_or(CachedGlyph {});
+		}
+	}
+
+	std::optional<CachedGlyph> GlyphCache::glyph(char32_t codepoint, bool* is_missed) {
+		if (is_missed) {
+			*is_missed = false;
+		}
+		if (codepoint >= LATIN_FIRST && codepoint < LATIN_END) {
+			return m_latin_glyphs[codepoint - LATIN_FIRST];
+		}
+
+		std::lock_guard lock(m_mutex);
+		if (auto it = m_glyphs.find(codepoint); it != m_glyphs.end()) {
+			return it->second;
+		}
+		if (m_missing_glyphs.contains(codepoint)) {
+			return {};
+		}
+		if (std::this_thread::get_id() != m_owner_thread) {
+			m_stats.num_missed_off_thread += 1;
+			if (is_missed) {
+				*is_missed = true;
+			}
+			return {};
+		}
+		std::optional<CachedGlyph> cached_glyph = _add_glyph(codepoint);
+		if (cached_glyph) {
+			m_glyphs[codepoint] = *cached_glyph;
+		}
+		else {
+			m_missing_glyphs.insert(codepoint);
+		}
+		return cached_glyph;
+	}
+
+	GlyphCacheStats GlyphCache::stats() const {
+		std::lock_guard lock(m_mutex);
+		GlyphCacheStats stats = m_stats;
+		stats.num_glyphs = m_glyphs.size();
+		stats.num_pages = m_pages.size();
+		return stats;
+	}
+
+	void GlyphCache::free_pages(OpenGLContext* gl_context) {
+		std::lock_guard lock(m_mutex);
+		for (const Page& page : m_pages) {
+			gl_context->free_texture(page.texture);
+		}
+		m_pages.clear();
+		m_glyphs.clear();
+		m_missing_glyphs.clear();
+	}
+
+	// Opens the font file if there's no face yet. Called with the mutex
+	// locked.
+	FontFace* GlyphCache::_face() {
+		if (!m_face && !m_font_path.empty()) {
+			std::expected<FontFace, std::string> face = load_font_face(m_font_path);
+			if (face.has_value()) {
+				set_font_size(face.value(), m_size);
+				m_face = std::move(face.value());
+			}
+			else {
+				m_font_path.clear();
+			}
+		}
+		return m_face ? &m_face.value() : nullptr;
+	}
+
+	// Called with the mutex locked
+	std::optional<CachedGlyph> GlyphCache::_add_glyph(char32_t codepoint) {
+		FontFace* face = _face();
+		if (!face) {
+			return {};
+		}
+		std::optional<GlyphBitmap> bitmap = rasterize_glyph(*face, codepoint);
+		if (!bitmap) {
+			return {};
+		}
+		return _pack_glyph(*bitmap);
+	}
+
+	// Packs the glyph into a page, adding a page if it doesn't fit in the
+	// last one. Called with the mutex locked.
+	std::optional<CachedGlyph> GlyphCache::_pack_glyph(const GlyphBitmap& bitmap) {
+		const glm::ivec2 size = bitmap.glyph.size;
+		if (size.x + GLYPH_PADDING > m_page_size || size.y + GLYPH_PADDING > m_page_size) {
+			return {};
+		}
+
+		/* Pack */
+		std::optional<glm::ivec2> pos;
+		if (!m_pages.empty()) {
+			pos = m_pages.back().packer.pack(size + GLYPH_PADDING);
+		}
+		if (!pos) {
+			const std::vector<RGBA> empty_pixels((size_t)m_page_size * m_page_size, RGBA { 0xFF, 0xFF, 0xFF, 0x00 });
+			m_pages.push_back(Page {
+				.texture = m_gl_context->add_texture((const unsigned char*)empty_pixels.data(), m_page_size, m_page_size),
+				.packer = core::SkylinePacker(glm::ivec2 { m_page_size, m_page_size }),
+			});
+			pos = m_pages.back().packer.pack(size + GLYPH_PADDING);
+		}
+		const Page& page = m_pages.back();
+
+		/* Update page */
+		// page rows are flipped like font atlases, the bottom glyph row
+		// goes first
+		if (size.x > 0 && size.y > 0) {
+			m_upload_pixels.resize((size_t)size.x * size.y);
+			for (int row = 0; row < size.y; row++) {
+				const int flipped_row = size.y - 1 - row;
+				for (int col = 0; col < size.x; col++) {
+					m_upload_pixels[(size_t)flipped_row * size.x + col] = glyph_pixel(bitmap.coverage[(size_t)row * size.x + col]);
+				}
+			}
+			const glm::ivec2 update_pos = { pos->x, m_page_size - pos->y - size.y };
+			m_gl_context->update_texture(page.texture, update_pos, size, (const unsigned char*)m_upload_pixels.data());
+			m_stats.num_page_updates += 1;
+		}
+
+		Glyph glyph = bitmap.glyph;
+		glyph.atlas_pos = *pos;
+		return CachedGlyph { .glyph = glyph, .texture = page.texture };
+	}
+
+} // namespace platform
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <core/skyline_packer.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/texture.h>
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace platform {
+
+	class OpenGLContext;
+
+	struct CachedGlyph {
+		Glyph glyph; // atlas_pos is within `texture`
+		Texture texture; // atlas page the glyph is packed in
+	};
+
+	struct GlyphCacheStats {
+		size_t num_glyphs = 0; // added on demand, not counting Latin-1
+		size_t num_pages = 0;
+		size_t num_page_updates = 0; // partial texture updates, one per added glyph
+		size_t num_missed_off_thread = 0; // glyphs asked for on other threads before they were added
+	};
+
+	// Glyphs outside ASCII, rasterized with FreeType the first time they're
+	// asked for and packed into atlas pages.
+	//
+	// The Latin-1 range is rasterized up front and looked up in a table,
+	// other codepoints are looked up by hash. Pages are added as earlier
+	// ones fill up, and each added glyph updates only its part of a page.
+	// Latin-1 glyphs can also be given already rasterized, e.g. loaded from
+	// a FontAtlasCache, in which case the font file is only opened once a
+	// glyph outside them is added.
+	//
+	// Adding glyphs uses FreeType and OpenGL, so only the thread that
+	// created the cache adds them. Other threads, e.g. recording text on
+	// worker recorders, get the glyphs already added and are told about
+	// the others being missed, so that they can be asked for again on the
+	// thread that created the cache. Codepoints the font has no glyph for
+	// aren't missed once that thread has tried adding them.
+	class GlyphCache {
+	public:
+		static constexpr char32_t LATIN_FIRST = 0x80;
+		static constexpr char32_t LATIN_END = 0x100;
+
+		GlyphCache(OpenGLContext* gl_context, FontFace face, uint8_t size, int page_size = 512);
+		// `latin_glyphs` as given by rasterize_latin_glyphs
+		GlyphCache(OpenGLContext* gl_context, std::filesystem::path font_path, uint8_t size, const std::vector<GlyphBitmap>& latin_glyphs, int page_size = 512);
+
+		// Sets `is_missed` to whether the glyph wasn't given only because it's
+		// not added yet and this isn't the thread that adds it
+		std::optional<CachedGlyph> glyph(char32_t codepoint, bool* is_missed = nullptr);
+
+		GlyphCacheStats stats() const;
+		void free_pages(OpenGLContext* gl_context);
+
+	private:
+		struct Page {
+			Texture texture;
+			core::SkylinePacker packer;
+		};
+
+		FontFace* _face();
+		std::optional<CachedGlyph> _add_glyph(char32_t codepoint);
+		std::optional<CachedGlyph> _pack_glyph(const GlyphBitmap& bitmap);
+
+		OpenGLContext* m_gl_context;
+		uint8_t m_size;
+		int m_page_size;
+		std::thread::id m_owner_thread;
+		std::array<CachedGlyph, LATIN_END - LATIN_FIRST> m_latin_glyphs; // immutable after construction
+		mutable std::mutex m_mutex; // guards everything below
+		std::filesystem::path m_font_path; // opened on first use if there's no face, cleared if that fails
+		std::optional<FontFace> m_face;
+		std::unordered_map<char32_t, CachedGlyph> m_glyphs;
+		std::unordered_set<char32_t> m_missing_glyphs; // not in the font, or too large for a page
+		std::vector<Page> m_pages;
+		std::vector<RGBA> m_upload_pixels; // scratch buffer for page updates
+		GlyphCacheStats m_stats;
+	};
+
+	// Glyphs from LATIN_FIRST up to LATIN_END, that a GlyphCache starts with
+	std::vector<GlyphBitmap> rasterize_latin_glyphs(const FontFace& face, uint8_t size);
+
+	// Ascii glyphs from the font's atlas, others from its glyph cache. See
+	// GlyphCache::glyph for `is_missed`.
+	std::optional<CachedGlyph> find_glyph(const Font& font, char32_t codepoint, bool* is_missed = nullptr);
+
+} // namespace platform
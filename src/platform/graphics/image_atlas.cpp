@@ -0,0 +1,113 @@
+#include <platform/graphics/image_atlas.h>
+
+#include <core/skyline_packer.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string.h>
+
+namespace platform {
+
+	constexpr int NUM_CHANNELS = 4; // images are read as RGBA
+
+	// Copies `image` into the atlas at `pos`, then repeats its outermost
+	// pixels `extrusion` times on every side
+	static void blit_extruded(ImageAtlas* atlas, const Image& image, glm::ivec2 pos, int extrusion) {
+		if (image.width <= 0 || image.height <= 0) {
+			return;
+		}
+
+		const size_t atlas_stride = (size_t)atlas->size.x * NUM_CHANNELS;
+		const size_t image_stride = (size_t)image.width * NUM_CHANNELS;
+		uint8_t* atlas_pixels = atlas->pixels.data();
+		auto atlas_pixel = [&](int x, int y) { return atlas_pixels + (size_t)y * atlas_stride + (size_t)x * NUM_CHANNELS; };
+
+		/* Rows */
+		for (int row = -extrusion; row < image.height + extrusion; row++) {
+			const int image_row = std::clamp(row, 0, image.height - 1);
+			const uint8_t* src = image.data.get() + (size_t)image_row * image_stride;
+			uint8_t* dst = atlas_pixel(pos.x, pos.y + row);
+			memcpy(dst, src, image_stride);
+
+			/* Extrude left and right edges */
+			for (int i = 1; i <= extrusion; i++) {
+				memcpy(dst - (size_t)i * NUM_CHANNELS, src, NUM_CHANNELS);
+				memcpy(dst + image_stride + (size_t)(i - 1) * NUM_CHANNELS, src + image_stride - NUM_CHANNELS, NUM_CHANNELS);
+			}
+		}
+	}
+
+	PackedImageAtlases pack_image_atlases(const std::vector<const Image*>& images, const ImageAtlasSettings& settings) {
+		PackedImageAtlases packed;
+		packed.regions.resize(images.size());
+		const int border = settings.extrusion; // on each side
+		const int max_size = std::min(settings.max_image_size, settings.size - 2 * border - settings.padding);
+
+		/* Sort by decreasing height */
+		std::vector<size_t> order(images.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+			if (images[lhs]->height != images[rhs]->height) {
+				return images[lhs]->height > images[rhs]->height;
+			}
+			return images[lhs]->width > images[rhs]->width;
+		});
+
+		/* Pack */
+		std::vector<core::SkylinePacker> packers;
+		for (size_t image_index : order) {
+			const Image& image = *images[image_index];
+			if (image.width > max_size || image.height > max_size) {
+				continue;
+			}
+
+			// padding goes to the right and below, images at the atlas
+			// edges are already clamped by their extrusion
+			const glm::ivec2 packed_size = glm::ivec2 { image.width, image.height } + 2 * border + settings.padding;
+			std::optional<glm::ivec2> pos;
+			size_t atlas_index = 0;
+			while (atlas_index < packers.size()) {
+				pos = packers[atlas_index].pack(packed_size);
+				if (pos) {
+					break;
+				}
+				atlas_index++;
+			}
+			if (!pos) {
+				packers.push_back(core::SkylinePacker({ settings.size, settings.size }));
+				pos = packers.back().pack(packed_size);
+			}
+
+			const glm::vec2 atlas_size = { settings.size, settings.size };
+			const glm::ivec2 image_pos = *pos + border;
+			const glm::ivec2 image_size = { image.width, image.height };
+			packed.regions[image_index] = AtlasRegion {
+				.atlas_index = atlas_index,
+				.pos = image_pos,
+				.size = image_size,
+				.uv = {
+					.bottom_left = glm::vec2(image_pos) / atlas_size,
+					.top_right = glm::vec2(image_pos + image_size) / atlas_size,
+				},
+			};
+		}
+
+		/* Fill atlases */
+		packed.atlases.reserve(packers.size());
+		for (const core::SkylinePacker& packer : packers) {
+			packed.atlases.push_back(ImageAtlas {
+				.pixels = std::vector<uint8_t>((size_t)settings.size * settings.size * NUM_CHANNELS, 0),
+				.size = packer.size(),
+				.occupancy = packer.occupancy(),
+			});
+		}
+		for (size_t i = 0; i < images.size(); i++) {
+			if (const std::optional<AtlasRegion>& region = packed.regions[i]) {
+				blit_extruded(&packed.atlases[region->atlas_index], *images[i], region->pos, border);
+			}
+		}
+
+		return packed;
+	}
+
+} // namespace platform
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <core/rect.h>
+#include <platform/graphics/image.h>
+
+#include <glm/vec2.hpp>
+
+#include <optional>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace platform {
+
+	struct ImageAtlasSettings {
+		int size = 1024; // width and height of each atlas
+		int max_image_size = 256; // larger images aren't packed, but get their own texture
+		int padding = 1; // transparent pixels between packed images
+		int extrusion = 1; // edge pixels repeated around each image, keeps linear filtering from sampling its neighbours
+	};
+
+	// An RGBA image holding several packed images, with rows in the same
+	// order as the images it was packed from
+	struct ImageAtlas {
+		std::vector<uint8_t> pixels;
+		glm::ivec2 size;
+		float occupancy; // fraction of pixels covered by images, including extrusion and padding
+	};
+
+	struct AtlasRegion {
+		size_t atlas_index;
+		glm::ivec2 pos; // of the image itself, inside its extrusion
+		glm::ivec2 size;
+		core::FlipRect uv; // draws the image like drawing its own texture with uvs from 0 to 1
+	};
+
+	struct PackedImageAtlases {
+		std::vector<ImageAtlas> atlases;
+		std::vector<std::optional<AtlasRegion>> regions; // per image, empty if it's too large to pack
+	};
+
+	// Packs RGBA images into as few atlases as fit them, largest first
+	PackedImageAtlases pack_image_atlases(const std::vector<const Image*>& images, const ImageAtlasSettings& settings);
+
+} // namespace platform
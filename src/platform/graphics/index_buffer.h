@@ -0,0 +1,14 @@
+#pragma once
+
+#include <SDL2/SDL_opengl.h>
+
+#include <stddef.h>
+
+namespace platform {
+
+	struct IndexBuffer {
+		GLuint id;
+		size_t num_indices;
+	};
+
+} // namespace platform
@@ -0,0 +1,26 @@
+#include <platform/graphics/quad.h>
+
+namespace platform {
+
+	std::vector<uint32_t> generate_quad_indices(size_t num_quads) {
+		std::vector<uint32_t> indices;
+		indices.reserve(num_quads * INDICES_PER_QUAD);
+		for (uint32_t i = 0; i < num_quads; i++) {
+			const uint32_t first = i * VERTICES_PER_QUAD;
+			// first triangle
+			indices.push_back(first + 0);
+			indices.push_back(first + 1);
+			indices.push_back(first + 2);
+			// second triangle
+			indices.push_back(first + 1);
+			indices.push_back(first + 2);
+			indices.push_back(first + 3);
+		}
+		return indices;
+	}
+
+	size_t num_quad_indices(size_t num_vertices) {
+		return (num_vertices / VERTICES_PER_QUAD) * INDICES_PER_QUAD;
+	}
+
+} // namespace platform
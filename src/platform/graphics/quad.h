@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace platform {
+
+	// Quads are stored as 4 vertices and drawn as 2 indexed triangles:
+	//
+	// 0 ---- 2
+	// |    / |
+	// |  /   |
+	// 1 ---- 3
+	//
+	constexpr size_t VERTICES_PER_QUAD = 4;
+	constexpr size_t INDICES_PER_QUAD = 6;
+
+	std::vector<uint32_t> generate_quad_indices(size_t num_quads);
+	size_t num_quad_indices(size_t num_vertices);
+
+} // namespace platform
@@ -0,0 +1,199 @@
+#include <platform/graphics/render_capture.h>
+
+#include <platform/file/file.h>
+
+#include <fstream>
+#include <string.h>
+#include <type_traits>
+
+namespace platform {
+
+	constexpr uint32_t CAPTURE_MAGIC = 0x50414352; // "RCAP"
+	constexpr uint32_t CAPTURE_VERSION = 5;
+
+	template <typename T>
+	static void write_value(std::vector<uint8_t>* bytes, const T& value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		const uint8_t* first = (const uint8_t*)&value;
+		bytes->insert(bytes->end(), first, first + sizeof(T));
+	}
+
+	template <typename T>
+	static void write_array(std::vector<uint8_t>* bytes, const std::vector<T>& values) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		write_value(bytes, (uint64_t)values.size());
+		const uint8_t* first = (const uint8_t*)values.data();
+		bytes->insert(bytes->end(), first, first + values.size() * sizeof(T));
+	}
+
+	class ByteReader {
+	public:
+		ByteReader(const std::vector<uint8_t>& bytes)
+			: m_bytes(bytes) {
+		}
+
+		template <typename T>
+		bool read_value(T* value) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			if (m_offset + sizeof(T) > m_bytes.size()) {
+				return false;
+			}
+			memcpy(value, m_bytes.data() + m_offset, sizeof(T));
+			m_offset += sizeof(T);
+			return true;
+		}
+
+		template <typename T>
+		bool read_array(std::vector<T>* values) {
+			uint64_t size;
+			if (!read_value(&size) || size > (m_bytes.size() - m_offset) / sizeof(T)) {
+				return false;
+			}
+			values->resize(size);
+			memcpy(values->data(), m_bytes.data() + m_offset, size * sizeof(T));
+			m_offset += size * sizeof(T);
+			return true;
+		}
+
+	private:
+		const std::vector<uint8_t>& m_bytes;
+		size_t m_offset = 0;
+	};
+
+	template <typename T>
+	static bool read_command(ByteReader* reader, std::vector<RenderCommand>* commands) {
+		T command;
+		if (!reader->read_value(&command)) {
+			return false;
+		}
+		commands->push_back(command);
+		return true;
+	}
+
+	std::vector<uint8_t> serialize_command_list(const RenderCommandList& command_list) {
+		std::vector<uint8_t> bytes;
+
+		/* Header */
+		write_value(&bytes, CAPTURE_MAGIC);
+		write_value(&bytes, CAPTURE_VERSION);
+		write_value(&bytes, command_list.vertex_format);
+
+		/* Vertices */
+		write_array(&bytes, command_list.vertices);
+		write_array(&bytes, command_list.packed_vertices);
+		write_array(&bytes, command_list.quad_instances);
+
+		/* Commands */
+		write_value(&bytes, (uint64_t)command_list.commands.size());
+		for (const RenderCommand& command : command_list.commands) {
+			write_value(&bytes, (uint8_t)command.tag());
+			std::visit([&](const auto& cmd) { write_value(&bytes, cmd); }, command);
+		}
+
+		return bytes;
+	}
+
+	std::expected<RenderCommandList, RenderCaptureError> deserialize_command_list(const std::vector<uint8_t>& bytes) {
+		ByteReader reader(bytes);
+		RenderCommandList command_list;
+
+		/* Header */
+		uint32_t magic;
+		uint32_t version;
+		if (!reader.read_value(&magic) || magic != CAPTURE_MAGIC) {
+			return std::unexpected(RenderCaptureError::InvalidHeader);
+		}
+		if (!reader.read_value(&version) || version != CAPTURE_VERSION) {
+			return std::unexpected(RenderCaptureError::UnsupportedVersion);
+		}
+		if (!reader.read_value(&command_list.vertex_format)) {
+			return std::unexpected(RenderCaptureError::UnexpectedEndOfData);
+		}
+
+		/* Vertices */
+		if (!reader.read_array(&command_list.vertices) || !reader.read_array(&command_list.packed_vertices) || !reader.read_array(&command_list.quad_instances)) {
+			return std::unexpected(RenderCaptureError::UnexpectedEndOfData);
+		}
+
+		/* Commands */
+		uint64_t num_commands;
+		if (!reader.read_value(&num_commands)) {
+			return std::unexpected(RenderCaptureError::UnexpectedEndOfData);
+		}
+		for (uint64_t i = 0; i < num_commands; i++) {
+			uint8_t tag;
+			if (!reader.read_value(&tag)) {
+				return std::unexpected(RenderCaptureError::UnexpectedEndOfData);
+			}
+
+			bool command_read = false;
+			switch ((RenderCommandType)tag) {
+				case RenderCommandType::SetProjection:
+					command_read = read_command<cmd::render::SetProjection>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::BindCanvas:
+					command_read = read_command<cmd::render::BindCanvas>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::UnbindCanvas:
+					command_read = read_command<cmd::render::UnbindCanvas>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::BindTexture:
+					command_read = read_command<cmd::render::BindTexture>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::SetUvScale:
+					command_read = read_command<cmd::render::SetUvScale>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::SetDistanceField:
+					command_read = read_command<cmd::render::SetDistanceField>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::DrawArrays:
+					command_read = read_command<cmd::render::DrawArrays>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::DrawQuads:
+					command_read = read_command<cmd::render::DrawQuads>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::DrawQuadInstances:
+					command_read = read_command<cmd::render::DrawQuadInstances>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::BindVertexBuffer:
+					command_read = read_command<cmd::render::BindVertexBuffer>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::BindStreamedVertices:
+					command_read = read_command<cmd::render::BindStreamedVertices>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::SetScissor:
+					command_read = read_command<cmd::render::SetScissor>(&reader, &command_list.commands);
+					break;
+				case RenderCommandType::DisableScissor:
+					command_read = read_command<cmd::render::DisableScissor>(&reader, &command_list.commands);
+					break;
+				default:
+					return std::unexpected(RenderCaptureError::UnknownCommand);
+			}
+			if (!command_read) {
+				return std::unexpected(RenderCaptureError::UnexpectedEndOfData);
+			}
+		}
+
+		return command_list;
+	}
+
+	bool save_render_capture(const std::filesystem::path& path, const RenderCommandList& command_list) {
+		std::ofstream file(path, std::ios::binary);
+		if (!file.is_open()) {
+			return false;
+		}
+		const std::vector<uint8_t> bytes = serialize_command_list(command_list);
+		file.write((const char*)bytes.data(), bytes.size());
+		return file.good();
+	}
+
+	std::expected<RenderCommandList, RenderCaptureError> load_render_capture(const std::filesystem::path& path) {
+		std::optional<std::vector<uint8_t>> bytes = read_file_bytes(path);
+		if (!bytes) {
+			return std::unexpected(RenderCaptureError::FailedToOpenFile);
+		}
+		return deserialize_command_list(bytes.value());
+	}
+
+} // namespace platform
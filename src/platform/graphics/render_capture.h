@@ -0,0 +1,29 @@
+#pragma once
+
+#include <platform/graphics/render_command.h>
+
+#include <expected>
+#include <filesystem>
+#include <stdint.h>
+#include <vector>
+
+namespace platform {
+
+	enum class RenderCaptureError {
+		FailedToOpenFile,
+		InvalidHeader,
+		UnsupportedVersion,
+		UnknownCommand,
+		UnexpectedEndOfData,
+	};
+
+	// Captures are raw dumps of the command list, meant to be replayed by
+	// the same build on the same machine. Static batches are referenced by
+	// their vertex buffer, so they only replay while the buffer exists.
+	std::vector<uint8_t> serialize_command_list(const RenderCommandList& command_list);
+	std::expected<RenderCommandList, RenderCaptureError> deserialize_command_list(const std::vector<uint8_t>& bytes);
+
+	bool save_render_capture(const std::filesystem::path& path, const RenderCommandList& command_list);
+	std::expected<RenderCommandList, RenderCaptureError> load_render_capture(const std::filesystem::path& path);
+
+} // namespace platform
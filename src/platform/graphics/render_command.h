@@ -0,0 +1,145 @@
+#pragma once
+
+#include <core/tagged_variant.h>
+#include <platform/graphics/canvas.h>
+#include <platform/graphics/scissor_rect.h>
+#include <platform/graphics/texture.h>
+#include <platform/graphics/vertex.h>
+#include <platform/graphics/vertex_buffer.h>
+
+#include <SDL2/SDL_opengl.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace platform {
+
+	enum class RenderCommandType {
+		SetProjection,
+		BindCanvas,
+		UnbindCanvas,
+		BindTexture,
+		SetUvScale,
+		SetDistanceField,
+		DrawArrays,
+		DrawQuads,
+		DrawQuadInstances,
+		BindVertexBuffer,
+		BindStreamedVertices,
+		SetScissor,
+		DisableScissor,
+	};
+
+	namespace cmd::render {
+
+		struct SetProjection {
+			static constexpr auto TAG = RenderCommandType::SetProjection;
+			glm::mat4 projection;
+		};
+
+		struct BindCanvas {
+			static constexpr auto TAG = RenderCommandType::BindCanvas;
+			Canvas canvas;
+		};
+
+		struct UnbindCanvas {
+			static constexpr auto TAG = RenderCommandType::UnbindCanvas;
+		};
+
+		struct BindTexture {
+			static constexpr auto TAG = RenderCommandType::BindTexture;
+			Texture texture;
+		};
+
+		struct SetUvScale {
+			static constexpr auto TAG = RenderCommandType::SetUvScale;
+			float uv_scale;
+		};
+
+		// Texture alpha is thresholded as a distance field, see
+		// Font::distance_field
+		struct SetDistanceField {
+			static constexpr auto TAG = RenderCommandType::SetDistanceField;
+			bool enabled;
+		};
+
+		struct DrawArrays {
+			static constexpr auto TAG = RenderCommandType::DrawArrays;
+			GLenum mode;
+			GLint first;
+			GLsizei count;
+		};
+
+		// Triangles drawn with the shared quad index buffer, see quad.h
+		struct DrawQuads {
+			static constexpr auto TAG = RenderCommandType::DrawQuads;
+			GLint first;
+			GLsizei num_vertices;
+		};
+
+		// Quads drawn with QuadMode::Instanced, see quad_instance.vert
+		struct DrawQuadInstances {
+			static constexpr auto TAG = RenderCommandType::DrawQuadInstances;
+			GLint first;
+			GLsizei count;
+			float uv_scale;
+		};
+
+		// Draws read from a static batch's vertex buffer instead of the
+		// command list's vertices, until BindStreamedVertices
+		struct BindVertexBuffer {
+			static constexpr auto TAG = RenderCommandType::BindVertexBuffer;
+			VertexBuffer vertex_buffer;
+		};
+
+		struct BindStreamedVertices {
+			static constexpr auto TAG = RenderCommandType::BindStreamedVertices;
+		};
+
+		// Draws only touch pixels inside the rect, until DisableScissor
+		struct SetScissor {
+			static constexpr auto TAG = RenderCommandType::SetScissor;
+			ScissorRect rect;
+		};
+
+		struct DisableScissor {
+			static constexpr auto TAG = RenderCommandType::DisableScissor;
+		};
+
+	} // namespace cmd::render
+
+	using RenderCommand = core::TaggedVariant<
+		RenderCommandType,
+		cmd::render::SetProjection,
+		cmd::render::BindCanvas,
+		cmd::render::UnbindCanvas,
+		cmd::render::BindTexture,
+		cmd::render::SetUvScale,
+		cmd::render::SetDistanceField,
+		cmd::render::DrawArrays,
+		cmd::render::DrawQuads,
+		cmd::render::DrawQuadInstances,
+		cmd::render::BindVertexBuffer,
+		cmd::render::BindStreamedVertices,
+		cmd::render::SetScissor,
+		cmd::render::DisableScissor>;
+
+	// Everything needed to draw one call to Renderer::render, without
+	// depending on a graphics API. Only one of the vertex arrays is used,
+	// depending on the vertex format.
+	struct RenderCommandList {
+		VertexFormat vertex_format = VertexFormat::Standard;
+		std::vector<Vertex> vertices;
+		std::vector<PackedVertex> packed_vertices;
+		std::vector<QuadInstance> quad_instances;
+		std::vector<RenderCommand> commands;
+
+		void clear() {
+			vertices.clear();
+			packed_vertices.clear();
+			quad_instances.clear();
+			commands.clear();
+		}
+	};
+
+} // namespace platform
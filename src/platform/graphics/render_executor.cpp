@@ -0,0 +1,201 @@
+#include <platform/graphics/render_executor.h>
+
+#include <platform/debug/logging.h>
+#include <platform/graphics/gl_context.h>
+#include <platform/graphics/quad.h>
+#include <platform/graphics/render_capture.h>
+
+#include <algorithm>
+
+namespace platform {
+
+	/* GLRenderExecutor */
+
+	GLRenderExecutor::GLRenderExecutor(OpenGLContext* gl_context)
+		: m_gl_context(gl_context) {
+		const size_t initial_num_quads = 1024;
+		m_quad_index_buffer = gl_context->add_index_buffer(generate_quad_indices(initial_num_quads));
+	}
+
+	void GLRenderExecutor::shutdown(OpenGLContext* gl_context) {
+		gl_context->free_index_buffer(m_quad_index_buffer);
+		m_quad_index_buffer = {};
+	}
+
+	void GLRenderExecutor::execute(const ShaderProgram& shader_program, const RenderCommandList& command_list) {
+		m_gl_context->bind_shader_program(shader_program);
+
+		/* Grow quad indices */
+		{
+			size_t max_quads = 0;
+			for (const RenderCommand& command : command_list.commands) {
+				if (command.tag() == RenderCommandType::DrawQuads) {
+					const cmd::render::DrawQuads& draw = std::get<cmd::render::DrawQuads>(command);
+					max_quads = std::max(max_quads, (size_t)draw.num_vertices / VERTICES_PER_QUAD);
+				}
+			}
+			_reserve_quad_indices(max_quads);
+		}
+
+		/* Upload vertices */
+		// Instances are pushed after the vertices but before either is
+		// drawn, so both go in one reserved range
+		const size_t vertex_bytes = command_list.vertex_format == VertexFormat::Standard
+			? command_list.vertices.size() * sizeof(Vertex) + sizeof(Vertex)
+			: command_list.packed_vertices.size() * sizeof(PackedVertex) + sizeof(PackedVertex);
+		const size_t instance_bytes = command_list.quad_instances.empty() ? 0 : command_list.quad_instances.size() * sizeof(QuadInstance) + sizeof(QuadInstance);
+		m_gl_context->reserve_vertex_stream(vertex_bytes + instance_bytes);
+		switch (command_list.vertex_format) {
+			case VertexFormat::Standard:
+				m_gl_context->upload_vertices(shader_program, command_list.vertices);
+				break;
+			case VertexFormat::Packed:
+				m_gl_context->upload_packed_vertices(shader_program, command_list.packed_vertices);
+				break;
+		}
+		if (!command_list.quad_instances.empty()) {
+			m_gl_context->upload_quad_instances(shader_program, command_list.quad_instances);
+		}
+
+		/* Execute commands */
+		for (const RenderCommand& command : command_list.commands) {
+			switch (command.tag()) {
+				case RenderCommandType::SetProjection: {
+					auto& [projection] = std::get<cmd::render::SetProjection>(command);
+					m_gl_context->set_projection(shader_program, projection);
+				} break;
+
+				case RenderCommandType::BindCanvas: {
+					auto& [canvas] = std::get<cmd::render::BindCanvas>(command);
+					m_gl_context->bind_canvas(canvas);
+				} break;
+
+				case RenderCommandType::UnbindCanvas:
+					m_gl_context->unbind_canvas();
+					break;
+
+				case RenderCommandType::BindTexture: {
+					auto& [texture] = std::get<cmd::render::BindTexture>(command);
+					m_gl_context->bind_texture(texture);
+				} break;
+
+				case RenderCommandType::SetUvScale: {
+					auto& [uv_scale] = std::get<cmd::render::SetUvScale>(command);
+					m_gl_context->set_uv_scale(shader_program, uv_scale);
+				} break;
+
+				case RenderCommandType::SetDistanceField: {
+					auto& [enabled] = std::get<cmd::render::SetDistanceField>(command);
+					m_gl_context->set_distance_field(shader_program, enabled);
+				} break;
+
+				case RenderCommandType::DrawArrays: {
+					auto& [mode, first, count] = std::get<cmd::render::DrawArrays>(command);
+					m_gl_context->draw_arrays(mode, first, count);
+				} break;
+
+				case RenderCommandType::DrawQuads: {
+					auto& [first, num_vertices] = std::get<cmd::render::DrawQuads>(command);
+					m_gl_context->draw_elements(GL_TRIANGLES, m_quad_index_buffer, (GLsizei)num_quad_indices(num_vertices), first);
+				} break;
+
+				case RenderCommandType::DrawQuadInstances: {
+					auto& [first, count, uv_scale] = std::get<cmd::render::DrawQuadInstances>(command);
+					m_gl_context->draw_quad_instances(shader_program, first, count, uv_scale);
+				} break;
+
+				case RenderCommandType::BindVertexBuffer: {
+					auto& [vertex_buffer] = std::get<cmd::render::BindVertexBuffer>(command);
+					m_gl_context->bind_vertex_buffer(shader_program, vertex_buffer);
+				} break;
+
+				case RenderCommandType::BindStreamedVertices:
+					m_gl_context->bind_streamed_vertices(shader_program);
+					break;
+
+				case RenderCommandType::SetScissor: {
+					auto& [rect] = std::get<cmd::render::SetScissor>(command);
+					m_gl_context->set_scissor(rect);
+				} break;
+
+				case RenderCommandType::DisableScissor:
+					m_gl_context->disable_scissor();
+					break;
+			}
+		}
+
+		/* Unbind */
+		m_gl_context->unbind_canvas();
+		m_gl_context->fence_vertices();
+		m_gl_context->unbind_shader_program();
+	}
+
+	StreamingBufferStats GLRenderExecutor::vertex_stream_stats() const {
+		return m_gl_context->vertex_stream_stats();
+	}
+
+	void GLRenderExecutor::_reserve_quad_indices(size_t num_quads) {
+		const size_t num_indices = num_quads * INDICES_PER_QUAD;
+		if (num_indices <= m_quad_index_buffer.num_indices) {
+			return;
+		}
+
+		// grow to next power of two to avoid reallocating every frame
+		size_t new_num_quads = std::max<size_t>(m_quad_index_buffer.num_indices / INDICES_PER_QUAD, 1);
+		while (new_num_quads < num_quads) {
+			new_num_quads *= 2;
+		}
+		m_gl_context->free_index_buffer(m_quad_index_buffer);
+		m_quad_index_buffer = m_gl_context->add_index_buffer(generate_quad_indices(new_num_quads));
+	}
+
+	/* NullRenderExecutor */
+
+	void NullRenderExecutor::execute(const ShaderProgram& /* shader_program */, const RenderCommandList& command_list) {
+		for (const RenderCommand& command : command_list.commands) {
+			// visit the command, so that benchmarks include reading it
+			std::visit([&](const auto&) { m_num_executed_commands += 1; }, command);
+		}
+	}
+
+	size_t NullRenderExecutor::num_executed_commands() const {
+		return m_num_executed_commands;
+	}
+
+	/* CaptureRenderExecutor */
+
+	CaptureRenderExecutor::CaptureRenderExecutor(IRenderExecutor* executor)
+		: m_executor(executor) {
+	}
+
+	void CaptureRenderExecutor::capture_next(const std::filesystem::path& path) {
+		m_capture_path = path;
+	}
+
+	void CaptureRenderExecutor::execute(const ShaderProgram& shader_program, const RenderCommandList& command_list) {
+		_save_capture(command_list);
+		m_executor->execute(shader_program, command_list);
+	}
+
+	void CaptureRenderExecutor::submit(const ShaderProgram& shader_program, RenderCommandList* command_list) {
+		_save_capture(*command_list);
+		m_executor->submit(shader_program, command_list);
+	}
+
+	StreamingBufferStats CaptureRenderExecutor::vertex_stream_stats() const {
+		return m_executor->vertex_stream_stats();
+	}
+
+	void CaptureRenderExecutor::_save_capture(const RenderCommandList& command_list) {
+		if (m_capture_path) {
+			if (save_render_capture(m_capture_path.value(), command_list)) {
+				LOG_INFO("Saved render capture to \"%s\"", m_capture_path->string().c_str());
+			}
+			else {
+				LOG_ERROR("Failed to save render capture to \"%s\"", m_capture_path->string().c_str());
+			}
+			m_capture_path.reset();
+		}
+	}
+
+} // namespace platform
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <platform/graphics/index_buffer.h>
+#include <platform/graphics/render_command.h>
+#include <platform/graphics/shader_program.h>
+#include <platform/graphics/streaming_buffer.h>
+
+#include <filesystem>
+#include <optional>
+#include <stddef.h>
+
+namespace platform {
+
+	class OpenGLContext;
+
+	// Consumes the command lists recorded by Renderer
+	class IRenderExecutor {
+	public:
+		virtual ~IRenderExecutor() {}
+		virtual void execute(const ShaderProgram& shader_program, const RenderCommandList& command_list) = 0;
+
+		// Called by Renderer with a list it clears and reuses afterwards.
+		// Executors that need the commands after returning can take them by
+		// swapping, instead of copying them in `execute`.
+		virtual void submit(const ShaderProgram& shader_program, RenderCommandList* command_list) {
+			execute(shader_program, *command_list);
+		}
+
+		// Of the last executed frame, for executors streaming vertices
+		virtual StreamingBufferStats vertex_stream_stats() const {
+			return {};
+		}
+	};
+
+	class GLRenderExecutor : public IRenderExecutor {
+	public:
+		GLRenderExecutor(OpenGLContext* gl_context);
+
+		// Frees the shared quad index buffer
+		void shutdown(OpenGLContext* gl_context);
+
+		void execute(const ShaderProgram& shader_program, const RenderCommandList& command_list) override;
+		StreamingBufferStats vertex_stream_stats() const override;
+
+	private:
+		void _reserve_quad_indices(size_t num_quads);
+
+		OpenGLContext* m_gl_context;
+		IndexBuffer m_quad_index_buffer;
+	};
+
+	// Visits every command without drawing anything, for measuring the
+	// CPU-side cost of recording and submitting.
+	class NullRenderExecutor : public IRenderExecutor {
+	public:
+		void execute(const ShaderProgram& shader_program, const RenderCommandList& command_list) override;
+
+		size_t num_executed_commands() const;
+
+	private:
+		size_t m_num_executed_commands = 0;
+	};
+
+	// Forwards to another executor, saving the next command list to a file
+	// when asked to.
+	class CaptureRenderExecutor : public IRenderExecutor {
+	public:
+		CaptureRenderExecutor(IRenderExecutor* executor);
+
+		void capture_next(const std::filesystem::path& path);
+		void execute(const ShaderProgram& shader_program, const RenderCommandList& command_list) override;
+		void submit(const ShaderProgram& shader_program, RenderCommandList* command_list) override;
+		StreamingBufferStats vertex_stream_stats() const override;
+
+	private:
+		void _save_capture(const RenderCommandList& command_list);
+
+		IRenderExecutor* m_executor;
+		std::optional<std::filesystem::path> m_capture_path;
+	};
+
+} // namespace platform
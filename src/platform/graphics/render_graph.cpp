@@ -0,0 +1,110 @@
+#include <platform/graphics/render_graph.h>
+
+#include <platform/debug/assert.h>
+#include <platform/graphics/renderer.h>
+#include <platform/input/timing.h>
+
+#include <algorithm>
+
+namespace platform {
+
+	static std::optional<size_t> find_pass_drawing(const std::vector<RenderPass>& passes, const Canvas& canvas) {
+		auto it = std::find_if(passes.begin(), passes.end(), [&](const RenderPass& pass) { return pass.target.framebuffer == canvas.framebuffer; });
+		if (it == passes.end()) {
+			return {};
+		}
+		return (size_t)(it - passes.begin());
+	}
+
+	void RenderGraph::add_pass(RenderPass pass) {
+		ASSERT(!find_pass_drawing(m_passes, pass.target), "Render pass \"%s\" draws to a canvas already drawn by another pass", pass.name.c_str());
+		m_passes.push_back(std::move(pass));
+	}
+
+	std::expected<void, RenderGraphError> RenderGraph::execute(Renderer* renderer) {
+		if (!_sort_passes()) {
+			m_passes.clear();
+			return std::unexpected(RenderGraphError::DependencyCycle);
+		}
+
+		m_pass_was_drawn.assign(m_passes.size(), false);
+		for (size_t pass_index : m_pass_order) {
+			const RenderPass& pass = m_passes[pass_index];
+
+			/* Cull */
+			const bool inputs_were_drawn = std::any_of(pass.inputs.begin(), pass.inputs.end(), [&](const Canvas& input) {
+				std::optional<size_t> input_pass = find_pass_drawing(m_passes, input);
+				return input_pass && m_pass_was_drawn[*input_pass];
+			});
+			auto drawn_pass = m_drawn_passes.find(pass.target.framebuffer);
+			const bool is_up_to_date = pass.version && !inputs_were_drawn && drawn_pass != m_drawn_passes.end() &&
+				drawn_pass->second.version == *pass.version && drawn_pass->second.size == pass.target.texture.size;
+			if (is_up_to_date) {
+				drawn_pass->second.num_skipped_frames += 1;
+				renderer->add_pass_stats({ .name = pass.name, .skipped = true, .num_skipped_frames = drawn_pass->second.num_skipped_frames });
+				continue;
+			}
+
+			/* Draw */
+			Timer timer;
+			renderer->push_draw_canvas(pass.target);
+			pass.draw(renderer);
+			renderer->pop_draw_canvas();
+			renderer->add_pass_stats({ .name = pass.name, .skipped = false, .record_ns = timer.elapsed_ns() });
+
+			m_pass_was_drawn[pass_index] = true;
+			if (pass.version) {
+				m_drawn_passes[pass.target.framebuffer] = DrawnPass { .version = *pass.version, .size = pass.target.texture.size };
+			}
+			else {
+				m_drawn_passes.erase(pass.target.framebuffer);
+			}
+		}
+
+		m_passes.clear();
+		return {};
+	}
+
+	void RenderGraph::invalidate() {
+		m_drawn_passes.clear();
+	}
+
+	// Orders passes so each comes after the passes drawing its inputs, and
+	// otherwise in the order they were added. Returns false on cycles.
+	bool RenderGraph::_sort_passes() {
+		constexpr size_t SORTED = SIZE_MAX;
+
+		m_num_unsorted_inputs.assign(m_passes.size(), 0);
+		for (size_t i = 0; i < m_passes.size(); i++) {
+			for (const Canvas& input : m_passes[i].inputs) {
+				if (find_pass_drawing(m_passes, input)) {
+					m_num_unsorted_inputs[i]++;
+				}
+			}
+		}
+
+		m_pass_order.clear();
+		while (m_pass_order.size() < m_passes.size()) {
+			auto next = std::find(m_num_unsorted_inputs.begin(), m_num_unsorted_inputs.end(), 0);
+			if (next == m_num_unsorted_inputs.end()) {
+				return false;
+			}
+			const size_t next_index = (size_t)(next - m_num_unsorted_inputs.begin());
+			*next = SORTED;
+			m_pass_order.push_back(next_index);
+
+			for (size_t i = 0; i < m_passes.size(); i++) {
+				if (m_num_unsorted_inputs[i] == SORTED) {
+					continue;
+				}
+				for (const Canvas& input : m_passes[i].inputs) {
+					if (input.framebuffer == m_passes[next_index].target.framebuffer) {
+						m_num_unsorted_inputs[i]--;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+} // namespace platform
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <platform/graphics/canvas.h>
+
+#include <SDL2/SDL_opengl.h>
+#include <glm/glm.hpp>
+
+#include <expected>
+#include <functional>
+#include <optional>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace platform {
+
+	class Renderer;
+
+	enum class RenderGraphError {
+		DependencyCycle,
+	};
+
+	struct RenderPass {
+		std::string name;
+		Canvas target;
+		std::vector<Canvas> inputs; // canvases the pass samples
+		std::optional<uint64_t> version; // identifies what the pass draws, drawn every frame if empty
+		std::function<void(Renderer*)> draw;
+	};
+
+	// Draws canvases as passes, each pass after the passes drawing its inputs.
+	//
+	// Every pass is drawn between one push and pop of its target canvas, so
+	// it gets a single framebuffer bind. A pass is skipped, keeping last
+	// frame's pixels, if it has the same version as when it was last drawn
+	// and none of its inputs were drawn this frame. Passes are declared
+	// anew every frame, while the graph remembers what was drawn.
+	class RenderGraph {
+	public:
+		void add_pass(RenderPass pass);
+
+		// Draws the passes declared since the last call, call before
+		// drawing anything that samples their canvases
+		std::expected<void, RenderGraphError> execute(Renderer* renderer);
+
+		// Draws every pass next frame, e.g. after recreating a canvas
+		void invalidate();
+
+	private:
+		struct DrawnPass {
+			uint64_t version;
+			glm::vec2 size;
+			size_t num_skipped_frames = 0; // since it was drawn
+		};
+
+		bool _sort_passes();
+
+		std::vector<RenderPass> m_passes;
+		std::unordered_map<GLuint, DrawnPass> m_drawn_passes; // by target framebuffer
+
+		// scratch buffers, kept to avoid reallocating every frame
+		std::vector<size_t> m_pass_order;
+		std::vector<size_t> m_num_unsorted_inputs;
+		std::vector<bool> m_pass_was_drawn;
+	};
+
+} // namespace platform
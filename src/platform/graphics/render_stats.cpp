@@ -0,0 +1,253 @@
+#include <platform/graphics/render_stats.h>
+
+#include <platform/debug/assert.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <math.h>
+
+namespace platform {
+
+	constexpr std::array<RenderStat, 8> RENDER_STATS = {
+		RenderStat::RenderNs,
+		RenderStat::RecordNs,
+		RenderStat::UploadBytes,
+		RenderStat::DrawCalls,
+		RenderStat::TextureBinds,
+		RenderStat::CanvasBinds,
+		RenderStat::ProgramBinds,
+		RenderStat::MergedSections,
+	};
+
+	const char* render_stat_name(RenderStat stat) {
+		switch (stat) {
+			case RenderStat::RenderNs:
+				return "render_ns";
+			case RenderStat::RecordNs:
+				return "record_ns";
+			case RenderStat::UploadBytes:
+				return "upload_bytes";
+			case RenderStat::DrawCalls:
+				return "draw_calls";
+			case RenderStat::TextureBinds:
+				return "texture_binds";
+			case RenderStat::CanvasBinds:
+				return "canvas_binds";
+			case RenderStat::ProgramBinds:
+				return "program_binds";
+			case RenderStat::MergedSections:
+				return "merged_sections";
+		}
+		return "";
+	}
+
+	static double stat_value(const RenderFrameStats& frame, RenderStat stat) {
+		switch (stat) {
+			case RenderStat::RenderNs:
+				return (double)frame.render_ns;
+			case RenderStat::RecordNs:
+				return (double)frame.record_ns;
+			case RenderStat::UploadBytes:
+				return (double)frame.num_upload_bytes;
+			case RenderStat::DrawCalls:
+				return (double)frame.num_draw_calls;
+			case RenderStat::TextureBinds:
+				return (double)frame.num_texture_binds;
+			case RenderStat::CanvasBinds:
+				return (double)frame.num_canvas_binds;
+			case RenderStat::ProgramBinds:
+				return (double)frame.num_program_binds;
+			case RenderStat::MergedSections:
+				return (double)frame.num_merged_sections;
+		}
+		return 0.0;
+	}
+
+	// Nearest rank percentile of sorted values
+	static double percentile(const std::vector<double>& sorted_values, double p) {
+		const size_t rank = (size_t)ceil(p * (double)sorted_values.size());
+		return sorted_values[std::clamp(rank, (size_t)1, sorted_values.size()) - 1];
+	}
+
+	static const RenderPassStats* find_drawn_pass(const RenderFrameStats& frame, const std::string& name) {
+		auto it = std::find_if(frame.passes.begin(), frame.passes.end(), [&](const RenderPassStats& pass) { return pass.name == name && !pass.skipped; });
+		return it != frame.passes.end() ? &*it : nullptr;
+	}
+
+	RenderStatsHistory::RenderStatsHistory(size_t max_frames)
+		: m_max_frames(max_frames) {
+		ASSERT(max_frames > 0, "Render stats history must keep at least one frame");
+		m_frames.reserve(max_frames);
+	}
+
+	void RenderStatsHistory::add_frame(const RenderDebugData& debug_data) {
+		/* Make room */
+		RenderFrameStats* frame;
+		if (m_frames.size() < m_max_frames) {
+			frame = &m_frames.emplace_back();
+		}
+		else {
+			// reuses the oldest frame, keeping its allocations
+			frame = &m_frames[m_first_frame];
+			m_first_frame = (m_first_frame + 1) % m_max_frames;
+		}
+
+		/* Copy stats */
+		frame->frame = m_num_added_frames++;
+		frame->render_ns = debug_data.render_ns;
+		frame->record_ns = 0;
+		for (const RenderPassStats& pass : debug_data.passes) {
+			frame->record_ns += pass.record_ns;
+		}
+		frame->num_upload_bytes = debug_data.num_vertex_bytes + debug_data.num_quad_instance_bytes;
+		frame->num_draw_calls = debug_data.num_draw_calls;
+		frame->num_texture_binds = debug_data.num_texture_binds;
+		frame->num_canvas_binds = debug_data.num_canvas_binds;
+		frame->num_program_binds = debug_data.num_program_binds;
+		frame->num_merged_sections = debug_data.num_raw_sections > debug_data.num_sections ? debug_data.num_raw_sections - debug_data.num_sections : 0;
+		frame->passes.assign(debug_data.passes.begin(), debug_data.passes.end());
+	}
+
+	void RenderStatsHistory::clear() {
+		m_frames.clear();
+		m_first_frame = 0;
+	}
+
+	size_t RenderStatsHistory::num_frames() const {
+		return m_frames.size();
+	}
+
+	const RenderFrameStats& RenderStatsHistory::frame(size_t index) const {
+		return m_frames[(m_first_frame + index) % m_frames.size()];
+	}
+
+	RenderStatSummary RenderStatsHistory::summarize(RenderStat stat) const {
+		m_values.clear();
+		for (const RenderFrameStats& frame : m_frames) {
+			m_values.push_back(stat_value(frame, stat));
+		}
+		return _summarize_values();
+	}
+
+	RenderStatSummary RenderStatsHistory::summarize_pass(const std::string& name) const {
+		m_values.clear();
+		for (const RenderFrameStats& frame : m_frames) {
+			if (const RenderPassStats* pass = find_drawn_pass(frame, name)) {
+				m_values.push_back((double)pass->record_ns);
+			}
+		}
+		return _summarize_values();
+	}
+
+	RenderStatSummary RenderStatsHistory::_summarize_values() const {
+		if (m_values.empty()) {
+			return {};
+		}
+		std::sort(m_values.begin(), m_values.end());
+		return RenderStatSummary {
+			.p50 = percentile(m_values, 0.50),
+			.p95 = percentile(m_values, 0.95),
+			.p99 = percentile(m_values, 0.99),
+			.worst = m_values.back(),
+		};
+	}
+
+	// Names of passes drawn in any kept frame, in the order first seen
+	static std::vector<std::string> drawn_pass_names(const RenderStatsHistory& history) {
+		std::vector<std::string> names;
+		for (size_t i = 0; i < history.num_frames(); i++) {
+			for (const RenderPassStats& pass : history.frame(i).passes) {
+				if (std::find(names.begin(), names.end(), pass.name) == names.end()) {
+					names.push_back(pass.name);
+				}
+			}
+		}
+		return names;
+	}
+
+	// One row per frame, oldest first. Pass columns hold their record time,
+	// and are empty in frames where the pass was skipped.
+	std::string RenderStatsHistory::to_csv() const {
+		const std::vector<std::string> pass_names = drawn_pass_names(*this);
+
+		/* Header */
+		std::string csv = "frame";
+		for (RenderStat stat : RENDER_STATS) {
+			csv += std::string(",") + render_stat_name(stat);
+		}
+		for (const std::string& name : pass_names) {
+			csv += ",\"pass " + name + " record_ns\"";
+		}
+		csv += "\n";
+
+		/* Frames */
+		for (size_t i = 0; i < num_frames(); i++) {
+			const RenderFrameStats& frame = this->frame(i);
+			csv += std::to_string(frame.frame);
+			for (RenderStat stat : RENDER_STATS) {
+				csv += "," + std::to_string((uint64_t)stat_value(frame, stat));
+			}
+			for (const std::string& name : pass_names) {
+				const RenderPassStats* pass = find_drawn_pass(frame, name);
+				csv += pass ? "," + std::to_string(pass->record_ns) : ",";
+			}
+			csv += "\n";
+		}
+		return csv;
+	}
+
+	// A summary of each stat and pass, followed by every frame
+	std::string RenderStatsHistory::to_json() const {
+		auto summary_to_json = [](const RenderStatSummary& summary) {
+			return nlohmann::json { { "p50", summary.p50 }, { "p95", summary.p95 }, { "p99", summary.p99 }, { "worst", summary.worst } };
+		};
+
+		/* Summary */
+		nlohmann::json summary = nlohmann::json::object();
+		for (RenderStat stat : RENDER_STATS) {
+			summary[render_stat_name(stat)] = summary_to_json(summarize(stat));
+		}
+		nlohmann::json pass_summary = nlohmann::json::object();
+		for (const std::string& name : drawn_pass_names(*this)) {
+			pass_summary[name] = summary_to_json(summarize_pass(name));
+		}
+
+		/* Frames */
+		nlohmann::json frames = nlohmann::json::array();
+		for (size_t i = 0; i < num_frames(); i++) {
+			const RenderFrameStats& frame = this->frame(i);
+			nlohmann::json frame_json = { { "frame", frame.frame } };
+			for (RenderStat stat : RENDER_STATS) {
+				frame_json[render_stat_name(stat)] = (uint64_t)stat_value(frame, stat);
+			}
+			nlohmann::json passes = nlohmann::json::array();
+			for (const RenderPassStats& pass : frame.passes) {
+				passes.push_back({ { "name", pass.name }, { "skipped", pass.skipped }, { "record_ns", pass.record_ns } });
+			}
+			frame_json["passes"] = std::move(passes);
+			frames.push_back(std::move(frame_json));
+		}
+
+		nlohmann::json json_object = {
+			{ "num_frames", num_frames() },
+			{ "summary", std::move(summary) },
+			{ "passes", std::move(pass_summary) },
+			{ "frames", std::move(frames) },
+		};
+		return json_object.dump(1, '\t');
+	}
+
+	bool RenderStatsHistory::save(const std::filesystem::path& path, RenderStatsFormat format) const {
+		std::ofstream file(path, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+		const std::string contents = format == RenderStatsFormat::Json ? to_json() : to_csv();
+		file.write(contents.data(), (std::streamsize)contents.size());
+		return (bool)file;
+	}
+
+} // namespace platform
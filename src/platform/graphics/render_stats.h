@@ -0,0 +1,84 @@
+#pragma once
+
+#include <platform/graphics/renderer_debug.h>
+
+#include <filesystem>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace platform {
+
+	enum class RenderStat {
+		RenderNs, // CPU time spent in Renderer::render
+		RecordNs, // CPU time spent recording render graph passes
+		UploadBytes, // vertices and quad instances
+		DrawCalls,
+		TextureBinds,
+		CanvasBinds,
+		ProgramBinds,
+		MergedSections, // sections saved by merging adjacent draws
+	};
+
+	struct RenderFrameStats {
+		uint64_t frame = 0; // index since the history was created
+		uint64_t render_ns = 0;
+		uint64_t record_ns = 0;
+		size_t num_upload_bytes = 0;
+		size_t num_draw_calls = 0;
+		size_t num_texture_binds = 0;
+		size_t num_canvas_binds = 0;
+		size_t num_program_binds = 0;
+		size_t num_merged_sections = 0;
+		std::vector<RenderPassStats> passes;
+	};
+
+	struct RenderStatSummary {
+		double p50 = 0.0;
+		double p95 = 0.0;
+		double p99 = 0.0;
+		double worst = 0.0;
+	};
+
+	enum class RenderStatsFormat {
+		Csv,
+		Json,
+	};
+
+	// Keeps the stats of the last frames rendered, to see how they're
+	// distributed rather than only the latest or average frame.
+	//
+	// Percentiles use the nearest rank, so with few frames p99 is the worst
+	// frame. Exports are meant to be compared between builds offline.
+	class RenderStatsHistory {
+	public:
+		explicit RenderStatsHistory(size_t max_frames = 600);
+
+		void add_frame(const RenderDebugData& debug_data);
+		void clear();
+
+		size_t num_frames() const;
+		const RenderFrameStats& frame(size_t index) const; // 0 is the oldest frame kept
+
+		RenderStatSummary summarize(RenderStat stat) const;
+		// Record time of a render graph pass, over the frames it was drawn
+		RenderStatSummary summarize_pass(const std::string& name) const;
+
+		std::string to_csv() const;
+		std::string to_json() const;
+		bool save(const std::filesystem::path& path, RenderStatsFormat format) const;
+
+	private:
+		RenderStatSummary _summarize_values() const;
+
+		std::vector<RenderFrameStats> m_frames; // ring buffer of the last frames
+		size_t m_max_frames;
+		size_t m_first_frame = 0; // index of the oldest frame in m_frames
+		uint64_t m_num_added_frames = 0;
+		mutable std::vector<double> m_values; // scratch buffer for summarizing
+	};
+
+	const char* render_stat_name(RenderStat stat);
+
+} // namespace platform
@@ -1,66 +1,61 @@
-#include <GL/glew.h> // must be included before <SDL2/SDL_opengl.h>
-
 #include <platform/graphics/renderer.h>
 
 #include <glm/gtc/matrix_transform.hpp> // glm::ortho
 #include <imgui/backends/imgui_impl_opengl3.h>
+#include <platform/debug/assert.h>
 #include <platform/debug/logging.h>
 #include <platform/graphics/gl_context.h>
+#include <platform/graphics/quad.h>
 #include <platform/input/timing.h>
 #include <stb_image/stb_image.h>
 
 #include <algorithm>
 #include <math.h>
 #include <set>
+#include <thread>
 #include <vector>
 
 namespace platform {
 
-	static std::vector<glm::vec2> circle_octant_points(float radius) {
-		/* Compute points in first octant */
-		//              90°
-		//         , - ~ ~ ~ - ,
-		//     , '       |       ' , 45°
-		//   ,           |       ⟋   ,
-		//  ,            |    ⟋       ,
-		// ,             | ⟋           ,
-		// ,             o             ,
-		// ,                           ,
-		//  ,                         ,
-		//   ,                       ,
-		//     ,                  , '
-		//       ' - , _ _ _ ,  '
-		std::vector<glm::vec2> quadrant_points;
-		{
-			glm::vec2 point = { 0.0f, radius };
-			while (point.x <= point.y) {
-				quadrant_points.push_back(point);
-
-				glm::vec2 mid_point = { point.x + 1, point.y - 0.5f };
-				if (pow(mid_point.x, 2) + pow(mid_point.y, 2) > pow(radius, 2)) {
-					point.y -= 1;
-				}
-				point.x += 1;
-			}
+	static Texture add_white_texture(OpenGLContext* gl_context) {
+		unsigned char data[] = { 0xFF, 0xFF, 0xFF, 0xFF };
+		return gl_context->add_texture(data, 1, 1);
+	}
+
+	Renderer::Renderer(OpenGLContext* gl_context, VertexFormat vertex_format, QuadMode quad_mode)
+		: m_gl_context(gl_context)
+		, m_gl_executor(gl_context)
+		, m_executor(&m_gl_executor)
+		, m_vertex_format(vertex_format)
+		, m_quad_mode(quad_mode)
+		, m_white_texture(add_white_texture(gl_context))
+		, m_recorder(m_white_texture, quad_mode)
+		, m_max_draw_threads(std::max(std::thread::hardware_concurrency(), 1u))
+		, m_draw_workers(m_max_draw_threads) {
+	}
+
+	void Renderer::shutdown(OpenGLContext* gl_context) {
+		for (const auto& [id, batch] : m_static_batches) {
+			gl_context->free_vertex_buffer(batch.vertex_buffer);
 		}
-		return quadrant_points;
+		m_static_batches.clear();
+		m_gl_executor.shutdown(gl_context);
+		gl_context->free_texture(m_white_texture);
 	}
 
-	Renderer::Renderer(OpenGLContext* gl_context) {
-		unsigned char data[] = { 0xFF, 0xFF, 0xFF, 0xFF };
-		m_white_texture = gl_context->add_texture(data, 1, 1);
+	void Renderer::set_executor(IRenderExecutor* executor) {
+		m_executor = executor ? executor : &m_gl_executor;
 	}
 
-	void Renderer::set_projection(const ShaderProgram& shader_program, glm::mat4 projection) {
-		glUseProgram(shader_program.id);
-		glUniformMatrix4fv(shader_program.uniforms.projection, 1, GL_FALSE, &projection[0][0]);
+	void Renderer::set_projection(glm::mat4 projection) {
+		m_projection = projection;
 	}
 
 	void Renderer::push_draw_canvas(Canvas canvas) {
-		m_draw_canvas_stack.push_back(canvas);
+		m_recorder.push_draw_canvas(canvas);
 	}
 	void Renderer::pop_draw_canvas() {
-		m_draw_canvas_stack.pop_back();
+		m_recorder.pop_draw_canvas();
 	}
 
 	void Renderer::set_render_canvas(Canvas canvas) {
@@ -70,271 +65,516 @@ namespace platform {
 		m_render_canvas = {};
 	}
 
-	static void set_pixel_coordinate_projection(Renderer* renderer, const ShaderProgram& shader_program, int width, int height) {
+	void Renderer::push_draw_layer(uint16_t layer) {
+		m_recorder.push_draw_layer(layer);
+	}
+	void Renderer::pop_draw_layer() {
+		m_recorder.pop_draw_layer();
+	}
+
+	void Renderer::push_clip_rect(core::Rect rect) {
+		m_recorder.push_clip_rect(rect);
+	}
+	void Renderer::pop_clip_rect() {
+		m_recorder.pop_clip_rect();
+	}
+
+	void Renderer::set_draw_order(DrawOrder draw_order) {
+		m_draw_order = draw_order;
+	}
+
+	static glm::mat4 pixel_coordinate_projection(int width, int height) {
 		float grid_offset = 0.375f; // used to avoid missing pixels
-		glm::mat4 projection = glm::ortho(grid_offset, grid_offset + width, grid_offset + height, grid_offset, -1.0f, 1.0f);
-		renderer->set_projection(shader_program, projection);
+		return glm::ortho(grid_offset, grid_offset + width, grid_offset + height, grid_offset, -1.0f, 1.0f);
 	}
 
 	void Renderer::render(const ShaderProgram& shader_program) {
+		ASSERT(shader_program.vertex_format == m_vertex_format, "Shader program vertex format does not match renderer");
+		ASSERT(m_quad_mode == QuadMode::Vertices || shader_program.quad_instances, "Drawing instanced quads with a shader program without a quad instance program");
 		m_debug_data = {};
 		Timer render_timer;
 
-		glUseProgram(shader_program.id);
-		glBindVertexArray(shader_program.vao);
-		glBindBuffer(GL_ARRAY_BUFFER, shader_program.vbo);
-
-		/* Upload vertices */
-		glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Vertex), m_vertices.data(), GL_STATIC_DRAW);
-		m_debug_data.num_vertices = m_vertices.size();
-
-		/* Draw vertices */
-		GLint offset = 0;
-		int i = 0;
-		for (const VertexSection& section : m_sections) {
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, section.texture.id);
-
-			std::optional<Canvas> canvas;
-			if (section.canvas) {
-				canvas = section.canvas;
-			}
-			else if (m_render_canvas) {
-				canvas = m_render_canvas;
-			}
-
-			if (canvas) {
-				glBindFramebuffer(GL_FRAMEBUFFER, canvas->framebuffer);
-				glViewport(0, 0, (int)canvas->texture.size.x, (int)canvas->texture.size.y);
-				set_pixel_coordinate_projection(this, shader_program, (int)canvas->texture.size.x, (int)canvas->texture.size.y);
-			}
-
-			m_debug_data.num_draw_calls += 1;
-			glDrawArrays(section.mode, offset, section.length);
-			glBindFramebuffer(GL_FRAMEBUFFER, NULL);
-
-			offset += section.length;
-			i++;
+		/* Sort */
+		if (m_draw_order == DrawOrder::Sorted) {
+			_sort_sections();
 		}
 
-		/* Clear render data */
-		m_vertices.clear();
-		m_sections.clear();
+		/* Record commands */
+		m_debug_data.num_vertices = m_recorder.m_vertices.size();
+		m_debug_data.num_quad_instances = m_recorder.m_quads.size();
+		m_debug_data.num_sections = m_recorder.m_sections.size();
+		m_debug_data.num_raw_sections = m_recorder.m_num_raw_sections;
+		m_debug_data.num_culled = m_recorder.m_num_culled;
+		m_debug_data.passes = std::move(m_pass_stats);
+		m_pass_stats.clear();
+		_collect_text_run_stats();
+		_record_commands();
+
+		/* Execute commands */
+		m_executor->submit(shader_program, &m_command_list);
+		m_debug_data.vertex_stream = m_executor->vertex_stream_stats();
 
-		/* Unbind */
-		glBindBuffer(GL_ARRAY_BUFFER, NULL);
-		glBindVertexArray(NULL);
-		glUseProgram(NULL);
+		/* Clear render data */
+		m_recorder.clear();
+		m_projection.reset();
+		m_command_list.clear();
 
 		m_debug_data.render_ms = render_timer.elapsed_ms();
 		m_debug_data.render_ns = render_timer.elapsed_ns();
 	}
 
 	void Renderer::draw_point(glm::vec2 point, glm::vec4 color) {
-		m_vertices.push_back(Vertex { .pos = point, .color = color });
-		m_sections.push_back(VertexSection { .mode = GL_POINTS, .length = 1, .texture = m_white_texture, .canvas = _current_draw_canvas() });
+		m_recorder.draw_point(point, color);
 	}
 
 	void Renderer::draw_line(glm::vec2 start, glm::vec2 end, glm::vec4 color) {
-		m_vertices.push_back(Vertex { .pos = start, .color = color });
-		m_vertices.push_back(Vertex { .pos = end, .color = color });
-		m_sections.push_back(VertexSection { .mode = GL_LINES, .length = 2, .texture = m_white_texture, .canvas = _current_draw_canvas() });
+		m_recorder.draw_line(start, end, color);
 	}
 
 	void Renderer::draw_rect(core::Rect quad, glm::vec4 color) {
-		// (x0, y0) ---- (x1, y0)
-		//     |            |
-		//     |            |
-		// (x0, y1) ---- (x1, y1)
-		float x0 = quad.top_left.x;
-		float y0 = quad.top_left.y;
-		float x1 = quad.bottom_right.x;
-		float y1 = quad.bottom_right.y;
+		m_recorder.draw_rect(quad, color);
+	}
 
-		m_vertices.push_back(Vertex { .pos = { x0, y0 }, .color = color });
-		m_vertices.push_back(Vertex { .pos = { x0, y1 }, .color = color });
-		m_vertices.push_back(Vertex { .pos = { x1, y1 }, .color = color });
-		m_vertices.push_back(Vertex { .pos = { x1, y0 }, .color = color });
+	void Renderer::draw_rect_fill(core::Rect quad, glm::vec4 color) {
+		m_recorder.draw_rect_fill(quad, color);
+	}
 
-		m_sections.push_back(VertexSection { .mode = GL_LINE_LOOP, .length = 4, .texture = m_white_texture, .canvas = _current_draw_canvas() });
+	void Renderer::draw_circle(glm::vec2 center, float radius, glm::vec4 color) {
+		m_recorder.draw_circle(center, radius, color);
 	}
 
-	void Renderer::draw_rect_fill(core::Rect quad, glm::vec4 color) {
-		// (x0, y0) ---- (x1, y0)
-		//     |            |
-		//     |            |
-		// (x0, y1) ---- (x1, y1)
-		float x0 = quad.top_left.x;
-		float y0 = quad.top_left.y;
-		float x1 = quad.bottom_right.x;
-		float y1 = quad.bottom_right.y;
+	void Renderer::draw_circle_fill(glm::vec2 center, float radius, glm::vec4 color) {
+		m_recorder.draw_circle_fill(center, radius, color);
+	}
 
-		// first triangle
-		m_vertices.push_back(Vertex { .pos = { x0, y0 }, .color = color });
-		m_vertices.push_back(Vertex { .pos = { x0, y1 }, .color = color });
-		m_vertices.push_back(Vertex { .pos = { x1, y0 }, .color = color });
+	void Renderer::draw_texture(Texture texture, core::Rect quad) {
+		m_recorder.draw_texture(texture, quad);
+	}
 
-		// second triangle
-		m_vertices.push_back(Vertex { .pos = { x0, y1 }, .color = color });
-		m_vertices.push_back(Vertex { .pos = { x1, y0 }, .color = color });
-		m_vertices.push_back(Vertex { .pos = { x1, y1 }, .color = color });
+	void Renderer::draw_texture_clipped(Texture texture, core::Rect quad, core::FlipRect uv) {
+		m_recorder.draw_texture_clipped(texture, quad, uv);
+	}
 
-		// sections
-		m_sections.push_back(VertexSection { .mode = GL_TRIANGLES, .length = 6, .texture = m_white_texture, .canvas = _current_draw_canvas() });
+	void Renderer::draw_texture_clipped_with_color(Texture texture, core::Rect quad, core::FlipRect uv, glm::vec4 color) {
+		m_recorder.draw_texture_clipped_with_color(texture, quad, uv, color);
 	}
 
-	void Renderer::draw_circle(glm::vec2 center, float radius, glm::vec4 color) {
-		std::vector<glm::vec2> quadrant_points = circle_octant_points(radius);
-		for (const glm::vec2& point : quadrant_points) {
-			float x = point.x;
-			float y = point.y;
-			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { x, y }, .color = color });
-			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { y, x }, .color = color });
-			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { y, -x }, .color = color });
-			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { x, -y }, .color = color });
-			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { -x, -y }, .color = color });
-			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { -y, -x }, .color = color });
-			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { -y, x }, .color = color });
-			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { -x, y }, .color = color });
-		}
+	void Renderer::draw_character(const Font& font, char character, glm::vec2 pos, glm::vec4 color) {
+		m_recorder.draw_character(font, character, pos, color);
+	}
 
-		m_sections.push_back(VertexSection { .mode = GL_POINTS, .length = 8 * (GLsizei)quadrant_points.size(), .texture = m_white_texture, .canvas = _current_draw_canvas() });
+	void Renderer::draw_text(const Font& font, const std::string& text, glm::vec2 pos, glm::vec4 color) {
+		m_recorder.draw_text(font, text, pos, color);
 	}
 
-	void Renderer::draw_circle_fill(glm::vec2 center, float radius, glm::vec4 color) {
-		/* Get points of upper half circle */
-		std::vector<glm::vec2> quadrant_points = circle_octant_points(radius);
-		std::vector<glm::vec2> half_circle_points;
-		for (const glm::vec2& point : quadrant_points) {
-			float x = point.x;
-			float y = point.y;
-			half_circle_points.push_back(glm::vec2 { x, y });
-			half_circle_points.push_back(glm::vec2 { y, x });
-			half_circle_points.push_back(glm::vec2 { -x, y });
-			half_circle_points.push_back(glm::vec2 { -y, x });
-		}
+	void Renderer::draw_text_centered(const Font& font, const std::string& text, glm::vec2 pos, glm::vec4 color) {
+		m_recorder.draw_text_centered(font, text, pos, color);
+	}
 
-		/* Remove points with overlapping x-coordinates to avoid overdraw */
-		{
-			std::vector<glm::vec2>& p = half_circle_points;
-			std::sort(p.begin(), p.end(), [](const glm::vec2& lhs, const glm::vec2& rhs) { return lhs.x < rhs.x; });
-			p.erase(std::unique(p.begin(), p.end(), [](const glm::vec2& lhs, const glm::vec2& rhs) { return lhs.x == rhs.x; }), p.end());
+	DrawRecorder Renderer::make_static_batch_recorder() const {
+		// Static batches are drawn from vertices, so quads are never instanced
+		return DrawRecorder(m_white_texture, QuadMode::Vertices);
+	}
+
+	StaticBatch Renderer::add_static_batch(const DrawRecorder& recorder) {
+		const uint32_t id = m_next_static_batch_id++;
+		m_static_batches[id] = _upload_static_batch(recorder);
+		return StaticBatch { id };
+	}
+
+	void Renderer::update_static_batch(StaticBatch batch, const DrawRecorder& recorder) {
+		StaticBatchData& batch_data = m_static_batches.at(batch.id);
+		m_gl_context->free_vertex_buffer(batch_data.vertex_buffer);
+		batch_data = _upload_static_batch(recorder);
+	}
+
+	void Renderer::free_static_batch(StaticBatch batch) {
+		auto it = m_static_batches.find(batch.id);
+		if (it != m_static_batches.end()) {
+			m_gl_context->free_vertex_buffer(it->second.vertex_buffer);
+			m_static_batches.erase(it);
 		}
+	}
+
+	void Renderer::draw_static_batch(StaticBatch batch) {
+		m_recorder.draw_static_batch(batch);
+	}
+
+	DrawRecorder Renderer::make_recorder() const {
+		// Start from the current canvas and layer, like drawing here would
+		DrawRecorder recorder(m_white_texture, m_quad_mode);
+		recorder._copy_draw_state(m_recorder);
+		return recorder;
+	}
+
+	void Renderer::submit(DrawRecorder* recorder) {
+		m_recorder.append(*recorder);
+		recorder->clear();
+	}
+
+	void Renderer::set_max_draw_threads(size_t max_draw_threads) {
+		m_max_draw_threads = std::max<size_t>(max_draw_threads, 1);
+		m_draw_workers.resize(m_max_draw_threads);
+	}
+
+	void Renderer::add_pass_stats(RenderPassStats stats) {
+		m_pass_stats.push_back(std::move(stats));
+	}
+
+	RenderDebugData Renderer::debug_data() const {
+		return m_debug_data;
+	}
 
-		/* Draw vertical lines */
-		for (const glm::vec2& point : half_circle_points) {
-			float x = point.x;
-			float y = point.y;
-			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { x, y }, .color = color });
-			m_vertices.push_back(Vertex { .pos = center + glm::vec2 { x, -y }, .color = color });
+	size_t Renderer::_prepare_worker_recorders(size_t num_items, size_t min_items_per_chunk) {
+		const size_t num_chunks = std::min(m_max_draw_threads, num_items / std::max<size_t>(min_items_per_chunk, 1));
+		while (m_worker_recorders.size() < num_chunks) {
+			m_worker_recorders.push_back(DrawRecorder(m_white_texture, m_quad_mode));
+		}
+		for (size_t i = 0; i < num_chunks; i++) {
+			_reset_worker_recorder(i);
 		}
-		m_sections.push_back(VertexSection { .mode = GL_LINES, .length = 2 * (GLsizei)half_circle_points.size(), .texture = m_white_texture, .canvas = _current_draw_canvas() });
+		return num_chunks;
 	}
 
-	void Renderer::draw_texture(Texture texture, core::Rect quad) {
-		core::FlipRect uv = {
-			.bottom_left = { 0.0f, 0.0f },
-			.top_right = { 1.0f, 1.0f }
+	void Renderer::_reset_worker_recorder(size_t index) {
+		DrawRecorder& recorder = m_worker_recorders[index];
+		recorder.clear();
+		recorder._copy_draw_state(m_recorder);
+	}
+
+	void Renderer::_collect_text_run_stats() {
+		TextRunCacheStats& text_runs = m_debug_data.text_runs;
+		auto collect = [&](DrawRecorder* recorder) {
+			const TextRunCacheStats stats = recorder->m_text_run_cache.stats();
+			text_runs.num_hits += stats.num_hits;
+			text_runs.num_misses += stats.num_misses;
+			text_runs.num_evictions += stats.num_evictions;
+			text_runs.num_incomplete += stats.num_incomplete;
+			recorder->m_text_run_cache.reset_stats();
 		};
-		draw_texture_clipped(texture, quad, uv);
+		collect(&m_recorder);
+		for (DrawRecorder& recorder : m_worker_recorders) {
+			collect(&recorder);
+		}
 	}
 
-	void Renderer::draw_texture_clipped(Texture texture, core::Rect quad, core::FlipRect uv) {
-		glm::vec4 white = { 1.0f, 1.0f, 1.0f, 1.0f };
-		draw_texture_clipped_with_color(texture, quad, uv, white);
+	uint16_t Renderer::_canvas_pass_index(const std::optional<Canvas>& canvas) {
+		// Sections without a canvas go to the render canvas, which is drawn last
+		if (!canvas) {
+			return UINT16_MAX;
+		}
+
+		auto it = std::find(m_recorder.m_canvas_pass_order.begin(), m_recorder.m_canvas_pass_order.end(), canvas->framebuffer);
+		if (it == m_recorder.m_canvas_pass_order.end()) {
+			// canvas still pushed, draw it after all finished ones
+			m_recorder.m_canvas_pass_order.push_back(canvas->framebuffer);
+			return (uint16_t)(m_recorder.m_canvas_pass_order.size() - 1);
+		}
+		return (uint16_t)(it - m_recorder.m_canvas_pass_order.begin());
 	}
 
-	void Renderer::draw_texture_clipped_with_color(Texture texture, core::Rect quad, core::FlipRect uv, glm::vec4 color) {
-		// (x0, y0) ---- (x1, y0)
-		//     |            |
-		//     |            |
-		// (x0, y1) ---- (x1, y1)
-		float x0 = quad.top_left.x;
-		float y0 = quad.top_left.y;
-		float x1 = quad.bottom_right.x;
-		float y1 = quad.bottom_right.y;
-
-		// (u0, v1) ---- (u1, v1)
-		//     |            |
-		//     |            |
-		// (u0, v0) ---- (u1, v0)
-		float u0 = uv.bottom_left.x;
-		float v0 = uv.bottom_left.y;
-		float u1 = uv.top_right.x;
-		float v1 = uv.top_right.y;
-
-		// first triangle
-		m_vertices.push_back(Vertex { .pos = { x0, y0 }, .color = color, .uv = { u0, v1 } });
-		m_vertices.push_back(Vertex { .pos = { x0, y1 }, .color = color, .uv = { u0, v0 } });
-		m_vertices.push_back(Vertex { .pos = { x1, y0 }, .color = color, .uv = { u1, v1 } });
-
-		// second triangle
-		m_vertices.push_back(Vertex { .pos = { x0, y1 }, .color = color, .uv = { u0, v0 } });
-		m_vertices.push_back(Vertex { .pos = { x1, y0 }, .color = color, .uv = { u1, v1 } });
-		m_vertices.push_back(Vertex { .pos = { x1, y1 }, .color = color, .uv = { u1, v0 } });
-
-		// sections
-		m_sections.push_back(VertexSection { .mode = GL_TRIANGLES, .length = 6, .texture = texture, .canvas = _current_draw_canvas() });
+	// Scissor rect covering the pixels of `rect` in a canvas, which has its
+	// origin in the top left unlike the scissor rect
+	static ScissorRect canvas_scissor_rect(const core::Rect& rect, glm::vec2 canvas_size) {
+		const glm::ivec2 min = glm::floor(rect.top_left);
+		const glm::ivec2 max = glm::max(glm::ivec2(glm::ceil(rect.bottom_right)), min);
+		return ScissorRect { .pos = { min.x, (int)canvas_size.y - max.y }, .size = max - min };
 	}
 
-	void Renderer::draw_character(const Font& font, char character, glm::vec2 pos, glm::vec4 color) {
-		const platform::Glyph& glyph = font.glyphs[character];
+	static bool scissor_rects_are_equal(const std::optional<ScissorRect>& lhs, const std::optional<ScissorRect>& rhs) {
+		if (lhs.has_value() != rhs.has_value()) {
+			return false;
+		}
+		return !lhs.has_value() || (lhs->pos == rhs->pos && lhs->size == rhs->size);
+	}
 
-		core::Rect quad = {
-			.top_left = { pos.x, pos.y },
-			.bottom_right = { pos.x + glyph.size.x, pos.y + glyph.size.y }
-		};
+	void Renderer::_record_commands() {
+		m_command_list.vertex_format = m_vertex_format;
+		m_section_uv_scales.assign(m_recorder.m_sections.size(), 1.0f);
 
-		float u0 = glyph.atlas_pos.x / (float)font.atlas.size.x;
-		float v0 = 1 - (glyph.atlas_pos.y + glyph.size.y) / (float)font.atlas.size.y;
-		float u1 = u0 + glyph.size.x / (float)font.atlas.size.x;
-		float v1 = v0 + glyph.size.y / (float)font.atlas.size.y;
+		/* Vertices */
+		if (m_vertex_format == VertexFormat::Standard) {
+			std::swap(m_command_list.vertices, m_recorder.m_vertices);
+			m_debug_data.num_vertex_bytes = m_command_list.vertices.size() * sizeof(Vertex);
+		}
+		else {
+			_pack_vertices();
+			m_debug_data.num_vertex_bytes = m_command_list.packed_vertices.size() * sizeof(PackedVertex);
+		}
 
-		core::FlipRect uv = {
-			.bottom_left = { u0, v0 },
-			.top_right = { u1, v1 }
-		};
+		/* Quad instances */
+		_pack_quad_instances();
+		m_debug_data.num_quad_instance_bytes = m_command_list.quad_instances.size() * sizeof(QuadInstance);
+
+		/* Commands */
+		std::vector<RenderCommand>& commands = m_command_list.commands;
+		m_debug_data.num_program_binds = 1; // bound by the executor for the whole frame
+		if (m_projection) {
+			commands.push_back(cmd::render::SetProjection { m_projection.value() });
+		}
+
+		GLint offset = 0;
+		GLint instance_offset = 0;
+		std::optional<Canvas> bound_canvas;
+		std::optional<GLuint> bound_texture;
+		std::optional<ScissorRect> bound_scissor;
+		float bound_uv_scale = 0.0f;
+		bool bound_distance_field = false;
+		for (size_t i = 0; i < m_recorder.m_sections.size(); i++) {
+			const VertexSection& section = m_recorder.m_sections[i];
+
+			// static batches bind their own textures
+			if (!section.static_batch && bound_texture != section.texture.id) {
+				commands.push_back(cmd::render::BindTexture { section.texture });
+				bound_texture = section.texture.id;
+				m_debug_data.num_texture_binds += 1;
+			}
+
+			// instance draws carry their own uv scale
+			if (m_vertex_format == VertexFormat::Packed && !section.instanced && !section.static_batch && m_section_uv_scales[i] != bound_uv_scale) {
+				commands.push_back(cmd::render::SetUvScale { m_section_uv_scales[i] });
+				bound_uv_scale = m_section_uv_scales[i];
+			}
+
+			if (!section.static_batch && section.distance_field != bound_distance_field) {
+				commands.push_back(cmd::render::SetDistanceField { section.distance_field });
+				bound_distance_field = section.distance_field;
+			}
+
+			std::optional<Canvas> canvas = section.canvas ? section.canvas : m_render_canvas;
+			if (!canvases_are_equal(canvas, bound_canvas)) {
+				if (canvas) {
+					commands.push_back(cmd::render::BindCanvas { canvas.value() });
+					commands.push_back(cmd::render::SetProjection { pixel_coordinate_projection((int)canvas->texture.size.x, (int)canvas->texture.size.y) });
+				}
+				else {
+					commands.push_back(cmd::render::UnbindCanvas {});
+				}
+				bound_canvas = canvas;
+				m_debug_data.num_canvas_binds += 1;
+			}
 
-		draw_texture_clipped_with_color(font.atlas, quad, uv, color);
+			// clip rects are in canvas pixels, so without a canvas there's
+			// nothing to scissor to and only culling applies
+			const std::optional<ScissorRect> scissor = section.scissor && canvas ? std::make_optional(canvas_scissor_rect(*section.scissor, canvas->texture.size)) : std::nullopt;
+			if (!scissor_rects_are_equal(scissor, bound_scissor)) {
+				if (scissor) {
+					commands.push_back(cmd::render::SetScissor { scissor.value() });
+				}
+				else {
+					commands.push_back(cmd::render::DisableScissor {});
+				}
+				bound_scissor = scissor;
+			}
+
+			if (section.static_batch) {
+				_record_static_batch(m_static_batches.at(section.static_batch), &bound_texture, &bound_uv_scale, &bound_distance_field);
+				continue;
+			}
+
+			m_debug_data.num_draw_calls += 1;
+			if (section.instanced) {
+				commands.push_back(cmd::render::DrawQuadInstances { .first = instance_offset, .count = section.length, .uv_scale = m_section_uv_scales[i] });
+				instance_offset += section.length;
+				m_debug_data.num_program_binds += 2;
+				continue;
+			}
+			if (section.indexed) {
+				commands.push_back(cmd::render::DrawQuads { .first = offset, .num_vertices = section.length });
+			}
+			else {
+				commands.push_back(cmd::render::DrawArrays { .mode = section.mode, .first = offset, .count = section.length });
+			}
+
+			offset += section.length;
+		}
+
+		if (bound_scissor) {
+			commands.push_back(cmd::render::DisableScissor {});
+		}
+		// uniforms outlive the frame, leave the program as next frame expects
+		if (bound_distance_field) {
+			commands.push_back(cmd::render::SetDistanceField { false });
+		}
 	}
 
-	void Renderer::draw_text(const Font& font, const std::string& text, glm::vec2 pos, glm::vec4 color) {
-		glm::vec2 pen = pos;
-		const char* chars = text.data();
-		for (char character = *chars; character != '\0'; character = *(++chars)) {
-			const platform::Glyph& glyph = font.glyphs[character];
-
-			if (character != ' ') {
-				glm::vec2 glyph_pos = glm::vec2 {
-					pen.x + glyph.bearing.x,
-					pen.y - glyph.bearing.y,
-				};
-				draw_character(font, character, glyph_pos, color);
+	// Power of two scale so that uvs up to `max_uv` fit in [0, 1] when
+	// normalized. Most sections sample within a texture and get 1.
+	static float uv_scale_for(float max_uv) {
+		return exp2f(ceilf(log2f(max_uv)));
+	}
+
+	// Packs a section's vertices into `packed` and returns the uv scale they
+	// were packed with
+	static float pack_section_vertices(const Vertex* first, const Vertex* last, PackedVertex* packed) {
+		float max_uv = 1.0f;
+		for (const Vertex* vertex = first; vertex != last; vertex++) {
+			max_uv = std::max({ max_uv, vertex->uv.x, vertex->uv.y });
+		}
+		const float uv_scale = uv_scale_for(max_uv);
+
+		for (const Vertex* vertex = first; vertex != last; vertex++) {
+			*packed++ = pack_vertex(*vertex, uv_scale);
+		}
+		return uv_scale;
+	}
+
+	void Renderer::_record_static_batch(const StaticBatchData& batch, std::optional<GLuint>* bound_texture, float* bound_uv_scale, bool* bound_distance_field) {
+		std::vector<RenderCommand>& commands = m_command_list.commands;
+		commands.push_back(cmd::render::BindVertexBuffer { batch.vertex_buffer });
+
+		GLint offset = 0;
+		for (size_t i = 0; i < batch.sections.size(); i++) {
+			const VertexSection& section = batch.sections[i];
+
+			if (*bound_texture != section.texture.id) {
+				commands.push_back(cmd::render::BindTexture { section.texture });
+				*bound_texture = section.texture.id;
+				m_debug_data.num_texture_binds += 1;
+			}
+			if (m_vertex_format == VertexFormat::Packed && batch.uv_scales[i] != *bound_uv_scale) {
+				commands.push_back(cmd::render::SetUvScale { batch.uv_scales[i] });
+				*bound_uv_scale = batch.uv_scales[i];
+			}
+			if (section.distance_field != *bound_distance_field) {
+				commands.push_back(cmd::render::SetDistanceField { section.distance_field });
+				*bound_distance_field = section.distance_field;
 			}
 
-			pen.x += glyph.advance;
+			m_debug_data.num_draw_calls += 1;
+			if (section.indexed) {
+				commands.push_back(cmd::render::DrawQuads { .first = offset, .num_vertices = section.length });
+			}
+			else {
+				commands.push_back(cmd::render::DrawArrays { .mode = section.mode, .first = offset, .count = section.length });
+			}
+			offset += section.length;
 		}
+
+		commands.push_back(cmd::render::BindStreamedVertices {});
+		m_debug_data.num_static_vertices += batch.vertex_buffer.num_vertices;
 	}
 
-	void Renderer::draw_text_centered(const Font& font, const std::string& text, glm::vec2 pos, glm::vec4 color) {
-		glm::vec2 box_size = { 0.0f, 0.0f };
-		box_size.y = (float)font.line_height;
+	Renderer::StaticBatchData Renderer::_upload_static_batch(const DrawRecorder& recorder) {
+		ASSERT(recorder.m_quads.empty(), "Static batch has instanced quads, record it with make_static_batch_recorder");
+		for (const VertexSection& section : recorder.m_sections) {
+			ASSERT(!section.canvas, "Static batch draws to a canvas, it's drawn to the canvas it's drawn in instead");
+			ASSERT(!section.static_batch, "Static batch draws another static batch");
+		}
 
-		const char* chars = text.data();
-		for (char character = *chars; character != '\0'; character = *(++chars)) {
-			const platform::Glyph& glyph = font.glyphs[character];
-			box_size.x += glyph.advance;
+		StaticBatchData batch = { .sections = recorder.m_sections };
+		batch.uv_scales.assign(batch.sections.size(), 1.0f);
+		switch (m_vertex_format) {
+			case VertexFormat::Standard:
+				batch.vertex_buffer = m_gl_context->add_vertex_buffer(recorder.m_vertices);
+				break;
+
+			case VertexFormat::Packed: {
+				std::vector<PackedVertex> packed_vertices(recorder.m_vertices.size());
+				GLsizei offset = 0;
+				for (size_t i = 0; i < batch.sections.size(); i++) {
+					const Vertex* first = recorder.m_vertices.data() + offset;
+					batch.uv_scales[i] = pack_section_vertices(first, first + batch.sections[i].length, packed_vertices.data() + offset);
+					offset += batch.sections[i].length;
+				}
+				batch.vertex_buffer = m_gl_context->add_packed_vertex_buffer(packed_vertices);
+			} break;
 		}
+		return batch;
+	}
 
-		draw_text(font, text, pos - box_size / 2.0f, color);
+	void Renderer::_pack_vertices() {
+		std::vector<PackedVertex>& packed_vertices = m_command_list.packed_vertices;
+		packed_vertices.resize(m_recorder.m_vertices.size());
+		GLsizei offset = 0;
+		for (size_t i = 0; i < m_recorder.m_sections.size(); i++) {
+			const VertexSection& section = m_recorder.m_sections[i];
+			if (section.instanced || section.static_batch) {
+				continue;
+			}
+			const Vertex* first = m_recorder.m_vertices.data() + offset;
+			m_section_uv_scales[i] = pack_section_vertices(first, first + section.length, packed_vertices.data() + offset);
+			offset += section.length;
+		}
 	}
 
-	RenderDebugData Renderer::debug_data() const {
-		return m_debug_data;
+	void Renderer::_pack_quad_instances() {
+		std::vector<QuadInstance>& quad_instances = m_command_list.quad_instances;
+		quad_instances.resize(m_recorder.m_quads.size());
+		GLsizei offset = 0;
+		for (size_t i = 0; i < m_recorder.m_sections.size(); i++) {
+			const VertexSection& section = m_recorder.m_sections[i];
+			if (!section.instanced) {
+				continue;
+			}
+			const Quad* first = m_recorder.m_quads.data() + offset;
+			const Quad* last = first + section.length;
+
+			float max_uv = 1.0f;
+			for (const Quad* quad = first; quad != last; quad++) {
+				max_uv = std::max({ max_uv, quad->uv0.x, quad->uv0.y, quad->uv1.x, quad->uv1.y });
+			}
+			const float uv_scale = uv_scale_for(max_uv);
+			m_section_uv_scales[i] = uv_scale;
+
+			for (GLsizei j = offset; j < offset + section.length; j++) {
+				quad_instances[j] = pack_quad(m_recorder.m_quads[j], uv_scale);
+			}
+			offset += section.length;
+		}
 	}
 
-	std::optional<Canvas> Renderer::_current_draw_canvas() {
-		return m_draw_canvas_stack.empty() ? std::nullopt : std::make_optional(m_draw_canvas_stack.back());
+	void Renderer::_sort_sections() {
+		// 64-bit sort key:
+		// | canvas pass (16) | layer (16) | texture (24) | primitive mode (8) |
+		m_sort_keys.clear();
+		for (uint32_t i = 0; i < (uint32_t)m_recorder.m_sections.size(); i++) {
+			const VertexSection& section = m_recorder.m_sections[i];
+			const uint64_t canvas_bits = _canvas_pass_index(section.canvas);
+			const uint64_t layer_bits = section.layer;
+			const uint64_t texture_bits = section.texture.id & 0xFFFFFF;
+			const uint64_t mode_bits = section.mode & 0xFF;
+			const uint64_t key = canvas_bits << 48 | layer_bits << 32 | texture_bits << 8 | mode_bits;
+			m_sort_keys.push_back(core::SortKey { key, i });
+		}
+		core::radix_sort(&m_sort_keys, &m_sort_scratch);
+
+		// find start of each section's vertices or quads
+		m_section_offsets.resize(m_recorder.m_sections.size());
+		GLsizei offset = 0;
+		GLsizei quad_offset = 0;
+		for (size_t i = 0; i < m_recorder.m_sections.size(); i++) {
+			GLsizei& section_offset = m_recorder.m_sections[i].instanced ? quad_offset : offset;
+			m_section_offsets[i] = section_offset;
+			section_offset += m_recorder.m_sections[i].length;
+		}
+
+		// gather vertices in sorted order, merging sections that end up adjacent
+		m_sorted_vertices.clear();
+		m_sorted_quads.clear();
+		m_sorted_sections.clear();
+		for (const core::SortKey& sort_key : m_sort_keys) {
+			const VertexSection& section = m_recorder.m_sections[sort_key.index];
+			if (section.instanced) {
+				const Quad* first = m_recorder.m_quads.data() + m_section_offsets[sort_key.index];
+				m_sorted_quads.insert(m_sorted_quads.end(), first, first + section.length);
+			}
+			else {
+				const Vertex* first = m_recorder.m_vertices.data() + m_section_offsets[sort_key.index];
+				m_sorted_vertices.insert(m_sorted_vertices.end(), first, first + section.length);
+			}
+
+			if (!m_sorted_sections.empty() && DrawRecorder::sections_are_mergeable(m_sorted_sections.back(), section)) {
+				m_sorted_sections.back().length += section.length;
+			}
+			else {
+				m_sorted_sections.push_back(section);
+			}
+		}
+
+		std::swap(m_recorder.m_vertices, m_sorted_vertices);
+		std::swap(m_recorder.m_quads, m_sorted_quads);
+		std::swap(m_recorder.m_sections, m_sorted_sections);
 	}
 
 } // namespace platform
@@ -1,30 +1,57 @@
 #pragma once
 
+#include <core/radix_sort.h>
 #include <core/rect.h>
+#include <core/worker_pool.h>
 #include <platform/graphics/canvas.h>
 #include <platform/graphics/color.h>
+#include <platform/graphics/draw_recorder.h>
 #include <platform/graphics/font.h>
 #include <platform/graphics/image.h>
+#include <platform/graphics/render_command.h>
+#include <platform/graphics/render_executor.h>
 #include <platform/graphics/renderer_debug.h>
 #include <platform/graphics/shader_program.h>
+#include <platform/graphics/static_batch.h>
 #include <platform/graphics/texture.h>
 #include <platform/graphics/vertex.h>
+#include <platform/graphics/vertex_buffer.h>
 
 #include <glm/glm.hpp>
 
 #include <optional>
+#include <stdint.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace platform {
 
 	class OpenGLContext;
 
+	enum class DrawOrder {
+		// Draw everything in the order it was submitted
+		Submission,
+		// Group draws by canvas, layer, texture and primitive. Draws within a
+		// layer keep their relative order only if they share texture and
+		// primitive, so use separate layers for draws that must overlap.
+		Sorted,
+	};
+
 	class Renderer {
 	public:
-		Renderer(OpenGLContext* gl_context);
+		Renderer(OpenGLContext* gl_context, VertexFormat vertex_format = VertexFormat::Standard, QuadMode quad_mode = QuadMode::Vertices);
+		Renderer(const Renderer&) = delete;
+		Renderer& operator=(const Renderer&) = delete;
+
+		// Frees the white texture, the OpenGL executor's quad index buffer
+		// and the static batches that haven't been freed
+		void shutdown(OpenGLContext* gl_context);
 
-		void set_projection(const ShaderProgram& shader_program, glm::mat4 projection);
+		// Executes the recorded commands on render, the OpenGL executor if null
+		void set_executor(IRenderExecutor* executor);
+
+		void set_projection(glm::mat4 projection);
 
 		void push_draw_canvas(Canvas canvas);
 		void pop_draw_canvas();
@@ -32,6 +59,15 @@ namespace platform {
 		void set_render_canvas(Canvas canvas);
 		void reset_render_canvas();
 
+		void push_draw_layer(uint16_t layer);
+		void pop_draw_layer();
+
+		// Clips draws to `rect`, see DrawRecorder
+		void push_clip_rect(core::Rect rect);
+		void pop_clip_rect();
+
+		void set_draw_order(DrawOrder draw_order);
+
 		void render(const ShaderProgram& shader_program);
 
 		void draw_point(glm::vec2 point, glm::vec4 color);
@@ -49,23 +85,102 @@ namespace platform {
 		void draw_text(const Font& font, const std::string& text, glm::vec2 pos, glm::vec4 color);
 		void draw_text_centered(const Font& font, const std::string& text, glm::vec2 pos, glm::vec4 color);
 
+		// Static batches keep what a recorder drew in their own vertex buffer,
+		// so that content that doesn't change between frames is uploaded
+		// once. A batch is drawn as a whole into the current canvas and
+		// layer, and must be updated when what it was drawn from changes.
+		DrawRecorder make_static_batch_recorder() const;
+		StaticBatch add_static_batch(const DrawRecorder& recorder);
+		void update_static_batch(StaticBatch batch, const DrawRecorder& recorder);
+		void free_static_batch(StaticBatch batch);
+		void draw_static_batch(StaticBatch batch);
+
+		// Recorder for drawing on another thread, starting from the current
+		// draw canvas and layer. Submitted recorders are drawn in the order
+		// they're submitted, as if their draws had been made here.
+		DrawRecorder make_recorder() const;
+		void submit(DrawRecorder* recorder);
+
+		// Draws `num_items` items split into chunks on worker threads, by
+		// calling `draw_items(DrawRecorder*, size_t first, size_t last)` for
+		// each chunk. The output is the same as drawing every item here in
+		// order. The worker threads are kept by the renderer between calls,
+		// one for each of the `max_draw_threads` chunks. Chunks have at least `min_items_per_chunk` items, so small
+		// batches are drawn on the calling thread. Glyph caches only add
+		// glyphs on the thread that made them, so chunks that missed glyphs
+		// are drawn again on the calling thread, which should be that one.
+		template <typename F>
+		void draw_parallel(size_t num_items, size_t min_items_per_chunk, F&& draw_items) {
+			const size_t num_chunks = _prepare_worker_recorders(num_items, min_items_per_chunk);
+			if (num_chunks <= 1) {
+				draw_items(&m_recorder, (size_t)0, num_items);
+				return;
+			}
+
+			m_draw_workers.run(num_chunks, [&](size_t chunk) {
+				draw_items(&m_worker_recorders[chunk], chunk * num_items / num_chunks, (chunk + 1) * num_items / num_chunks);
+			});
+			for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+				if (m_worker_recorders[chunk].missed_glyphs()) {
+					_reset_worker_recorder(chunk);
+					draw_items(&m_worker_recorders[chunk], chunk * num_items / num_chunks, (chunk + 1) * num_items / num_chunks);
+				}
+				submit(&m_worker_recorders[chunk]);
+			}
+		}
+		void set_max_draw_threads(size_t max_draw_threads);
+
+		// Reported by RenderGraph, shown in the debug data of the next render
+		void add_pass_stats(RenderPassStats stats);
+
 		RenderDebugData debug_data() const;
 
 	private:
-		struct VertexSection {
-			GLenum mode;
-			GLsizei length;
-			Texture texture;
-			std::optional<Canvas> canvas;
+		struct StaticBatchData {
+			VertexBuffer vertex_buffer;
+			std::vector<VertexSection> sections;
+			std::vector<float> uv_scales; // per section, with VertexFormat::Packed
 		};
 
-		std::optional<Canvas> _current_draw_canvas();
-
-		std::vector<Vertex> m_vertices;
-		std::vector<VertexSection> m_sections;
+		StaticBatchData _upload_static_batch(const DrawRecorder& recorder);
+		void _record_static_batch(const StaticBatchData& batch, std::optional<GLuint>* bound_texture, float* bound_uv_scale, bool* bound_distance_field);
+		size_t _prepare_worker_recorders(size_t num_items, size_t min_items_per_chunk);
+		void _reset_worker_recorder(size_t index);
+		void _collect_text_run_stats();
+		void _sort_sections();
+		uint16_t _canvas_pass_index(const std::optional<Canvas>& canvas);
+		void _record_commands();
+		void _pack_vertices();
+		void _pack_quad_instances();
+
+		OpenGLContext* m_gl_context;
+		GLRenderExecutor m_gl_executor;
+		IRenderExecutor* m_executor;
+		VertexFormat m_vertex_format;
+		QuadMode m_quad_mode;
+		RenderCommandList m_command_list;
 		Texture m_white_texture;
-		std::vector<Canvas> m_draw_canvas_stack;
+		DrawRecorder m_recorder;
+		std::vector<DrawRecorder> m_worker_recorders; // kept to avoid reallocating every frame
+		size_t m_max_draw_threads;
+		core::WorkerPool m_draw_workers; // started by the first parallel draw
+		std::optional<glm::mat4> m_projection; // applied at start of next render
 		std::optional<Canvas> m_render_canvas;
+		DrawOrder m_draw_order = DrawOrder::Submission;
+		std::unordered_map<uint32_t, StaticBatchData> m_static_batches;
+		uint32_t m_next_static_batch_id = 1; // 0 is used for sections without a batch
+
+		// scratch buffers for sorting, kept to avoid reallocating every frame
+		std::vector<core::SortKey> m_sort_keys;
+		std::vector<core::SortKey> m_sort_scratch;
+		std::vector<GLsizei> m_section_offsets;
+		std::vector<Vertex> m_sorted_vertices;
+		std::vector<Quad> m_sorted_quads;
+		std::vector<VertexSection> m_sorted_sections;
+
+		// uv scale for each section when packing vertices or quads
+		std::vector<float> m_section_uv_scales;
+		std::vector<RenderPassStats> m_pass_stats; // since last render
 		RenderDebugData m_debug_data;
 	};
 
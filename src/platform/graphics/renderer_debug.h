@@ -1,12 +1,37 @@
 #pragma once
 
+#include <platform/graphics/streaming_buffer.h>
+#include <platform/graphics/text_run_cache.h>
+
 #include <stdint.h>
+#include <string>
+#include <vector>
 
 namespace platform {
 
+	struct RenderPassStats {
+		std::string name;
+		bool skipped = false; // up to date since an earlier frame
+		size_t num_skipped_frames = 0; // in a row, including this one
+		uint64_t record_ns = 0;
+	};
+
 	struct RenderDebugData {
 		size_t num_draw_calls = 0;
-		size_t num_vertices = 0;
+		size_t num_vertices = 0; // drawn by draw calls this frame
+		size_t num_vertex_bytes = 0; // uploaded this frame
+		size_t num_static_vertices = 0; // drawn from static batches, already uploaded
+		size_t num_quad_instances = 0;
+		size_t num_quad_instance_bytes = 0; // uploaded this frame
+		size_t num_sections = 0; // after merging adjacent sections
+		size_t num_raw_sections = 0; // as pushed by draw calls
+		size_t num_culled = 0; // draws and glyphs dropped outside the canvas or clip rect
+		size_t num_texture_binds = 0;
+		size_t num_canvas_binds = 0; // including unbinding back to the window
+		size_t num_program_binds = 0; // instanced quad draws switch to their own program and back
+		StreamingBufferStats vertex_stream;
+		TextRunCacheStats text_runs; // drawn since last render
+		std::vector<RenderPassStats> passes; // render graph passes, in the order they were drawn
 		uint64_t render_ms = 0;
 		uint64_t render_ns = 0;
 	};
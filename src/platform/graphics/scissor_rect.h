@@ -0,0 +1,14 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace platform {
+
+	// Pixels let through by the scissor test, in window coordinates with
+	// (0, 0) in the bottom left corner of the target like glScissor
+	struct ScissorRect {
+		glm::ivec2 pos;
+		glm::ivec2 size;
+	};
+
+} // namespace platform
@@ -1,16 +1,35 @@
 #pragma once
 
+#include <platform/graphics/vertex.h>
+
 #include <SDL2/SDL_opengl.h>
 
+#include <optional>
+
 namespace platform {
 
+	// Vertex stage for QuadMode::Instanced, linked with the same fragment
+	// shader as the ShaderProgram it belongs to
+	struct QuadInstanceProgram {
+		GLuint id;
+		GLuint vao;
+		struct {
+			GLint projection;
+			GLint uv_scale;
+			GLint distance_field;
+		} uniforms;
+	};
+
 	struct ShaderProgram {
 		GLuint id;
 		GLuint vao;
-		GLuint vbo;
+		VertexFormat vertex_format;
 		struct {
 			GLint projection;
+			GLint uv_scale;
+			GLint distance_field;
 		} uniforms;
+		std::optional<QuadInstanceProgram> quad_instances; // needed for QuadMode::Instanced
 	};
 
 } // namespace platform
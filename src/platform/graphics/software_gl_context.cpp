@@ -0,0 +1,409 @@
+#include <platform/graphics/software_gl_context.h>
+
+#include <platform/debug/assert.h>
+#include <platform/debug/logging.h>
+#include <platform/graphics/quad.h>
+#include <platform/graphics/vertex.h>
+
+#include <string.h>
+
+namespace platform {
+
+	SoftwareOpenGLContext::SoftwareOpenGLContext(int width, int height, size_t num_threads)
+		: OpenGLContext(SDL_GLContext { nullptr })
+		, m_rasterizer(num_threads)
+		, m_framebuffer(width, height) {
+	}
+
+	Texture SoftwareOpenGLContext::add_texture(
+		const unsigned char* data,
+		int width,
+		int height,
+		TextureWrapping wrapping,
+		TextureFilter filter
+	) {
+		const GLuint id = _next_id();
+		SoftwareTexture& texture = m_textures[id];
+		texture = SoftwareTexture { .image = RasterImage(width, height), .wrapping = wrapping, .filter = filter };
+		if (data) {
+			// RGBA bytes in rows from the bottom, same layout as the image
+			memcpy(texture.image.pixels.data(), data, texture.image.pixels.size() * sizeof(uint32_t));
+		}
+		return Texture { id, glm::vec2 { width, height } };
+	}
+
+	void SoftwareOpenGLContext::update_texture(Texture texture, glm::ivec2 pos, glm::ivec2 size, const unsigned char* data) {
+		_flush();
+		RasterImage& image = _texture(texture.id).image;
+		ASSERT(pos.x >= 0 && pos.y >= 0 && pos.x + size.x <= image.width && pos.y + size.y <= image.height, "Texture update outside of texture");
+		for (int row = 0; row < size.y; row++) {
+			memcpy(&image.pixels[(size_t)(pos.y + row) * image.width + pos.x], data + (size_t)row * size.x * sizeof(uint32_t), (size_t)size.x * sizeof(uint32_t));
+		}
+	}
+
+	void SoftwareOpenGLContext::set_texture_wrapping(Texture texture, TextureWrapping wrapping) {
+		_flush();
+		_texture(texture.id).wrapping = wrapping;
+	}
+
+	void SoftwareOpenGLContext::set_texture_filter(Texture texture, TextureFilter filter) {
+		_flush();
+		_texture(texture.id).filter = filter;
+	}
+
+	void SoftwareOpenGLContext::free_texture(Texture texture) {
+		_flush();
+		m_textures.erase(texture.id);
+	}
+
+	Canvas SoftwareOpenGLContext::add_canvas(int width, int height, TextureWrapping wrapping, TextureFilter filter) {
+		const Texture texture = add_texture(nullptr, width, height, wrapping, filter);
+		const GLuint framebuffer = _next_id();
+		m_canvas_textures[framebuffer] = texture.id;
+		return Canvas { framebuffer, texture };
+	}
+
+	void SoftwareOpenGLContext::free_canvas(Canvas canvas) {
+		_flush();
+		if (m_canvas == canvas.framebuffer) {
+			m_canvas = 0;
+		}
+		m_canvas_textures.erase(canvas.framebuffer);
+		m_textures.erase(canvas.texture.id);
+	}
+
+	std::expected<ShaderProgram, ShaderProgramError> SoftwareOpenGLContext::add_shader_program(const char* /* vertex_src */, const char* /* fragment_src */, VertexFormat vertex_format) {
+		const GLuint id = _next_id();
+		m_uniforms[id] = Uniforms {};
+		return ShaderProgram {
+			.id = id,
+			.vao = 0,
+			.vertex_format = vertex_format,
+			.uniforms {
+				.projection = 0,
+				.uv_scale = 1,
+				.distance_field = 2,
+			},
+		};
+	}
+
+	std::expected<QuadInstanceProgram, ShaderProgramError> SoftwareOpenGLContext::add_quad_instance_program(const char* /* vertex_src */, const char* /* fragment_src */) {
+		const GLuint id = _next_id();
+		m_uniforms[id] = Uniforms {};
+		return QuadInstanceProgram {
+			.id = id,
+			.vao = 0,
+			.uniforms {
+				.projection = 0,
+				.uv_scale = 1,
+				.distance_field = 2,
+			},
+		};
+	}
+
+	void SoftwareOpenGLContext::free_shader_program(const ShaderProgram& shader_program) {
+		if (shader_program.quad_instances) {
+			m_uniforms.erase(shader_program.quad_instances->id);
+		}
+		m_uniforms.erase(shader_program.id);
+	}
+
+	IndexBuffer SoftwareOpenGLContext::add_index_buffer(const std::vector<uint32_t>& indices) {
+		const GLuint id = _next_id();
+		m_index_buffers[id] = indices;
+		return IndexBuffer { id, indices.size() };
+	}
+
+	void SoftwareOpenGLContext::free_index_buffer(IndexBuffer index_buffer) {
+		m_index_buffers.erase(index_buffer.id);
+	}
+
+	VertexBuffer SoftwareOpenGLContext::add_vertex_buffer(const std::vector<Vertex>& vertices) {
+		const GLuint id = _next_id();
+		m_vertex_buffers[id].vertices = vertices;
+		return VertexBuffer { .id = id, .num_vertices = vertices.size(), .vertex_format = VertexFormat::Standard };
+	}
+
+	VertexBuffer SoftwareOpenGLContext::add_packed_vertex_buffer(const std::vector<PackedVertex>& vertices) {
+		const GLuint id = _next_id();
+		m_vertex_buffers[id].packed_vertices = vertices;
+		return VertexBuffer { .id = id, .num_vertices = vertices.size(), .vertex_format = VertexFormat::Packed };
+	}
+
+	void SoftwareOpenGLContext::free_vertex_buffer(VertexBuffer vertex_buffer) {
+		auto it = m_vertex_buffers.find(vertex_buffer.id);
+		if (it == m_vertex_buffers.end()) {
+			return;
+		}
+		if (m_bound_vertices == &it->second) {
+			m_bound_vertices = &m_streamed_vertices;
+		}
+		m_vertex_buffers.erase(it);
+	}
+
+	void SoftwareOpenGLContext::bind_shader_program(const ShaderProgram& shader_program) {
+		m_shader_program = shader_program.id;
+		m_vertex_format = shader_program.vertex_format;
+	}
+
+	void SoftwareOpenGLContext::unbind_shader_program() {
+		_flush();
+		m_shader_program = 0;
+	}
+
+	void SoftwareOpenGLContext::set_projection(const ShaderProgram& shader_program, glm::mat4 projection) {
+		m_uniforms[shader_program.id].projection = projection;
+		if (shader_program.quad_instances) {
+			m_uniforms[shader_program.quad_instances->id].projection = projection;
+		}
+	}
+
+	void SoftwareOpenGLContext::reserve_vertex_stream(size_t /* size */) {
+	}
+
+	void SoftwareOpenGLContext::upload_vertices(const ShaderProgram& /* shader_program */, const std::vector<Vertex>& vertices) {
+		m_streamed_vertices.vertices = vertices;
+	}
+
+	void SoftwareOpenGLContext::upload_packed_vertices(const ShaderProgram& /* shader_program */, const std::vector<PackedVertex>& vertices) {
+		m_streamed_vertices.packed_vertices = vertices;
+	}
+
+	void SoftwareOpenGLContext::upload_quad_instances(const ShaderProgram& /* shader_program */, const std::vector<QuadInstance>& instances) {
+		m_quad_instances = instances;
+	}
+
+	void SoftwareOpenGLContext::bind_vertex_buffer(const ShaderProgram& /* shader_program */, VertexBuffer vertex_buffer) {
+		m_bound_vertices = &m_vertex_buffers.at(vertex_buffer.id);
+	}
+
+	void SoftwareOpenGLContext::bind_streamed_vertices(const ShaderProgram& /* shader_program */) {
+		m_bound_vertices = &m_streamed_vertices;
+	}
+
+	void SoftwareOpenGLContext::fence_vertices() {
+		_flush();
+	}
+
+	StreamingBufferStats SoftwareOpenGLContext::vertex_stream_stats() const {
+		return StreamingBufferStats {};
+	}
+
+	void SoftwareOpenGLContext::set_uv_scale(const ShaderProgram& shader_program, float uv_scale) {
+		m_uniforms[shader_program.id].uv_scale = uv_scale;
+	}
+
+	void SoftwareOpenGLContext::set_distance_field(const ShaderProgram& shader_program, bool enabled) {
+		m_uniforms[shader_program.id].distance_field = enabled;
+		if (shader_program.quad_instances) {
+			m_uniforms[shader_program.quad_instances->id].distance_field = enabled;
+		}
+	}
+
+	void SoftwareOpenGLContext::bind_texture(Texture texture) {
+		m_texture = texture.id;
+	}
+
+	void SoftwareOpenGLContext::bind_canvas(Canvas canvas) {
+		_flush();
+		ASSERT(m_canvas_textures.contains(canvas.framebuffer), "Binding unknown canvas %u", canvas.framebuffer);
+		m_canvas = canvas.framebuffer;
+	}
+
+	void SoftwareOpenGLContext::unbind_canvas() {
+		_flush();
+		m_canvas = 0;
+	}
+
+	void SoftwareOpenGLContext::set_scissor(ScissorRect rect) {
+		m_rasterizer.set_scissor(rect);
+	}
+
+	void SoftwareOpenGLContext::disable_scissor() {
+		m_rasterizer.set_scissor(std::nullopt);
+	}
+
+	void SoftwareOpenGLContext::draw_arrays(GLenum mode, GLint first, GLsizei count) {
+		_draw(mode, nullptr, (size_t)first, (size_t)count, 0);
+	}
+
+	void SoftwareOpenGLContext::draw_elements(GLenum mode, IndexBuffer index_buffer, GLsizei count, GLint base_vertex) {
+		auto it = m_index_buffers.find(index_buffer.id);
+		ASSERT(it != m_index_buffers.end(), "Drawing with unknown index buffer %u", index_buffer.id);
+		ASSERT((size_t)count <= it->second.size(), "Drawing %d indices from index buffer with %zu indices", count, it->second.size());
+		_draw(mode, &it->second, 0, (size_t)count, base_vertex);
+	}
+
+	void SoftwareOpenGLContext::draw_quad_instances(const ShaderProgram& shader_program, GLint first, GLsizei count, float uv_scale) {
+		ASSERT(shader_program.quad_instances, "Drawing quad instances with a shader program without a quad instance program");
+		ASSERT((size_t)(first + count) <= m_quad_instances.size(), "Quad instances %d to %d out of range, only %zu uploaded", first, first + count, m_quad_instances.size());
+
+		/* Expand instances */
+		// Same corners and triangles as quad_instance.vert drawn as a strip
+		const RasterImage* target = _target();
+		const glm::vec2 viewport_size = { target->width, target->height };
+		Uniforms uniforms = m_uniforms.at(shader_program.quad_instances->id);
+		uniforms.uv_scale = uv_scale;
+		std::vector<RasterVertex>& vertices = m_scratch_vertices;
+		vertices.clear();
+		for (size_t i = (size_t)first; i < (size_t)(first + count); i++) {
+			const QuadInstance& instance = m_quad_instances[i];
+			const glm::vec4 color = unpack_color(instance.color);
+			const glm::vec2 uv0 = glm::vec2 { instance.uv[0], instance.uv[1] } / 65535.0f;
+			const glm::vec2 uv1 = glm::vec2 { instance.uv[2], instance.uv[3] } / 65535.0f;
+			const RasterVertex corners[VERTICES_PER_QUAD] = {
+				_shade_vertex(Vertex { .pos = instance.pos0, .color = color, .uv = uv0 }, uniforms, viewport_size),
+				_shade_vertex(Vertex { .pos = { instance.pos0.x, instance.pos1.y }, .color = color, .uv = { uv0.x, uv1.y } }, uniforms, viewport_size),
+				_shade_vertex(Vertex { .pos = { instance.pos1.x, instance.pos0.y }, .color = color, .uv = { uv1.x, uv0.y } }, uniforms, viewport_size),
+				_shade_vertex(Vertex { .pos = instance.pos1, .color = color, .uv = uv1 }, uniforms, viewport_size),
+			};
+			vertices.insert(vertices.end(), { corners[0], corners[1], corners[2], corners[1], corners[2], corners[3] });
+		}
+
+		m_rasterizer.draw(RasterPrimitive::Triangles, _bound_texture(uniforms), vertices);
+	}
+
+	void SoftwareOpenGLContext::clear(glm::vec4 color) {
+		_flush();
+		RasterImage* target = _target();
+		std::fill(target->pixels.begin(), target->pixels.end(), pack_color(color));
+	}
+
+	void SoftwareOpenGLContext::resize_framebuffer(int width, int height) {
+		_flush();
+		m_framebuffer = RasterImage(width, height);
+	}
+
+	const RasterImage& SoftwareOpenGLContext::framebuffer() {
+		_flush();
+		return m_framebuffer;
+	}
+
+	const RasterImage& SoftwareOpenGLContext::canvas_pixels(Canvas canvas) {
+		return texture_pixels(canvas.texture);
+	}
+
+	const RasterImage& SoftwareOpenGLContext::texture_pixels(Texture texture) {
+		_flush();
+		return _texture(texture.id).image;
+	}
+
+	SoftwareRasterizer& SoftwareOpenGLContext::rasterizer() {
+		return m_rasterizer;
+	}
+
+	GLuint SoftwareOpenGLContext::_next_id() {
+		return ++m_last_id;
+	}
+
+	SoftwareOpenGLContext::SoftwareTexture& SoftwareOpenGLContext::_texture(GLuint id) {
+		auto it = m_textures.find(id);
+		ASSERT(it != m_textures.end(), "Unknown texture %u", id);
+		return it->second;
+	}
+
+	RasterImage* SoftwareOpenGLContext::_target() {
+		if (m_canvas == 0) {
+			return &m_framebuffer;
+		}
+		return &_texture(m_canvas_textures.at(m_canvas)).image;
+	}
+
+	void SoftwareOpenGLContext::_flush() {
+		m_rasterizer.flush(_target());
+	}
+
+	RasterTexture SoftwareOpenGLContext::_bound_texture(const Uniforms& uniforms) {
+		if (auto it = m_textures.find(m_texture); it != m_textures.end()) {
+			return RasterTexture { .image = &it->second.image, .wrapping = it->second.wrapping, .filter = it->second.filter, .distance_field = uniforms.distance_field };
+		}
+		return RasterTexture {};
+	}
+
+	Vertex SoftwareOpenGLContext::_fetch_vertex(size_t index) const {
+		switch (m_vertex_format) {
+			case VertexFormat::Standard:
+				return m_bound_vertices->vertices[index];
+
+			case VertexFormat::Packed: {
+				const PackedVertex& packed = m_bound_vertices->packed_vertices[index];
+				return Vertex {
+					.pos = packed.pos,
+					.color = unpack_color(packed.color),
+					.uv = glm::vec2 { packed.uv[0], packed.uv[1] } / 65535.0f,
+				};
+			}
+		}
+		return Vertex {};
+	}
+
+	RasterVertex SoftwareOpenGLContext::_shade_vertex(const Vertex& vertex, const Uniforms& uniforms, glm::vec2 viewport_size) const {
+		/* Vertex shader */
+		const glm::vec4 clip_pos = uniforms.projection * glm::vec4 { vertex.pos.x, vertex.pos.y, 0.0f, 1.0f };
+		const glm::vec2 ndc = glm::vec2 { clip_pos.x, clip_pos.y } / clip_pos.w;
+
+		/* Viewport transform */
+		const glm::vec2 window_pos = (ndc + 1.0f) * 0.5f * viewport_size;
+
+		return RasterVertex {
+			.pos = window_pos,
+			.color = vertex.color,
+			.uv = vertex.uv * uniforms.uv_scale,
+		};
+	}
+
+	void SoftwareOpenGLContext::_draw(GLenum mode, const std::vector<uint32_t>* indices, size_t first, size_t count, GLint base_vertex) {
+		ASSERT(m_shader_program != 0, "Drawing without a bound shader program");
+
+		/* Fetch vertices */
+		// Viewport is always the whole target, like bind_canvas sets it
+		const RasterImage* target = _target();
+		const glm::vec2 viewport_size = { target->width, target->height };
+		const Uniforms& uniforms = m_uniforms.at(m_shader_program);
+		std::vector<RasterVertex>& vertices = m_scratch_vertices;
+		vertices.clear();
+		const size_t num_uploaded = m_vertex_format == VertexFormat::Standard ? m_bound_vertices->vertices.size() : m_bound_vertices->packed_vertices.size();
+		for (size_t i = first; i < first + count; i++) {
+			const size_t index = indices ? (size_t)((*indices)[i] + base_vertex) : i;
+			ASSERT(index < num_uploaded, "Vertex index %zu out of range, only %zu vertices uploaded", index, num_uploaded);
+			vertices.push_back(_shade_vertex(_fetch_vertex(index), uniforms, viewport_size));
+		}
+
+		/* Texture */
+		const RasterTexture texture = _bound_texture(uniforms);
+
+		/* Assemble primitives */
+		switch (mode) {
+			case GL_POINTS:
+				m_rasterizer.draw(RasterPrimitive::Points, texture, vertices);
+				break;
+
+			case GL_LINES:
+				m_rasterizer.draw(RasterPrimitive::Lines, texture, vertices);
+				break;
+
+			case GL_LINE_STRIP:
+			case GL_LINE_LOOP: {
+				std::vector<RasterVertex> lines;
+				for (size_t i = 0; i + 1 < vertices.size(); i++) {
+					lines.push_back(vertices[i]);
+					lines.push_back(vertices[i + 1]);
+				}
+				if (mode == GL_LINE_LOOP && vertices.size() > 2) {
+					lines.push_back(vertices.back());
+					lines.push_back(vertices.front());
+				}
+				m_rasterizer.draw(RasterPrimitive::Lines, texture, lines);
+			} break;
+
+			case GL_TRIANGLES:
+				m_rasterizer.draw(RasterPrimitive::Triangles, texture, vertices);
+				break;
+
+			default:
+				LOG_WARNING("SoftwareOpenGLContext can't draw primitive mode %u", mode);
+				break;
+		}
+	}
+
+} // namespace platform
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <platform/graphics/gl_context.h>
+#include <platform/graphics/software_rasterizer.h>
+
+#include <glm/glm.hpp>
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace platform {
+
+	// OpenGLContext that renders into memory with a SoftwareRasterizer
+	// instead of talking to a driver, for rendering without a window, e.g.
+	// on CI or in golden image tests.
+	//
+	// Shader sources are ignored. Every shader program behaves like
+	// shader.vert and shader.frag, i.e. `projection * pos` and
+	// `texture(uv * uv_scale) * color`, and quad instance programs like
+	// quad_instance.vert, including the distance field path of shader.frag.
+	class SoftwareOpenGLContext : public OpenGLContext {
+	public:
+		SoftwareOpenGLContext(int width, int height, size_t num_threads = 1);
+
+		Texture add_texture(const unsigned char* data, int width, int height, TextureWrapping wrapping = TextureWrapping::ClampToEdge, TextureFilter filter = TextureFilter::Nearest) override;
+		void update_texture(Texture texture, glm::ivec2 pos, glm::ivec2 size, const unsigned char* data) override;
+		void set_texture_wrapping(Texture texture, TextureWrapping wrapping) override;
+		void set_texture_filter(Texture texture, TextureFilter filter) override;
+		void free_texture(Texture texture) override;
+
+		Canvas add_canvas(int width, int height, TextureWrapping wrapping = TextureWrapping::ClampToEdge, TextureFilter filter = TextureFilter::Nearest) override;
+		void free_canvas(Canvas canvas) override;
+
+		std::expected<ShaderProgram, ShaderProgramError> add_shader_program(const char* vertex_src, const char* fragment_src, VertexFormat vertex_format = VertexFormat::Standard) override;
+		std::expected<QuadInstanceProgram, ShaderProgramError> add_quad_instance_program(const char* vertex_src, const char* fragment_src) override;
+		void free_shader_program(const ShaderProgram& shader_program) override;
+
+		IndexBuffer add_index_buffer(const std::vector<uint32_t>& indices) override;
+		void free_index_buffer(IndexBuffer index_buffer) override;
+
+		VertexBuffer add_vertex_buffer(const std::vector<Vertex>& vertices) override;
+		VertexBuffer add_packed_vertex_buffer(const std::vector<PackedVertex>& vertices) override;
+		void free_vertex_buffer(VertexBuffer vertex_buffer) override;
+
+		void bind_shader_program(const ShaderProgram& shader_program) override;
+		void unbind_shader_program() override;
+		void set_projection(const ShaderProgram& shader_program, glm::mat4 projection) override;
+		void reserve_vertex_stream(size_t size) override;
+		void upload_vertices(const ShaderProgram& shader_program, const std::vector<Vertex>& vertices) override;
+		void upload_packed_vertices(const ShaderProgram& shader_program, const std::vector<PackedVertex>& vertices) override;
+		void upload_quad_instances(const ShaderProgram& shader_program, const std::vector<QuadInstance>& instances) override;
+		void bind_vertex_buffer(const ShaderProgram& shader_program, VertexBuffer vertex_buffer) override;
+		void bind_streamed_vertices(const ShaderProgram& shader_program) override;
+		void fence_vertices() override;
+		StreamingBufferStats vertex_stream_stats() const override;
+		void set_uv_scale(const ShaderProgram& shader_program, float uv_scale) override;
+		void set_distance_field(const ShaderProgram& shader_program, bool enabled) override;
+		void bind_texture(Texture texture) override;
+		void bind_canvas(Canvas canvas) override;
+		void unbind_canvas() override;
+		void set_scissor(ScissorRect rect) override;
+		void disable_scissor() override;
+		void draw_arrays(GLenum mode, GLint first, GLsizei count) override;
+		void draw_elements(GLenum mode, IndexBuffer index_buffer, GLsizei count, GLint base_vertex) override;
+		void draw_quad_instances(const ShaderProgram& shader_program, GLint first, GLsizei count, float uv_scale) override;
+
+		// Clears whatever is bound, like glClear
+		void clear(glm::vec4 color);
+		void resize_framebuffer(int width, int height);
+
+		// Rasterizes pending draws before returning pixels
+		const RasterImage& framebuffer();
+		const RasterImage& canvas_pixels(Canvas canvas);
+		const RasterImage& texture_pixels(Texture texture);
+
+		SoftwareRasterizer& rasterizer();
+
+	private:
+		struct SoftwareTexture {
+			RasterImage image;
+			TextureWrapping wrapping;
+			TextureFilter filter;
+		};
+		struct SoftwareVertexBuffer {
+			std::vector<Vertex> vertices;
+			std::vector<PackedVertex> packed_vertices;
+		};
+		struct Uniforms {
+			glm::mat4 projection = glm::mat4(1.0f);
+			float uv_scale = 1.0f;
+			bool distance_field = false;
+		};
+
+		GLuint _next_id();
+		SoftwareTexture& _texture(GLuint id);
+		RasterImage* _target();
+		void _flush();
+		void _draw(GLenum mode, const std::vector<uint32_t>* indices, size_t first, size_t count, GLint base_vertex);
+		RasterTexture _bound_texture(const Uniforms& uniforms);
+		Vertex _fetch_vertex(size_t index) const;
+		RasterVertex _shade_vertex(const Vertex& vertex, const Uniforms& uniforms, glm::vec2 viewport_size) const;
+
+		SoftwareRasterizer m_rasterizer;
+		GLuint m_last_id = 0;
+		RasterImage m_framebuffer;
+		std::unordered_map<GLuint, SoftwareTexture> m_textures;
+		std::unordered_map<GLuint, GLuint> m_canvas_textures; // framebuffer -> texture
+		std::unordered_map<GLuint, std::vector<uint32_t>> m_index_buffers;
+		std::unordered_map<GLuint, SoftwareVertexBuffer> m_vertex_buffers;
+		std::unordered_map<GLuint, Uniforms> m_uniforms; // per shader program
+
+		/* Bound state */
+		GLuint m_shader_program = 0;
+		VertexFormat m_vertex_format = VertexFormat::Standard;
+		SoftwareVertexBuffer m_streamed_vertices;
+		const SoftwareVertexBuffer* m_bound_vertices = &m_streamed_vertices;
+		std::vector<QuadInstance> m_quad_instances;
+		GLuint m_texture = 0;
+		GLuint m_canvas = 0; // 0 for the framebuffer
+		std::vector<RasterVertex> m_scratch_vertices;
+	};
+
+} // namespace platform
@@ -0,0 +1,477 @@
+#include <platform/graphics/software_rasterizer.h>
+
+#include <core/future.h>
+#include <platform/graphics/vertex.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace platform {
+
+	// Triangle vertices are snapped to 1/256 pixel, like the 8 subpixel bits
+	// of typical GPUs, so that edge functions are exact integers.
+	constexpr int SUBPIXEL_BITS = 8;
+	constexpr int64_t SUBPIXEL = 1 << SUBPIXEL_BITS;
+
+	// Keeps fixed point edge function products within 64 bits
+	constexpr float MAX_COORDINATE = 1 << 20;
+
+	// Rows per band are at least this many, so that small targets aren't
+	// split across more threads than is worth it
+	constexpr int MIN_BAND_HEIGHT = 32;
+
+	RasterImage::RasterImage(int width, int height, uint32_t fill)
+		: width(width)
+		, height(height)
+		, pixels((size_t)width * height, fill) {
+	}
+
+	/* Blending */
+
+	// floor(x / 255) for x <= 255 * 255 + 255
+	static uint32_t div255(uint32_t x) {
+		x += 1;
+		return (x + (x >> 8)) >> 8;
+	}
+
+	uint32_t blend_pixel(uint32_t dst, uint32_t src) {
+		const uint32_t alpha = src >> 24;
+		const uint32_t inv_alpha = 255 - alpha;
+		uint32_t result = 0;
+		for (uint32_t shift = 0; shift < 32; shift += 8) {
+			const uint32_t s = (src >> shift) & 0xFF;
+			const uint32_t d = (dst >> shift) & 0xFF;
+			result |= div255(s * alpha + d * inv_alpha + 127) << shift;
+		}
+		return result;
+	}
+
+	void blend_span(uint32_t* pixels, size_t num_pixels, uint32_t src) {
+		const uint32_t alpha = src >> 24;
+		if (alpha == 0) {
+			return;
+		}
+		if (alpha == 255) {
+			std::fill_n(pixels, num_pixels, src);
+			return;
+		}
+
+		size_t i = 0;
+#ifdef HAS_SSE2
+		/* Blend 4 pixels at a time */
+		{
+			// Same arithmetic as blend_pixel, on 16-bit channels. The sum
+			// s * a + d * (255 - a) + 127 is at most 255 * 255 + 127, so it
+			// fits without overflowing.
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i one = _mm_set1_epi16(1);
+			const __m128i inv_alpha = _mm_set1_epi16((short)(255 - alpha));
+			const __m128i src16 = _mm_unpacklo_epi8(_mm_set1_epi32((int)src), zero);
+			const __m128i src_term = _mm_add_epi16(_mm_mullo_epi16(src16, _mm_set1_epi16((short)alpha)), _mm_set1_epi16(127));
+
+			auto blend_channels = [&](__m128i dst16) {
+				__m128i sum = _mm_add_epi16(_mm_mullo_epi16(dst16, inv_alpha), src_term);
+				sum = _mm_add_epi16(sum, one);
+				return _mm_srli_epi16(_mm_add_epi16(sum, _mm_srli_epi16(sum, 8)), 8);
+			};
+
+			for (; i + 4 <= num_pixels; i += 4) {
+				const __m128i dst = _mm_loadu_si128((const __m128i*)(pixels + i));
+				const __m128i lo = blend_channels(_mm_unpacklo_epi8(dst, zero));
+				const __m128i hi = blend_channels(_mm_unpackhi_epi8(dst, zero));
+				_mm_storeu_si128((__m128i*)(pixels + i), _mm_packus_epi16(lo, hi));
+			}
+		}
+#endif
+		for (; i < num_pixels; i++) {
+			pixels[i] = blend_pixel(pixels[i], src);
+		}
+	}
+
+	/* Sampling */
+
+	// Wraps a texel coordinate, or returns -1 for the border color
+	static int wrap_texel(int i, int size, TextureWrapping wrapping) {
+		switch (wrapping) {
+			case TextureWrapping::Repeat:
+				return ((i % size) + size) % size;
+
+			case TextureWrapping::MirroredRepeat: {
+				const int period = ((i % (2 * size)) + 2 * size) % (2 * size);
+				return period < size ? period : 2 * size - 1 - period;
+			}
+
+			case TextureWrapping::ClampToEdge:
+				return std::clamp(i, 0, size - 1);
+
+			case TextureWrapping::ClampToBorder:
+				return i >= 0 && i < size ? i : -1;
+		}
+		return -1;
+	}
+
+	static glm::vec4 fetch_texel(const RasterTexture& texture, int x, int y) {
+		const RasterImage& image = *texture.image;
+		x = wrap_texel(x, image.width, texture.wrapping);
+		y = wrap_texel(y, image.height, texture.wrapping);
+		if (x < 0 || y < 0) {
+			return glm::vec4 { 0.0f, 0.0f, 0.0f, 0.0f };
+		}
+		return unpack_color(image.pixel(x, y));
+	}
+
+	glm::vec4 sample_texture(const RasterTexture& texture, glm::vec2 uv) {
+		if (!texture.image || texture.image->pixels.empty()) {
+			return glm::vec4 { 0.0f, 0.0f, 0.0f, 1.0f };
+		}
+
+		const glm::vec2 size = { texture.image->width, texture.image->height };
+		switch (texture.filter) {
+			case TextureFilter::Nearest: {
+				const glm::vec2 texel = glm::floor(uv * size);
+				return fetch_texel(texture, (int)texel.x, (int)texel.y);
+			}
+
+			case TextureFilter::Linear: {
+				const glm::vec2 texel = uv * size - 0.5f;
+				const glm::vec2 texel0 = glm::floor(texel);
+				const glm::vec2 t = texel - texel0;
+				const int x0 = (int)texel0.x;
+				const int y0 = (int)texel0.y;
+				const glm::vec4 bottom = glm::mix(fetch_texel(texture, x0, y0), fetch_texel(texture, x0 + 1, y0), t.x);
+				const glm::vec4 top = glm::mix(fetch_texel(texture, x0, y0 + 1), fetch_texel(texture, x0 + 1, y0 + 1), t.x);
+				return glm::mix(bottom, top, t.y);
+			}
+		}
+		return glm::vec4 { 0.0f, 0.0f, 0.0f, 1.0f };
+	}
+
+	// `uv_dx` and `uv_dy` are how much the uv changes to the next pixel,
+	// for distance fields
+	static uint32_t shade_fragment(const RasterTexture& texture, glm::vec4 color, glm::vec2 uv, glm::vec2 uv_dx = { 0.0f, 0.0f }, glm::vec2 uv_dy = { 0.0f, 0.0f }) {
+		glm::vec4 texel = sample_texture(texture, uv);
+		if (texture.distance_field) {
+			// fwidth from differences with the neighbouring pixels, like
+			// GPUs take them within 2x2 pixel quads
+			const float edge_width = std::abs(sample_texture(texture, uv + uv_dx).a - texel.a) + std::abs(sample_texture(texture, uv + uv_dy).a - texel.a);
+			texel.a = edge_width > 0.0f
+				? glm::smoothstep(0.5f - edge_width / 2.0f, 0.5f + edge_width / 2.0f, texel.a)
+				: (texel.a >= 0.5f ? 1.0f : 0.0f);
+		}
+		return pack_color(texel * color);
+	}
+
+	/* Fixed point helpers */
+
+	struct FixedPoint {
+		int64_t x;
+		int64_t y;
+	};
+
+	static int64_t to_fixed(float value) {
+		return (int64_t)std::llround(std::clamp(value, -MAX_COORDINATE, MAX_COORDINATE) * SUBPIXEL);
+	}
+
+	static int64_t floor_div(int64_t n, int64_t d) {
+		return n >= 0 ? n / d : -((-n + d - 1) / d);
+	}
+
+	static int64_t ceil_div(int64_t n, int64_t d) {
+		return n >= 0 ? (n + d - 1) / d : -((-n) / d);
+	}
+
+	/* SoftwareRasterizer */
+
+	SoftwareRasterizer::SoftwareRasterizer(size_t num_threads)
+		: m_num_threads(std::max<size_t>(num_threads, 1)) {
+	}
+
+	void SoftwareRasterizer::set_num_threads(size_t num_threads) {
+		m_num_threads = std::max<size_t>(num_threads, 1);
+	}
+
+	size_t SoftwareRasterizer::num_threads() const {
+		return m_num_threads;
+	}
+
+	void SoftwareRasterizer::set_scissor(std::optional<ScissorRect> scissor) {
+		m_scissor = scissor;
+	}
+
+	void SoftwareRasterizer::draw(RasterPrimitive primitive, const RasterTexture& texture, std::span<const RasterVertex> vertices) {
+		if (vertices.empty()) {
+			return;
+		}
+
+		// Extend the previous batch when possible, since each batch is
+		// visited once per band
+		if (!m_batches.empty()) {
+			Batch& last = m_batches.back();
+			const bool same_texture = last.texture.image == texture.image && last.texture.wrapping == texture.wrapping && last.texture.filter == texture.filter;
+			const bool same_scissor = last.scissor.has_value() == m_scissor.has_value() &&
+				(!m_scissor || (last.scissor->pos == m_scissor->pos && last.scissor->size == m_scissor->size));
+			if (last.primitive == primitive && same_texture && same_scissor) {
+				m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+				last.count += vertices.size();
+				return;
+			}
+		}
+
+		m_batches.push_back(Batch { .primitive = primitive, .texture = texture, .scissor = m_scissor, .first = m_vertices.size(), .count = vertices.size() });
+		m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+	}
+
+	void SoftwareRasterizer::flush(RasterImage* target) {
+		if (m_batches.empty() || target->width <= 0 || target->height <= 0) {
+			m_vertices.clear();
+			m_batches.clear();
+			return;
+		}
+
+		/* Split target into bands */
+		const int max_bands = std::max(1, (target->height + MIN_BAND_HEIGHT - 1) / MIN_BAND_HEIGHT);
+		const int num_bands = std::min(max_bands, (int)m_num_threads);
+		const int band_height = (target->height + num_bands - 1) / num_bands;
+		std::vector<Band> bands;
+		for (int y = 0; y < target->height; y += band_height) {
+			bands.push_back(Band { .y_begin = y, .y_end = std::min(y + band_height, target->height) });
+		}
+
+		/* Rasterize */
+		if (bands.size() <= 1) {
+			for (const Band& band : bands) {
+				_rasterize_band(target, band);
+			}
+		}
+		else {
+			auto batch = core::batch_async(std::launch::async, bands, [this, target](Band band) {
+				_rasterize_band(target, band);
+			});
+			for (std::future<void>& future : batch) {
+				future.get();
+			}
+		}
+
+		m_vertices.clear();
+		m_batches.clear();
+	}
+
+	size_t SoftwareRasterizer::num_queued_vertices() const {
+		return m_vertices.size();
+	}
+
+	void SoftwareRasterizer::_rasterize_band(RasterImage* target, Band band) const {
+		for (const Batch& batch : m_batches) {
+			PixelBounds bounds = { .x_begin = 0, .x_end = target->width, .y_begin = band.y_begin, .y_end = band.y_end };
+			if (batch.scissor) {
+				bounds.x_begin = std::max(bounds.x_begin, batch.scissor->pos.x);
+				bounds.x_end = std::min(bounds.x_end, batch.scissor->pos.x + batch.scissor->size.x);
+				bounds.y_begin = std::max(bounds.y_begin, batch.scissor->pos.y);
+				bounds.y_end = std::min(bounds.y_end, batch.scissor->pos.y + batch.scissor->size.y);
+				if (bounds.x_begin >= bounds.x_end || bounds.y_begin >= bounds.y_end) {
+					continue;
+				}
+			}
+
+			switch (batch.primitive) {
+				case RasterPrimitive::Points:
+					_rasterize_points(target, bounds, batch);
+					break;
+
+				case RasterPrimitive::Lines:
+					_rasterize_lines(target, bounds, batch);
+					break;
+
+				case RasterPrimitive::Triangles:
+					_rasterize_triangles(target, bounds, batch);
+					break;
+			}
+		}
+	}
+
+	void SoftwareRasterizer::_rasterize_points(RasterImage* target, PixelBounds bounds, const Batch& batch) const {
+		for (size_t i = batch.first; i < batch.first + batch.count; i++) {
+			const RasterVertex& vertex = m_vertices[i];
+			const float x = std::floor(vertex.pos.x);
+			const float y = std::floor(vertex.pos.y);
+			if (x < bounds.x_begin || x >= bounds.x_end || y < bounds.y_begin || y >= bounds.y_end) {
+				continue;
+			}
+			uint32_t& pixel = target->pixel((int)x, (int)y);
+			pixel = blend_pixel(pixel, shade_fragment(batch.texture, vertex.color, vertex.uv));
+		}
+	}
+
+	void SoftwareRasterizer::_rasterize_lines(RasterImage* target, PixelBounds bounds, const Batch& batch) const {
+		for (size_t i = batch.first; i + 1 < batch.first + batch.count; i += 2) {
+			const RasterVertex& start = m_vertices[i];
+			const RasterVertex& end = m_vertices[i + 1];
+			const glm::vec2 delta = end.pos - start.pos;
+
+			// Step along the major axis one pixel center at a time, including
+			// the start and excluding the end
+			const bool x_major = std::abs(delta.x) >= std::abs(delta.y);
+			const int axis = x_major ? 0 : 1;
+			const float major_start = start.pos[axis];
+			const float major_delta = delta[axis];
+			if (major_delta == 0.0f) {
+				continue;
+			}
+
+			int first;
+			int last;
+			if (major_delta > 0.0f) {
+				first = (int)std::ceil(major_start - 0.5f);
+				last = (int)std::ceil(major_start + major_delta - 0.5f) - 1;
+			}
+			else {
+				first = (int)std::floor(major_start + major_delta - 0.5f) + 1;
+				last = (int)std::floor(major_start - 0.5f);
+			}
+			if (x_major) {
+				first = std::max(first, bounds.x_begin);
+				last = std::min(last, bounds.x_end - 1);
+			}
+			else {
+				first = std::max(first, bounds.y_begin);
+				last = std::min(last, bounds.y_end - 1);
+			}
+
+			for (int major = first; major <= last; major++) {
+				const float t = (major + 0.5f - major_start) / major_delta;
+				const glm::vec2 pos = start.pos + t * delta;
+				const int x = x_major ? major : (int)std::floor(pos.x);
+				const int y = x_major ? (int)std::floor(pos.y) : major;
+				if (x < bounds.x_begin || x >= bounds.x_end || y < bounds.y_begin || y >= bounds.y_end) {
+					continue;
+				}
+				const glm::vec4 color = glm::mix(start.color, end.color, t);
+				const glm::vec2 uv = glm::mix(start.uv, end.uv, t);
+				uint32_t& pixel = target->pixel(x, y);
+				pixel = blend_pixel(pixel, shade_fragment(batch.texture, color, uv));
+			}
+		}
+	}
+
+	void SoftwareRasterizer::_rasterize_triangles(RasterImage* target, PixelBounds bounds, const Batch& batch) const {
+		for (size_t i = batch.first; i + 2 < batch.first + batch.count; i += 3) {
+			const RasterVertex* v[3] = { &m_vertices[i], &m_vertices[i + 1], &m_vertices[i + 2] };
+			FixedPoint p[3];
+			for (int k = 0; k < 3; k++) {
+				p[k] = FixedPoint { to_fixed(v[k]->pos.x), to_fixed(v[k]->pos.y) };
+			}
+
+			/* Orient counter-clockwise */
+			auto edge_function = [](FixedPoint a, FixedPoint b, FixedPoint c) {
+				return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+			};
+			int64_t area = edge_function(p[0], p[1], p[2]);
+			if (area == 0) {
+				continue;
+			}
+			if (area < 0) {
+				std::swap(p[1], p[2]);
+				std::swap(v[1], v[2]);
+				area = -area;
+			}
+
+			/* Bounding box, clipped to band and scissor */
+			const int64_t min_x = std::min({ p[0].x, p[1].x, p[2].x });
+			const int64_t max_x = std::max({ p[0].x, p[1].x, p[2].x });
+			const int64_t min_y = std::min({ p[0].y, p[1].y, p[2].y });
+			const int64_t max_y = std::max({ p[0].y, p[1].y, p[2].y });
+			const int x_begin = (int)std::max<int64_t>(floor_div(min_x, SUBPIXEL), bounds.x_begin);
+			const int x_end = (int)std::min<int64_t>(ceil_div(max_x, SUBPIXEL) + 1, bounds.x_end);
+			const int y_begin = (int)std::max<int64_t>(floor_div(min_y, SUBPIXEL), bounds.y_begin);
+			const int y_end = (int)std::min<int64_t>(ceil_div(max_y, SUBPIXEL) + 1, bounds.y_end);
+			if (x_begin >= x_end || y_begin >= y_end) {
+				continue;
+			}
+
+			/* Edge setup */
+			// Edge k is opposite vertex k. Pixels exactly on an edge are only
+			// covered by top and left edges, so that triangles sharing an
+			// edge don't both cover it.
+			struct Edge {
+				int64_t row_start; // value at (x_begin, y) pixel center
+				int64_t step_x;
+				int64_t step_y;
+				int64_t bias; // pixel is inside when value >= bias
+			} edges[3];
+			const FixedPoint first_center = { x_begin * SUBPIXEL + SUBPIXEL / 2, y_begin * SUBPIXEL + SUBPIXEL / 2 };
+			for (int k = 0; k < 3; k++) {
+				const FixedPoint a = p[(k + 1) % 3];
+				const FixedPoint b = p[(k + 2) % 3];
+				const FixedPoint d = { b.x - a.x, b.y - a.y };
+				const bool top_left = d.y < 0 || (d.y == 0 && d.x < 0);
+				edges[k] = Edge {
+					.row_start = edge_function(a, b, first_center),
+					.step_x = -d.y * SUBPIXEL,
+					.step_y = d.x * SUBPIXEL,
+					.bias = top_left ? 0 : 1,
+				};
+			}
+
+			/* Check for constant fragments */
+			// A single texel and flat color shade every fragment the same,
+			// so spans can be filled without interpolating
+			const bool single_texel = batch.texture.image && batch.texture.image->width == 1 && batch.texture.image->height == 1;
+			const bool flat_color = v[0]->color == v[1]->color && v[1]->color == v[2]->color;
+			const bool constant = single_texel && flat_color;
+			const uint32_t constant_fragment = constant ? shade_fragment(batch.texture, v[0]->color, v[0]->uv) : 0;
+
+			/* Rasterize rows */
+			const double inv_area = 1.0 / (double)area;
+			const glm::vec2 uv_dx = (v[1]->uv - v[0]->uv) * (float)(edges[1].step_x * inv_area) + (v[2]->uv - v[0]->uv) * (float)(edges[2].step_x * inv_area);
+			const glm::vec2 uv_dy = (v[1]->uv - v[0]->uv) * (float)(edges[1].step_y * inv_area) + (v[2]->uv - v[0]->uv) * (float)(edges[2].step_y * inv_area);
+			for (int y = y_begin; y < y_end; y++) {
+				// Find span of covered pixels, solving value + step_x * dx >= bias
+				// for each edge
+				int64_t span_begin = 0;
+				int64_t span_end = x_end - x_begin;
+				const int64_t row_offset = (int64_t)(y - y_begin);
+				int64_t row_values[3];
+				for (int k = 0; k < 3; k++) {
+					const Edge& edge = edges[k];
+					const int64_t value = edge.row_start + edge.step_y * row_offset;
+					row_values[k] = value;
+					if (edge.step_x > 0) {
+						span_begin = std::max(span_begin, ceil_div(edge.bias - value, edge.step_x));
+					}
+					else if (edge.step_x < 0) {
+						span_end = std::min(span_end, floor_div(value - edge.bias, -edge.step_x) + 1);
+					}
+					else if (value < edge.bias) {
+						span_end = 0;
+					}
+				}
+				if (span_begin >= span_end) {
+					continue;
+				}
+
+				uint32_t* row = &target->pixel(x_begin, y);
+				if (constant) {
+					blend_span(row + span_begin, (size_t)(span_end - span_begin), constant_fragment);
+					continue;
+				}
+
+				for (int64_t dx = span_begin; dx < span_end; dx++) {
+					const float w1 = (float)((double)(row_values[1] + edges[1].step_x * dx) * inv_area);
+					const float w2 = (float)((double)(row_values[2] + edges[2].step_x * dx) * inv_area);
+					const float w0 = 1.0f - w1 - w2;
+					const glm::vec4 color = v[0]->color * w0 + v[1]->color * w1 + v[2]->color * w2;
+					const glm::vec2 uv = v[0]->uv * w0 + v[1]->uv * w1 + v[2]->uv * w2;
+					row[dx] = blend_pixel(row[dx], shade_fragment(batch.texture, color, uv, uv_dx, uv_dy));
+				}
+			}
+		}
+	}
+
+} // namespace platform
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <platform/graphics/scissor_rect.h>
+#include <platform/graphics/texture.h>
+
+#include <glm/glm.hpp>
+
+#include <optional>
+#include <span>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace platform {
+
+	// RGBA8 pixels, red in lowest byte (see pack_color). Rows are stored
+	// bottom to top like OpenGL textures, so row 0 is the bottom row.
+	struct RasterImage {
+		int width = 0;
+		int height = 0;
+		std::vector<uint32_t> pixels;
+
+		RasterImage() = default;
+		RasterImage(int width, int height, uint32_t fill = 0);
+
+		uint32_t& pixel(int x, int y) {
+			return pixels[(size_t)y * width + x];
+		}
+		uint32_t pixel(int x, int y) const {
+			return pixels[(size_t)y * width + x];
+		}
+	};
+
+	// Image plus sampler state, like a bound OpenGL texture
+	struct RasterTexture {
+		const RasterImage* image = nullptr;
+		TextureWrapping wrapping = TextureWrapping::ClampToEdge;
+		TextureFilter filter = TextureFilter::Nearest;
+		// Alpha is a distance field thresholded at 0.5 like shader.frag.
+		// Points and lines have no derivatives to antialias with.
+		bool distance_field = false;
+	};
+
+	// Vertex in window coordinates, i.e. pixels with (0, 0) in the bottom
+	// left corner of the target
+	struct RasterVertex {
+		glm::vec2 pos;
+		glm::vec4 color;
+		glm::vec2 uv;
+	};
+
+	enum class RasterPrimitive {
+		Points,
+		Lines, // pairs of vertices
+		Triangles, // triples of vertices
+	};
+
+	// Draws primitives into an RGBA8 image on the CPU, following the OpenGL
+	// rasterization rules closely enough to stand in for a GPU in tests:
+	//
+	// - triangles cover pixels whose center is inside, with a top-left fill
+	//   rule so that shared edges are drawn once
+	// - lines exclude their last pixel
+	// - fragments are `texture(uv) * color`, blended with
+	//   (SRC_ALPHA, ONE_MINUS_SRC_ALPHA)
+	//
+	// Draws are queued and rasterized on `flush`. The target is split into
+	// horizontal bands that are rasterized on separate threads, each band
+	// drawing every primitive in submission order, so the output doesn't
+	// depend on the number of threads.
+	class SoftwareRasterizer {
+	public:
+		explicit SoftwareRasterizer(size_t num_threads = 1);
+
+		void set_num_threads(size_t num_threads);
+		size_t num_threads() const;
+
+		// Later draws only touch pixels inside the rect, or all pixels if empty
+		void set_scissor(std::optional<ScissorRect> scissor);
+
+		// The texture image must stay alive and unchanged until flushed
+		void draw(RasterPrimitive primitive, const RasterTexture& texture, std::span<const RasterVertex> vertices);
+		void flush(RasterImage* target);
+		size_t num_queued_vertices() const;
+
+	private:
+		struct Batch {
+			RasterPrimitive primitive;
+			RasterTexture texture;
+			std::optional<ScissorRect> scissor;
+			size_t first;
+			size_t count;
+		};
+		struct Band {
+			int y_begin;
+			int y_end;
+		};
+		struct PixelBounds {
+			int x_begin;
+			int x_end;
+			int y_begin;
+			int y_end;
+		};
+
+		void _rasterize_band(RasterImage* target, Band band) const;
+		void _rasterize_points(RasterImage* target, PixelBounds bounds, const Batch& batch) const;
+		void _rasterize_lines(RasterImage* target, PixelBounds bounds, const Batch& batch) const;
+		void _rasterize_triangles(RasterImage* target, PixelBounds bounds, const Batch& batch) const;
+
+		size_t m_num_threads;
+		std::optional<ScissorRect> m_scissor;
+		std::vector<RasterVertex> m_vertices;
+		std::vector<Batch> m_batches;
+	};
+
+	// Blends a constant source color over a span of pixels, 4 pixels at a
+	// time when SSE2 is available
+	void blend_span(uint32_t* pixels, size_t num_pixels, uint32_t src);
+	uint32_t blend_pixel(uint32_t dst, uint32_t src);
+
+	glm::vec4 sample_texture(const RasterTexture& texture, glm::vec2 uv);
+
+} // namespace platform
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace platform {
+
+	// Handle to draws recorded once and kept on the GPU, see
+	// Renderer::add_static_batch
+	struct StaticBatch {
+		uint32_t id;
+	};
+
+} // namespace platform
@@ -0,0 +1,124 @@
+#include <platform/graphics/streaming_buffer.h>
+
+#include <algorithm>
+
+namespace platform {
+
+	static size_t align_up(size_t value, size_t alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	StreamingBuffer::StreamingBuffer(IStreamingBufferBackend* backend, size_t num_frames, size_t initial_frame_capacity)
+		: m_backend(backend)
+		, m_num_frames(num_frames)
+		, m_frame_capacity(std::max<size_t>(initial_frame_capacity, 1))
+		, m_capacity(num_frames * m_frame_capacity) {
+		m_backend->resize(m_capacity);
+	}
+
+	void StreamingBuffer::reserve(size_t size) {
+		const Range range = _allocate(size, 1);
+		m_head = range.begin;
+		m_reserved_end = range.end;
+	}
+
+	size_t StreamingBuffer::push(const void* data, size_t size, size_t alignment) {
+		Range range;
+		range.begin = align_up(m_head, alignment);
+		range.end = range.begin + size;
+		if (range.end > m_reserved_end) {
+			m_reserved_end = 0;
+			range = _allocate(size, alignment);
+		}
+
+		/* Write */
+		m_backend->write(range.begin, data, size);
+		m_pending.push_back(range);
+		m_head = range.end;
+
+		return range.begin;
+	}
+
+	void StreamingBuffer::fence() {
+		m_reserved_end = 0;
+		if (m_pending.empty()) {
+			return;
+		}
+		m_in_flight.push_back(FencedRanges { .fence = m_backend->insert_fence(), .ranges = m_pending });
+		m_pending.clear();
+	}
+
+	StreamingBufferStats StreamingBuffer::stats() const {
+		StreamingBufferStats stats = m_stats;
+		stats.capacity = m_capacity;
+		stats.frame_capacity = m_frame_capacity;
+		return stats;
+	}
+
+	// Range for `size` bytes that's free to write, growing the buffer or
+	// waiting for the GPU if needed
+	StreamingBuffer::Range StreamingBuffer::_allocate(size_t size, size_t alignment) {
+		if (size > m_frame_capacity) {
+			_grow(size);
+		}
+
+		/* Allocate */
+		Range range;
+		range.begin = align_up(m_head, alignment);
+		if (range.begin + size > m_capacity) {
+			range.begin = 0; // wrap around
+		}
+		range.end = range.begin + size;
+
+		/* Wait until range is free */
+		auto overlaps = [&](const Range& other) { return range.begin < other.end && other.begin < range.end; };
+		if (std::any_of(m_pending.begin(), m_pending.end(), overlaps)) {
+			// Too much pushed without a fence. Draw calls for the pending data
+			// have been issued, so it can be fenced here.
+			fence();
+		}
+		_wait_for_range(range);
+
+		return range;
+	}
+
+	void StreamingBuffer::_grow(size_t min_frame_capacity) {
+		while (m_frame_capacity < min_frame_capacity) {
+			m_frame_capacity *= 2;
+		}
+		m_capacity = m_num_frames * m_frame_capacity;
+
+		// Pending data is still read from the old storage by the draw calls
+		// already issued, so only the fences need to be cleaned up.
+		while (!m_in_flight.empty()) {
+			_wait_for_oldest();
+		}
+		m_pending.clear();
+		m_head = 0;
+
+		m_backend->resize(m_capacity);
+		m_stats.num_resizes += 1;
+	}
+
+	void StreamingBuffer::_wait_for_range(Range range) {
+		auto overlaps = [&](const Range& other) { return range.begin < other.end && other.begin < range.end; };
+		auto in_flight_overlaps = [&]() {
+			return std::any_of(m_in_flight.begin(), m_in_flight.end(), [&](const FencedRanges& fenced) {
+				return std::any_of(fenced.ranges.begin(), fenced.ranges.end(), overlaps);
+			});
+		};
+
+		// The ring is written in order, so the oldest data is the first to
+		// be overwritten
+		while (in_flight_overlaps()) {
+			_wait_for_oldest();
+		}
+	}
+
+	void StreamingBuffer::_wait_for_oldest() {
+		m_backend->wait_fence(m_in_flight.front().fence);
+		m_in_flight.pop_front();
+		m_stats.num_fence_waits += 1;
+	}
+
+} // namespace platform
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <deque>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace platform {
+
+	// Storage that a StreamingBuffer writes into, e.g. a persistently mapped
+	// OpenGL buffer. Fences mark the point after which the GPU no longer
+	// reads what was written before the fence was inserted.
+	class IStreamingBufferBackend {
+	public:
+		virtual ~IStreamingBufferBackend() {}
+		virtual void resize(size_t capacity) = 0; // discards previous contents
+		virtual void write(size_t offset, const void* data, size_t size) = 0;
+		virtual uint64_t insert_fence() = 0;
+		virtual void wait_fence(uint64_t fence) = 0; // waits and deletes fence
+	};
+
+	struct StreamingBufferStats {
+		size_t capacity = 0; // bytes
+		size_t frame_capacity = 0; // bytes, largest allowed single allocation
+		size_t num_fence_waits = 0;
+		size_t num_resizes = 0;
+	};
+
+	// Ring allocator over a buffer with room for `num_frames` frames of data.
+	//
+	// Data is pushed into the ring and then read by draw calls. After the
+	// draw calls are issued, `fence()` is called, and the ring won't write
+	// over that data again until the GPU has passed the fence. When a push
+	// doesn't fit in one frame's capacity, the buffer is grown to the next
+	// power of two.
+	//
+	// Draw calls reading pushed data must be issued before the next push,
+	// since a push may grow the buffer or fence the previous data itself.
+	// Data pushed together before any of it is drawn, like a frame's
+	// vertices and quad instances, is reserved for up front instead.
+	class StreamingBuffer {
+	public:
+		StreamingBuffer(IStreamingBufferBackend* backend, size_t num_frames, size_t initial_frame_capacity);
+
+		// Makes room for `size` bytes of pushes, including their alignment
+		// padding, in one range. Growing, wrapping and waiting happen
+		// here, so pushes that fit in the range don't invalidate each
+		// other. The reservation ends at the next fence.
+		void reserve(size_t size);
+		size_t push(const void* data, size_t size, size_t alignment);
+		void fence();
+
+		StreamingBufferStats stats() const;
+
+	private:
+		struct Range {
+			size_t begin;
+			size_t end;
+		};
+		struct FencedRanges {
+			uint64_t fence;
+			std::vector<Range> ranges;
+		};
+
+		Range _allocate(size_t size, size_t alignment);
+		void _grow(size_t min_frame_capacity);
+		void _wait_for_range(Range range);
+		void _wait_for_oldest();
+
+		IStreamingBufferBackend* m_backend;
+		size_t m_num_frames;
+		size_t m_frame_capacity;
+		size_t m_capacity;
+		size_t m_head = 0;
+		size_t m_reserved_end = 0; // end of the range made room for by reserve, pushes up to it are free
+		std::vector<Range> m_pending; // pushed since last fence
+		std::deque<FencedRanges> m_in_flight; // oldest first
+		StreamingBufferStats m_stats;
+	};
+
+} // namespace platform
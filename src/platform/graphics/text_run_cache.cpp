@@ -0,0 +1,133 @@
+#include <platform/graphics/text_run_cache.h>
+
+#include <core/hash.h>
+#include <core/utf8.h>
+#include <platform/graphics/glyph_cache.h>
+
+#include <string_view>
+
+namespace platform {
+
+	std::vector<GlyphQuad> layout_text_run(const Font& font, const std::string& text, bool* is_complete) {
+		std::vector<GlyphQuad> quads;
+		if (is_complete) {
+			*is_complete = true;
+		}
+		float pen_x = 0.0f;
+		const char* it = text.data();
+		const char* end = text.data() + text.size();
+		while (it != end) {
+			const char32_t codepoint = core::utf8::next_codepoint(&it, end);
+			bool is_missed;
+			const std::optional<CachedGlyph> cached_glyph = find_glyph(font, codepoint, &is_missed);
+			if (!cached_glyph) {
+				if (is_complete && is_missed) {
+					*is_complete = false;
+				}
+				continue;
+			}
+			const platform::Glyph& glyph = cached_glyph->glyph;
+
+			if (codepoint != ' ' && glyph.size.x > 0 && glyph.size.y > 0) {
+				const glm::vec2 atlas_size = cached_glyph->texture.size;
+				const glm::vec2 pos0 = glm::vec2 { pen_x + glyph.bearing.x * font.scale, -glyph.bearing.y * font.scale };
+
+				// atlas rows are flipped, v0 is the bottom of the glyph
+				const float u0 = glyph.atlas_pos.x / atlas_size.x;
+				const float v0 = 1 - (glyph.atlas_pos.y + glyph.size.y) / atlas_size.y;
+				const float u1 = u0 + glyph.size.x / atlas_size.x;
+				const float v1 = v0 + glyph.size.y / atlas_size.y;
+
+				quads.push_back(GlyphQuad {
+					.pos0 = pos0,
+					.pos1 = pos0 + glm::vec2 { glyph.size } * font.scale,
+					.uv0 = { u0, v1 },
+					.uv1 = { u1, v0 },
+					.texture = cached_glyph->texture,
+				});
+			}
+
+			pen_x += glyph.advance * font.scale;
+		}
+		return quads;
+	}
+
+	TextRunCache::TextRunCache(size_t max_quads)
+		: m_max_quads(max_quads) {
+	}
+
+	const std::vector<GlyphQuad>& TextRunCache::quads(const Font& font, const std::string& text, bool* is_complete) {
+		if (is_complete) {
+			*is_complete = true;
+		}
+
+		size_t key = std::hash<std::string_view> {}(text);
+		core::hash::add_to_hash(&key, font.atlas.id);
+		core::hash::add_to_hash(&key, font.generation);
+		core::hash::add_to_hash(&key, font.size);
+
+		/* Hit */
+		auto it = m_runs_by_key.find(key);
+		if (it != m_runs_by_key.end()) {
+			TextRun& run = *it->second;
+			if (run.atlas == font.atlas.id && run.font_generation == font.generation && run.font_size == font.size && run.text == text) {
+				m_stats.num_hits += 1;
+				m_runs.splice(m_runs.begin(), m_runs, it->second);
+				return run.quads;
+			}
+
+			// hash collision, replace the other run
+			m_num_quads -= run.quads.size();
+			m_runs.erase(it->second);
+			m_runs_by_key.erase(it);
+		}
+
+		/* Miss */
+		m_stats.num_misses += 1;
+		bool is_run_complete;
+		std::vector<GlyphQuad> quads = layout_text_run(font, text, &is_run_complete);
+		if (!is_run_complete) {
+			m_stats.num_incomplete += 1;
+			if (is_complete) {
+				*is_complete = false;
+			}
+		}
+		if (!is_run_complete || quads.size() > m_max_quads) {
+			m_uncached_quads = std::move(quads);
+			return m_uncached_quads;
+		}
+
+		_evict_until_fits(quads.size());
+		m_num_quads += quads.size();
+		m_runs.push_front(TextRun { .key = key, .atlas = font.atlas.id, .font_generation = font.generation, .font_size = font.size, .text = text, .quads = std::move(quads) });
+		m_runs_by_key[key] = m_runs.begin();
+		return m_runs.front().quads;
+	}
+
+	size_t TextRunCache::num_runs() const {
+		return m_runs.size();
+	}
+
+	size_t TextRunCache::num_quads() const {
+		return m_num_quads;
+	}
+
+	TextRunCacheStats TextRunCache::stats() const {
+		return m_stats;
+	}
+
+	void TextRunCache::reset_stats() {
+		m_stats = {};
+	}
+
+	void TextRunCache::_evict_until_fits(size_t num_quads) {
+		while (!m_runs.empty() && m_num_quads + num_quads > m_max_quads) {
+			const TextRun& run = m_runs.back();
+			m_num_quads -= run.quads.size();
+			m_runs_by_key.erase(run.key);
+			m_runs.pop_back();
+			m_stats.num_evictions += 1;
+		}
+	}
+
+} // namespace platform
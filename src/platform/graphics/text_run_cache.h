@@ -0,0 +1,86 @@
+#pragma once
+
+#include <platform/graphics/font.h>
+#include <platform/graphics/texture.h>
+
+#include <glm/glm.hpp>
+
+#include <list>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace platform {
+
+	// Glyph quad of a laid out text run, with corners and uvs like Quad
+	struct GlyphQuad {
+		glm::vec2 pos0; // relative to the start of the text's baseline
+		glm::vec2 pos1;
+		glm::vec2 uv0;
+		glm::vec2 uv1;
+		Texture texture; // font atlas or glyph cache page
+	};
+
+	struct TextRunCacheStats {
+		size_t num_hits = 0;
+		size_t num_misses = 0;
+		size_t num_evictions = 0;
+		size_t num_incomplete = 0; // runs not kept since they had glyphs not yet in the glyph cache
+	};
+
+	// Laid out glyph quads by font and string, so that drawing text that
+	// doesn't change between frames only has to translate the quads.
+	//
+	// Text is UTF-8. Runs with glyphs the font's glyph cache missed, since
+	// it couldn't add them on this thread, are laid out without them and
+	// not kept, so they're laid out again once the glyphs are there.
+	//
+	// Fonts are told apart by their atlas texture, generation and size.
+	// Memory is bounded by the total number of quads stored, evicting the
+	// least recently drawn runs first. Runs longer than the bound are laid
+	// out but not kept. The bound should fit all text drawn in a frame,
+	// since drawing more than fits in the same order every frame evicts
+	// each run before it's drawn again. Every DrawRecorder has its own
+	// cache, so worker recorders each take up to the bound as well.
+	class TextRunCache {
+	public:
+		explicit TextRunCache(size_t max_quads = 256 * 1024); // about 11.5 MB of 44 byte quads
+
+		// Reference is valid until the next call. Sets `is_complete` like
+		// layout_text_run.
+		const std::vector<GlyphQuad>& quads(const Font& font, const std::string& text, bool* is_complete = nullptr);
+
+		size_t num_runs() const;
+		size_t num_quads() const;
+
+		// Counted since the last reset
+		TextRunCacheStats stats() const;
+		void reset_stats();
+
+	private:
+		struct TextRun {
+			uint64_t key;
+			GLuint atlas;
+			uint64_t font_generation;
+			size_t font_size; // distance field fonts of every size share an atlas
+			std::string text;
+			std::vector<GlyphQuad> quads;
+		};
+
+		void _evict_until_fits(size_t num_quads);
+
+		size_t m_max_quads;
+		size_t m_num_quads = 0;
+		std::list<TextRun> m_runs; // most recently drawn first
+		std::unordered_map<uint64_t, std::list<TextRun>::iterator> m_runs_by_key;
+		std::vector<GlyphQuad> m_uncached_quads;
+		TextRunCacheStats m_stats;
+	};
+
+	// Sets `is_complete` to whether no glyph was missed, see
+	// GlyphCache::glyph. Codepoints the font has no glyph for are skipped.
+	std::vector<GlyphQuad> layout_text_run(const Font& font, const std::string& text, bool* is_complete = nullptr);
+
+} // namespace platform
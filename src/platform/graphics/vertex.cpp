@@ -0,0 +1,58 @@
+#include <platform/graphics/vertex.h>
+
+namespace platform {
+
+	static uint32_t unorm8(float value) {
+		return (uint32_t)(glm::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	static uint16_t unorm16(float value) {
+		return (uint16_t)(glm::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+	}
+
+	size_t vertex_size(VertexFormat format) {
+		switch (format) {
+			case VertexFormat::Standard:
+				return sizeof(Vertex);
+			case VertexFormat::Packed:
+				return sizeof(PackedVertex);
+		}
+		return 0;
+	}
+
+	uint32_t pack_color(glm::vec4 color) {
+		return unorm8(color.r) | unorm8(color.g) << 8 | unorm8(color.b) << 16 | unorm8(color.a) << 24;
+	}
+
+	glm::vec4 unpack_color(uint32_t color) {
+		return glm::vec4 {
+			(color & 0xFF) / 255.0f,
+			(color >> 8 & 0xFF) / 255.0f,
+			(color >> 16 & 0xFF) / 255.0f,
+			(color >> 24 & 0xFF) / 255.0f,
+		};
+	}
+
+	PackedVertex pack_vertex(const Vertex& vertex, float uv_scale) {
+		return PackedVertex {
+			.pos = vertex.pos,
+			.color = pack_color(vertex.color),
+			.uv = { unorm16(vertex.uv.x / uv_scale), unorm16(vertex.uv.y / uv_scale) },
+		};
+	}
+
+	QuadInstance pack_quad(const Quad& quad, float uv_scale) {
+		return QuadInstance {
+			.pos0 = quad.pos0,
+			.pos1 = quad.pos1,
+			.uv = {
+				unorm16(quad.uv0.x / uv_scale),
+				unorm16(quad.uv0.y / uv_scale),
+				unorm16(quad.uv1.x / uv_scale),
+				unorm16(quad.uv1.y / uv_scale),
+			},
+			.color = pack_color(quad.color),
+		};
+	}
+
+} // namespace platform
@@ -3,12 +3,69 @@
 #include <SDL2/SDL_opengl.h>
 #include <glm/glm.hpp>
 
+#include <stddef.h>
+#include <stdint.h>
+
 namespace platform {
 
+	enum class VertexFormat {
+		// 32 bytes, full float precision
+		Standard,
+		// 16 bytes, RGBA8 color and 16-bit normalized uv
+		Packed,
+	};
+
+	enum class QuadMode {
+		// Textured quads are 4 vertices each
+		Vertices,
+		// Textured quads are one QuadInstance each, expanded to the quad's
+		// corners in the vertex shader (see quad_instance.vert)
+		Instanced,
+	};
+
 	struct Vertex {
 		glm::vec2 pos;
 		glm::vec4 color;
 		glm::vec2 uv;
 	};
 
+	// Compact vertex used when uploading with VertexFormat::Packed.
+	//
+	// The uv is stored normalized to [0, 1] and multiplied by the uv_scale
+	// uniform in the vertex shader, so that sections with repeating uvs
+	// (e.g. a tiled grid) can still be represented.
+	struct PackedVertex {
+		glm::vec2 pos;
+		uint32_t color; // RGBA8, red in lowest byte
+		uint16_t uv[2];
+	};
+	static_assert(sizeof(PackedVertex) == 16);
+
+	// Textured quad as recorded with QuadMode::Instanced. The corners are
+	// vertex 0 and 3 in the order of quad.h. Vertex 1 takes its x from
+	// corner 0 and its y from corner 3, vertex 2 the other way around.
+	struct Quad {
+		glm::vec2 pos0;
+		glm::vec2 pos1;
+		glm::vec2 uv0;
+		glm::vec2 uv1;
+		glm::vec4 color;
+	};
+
+	// Compact quad uploaded with QuadMode::Instanced, with the uv normalized
+	// like PackedVertex.
+	struct QuadInstance {
+		glm::vec2 pos0;
+		glm::vec2 pos1;
+		uint16_t uv[4]; // uv0, uv1
+		uint32_t color; // RGBA8, red in lowest byte
+	};
+	static_assert(sizeof(QuadInstance) == 28);
+
+	size_t vertex_size(VertexFormat format);
+	uint32_t pack_color(glm::vec4 color);
+	glm::vec4 unpack_color(uint32_t color);
+	PackedVertex pack_vertex(const Vertex& vertex, float uv_scale);
+	QuadInstance pack_quad(const Quad& quad, float uv_scale);
+
 } // namespace platform
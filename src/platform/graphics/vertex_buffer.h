@@ -0,0 +1,19 @@
+#pragma once
+
+#include <platform/graphics/vertex.h>
+
+#include <SDL2/SDL_opengl.h>
+
+#include <stddef.h>
+
+namespace platform {
+
+	// Vertices uploaded once and kept on the GPU, unlike the vertices
+	// streamed every frame
+	struct VertexBuffer {
+		GLuint id;
+		size_t num_vertices;
+		VertexFormat vertex_format;
+	};
+
+} // namespace platform
@@ -8,7 +8,7 @@
 namespace platform {
 
 	std::string usage_string() {
-		return std::string("usage: ") + application_name() + "[-h | --help] [--editor]";
+		return std::string("usage: ") + application_name() + "[-h | --help] [--editor] [--windowed] [--packed-vertices] [--instanced-quads]";
 	}
 
 	std::expected<CommandLineArgs, std::string> parse_arguments(int argc, char** argv) {
@@ -24,6 +24,12 @@ namespace platform {
 			else if (core::string::equals(argv[i], "--windowed")) {
 				cmds.start_game_windowed = true;
 			}
+			else if (core::string::equals(argv[i], "--packed-vertices")) {
+				cmds.use_packed_vertices = true;
+			}
+			else if (core::string::equals(argv[i], "--instanced-quads")) {
+				cmds.use_instanced_quads = true;
+			}
 			else {
 				return std::unexpected(std::string("Unexpected arg: ") + argv[i]);
 			}
@@ -9,6 +9,8 @@ namespace platform {
 		bool print_usage = false;
 		bool start_in_editor_mode = false;
 		bool start_game_windowed = false;
+		bool use_packed_vertices = false;
+		bool use_instanced_quads = false;
 	};
 
 	std::string usage_string();
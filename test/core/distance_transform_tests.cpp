@@ -0,0 +1,89 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <core/distance_transform.h>
+
+#include <cmath>
+#include <random>
+
+static float brute_force_squared_distance(const std::vector<uint8_t>& is_feature, glm::ivec2 size, glm::ivec2 cell) {
+	float min_distance = core::DISTANCE_TRANSFORM_INFINITY;
+	for (int y = 0; y < size.y; y++) {
+		for (int x = 0; x < size.x; x++) {
+			if (is_feature[(size_t)(y * size.x + x)]) {
+				min_distance = std::min(min_distance, (float)((x - cell.x) * (x - cell.x) + (y - cell.y) * (y - cell.y)));
+			}
+		}
+	}
+	return min_distance;
+}
+
+TEST(DistanceTransformTests, SquaredDistanceTransform_SingleFeature_SquaredDistanceToIt) {
+	const glm::ivec2 size = { 5, 4 };
+	std::vector<uint8_t> is_feature(20, 0);
+	is_feature[2 * 5 + 1] = 1;
+
+	const std::vector<float> distances = core::squared_distance_transform(is_feature, size);
+
+	for (int y = 0; y < size.y; y++) {
+		for (int x = 0; x < size.x; x++) {
+			EXPECT_EQ(distances[(size_t)(y * size.x + x)], (float)((x - 1) * (x - 1) + (y - 2) * (y - 2))) << x << ", " << y;
+		}
+	}
+}
+
+TEST(DistanceTransformTests, SquaredDistanceTransform_NoFeatures_Infinity) {
+	const std::vector<uint8_t> is_feature(12, 0);
+
+	const std::vector<float> distances = core::squared_distance_transform(is_feature, { 4, 3 });
+
+	EXPECT_THAT(distances, testing::Each(core::DISTANCE_TRANSFORM_INFINITY));
+}
+
+TEST(DistanceTransformTests, SquaredDistanceTransform_RandomFeatures_MatchesBruteForce) {
+	const glm::ivec2 size = { 37, 23 };
+	std::mt19937 rng(1234);
+	std::bernoulli_distribution is_feature_dist(0.05);
+	std::vector<uint8_t> is_feature((size_t)(size.x * size.y));
+	for (uint8_t& cell : is_feature) {
+		cell = is_feature_dist(rng);
+	}
+
+	const std::vector<float> distances = core::squared_distance_transform(is_feature, size);
+
+	for (int y = 0; y < size.y; y++) {
+		for (int x = 0; x < size.x; x++) {
+			EXPECT_EQ(distances[(size_t)(y * size.x + x)], brute_force_squared_distance(is_feature, size, { x, y })) << x << ", " << y;
+		}
+	}
+}
+
+TEST(DistanceTransformTests, SignedDistanceField_Square_ReferenceDistances) {
+	// 3x3 square in the middle of a 7x7 grid
+	const glm::ivec2 size = { 7, 7 };
+	std::vector<uint8_t> coverage(49, 0);
+	for (int y = 2; y < 5; y++) {
+		for (int x = 2; x < 5; x++) {
+			coverage[(size_t)(y * 7 + x)] = 255;
+		}
+	}
+
+	const std::vector<float> distances = core::signed_distance_field(coverage, size);
+
+	const float middle_row[] = { -1.5f, -0.5f, 0.5f, 1.5f, 0.5f, -0.5f, -1.5f };
+	for (int x = 0; x < 7; x++) {
+		EXPECT_FLOAT_EQ(distances[(size_t)(3 * 7 + x)], middle_row[x]) << x;
+	}
+	EXPECT_FLOAT_EQ(distances[0], 0.5f - std::sqrt(8.0f)); // to the square's corner
+	EXPECT_FLOAT_EQ(distances[1 * 7 + 1], 0.5f - std::sqrt(2.0f));
+	EXPECT_FLOAT_EQ(distances[2 * 7 + 2], 0.5f);
+}
+
+TEST(DistanceTransformTests, SignedDistanceField_CoverageAtThreshold_Inside) {
+	const std::vector<uint8_t> coverage = { 127, 128 };
+
+	const std::vector<float> distances = core::signed_distance_field(coverage, { 2, 1 }, 128);
+
+	EXPECT_FLOAT_EQ(distances[0], -0.5f);
+	EXPECT_FLOAT_EQ(distances[1], 0.5f);
+}
@@ -0,0 +1,67 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <core/radix_sort.h>
+
+#include <algorithm>
+#include <random>
+
+static std::vector<uint64_t> sorted_keys(const std::vector<core::SortKey>& keys) {
+	std::vector<uint64_t> result;
+	for (const core::SortKey& sort_key : keys) {
+		result.push_back(sort_key.key);
+	}
+	return result;
+}
+
+static std::vector<uint32_t> sorted_indices(const std::vector<core::SortKey>& keys) {
+	std::vector<uint32_t> result;
+	for (const core::SortKey& sort_key : keys) {
+		result.push_back(sort_key.index);
+	}
+	return result;
+}
+
+TEST(RadixSortTests, EmptyKeys_StaysEmpty) {
+	std::vector<core::SortKey> keys;
+	std::vector<core::SortKey> scratch;
+
+	core::radix_sort(&keys, &scratch);
+
+	EXPECT_TRUE(keys.empty());
+}
+
+TEST(RadixSortTests, SmallKeys_AreSorted) {
+	std::vector<core::SortKey> keys = { { 3, 0 }, { 1, 1 }, { 2, 2 }, { 0, 3 } };
+	std::vector<core::SortKey> scratch;
+
+	core::radix_sort(&keys, &scratch);
+
+	EXPECT_THAT(sorted_keys(keys), testing::ElementsAre(0, 1, 2, 3));
+	EXPECT_THAT(sorted_indices(keys), testing::ElementsAre(3, 1, 2, 0));
+}
+
+TEST(RadixSortTests, EqualKeys_KeepRelativeOrder) {
+	const uint64_t high = 1ull << 48;
+	std::vector<core::SortKey> keys = { { high, 0 }, { 5, 1 }, { high, 2 }, { 5, 3 }, { high | 5, 4 } };
+	std::vector<core::SortKey> scratch;
+
+	core::radix_sort(&keys, &scratch);
+
+	EXPECT_THAT(sorted_indices(keys), testing::ElementsAre(1, 3, 0, 2, 4));
+}
+
+TEST(RadixSortTests, RandomKeys_MatchStableSort) {
+	std::mt19937_64 rng(1234);
+	std::vector<core::SortKey> keys;
+	for (uint32_t i = 0; i < 1000; i++) {
+		keys.push_back(core::SortKey { rng() % 64 | (rng() % 4) << 40, i });
+	}
+	std::vector<core::SortKey> expected = keys;
+	std::stable_sort(expected.begin(), expected.end(), [](const core::SortKey& lhs, const core::SortKey& rhs) { return lhs.key < rhs.key; });
+	std::vector<core::SortKey> scratch;
+
+	core::radix_sort(&keys, &scratch);
+
+	EXPECT_EQ(sorted_indices(keys), sorted_indices(expected));
+}
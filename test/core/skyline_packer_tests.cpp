@@ -0,0 +1,94 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <core/skyline_packer.h>
+
+#include <algorithm>
+#include <random>
+
+struct PackedRect {
+	glm::ivec2 pos;
+	glm::ivec2 size;
+};
+
+static bool rects_overlap(const PackedRect& lhs, const PackedRect& rhs) {
+	return lhs.pos.x < rhs.pos.x + rhs.size.x && rhs.pos.x < lhs.pos.x + lhs.size.x &&
+		lhs.pos.y < rhs.pos.y + rhs.size.y && rhs.pos.y < lhs.pos.y + lhs.size.y;
+}
+
+// Sprite and glyph like sizes, sorted by decreasing height like atlases pack them
+static std::vector<glm::ivec2> make_corpus(size_t num_rects, int min_size, int max_size) {
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<int> dist(min_size, max_size);
+	std::vector<glm::ivec2> sizes;
+	for (size_t i = 0; i < num_rects; i++) {
+		sizes.push_back({ dist(rng), dist(rng) });
+	}
+	std::sort(sizes.begin(), sizes.end(), [](glm::ivec2 lhs, glm::ivec2 rhs) { return lhs.y > rhs.y; });
+	return sizes;
+}
+
+// Packs until the first rect that doesn't fit
+static std::vector<PackedRect> pack_corpus(core::SkylinePacker* packer, const std::vector<glm::ivec2>& sizes) {
+	std::vector<PackedRect> packed;
+	for (glm::ivec2 size : sizes) {
+		std::optional<glm::ivec2> pos = packer->pack(size);
+		if (!pos) {
+			break;
+		}
+		packed.push_back({ *pos, size });
+	}
+	return packed;
+}
+
+TEST(SkylinePackerTests, Pack_SameSizedSquares_FillsAreaExactly) {
+	core::SkylinePacker packer({ 64, 64 });
+
+	for (int i = 0; i < 16; i++) {
+		ASSERT_TRUE(packer.pack({ 16, 16 }).has_value());
+	}
+
+	EXPECT_FALSE(packer.pack({ 1, 1 }).has_value());
+	EXPECT_FLOAT_EQ(packer.occupancy(), 1.0f);
+}
+
+TEST(SkylinePackerTests, Pack_RectLargerThanArea_ReturnsEmpty) {
+	core::SkylinePacker packer({ 64, 64 });
+
+	EXPECT_FALSE(packer.pack({ 65, 1 }).has_value());
+	EXPECT_FALSE(packer.pack({ 1, 65 }).has_value());
+	EXPECT_EQ(packer.packed_area(), 0);
+}
+
+TEST(SkylinePackerTests, Pack_Corpus_PackedRectsAreInsideAndDontOverlap) {
+	core::SkylinePacker packer({ 256, 256 });
+
+	std::vector<PackedRect> packed = pack_corpus(&packer, make_corpus(200, 4, 40));
+
+	ASSERT_GT(packed.size(), 0);
+	for (size_t i = 0; i < packed.size(); i++) {
+		EXPECT_GE(packed[i].pos.x, 0);
+		EXPECT_GE(packed[i].pos.y, 0);
+		EXPECT_LE(packed[i].pos.x + packed[i].size.x, 256);
+		EXPECT_LE(packed[i].pos.y + packed[i].size.y, 256);
+		for (size_t j = i + 1; j < packed.size(); j++) {
+			EXPECT_FALSE(rects_overlap(packed[i], packed[j])) << "rects " << i << " and " << j;
+		}
+	}
+}
+
+TEST(SkylinePackerTests, Pack_SpriteCorpus_OccupiesMostOfTheAreaBeforeRunningOut) {
+	core::SkylinePacker packer({ 1024, 1024 });
+
+	pack_corpus(&packer, make_corpus(2000, 8, 64));
+
+	EXPECT_GT(packer.occupancy(), 0.85f);
+}
+
+TEST(SkylinePackerTests, Pack_GlyphCorpus_OccupiesMostOfTheAreaBeforeRunningOut) {
+	core::SkylinePacker packer({ 512, 512 });
+
+	pack_corpus(&packer, make_corpus(2000, 2, 24));
+
+	EXPECT_GT(packer.occupancy(), 0.9f);
+}
@@ -0,0 +1,43 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <core/utf8.h>
+
+#include <string>
+#include <vector>
+
+static std::vector<char32_t> decode(const std::string& text) {
+	std::vector<char32_t> codepoints;
+	const char* it = text.data();
+	const char* end = text.data() + text.size();
+	while (it != end) {
+		codepoints.push_back(core::utf8::next_codepoint(&it, end));
+	}
+	return codepoints;
+}
+
+TEST(Utf8Tests, NextCodepoint_Ascii_OneByteEach) {
+	EXPECT_THAT(decode("Hi!"), testing::ElementsAre(U'H', U'i', U'!'));
+}
+
+TEST(Utf8Tests, NextCodepoint_MultiByteSequences_Decoded) {
+	// 2, 3 and 4 byte sequences
+	EXPECT_THAT(decode("\xC3\xA5\xE6\x97\xA5\xF0\x9F\x98\x80"), testing::ElementsAre(U'\u00E5', U'\u65E5', U'\U0001F600'));
+}
+
+TEST(Utf8Tests, NextCodepoint_TruncatedSequence_ReplacementPerByte) {
+	EXPECT_THAT(decode("\xE6\x97"), testing::ElementsAre(core::utf8::REPLACEMENT_CHARACTER, core::utf8::REPLACEMENT_CHARACTER));
+}
+
+TEST(Utf8Tests, NextCodepoint_InvalidBytes_ReplacedAndDecodingContinues) {
+	EXPECT_THAT(decode("a\xFF" "b\x80" "c"), testing::ElementsAre(U'a', core::utf8::REPLACEMENT_CHARACTER, U'b', core::utf8::REPLACEMENT_CHARACTER, U'c'));
+}
+
+TEST(Utf8Tests, NextCodepoint_OverlongEncoding_Replaced) {
+	// '/' encoded with two bytes
+	EXPECT_EQ(decode("\xC0\xAF").front(), core::utf8::REPLACEMENT_CHARACTER);
+}
+
+TEST(Utf8Tests, NextCodepoint_Surrogate_Replaced) {
+	EXPECT_EQ(decode("\xED\xA0\x80").front(), core::utf8::REPLACEMENT_CHARACTER);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <core/worker_pool.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST(WorkerPoolTests, Run_SeveralJobs_RunsEachIndexOnce) {
+	core::WorkerPool pool(4);
+	std::vector<std::atomic<int>> num_runs(10);
+
+	pool.run(num_runs.size(), [&](size_t index) { num_runs[index]++; });
+
+	for (const std::atomic<int>& count : num_runs) {
+		EXPECT_EQ(count.load(), 1);
+	}
+}
+
+TEST(WorkerPoolTests, Run_ReturnsAfterAllJobsAreDone) {
+	core::WorkerPool pool(2);
+	std::atomic<int> num_done = 0;
+
+	pool.run(8, [&](size_t /* index */) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		num_done++;
+	});
+
+	EXPECT_EQ(num_done.load(), 8);
+}
+
+TEST(WorkerPoolTests, Run_JobsOnWorkerThreads_NotOnCallingThread) {
+	core::WorkerPool pool(2);
+	std::atomic<bool> ran_on_calling_thread = false;
+	const std::thread::id calling_thread = std::this_thread::get_id();
+
+	pool.run(4, [&](size_t /* index */) {
+		if (std::this_thread::get_id() == calling_thread) {
+			ran_on_calling_thread = true;
+		}
+	});
+
+	EXPECT_FALSE(ran_on_calling_thread.load());
+}
+
+TEST(WorkerPoolTests, Run_SeveralBatches_KeepsThreadsBetweenBatches) {
+	core::WorkerPool pool(2);
+	std::mutex mutex;
+	std::set<std::thread::id> thread_ids;
+
+	for (int batch = 0; batch < 20; batch++) {
+		pool.run(2, [&](size_t /* index */) {
+			std::lock_guard lock(mutex);
+			thread_ids.insert(std::this_thread::get_id());
+		});
+	}
+
+	EXPECT_LE(thread_ids.size(), 2);
+}
+
+TEST(WorkerPoolTests, Resize_ThenRun_RunsEachIndexOnce) {
+	core::WorkerPool pool(1);
+	pool.run(1, [](size_t /* index */) {});
+	std::vector<std::atomic<int>> num_runs(6);
+
+	pool.resize(3);
+	pool.run(num_runs.size(), [&](size_t index) { num_runs[index]++; });
+
+	EXPECT_EQ(pool.num_threads(), 3);
+	for (const std::atomic<int>& count : num_runs) {
+		EXPECT_EQ(count.load(), 1);
+	}
+}
+
+TEST(WorkerPoolTests, Resize_ToZero_KeepsOneThread) {
+	core::WorkerPool pool(4);
+	pool.resize(0);
+	EXPECT_EQ(pool.num_threads(), 1);
+}
@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+
+#include <engine/state/scene_graph.h>
+
+#include <iterator>
+
+TEST(SceneGraphTests, AddTextNode_VersionChanged) {
+	engine::SceneGraph scene_graph;
+	const uint64_t version = scene_graph.version();
+
+	scene_graph.add_text_node(scene_graph.root(), engine::TextID(0));
+
+	EXPECT_NE(scene_graph.version(), version);
+}
+
+TEST(SceneGraphTests, RemoveNode_VersionChanged) {
+	engine::SceneGraph scene_graph;
+	scene_graph.add_text_node(scene_graph.root(), engine::TextID(0));
+	const uint64_t version = scene_graph.version();
+
+	scene_graph.remove_node(std::next(scene_graph.root())); // the text node, first after the root
+
+	EXPECT_NE(scene_graph.version(), version);
+}
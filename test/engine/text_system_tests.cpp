@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <engine/system/text_system.h>
+#include <platform/graphics/software_gl_context.h>
+
+#include <filesystem>
+
+class TextSystemTests : public testing::Test {
+protected:
+	void TearDown() override {
+		m_text_system.shutdown(&m_gl_context);
+	}
+
+	engine::FontID add_test_font() {
+		return m_text_system.add_font(&m_gl_context, m_font_path.c_str(), 16).value();
+	}
+
+	platform::SoftwareOpenGLContext m_gl_context = platform::SoftwareOpenGLContext(64, 64);
+	engine::TextSystem m_text_system;
+	std::string m_font_path = (std::filesystem::current_path() / "test/platform/test_data/test_font.ttf").string();
+};
+
+TEST_F(TextSystemTests, AddFont_VersionChanged) {
+	const uint64_t version = m_text_system.version();
+
+	add_test_font();
+
+	EXPECT_NE(m_text_system.version(), version);
+}
+
+TEST_F(TextSystemTests, AddFont_MissingFile_VersionUnchanged) {
+	const uint64_t version = m_text_system.version();
+
+	EXPECT_FALSE(m_text_system.add_font(&m_gl_context, "missing_font.ttf", 16).has_value());
+
+	EXPECT_EQ(m_text_system.version(), version);
+}
+
+TEST_F(TextSystemTests, AddTextNode_VersionChanged) {
+	const engine::FontID font_id = add_test_font();
+	const uint64_t version = m_text_system.version();
+
+	m_text_system.add_text_node(font_id, "Hello");
+
+	EXPECT_NE(m_text_system.version(), version);
+}
+
+TEST_F(TextSystemTests, RemoveTextNode_VersionChanged) {
+	const engine::TextID text_id = m_text_system.add_text_node(add_test_font(), "Hello");
+	const uint64_t version = m_text_system.version();
+
+	m_text_system.remove_text_node(text_id);
+
+	EXPECT_NE(m_text_system.version(), version);
+}
+
+TEST_F(TextSystemTests, SetPosition_VersionChanged) {
+	const engine::TextID text_id = m_text_system.add_text_node(add_test_font(), "Hello");
+	const uint64_t version = m_text_system.version();
+
+	m_text_system.set_position(text_id, { 10.0f, 20.0f });
+
+	EXPECT_NE(m_text_system.version(), version);
+}
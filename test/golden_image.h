@@ -0,0 +1,98 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <platform/graphics/software_rasterizer.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdlib.h>
+#include <string>
+
+// Golden images are stored as binary PAM files (RGBA8, top row first), a
+// format simple enough to read and write without a library and viewable in
+// most image editors.
+//
+// To regenerate after an intended change to rendering, run the tests with
+// the UPDATE_GOLDEN_IMAGES environment variable set.
+
+inline void save_golden_image(const std::filesystem::path& path, const platform::RasterImage& image) {
+	std::ofstream file(path, std::ios::binary);
+	file << "P7\nWIDTH " << image.width << "\nHEIGHT " << image.height << "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+	for (int y = image.height - 1; y >= 0; y--) {
+		file.write((const char*)&image.pixels[(size_t)y * image.width], image.width * sizeof(uint32_t));
+	}
+}
+
+inline std::optional<platform::RasterImage> load_golden_image(const std::filesystem::path& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		return {};
+	}
+
+	/* Header */
+	int width = 0;
+	int height = 0;
+	for (std::string token; file >> token && token != "ENDHDR";) {
+		if (token == "WIDTH") {
+			file >> width;
+		}
+		else if (token == "HEIGHT") {
+			file >> height;
+		}
+	}
+	file.get(); // newline after ENDHDR
+
+	/* Pixels */
+	platform::RasterImage image(width, height);
+	for (int y = image.height - 1; y >= 0; y--) {
+		file.read((char*)&image.pixels[(size_t)y * image.width], image.width * sizeof(uint32_t));
+	}
+	if (!file) {
+		return {};
+	}
+	return image;
+}
+
+// Compares with a small tolerance, since float rounding differs slightly
+// between compilers and FreeType versions may rasterize glyphs differently.
+// On mismatch, the actual image is written to the temp directory for
+// inspection.
+inline testing::AssertionResult matches_golden_image(const platform::RasterImage& actual, const std::filesystem::path& golden_path) {
+	const int max_channel_difference = 2;
+	const double max_mismatched_fraction = 0.005;
+
+	if (getenv("UPDATE_GOLDEN_IMAGES")) {
+		save_golden_image(golden_path, actual);
+		return testing::AssertionSuccess() << "updated " << golden_path.string();
+	}
+
+	std::optional<platform::RasterImage> golden = load_golden_image(golden_path);
+	if (!golden) {
+		return testing::AssertionFailure() << "could not read " << golden_path.string() << ", set UPDATE_GOLDEN_IMAGES to create it";
+	}
+	if (golden->width != actual.width || golden->height != actual.height) {
+		return testing::AssertionFailure() << "size " << actual.width << "x" << actual.height << " differs from golden " << golden->width << "x" << golden->height;
+	}
+
+	size_t num_mismatched = 0;
+	for (size_t i = 0; i < actual.pixels.size(); i++) {
+		for (int shift = 0; shift < 32; shift += 8) {
+			const int lhs = (actual.pixels[i] >> shift) & 0xFF;
+			const int rhs = (golden->pixels[i] >> shift) & 0xFF;
+			if (std::abs(lhs - rhs) > max_channel_difference) {
+				num_mismatched++;
+				break;
+			}
+		}
+	}
+
+	if ((double)num_mismatched > max_mismatched_fraction * actual.pixels.size()) {
+		const std::filesystem::path actual_path = std::filesystem::temp_directory_path() / golden_path.filename().replace_extension(".actual.pam");
+		save_golden_image(actual_path, actual);
+		return testing::AssertionFailure() << num_mismatched << " of " << actual.pixels.size() << " pixels differ from " << golden_path.string() << ", actual image written to " << actual_path.string();
+	}
+	return testing::AssertionSuccess();
+}
@@ -12,13 +12,41 @@ namespace testing {
 			: platform::OpenGLContext(SDL_GLContext { nullptr }) {}
 
 		MOCK_METHOD(platform::Texture, add_texture, (const unsigned char* data, int width, int height, platform::TextureWrapping wrapping, platform::TextureFilter filter), (override));
+		MOCK_METHOD(void, update_texture, (platform::Texture texture, glm::ivec2 pos, glm::ivec2 size, const unsigned char* data), (override));
 		MOCK_METHOD(void, set_texture_wrapping, (platform::Texture texture, platform::TextureWrapping wrapping), (override));
 		MOCK_METHOD(void, set_texture_filter, (platform::Texture texture, platform::TextureFilter filter), (override));
 		MOCK_METHOD(void, free_texture, (platform::Texture texture), (override));
 		MOCK_METHOD(platform::Canvas, add_canvas, (int width, int height, platform::TextureWrapping wrapping, platform::TextureFilter filter), (override));
 		MOCK_METHOD(void, free_canvas, (platform::Canvas canvas), (override));
-		MOCK_METHOD((std::expected<platform::ShaderProgram, platform::ShaderProgramError>), add_shader_program, (const char* vertex_src, const char* fragment_src), (override));
+		MOCK_METHOD((std::expected<platform::ShaderProgram, platform::ShaderProgramError>), add_shader_program, (const char* vertex_src, const char* fragment_src, platform::VertexFormat vertex_format), (override));
+		MOCK_METHOD((std::expected<platform::QuadInstanceProgram, platform::ShaderProgramError>), add_quad_instance_program, (const char* vertex_src, const char* fragment_src), (override));
 		MOCK_METHOD(void, free_shader_program, (const platform::ShaderProgram& shader_program), (override));
+		MOCK_METHOD(platform::IndexBuffer, add_index_buffer, (const std::vector<uint32_t>& indices), (override));
+		MOCK_METHOD(void, free_index_buffer, (platform::IndexBuffer index_buffer), (override));
+		MOCK_METHOD(platform::VertexBuffer, add_vertex_buffer, (const std::vector<platform::Vertex>& vertices), (override));
+		MOCK_METHOD(platform::VertexBuffer, add_packed_vertex_buffer, (const std::vector<platform::PackedVertex>& vertices), (override));
+		MOCK_METHOD(void, free_vertex_buffer, (platform::VertexBuffer vertex_buffer), (override));
+		MOCK_METHOD(void, bind_shader_program, (const platform::ShaderProgram& shader_program), (override));
+		MOCK_METHOD(void, unbind_shader_program, (), (override));
+		MOCK_METHOD(void, set_projection, (const platform::ShaderProgram& shader_program, glm::mat4 projection), (override));
+		MOCK_METHOD(void, reserve_vertex_stream, (size_t size), (override));
+		MOCK_METHOD(void, upload_vertices, (const platform::ShaderProgram& shader_program, const std::vector<platform::Vertex>& vertices), (override));
+		MOCK_METHOD(void, upload_packed_vertices, (const platform::ShaderProgram& shader_program, const std::vector<platform::PackedVertex>& vertices), (override));
+		MOCK_METHOD(void, upload_quad_instances, (const platform::ShaderProgram& shader_program, const std::vector<platform::QuadInstance>& instances), (override));
+		MOCK_METHOD(void, bind_vertex_buffer, (const platform::ShaderProgram& shader_program, platform::VertexBuffer vertex_buffer), (override));
+		MOCK_METHOD(void, bind_streamed_vertices, (const platform::ShaderProgram& shader_program), (override));
+		MOCK_METHOD(void, fence_vertices, (), (override));
+		MOCK_METHOD(platform::StreamingBufferStats, vertex_stream_stats, (), (const, override));
+		MOCK_METHOD(void, set_uv_scale, (const platform::ShaderProgram& shader_program, float uv_scale), (override));
+		MOCK_METHOD(void, set_distance_field, (const platform::ShaderProgram& shader_program, bool enabled), (override));
+		MOCK_METHOD(void, bind_texture, (platform::Texture texture), (override));
+		MOCK_METHOD(void, bind_canvas, (platform::Canvas canvas), (override));
+		MOCK_METHOD(void, unbind_canvas, (), (override));
+		MOCK_METHOD(void, set_scissor, (platform::ScissorRect rect), (override));
+		MOCK_METHOD(void, disable_scissor, (), (override));
+		MOCK_METHOD(void, draw_arrays, (GLenum mode, GLint first, GLsizei count), (override));
+		MOCK_METHOD(void, draw_elements, (GLenum mode, platform::IndexBuffer index_buffer, GLsizei count, GLint base_vertex), (override));
+		MOCK_METHOD(void, draw_quad_instances, (const platform::ShaderProgram& shader_program, GLint first, GLsizei count, float uv_scale), (override));
 	};
 
 } // namespace testing
@@ -0,0 +1,48 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/circle_cache.h>
+
+using namespace testing;
+
+TEST(CircleCacheTests, RadiusOne_PointsOnCircle) {
+	platform::CircleCache cache;
+
+	EXPECT_THAT(cache.octant_points(1.0f), ElementsAre(glm::vec2 { 0.0f, 1.0f }));
+	EXPECT_THAT(cache.span_points(1.0f), ElementsAre(glm::vec2 { -1.0f, 0.0f }, glm::vec2 { 0.0f, 1.0f }, glm::vec2 { 1.0f, 0.0f }));
+}
+
+TEST(CircleCacheTests, SpanPoints_AnyRadius_OnePointPerXInOrder) {
+	platform::CircleCache cache;
+
+	const std::vector<glm::vec2>& span_points = cache.span_points(10.0f);
+
+	ASSERT_EQ(span_points.size(), 21);
+	for (size_t i = 0; i < span_points.size(); i++) {
+		EXPECT_EQ(span_points[i].x, (float)i - 10.0f);
+	}
+}
+
+TEST(CircleCacheTests, SpanPoints_SameRadiusTwice_ComputedOnce) {
+	platform::CircleCache cache;
+
+	const std::vector<glm::vec2>* first = &cache.span_points(5.0f);
+	const size_t num_points = cache.num_points();
+	const std::vector<glm::vec2>* second = &cache.span_points(5.0f);
+
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(cache.num_points(), num_points);
+	EXPECT_EQ(cache.num_tables(), 1);
+}
+
+TEST(CircleCacheTests, SpanPoints_ExceedsMaxPoints_CacheCleared) {
+	platform::CircleCache cache(100);
+
+	for (float radius = 1.0f; radius <= 30.0f; radius += 1.0f) {
+		cache.span_points(radius);
+		EXPECT_LE(cache.num_points(), 100);
+	}
+
+	EXPECT_LT(cache.num_tables(), 30);
+	EXPECT_EQ(cache.span_points(30.0f).size(), 61);
+}
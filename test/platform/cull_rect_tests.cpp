@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <platform/graphics/cull_rect.h>
+
+TEST(CullRectTests, Overlaps_RectInside_ReturnsTrue) {
+	const platform::CullRect cull_rect({ { 0.0f, 0.0f }, { 64.0f, 32.0f } });
+
+	EXPECT_TRUE(cull_rect.overlaps({ 10.0f, 10.0f }, { 20.0f, 20.0f }));
+}
+
+TEST(CullRectTests, Overlaps_RectCrossingEdge_ReturnsTrue) {
+	const platform::CullRect cull_rect({ { 0.0f, 0.0f }, { 64.0f, 32.0f } });
+
+	EXPECT_TRUE(cull_rect.overlaps({ -10.0f, 10.0f }, { 1.0f, 20.0f }));
+	EXPECT_TRUE(cull_rect.overlaps({ -10.0f, -10.0f }, { 100.0f, 100.0f }));
+}
+
+TEST(CullRectTests, Overlaps_RectOutsideEachSide_ReturnsFalse) {
+	const platform::CullRect cull_rect({ { 0.0f, 0.0f }, { 64.0f, 32.0f } });
+
+	EXPECT_FALSE(cull_rect.overlaps({ -20.0f, 10.0f }, { -10.0f, 20.0f }));
+	EXPECT_FALSE(cull_rect.overlaps({ 70.0f, 10.0f }, { 80.0f, 20.0f }));
+	EXPECT_FALSE(cull_rect.overlaps({ 10.0f, -20.0f }, { 20.0f, -10.0f }));
+	EXPECT_FALSE(cull_rect.overlaps({ 10.0f, 40.0f }, { 20.0f, 50.0f }));
+}
+
+TEST(CullRectTests, Overlaps_RectTouchingEdge_ReturnsFalse) {
+	const platform::CullRect cull_rect({ { 0.0f, 0.0f }, { 64.0f, 32.0f } });
+
+	EXPECT_FALSE(cull_rect.overlaps({ 64.0f, 10.0f }, { 80.0f, 20.0f }));
+	EXPECT_FALSE(cull_rect.overlaps({ 10.0f, -10.0f }, { 20.0f, 0.0f }));
+}
+
+TEST(CullRectTests, Overlaps_CornersInAnyOrder_SameResult) {
+	const platform::CullRect cull_rect({ { 0.0f, 0.0f }, { 64.0f, 32.0f } });
+
+	EXPECT_TRUE(cull_rect.overlaps({ 20.0f, 20.0f }, { 10.0f, 10.0f }));
+	EXPECT_TRUE(cull_rect.overlaps({ 20.0f, 10.0f }, { 10.0f, 20.0f }));
+	EXPECT_FALSE(cull_rect.overlaps({ 80.0f, 20.0f }, { 70.0f, 10.0f }));
+}
+
+TEST(CullRectTests, Rect_FlippedRect_ReturnsOrderedRect) {
+	const platform::CullRect cull_rect({ { 64.0f, 32.0f }, { 0.0f, 0.0f } });
+
+	EXPECT_EQ(cull_rect.rect().top_left, glm::vec2(0.0f, 0.0f));
+	EXPECT_EQ(cull_rect.rect().bottom_right, glm::vec2(64.0f, 32.0f));
+}
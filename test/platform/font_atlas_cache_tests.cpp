@@ -0,0 +1,178 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/file/file.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/font_atlas_cache.h>
+#include <platform/graphics/glyph_cache.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string.h>
+
+using namespace testing;
+
+static std::filesystem::path test_font_path() {
+	return std::filesystem::current_path() / "test/platform/test_data/test_font.ttf";
+}
+
+static platform::BakedFont bake_test_font(uint8_t size) {
+	const platform::FontFace face = platform::load_font_face(test_font_path()).value();
+	return platform::BakedFont {
+		.atlas = platform::generate_font_atlas(face, size),
+		.latin_glyphs = platform::rasterize_latin_glyphs(face, size),
+	};
+}
+
+static void expect_glyphs_eq(const platform::Glyph& lhs, const platform::Glyph& rhs) {
+	EXPECT_EQ(lhs.atlas_pos, rhs.atlas_pos);
+	EXPECT_EQ(lhs.size, rhs.size);
+	EXPECT_EQ(lhs.bearing, rhs.bearing);
+	EXPECT_EQ(lhs.advance, rhs.advance);
+}
+
+static void expect_atlases_eq(const platform::FontAtlas& lhs, const platform::FontAtlas& rhs) {
+	EXPECT_EQ(lhs.size, rhs.size);
+	EXPECT_EQ(lhs.width, rhs.width);
+	EXPECT_EQ(lhs.height, rhs.height);
+	EXPECT_EQ(lhs.line_height, rhs.line_height);
+	EXPECT_EQ(lhs.occupancy, rhs.occupancy);
+	EXPECT_EQ(lhs.distance_field, rhs.distance_field);
+	for (size_t i = 0; i < platform::FontAtlas::NUM_GLYPHS; i++) {
+		expect_glyphs_eq(lhs.glyphs[i], rhs.glyphs[i]);
+	}
+	ASSERT_EQ(lhs.pixels.size(), rhs.pixels.size());
+	EXPECT_EQ(memcmp(lhs.pixels.data(), rhs.pixels.data(), lhs.pixels.size() * sizeof(platform::RGBA)), 0);
+}
+
+class FontAtlasCacheTests : public Test {
+protected:
+	FontAtlasCacheTests()
+		: m_directory(std::filesystem::temp_directory_path() / "font_atlas_cache_tests" / UnitTest::GetInstance()->current_test_info()->name()) {
+		std::filesystem::remove_all(m_directory);
+	}
+
+	~FontAtlasCacheTests() {
+		std::filesystem::remove_all(m_directory);
+	}
+
+	std::filesystem::path m_directory;
+};
+
+TEST(FontAtlasCacheSerializationTests, SerializeBakedFont_Deserialized_SameAtlasAndLatinGlyphs) {
+	const platform::BakedFont font = bake_test_font(16);
+
+	const std::expected<platform::BakedFont, platform::FontAtlasCacheError> deserialized = platform::deserialize_baked_font(platform::serialize_baked_font(font));
+
+	ASSERT_TRUE(deserialized.has_value());
+	expect_atlases_eq(deserialized->atlas, font.atlas);
+	ASSERT_EQ(deserialized->latin_glyphs.size(), font.latin_glyphs.size());
+	for (size_t i = 0; i < font.latin_glyphs.size(); i++) {
+		expect_glyphs_eq(deserialized->latin_glyphs[i].glyph, font.latin_glyphs[i].glyph);
+		EXPECT_EQ(deserialized->latin_glyphs[i].coverage, font.latin_glyphs[i].coverage);
+	}
+}
+
+TEST(FontAtlasCacheSerializationTests, SerializeBakedFont_AtlasPixels_OneBytePerPixel) {
+	const platform::BakedFont font = { .atlas = bake_test_font(16).atlas };
+
+	const std::vector<uint8_t> bytes = platform::serialize_baked_font(font);
+
+	EXPECT_LT(bytes.size(), font.atlas.pixels.size() * sizeof(platform::RGBA) / 2);
+}
+
+TEST(FontAtlasCacheSerializationTests, DeserializeBakedFont_Truncated_UnexpectedEndOfData) {
+	std::vector<uint8_t> bytes = platform::serialize_baked_font(bake_test_font(16));
+	bytes.resize(bytes.size() / 2);
+
+	const std::expected<platform::BakedFont, platform::FontAtlasCacheError> deserialized = platform::deserialize_baked_font(bytes);
+
+	ASSERT_FALSE(deserialized.has_value());
+	EXPECT_EQ(deserialized.error(), platform::FontAtlasCacheError::UnexpectedEndOfData);
+}
+
+TEST(FontAtlasCacheSerializationTests, DeserializeBakedFont_OtherVersion_UnsupportedVersion) {
+	std::vector<uint8_t> bytes = platform::serialize_baked_font(bake_test_font(16));
+	bytes[4] += 1; // version follows the 4 byte magic
+
+	const std::expected<platform::BakedFont, platform::FontAtlasCacheError> deserialized = platform::deserialize_baked_font(bytes);
+
+	ASSERT_FALSE(deserialized.has_value());
+	EXPECT_EQ(deserialized.error(), platform::FontAtlasCacheError::UnsupportedVersion);
+}
+
+TEST(FontAtlasCacheSerializationTests, FontAtlasCacheKey_DifferentParameters_DifferentKeys) {
+	const uint64_t file_hash = platform::hash_font_file(platform::read_file_bytes(test_font_path()).value());
+	const uint64_t key = platform::font_atlas_cache_key(file_hash, 16, {}, false);
+
+	EXPECT_EQ(platform::font_atlas_cache_key(file_hash, 16, {}, false), key);
+	EXPECT_NE(platform::font_atlas_cache_key(file_hash + 1, 16, {}, false), key);
+	EXPECT_NE(platform::font_atlas_cache_key(file_hash, 17, {}, false), key);
+	EXPECT_NE(platform::font_atlas_cache_key(file_hash, 16, { .padding = 2 }, false), key);
+	EXPECT_NE(platform::font_atlas_cache_key(file_hash, 16, { .mode = platform::FontAtlasMode::DistanceField }, false), key);
+	EXPECT_NE(platform::font_atlas_cache_key(file_hash, 16, {}, true), key);
+}
+
+TEST_F(FontAtlasCacheTests, Load_NothingStored_Miss) {
+	platform::FontAtlasCache cache(m_directory);
+
+	EXPECT_FALSE(cache.load(1234).has_value());
+	EXPECT_EQ(cache.stats().num_misses, 1);
+}
+
+TEST_F(FontAtlasCacheTests, Load_AfterStore_Hit) {
+	platform::FontAtlasCache cache(m_directory);
+	const platform::BakedFont font = bake_test_font(16);
+
+	ASSERT_TRUE(cache.store(1234, font));
+	const std::optional<platform::BakedFont> loaded = cache.load(1234);
+
+	ASSERT_TRUE(loaded.has_value());
+	expect_atlases_eq(loaded->atlas, font.atlas);
+	EXPECT_EQ(loaded->latin_glyphs.size(), font.latin_glyphs.size());
+	EXPECT_FALSE(cache.load(5678).has_value());
+	EXPECT_EQ(cache.stats().num_hits, 1);
+	EXPECT_EQ(cache.stats().num_stores, 1);
+}
+
+TEST_F(FontAtlasCacheTests, Load_CorruptEntry_Miss) {
+	platform::FontAtlasCache cache(m_directory);
+	ASSERT_TRUE(cache.store(1234, bake_test_font(16)));
+	std::filesystem::resize_file(cache.entry_path(1234), 16);
+
+	EXPECT_FALSE(cache.load(1234).has_value());
+	EXPECT_EQ(cache.stats().num_misses, 1);
+}
+
+TEST_F(FontAtlasCacheTests, LoadOrBakeFont_SecondLoad_LoadedFromCache) {
+	platform::FontAtlasCache cache(m_directory);
+
+	const std::expected<platform::BakedFont, std::string> baked = platform::load_or_bake_font(&cache, test_font_path(), 16, {}, true);
+	const std::expected<platform::BakedFont, std::string> loaded = platform::load_or_bake_font(&cache, test_font_path(), 16, {}, true);
+
+	ASSERT_TRUE(baked.has_value());
+	ASSERT_TRUE(loaded.has_value());
+	expect_atlases_eq(loaded->atlas, baked->atlas);
+	EXPECT_EQ(loaded->latin_glyphs.size(), platform::GlyphCache::LATIN_END - platform::GlyphCache::LATIN_FIRST);
+	EXPECT_EQ(cache.stats().num_misses, 1);
+	EXPECT_EQ(cache.stats().num_hits, 1);
+}
+
+TEST_F(FontAtlasCacheTests, LoadOrBakeFont_FontFileChanged_Baked) {
+	std::filesystem::create_directories(m_directory);
+	const std::filesystem::path font_path = m_directory / "font.ttf";
+	std::filesystem::copy_file(test_font_path(), font_path);
+	platform::FontAtlasCache cache(m_directory / "cache");
+	platform::load_or_bake_font(&cache, font_path, 16);
+
+	// trailing bytes change the file's hash but not the font
+	{
+		std::ofstream file(font_path, std::ios::binary | std::ios::app);
+		file.put(0);
+	}
+	const std::expected<platform::BakedFont, std::string> font = platform::load_or_bake_font(&cache, font_path, 16);
+
+	ASSERT_TRUE(font.has_value());
+	EXPECT_EQ(cache.stats().num_misses, 2);
+	EXPECT_EQ(cache.stats().num_hits, 0);
+}
@@ -0,0 +1,94 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/font_baker.h>
+
+#include <filesystem>
+#include <string.h>
+
+using namespace testing;
+
+static std::filesystem::path test_font_path() {
+	return std::filesystem::current_path() / "test/platform/test_data/test_font.ttf";
+}
+
+static bool atlases_are_equal(const platform::FontAtlas& lhs, const platform::FontAtlas& rhs) {
+	return lhs.width == rhs.width && lhs.height == rhs.height && lhs.line_height == rhs.line_height &&
+		memcmp(lhs.glyphs, rhs.glyphs, sizeof(lhs.glyphs)) == 0 &&
+		lhs.pixels.size() == rhs.pixels.size() &&
+		memcmp(lhs.pixels.data(), rhs.pixels.data(), lhs.pixels.size() * sizeof(platform::RGBA)) == 0;
+}
+
+TEST(FontBakerTests, BakeFontAtlases_SeveralSizes_SameAsGeneratingEachAtlas) {
+	const std::vector<platform::FontBakeRequest> requests = {
+		{ .path = test_font_path(), .size = 8 },
+		{ .path = test_font_path(), .size = 16 },
+		{ .path = test_font_path(), .size = 24 },
+	};
+
+	std::vector<std::expected<platform::FontAtlas, std::string>> atlases = platform::bake_font_atlases(requests, { .num_threads = 4 });
+
+	platform::FontFace face = platform::load_font_face(test_font_path()).value();
+	ASSERT_EQ(atlases.size(), requests.size());
+	for (size_t i = 0; i < requests.size(); i++) {
+		ASSERT_TRUE(atlases[i].has_value());
+		EXPECT_TRUE(atlases_are_equal(atlases[i].value(), platform::generate_font_atlas(face, requests[i].size))) << "font size " << (int)requests[i].size;
+	}
+}
+
+TEST(FontBakerTests, BakeFontAtlases_OneThreadOrMany_SameAtlases) {
+	std::vector<platform::FontBakeRequest> requests;
+	for (uint8_t size = 8; size <= 32; size += 4) {
+		requests.push_back({ .path = test_font_path(), .size = size });
+	}
+
+	std::vector<std::expected<platform::FontAtlas, std::string>> one_thread = platform::bake_font_atlases(requests, { .num_threads = 1 });
+	std::vector<std::expected<platform::FontAtlas, std::string>> many_threads = platform::bake_font_atlases(requests, { .num_threads = 8, .glyphs_per_task = 5 });
+
+	for (size_t i = 0; i < requests.size(); i++) {
+		ASSERT_TRUE(one_thread[i].has_value());
+		ASSERT_TRUE(many_threads[i].has_value());
+		EXPECT_TRUE(atlases_are_equal(one_thread[i].value(), many_threads[i].value())) << "font size " << (int)requests[i].size;
+	}
+}
+
+TEST(FontBakerTests, BakeFontAtlases_SameFileSeveralSizes_FileReadOnce) {
+	const std::vector<platform::FontBakeRequest> requests = {
+		{ .path = test_font_path(), .size = 12 },
+		{ .path = test_font_path(), .size = 14 },
+		{ .path = test_font_path(), .size = 16 },
+	};
+	platform::FontBakeStats stats;
+
+	platform::bake_font_atlases(requests, { .num_threads = 2, .glyphs_per_task = 32 }, &stats);
+
+	EXPECT_EQ(stats.num_files_read, 1);
+	EXPECT_EQ(stats.num_tasks, 9); // 95 printable ascii glyphs in tasks of 32, per size
+	EXPECT_EQ(stats.num_threads, 2);
+}
+
+TEST(FontBakerTests, BakeFontAtlases_MissingFile_ErrorOnlyForItsRequests) {
+	const std::vector<platform::FontBakeRequest> requests = {
+		{ .path = test_font_path(), .size = 16 },
+		{ .path = "does/not/exist.ttf", .size = 16 },
+	};
+
+	std::vector<std::expected<platform::FontAtlas, std::string>> atlases = platform::bake_font_atlases(requests);
+
+	ASSERT_EQ(atlases.size(), 2);
+	EXPECT_TRUE(atlases[0].has_value());
+	EXPECT_FALSE(atlases[1].has_value());
+}
+
+TEST(FontBakerTests, BakeFontAtlases_FileIsNotAFont_ErrorOnlyForItsRequests) {
+	const std::vector<platform::FontBakeRequest> requests = {
+		{ .path = std::filesystem::current_path() / "test/platform/test_data/test_image.png", .size = 16 },
+		{ .path = test_font_path(), .size = 16 },
+	};
+
+	std::vector<std::expected<platform::FontAtlas, std::string>> atlases = platform::bake_font_atlases(requests, { .num_threads = 3 });
+
+	ASSERT_EQ(atlases.size(), 2);
+	EXPECT_FALSE(atlases[0].has_value());
+	EXPECT_TRUE(atlases[1].has_value());
+}
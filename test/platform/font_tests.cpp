@@ -0,0 +1,151 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/font.h>
+
+#include <filesystem>
+
+using namespace testing;
+
+constexpr uint8_t FONT_SIZES[] = { 8, 12, 16, 24, 32, 48 };
+
+static platform::FontFace load_test_font_face() {
+	return platform::load_font_face(std::filesystem::current_path() / "test/platform/test_data/test_font.ttf").value();
+}
+
+// Atlas bytes with the square grid generate_font_atlas used before packing
+// glyphs, which assumed glyphs twice as tall as they are wide
+static size_t grid_atlas_bytes(const platform::FontFace& face, uint8_t size) {
+	constexpr int pixels_per_point = 64;
+	FT_Set_Char_Size(face.get(), 0, size * pixels_per_point, 96, 96);
+	const uint32_t glyph_height = (1 + (face->size->metrics.height / pixels_per_point));
+	const uint32_t glyph_width = glyph_height / 2;
+	const uint32_t columns = (uint32_t)roundf(sqrtf((float)platform::Font::NUM_GLYPHS * (float)glyph_height / (float)glyph_width));
+	const uint32_t rows = (uint32_t)roundf((float)platform::Font::NUM_GLYPHS / (float)columns);
+	return (size_t)columns * glyph_width * rows * glyph_height * sizeof(platform::RGBA);
+}
+
+static bool glyphs_overlap(const platform::Glyph& lhs, const platform::Glyph& rhs) {
+	return lhs.atlas_pos.x < rhs.atlas_pos.x + rhs.size.x && rhs.atlas_pos.x < lhs.atlas_pos.x + lhs.size.x &&
+		lhs.atlas_pos.y < rhs.atlas_pos.y + rhs.size.y && rhs.atlas_pos.y < lhs.atlas_pos.y + lhs.size.y;
+}
+
+TEST(FontTests, GenerateFontAtlas_SeveralSizes_FewerBytesThanGrid) {
+	platform::FontFace face = load_test_font_face();
+
+	for (uint8_t size : FONT_SIZES) {
+		const size_t grid_bytes = grid_atlas_bytes(face, size);
+		const platform::FontAtlas atlas = platform::generate_font_atlas(face, size);
+
+		EXPECT_LT(atlas.pixels.size() * sizeof(platform::RGBA), grid_bytes) << "font size " << (int)size;
+	}
+}
+
+TEST(FontTests, GenerateFontAtlas_SeveralSizes_GlyphsInsideAtlasWithoutOverlapping) {
+	platform::FontFace face = load_test_font_face();
+
+	for (uint8_t size : FONT_SIZES) {
+		const platform::FontAtlas atlas = platform::generate_font_atlas(face, size);
+
+		for (int i = ' '; i < platform::Font::NUM_GLYPHS; i++) {
+			const platform::Glyph& glyph = atlas.glyphs[i];
+			EXPECT_GE(glyph.atlas_pos.x, 0);
+			EXPECT_GE(glyph.atlas_pos.y, 0);
+			EXPECT_LE(glyph.atlas_pos.x + glyph.size.x, (int)atlas.width) << "font size " << (int)size << ", glyph " << i;
+			EXPECT_LE(glyph.atlas_pos.y + glyph.size.y, (int)atlas.height) << "font size " << (int)size << ", glyph " << i;
+			for (int j = ' '; j < i; j++) {
+				if (glyph.size.x > 0 && atlas.glyphs[j].size.x > 0) {
+					EXPECT_FALSE(glyphs_overlap(glyph, atlas.glyphs[j])) << "font size " << (int)size << ", glyphs " << i << " and " << j;
+				}
+			}
+		}
+	}
+}
+
+TEST(FontTests, GenerateFontAtlas_SeveralSizes_MostlyCoveredByGlyphs) {
+	platform::FontFace face = load_test_font_face();
+
+	for (uint8_t size : FONT_SIZES) {
+		const platform::FontAtlas atlas = platform::generate_font_atlas(face, size);
+
+		EXPECT_GT(atlas.occupancy, 0.75f) << "font size " << (int)size;
+	}
+}
+
+TEST(FontTests, GenerateFontAtlas_PowerOfTwo_WidthAndHeightArePowersOfTwo) {
+	platform::FontFace face = load_test_font_face();
+
+	const platform::FontAtlas atlas = platform::generate_font_atlas(face, 24, { .power_of_two = true });
+
+	EXPECT_EQ(atlas.width & (atlas.width - 1), 0);
+	EXPECT_EQ(atlas.height & (atlas.height - 1), 0);
+	EXPECT_EQ(atlas.pixels.size(), (size_t)atlas.width * atlas.height);
+}
+
+TEST(FontTests, GenerateFontAtlas_GlyphPixels_CopiedToAtlasWithFlippedRows) {
+	platform::FontFace face = load_test_font_face();
+
+	const platform::FontAtlas atlas = platform::generate_font_atlas(face, 16);
+
+	// the top row of the glyph is the last row of it in the atlas
+	FT_Load_Char(face.get(), 'A', FT_LOAD_RENDER);
+	const FT_Bitmap& bmp = face->glyph->bitmap;
+	const platform::Glyph& glyph = atlas.glyphs['A'];
+	ASSERT_EQ(glyph.size, glm::ivec2(bmp.width, bmp.rows));
+	for (int row = 0; row < glyph.size.y; row++) {
+		const size_t atlas_row = atlas.height - 1 - (size_t)(glyph.atlas_pos.y + row);
+		for (int col = 0; col < glyph.size.x; col++) {
+			const platform::RGBA pixel = atlas.pixels[atlas_row * atlas.width + glyph.atlas_pos.x + col];
+			EXPECT_EQ(pixel.a, platform::glyph_pixel(bmp.buffer[row * bmp.pitch + col]).a);
+		}
+	}
+}
+
+TEST(FontTests, DistanceFieldPixel_Distances_EdgeAtHalfAlphaSaturatingAtSpread) {
+	EXPECT_EQ(platform::distance_field_pixel(0.0f, 4).a, 128);
+	EXPECT_EQ(platform::distance_field_pixel(2.0f, 4).a, 191);
+	EXPECT_EQ(platform::distance_field_pixel(4.0f, 4).a, 255);
+	EXPECT_EQ(platform::distance_field_pixel(-4.0f, 4).a, 0);
+	EXPECT_EQ(platform::distance_field_pixel(-10.0f, 4).a, 0);
+}
+
+TEST(FontTests, GenerateFontAtlas_DistanceField_GlyphsGrownBySpread) {
+	platform::FontFace face = load_test_font_face();
+
+	const platform::FontAtlas coverage = platform::generate_font_atlas(face, 16);
+	const platform::FontAtlas distance_field = platform::generate_font_atlas(face, 16, { .mode = platform::FontAtlasMode::DistanceField, .distance_field_spread = 4 });
+
+	EXPECT_FALSE(coverage.distance_field);
+	EXPECT_TRUE(distance_field.distance_field);
+	for (int i = '!'; i < platform::Font::NUM_GLYPHS; i++) {
+		const platform::Glyph& glyph = coverage.glyphs[i];
+		if (glyph.size.x == 0 || glyph.size.y == 0) {
+			continue;
+		}
+		EXPECT_EQ(distance_field.glyphs[i].size, glyph.size + 8) << "glyph " << i;
+		EXPECT_EQ(distance_field.glyphs[i].bearing, glyph.bearing + glm::ivec2(-4, 4)) << "glyph " << i;
+		EXPECT_EQ(distance_field.glyphs[i].advance, glyph.advance) << "glyph " << i;
+	}
+}
+
+TEST(FontTests, GenerateFontAtlas_DistanceField_CoveredPixelsInsideEdge) {
+	platform::FontFace face = load_test_font_face();
+
+	const platform::FontAtlas atlas = platform::generate_font_atlas(face, 16, { .mode = platform::FontAtlasMode::DistanceField, .distance_field_spread = 4 });
+
+	// pixels at least half covered are inside, above half alpha
+	FT_Load_Char(face.get(), 'A', FT_LOAD_RENDER);
+	const FT_Bitmap& bmp = face->glyph->bitmap;
+	const platform::Glyph& glyph = atlas.glyphs['A'];
+	auto atlas_alpha = [&](int col, int row) {
+		const size_t atlas_row = atlas.height - 1 - (size_t)(glyph.atlas_pos.y + row);
+		return atlas.pixels[atlas_row * atlas.width + glyph.atlas_pos.x + col].a;
+	};
+	for (int row = 0; row < (int)bmp.rows; row++) {
+		for (int col = 0; col < (int)bmp.width; col++) {
+			const bool is_inside = bmp.buffer[row * bmp.pitch + col] >= 128;
+			EXPECT_EQ(atlas_alpha(col + 4, row + 4) >= 128, is_inside) << col << ", " << row;
+		}
+	}
+	EXPECT_EQ(atlas_alpha(0, 0), 0); // further than the spread from the glyph
+}
@@ -0,0 +1,129 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <mock_gl_context.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/frame_pipeline.h>
+#include <platform/graphics/render_capture.h>
+#include <platform/graphics/renderer.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+
+using namespace testing;
+
+// Saves what it executes, on the pipeline's render thread
+class SavingRenderExecutor : public platform::IRenderExecutor {
+public:
+	void execute(const platform::ShaderProgram& /* shader_program */, const platform::RenderCommandList& command_list) override {
+		while (is_blocked.load()) {
+			std::this_thread::yield();
+		}
+		executed_bytes.push_back(platform::serialize_command_list(command_list));
+	}
+
+	// Counts the executed frames in num_resizes, to tell frames apart
+	platform::StreamingBufferStats vertex_stream_stats() const override {
+		return platform::StreamingBufferStats { .num_resizes = executed_bytes.size() };
+	}
+
+	std::atomic<bool> is_blocked = false;
+	std::vector<std::vector<uint8_t>> executed_bytes;
+};
+
+static platform::RenderCommandList make_frame(float id) {
+	platform::RenderCommandList command_list;
+	command_list.commands.push_back(platform::cmd::render::SetUvScale { id });
+	return command_list;
+}
+
+TEST(FramePipelineTests, Submit_ManyFrames_ExecutedInOrder) {
+	SavingRenderExecutor executor;
+	std::vector<std::vector<uint8_t>> expected_bytes;
+	{
+		platform::FramePipeline pipeline(&executor, 2);
+		for (int frame = 0; frame < 100; frame++) {
+			platform::RenderCommandList command_list = make_frame((float)frame);
+			expected_bytes.push_back(platform::serialize_command_list(command_list));
+			pipeline.submit({}, &command_list);
+		}
+		pipeline.flush();
+
+		EXPECT_EQ(pipeline.stats().num_executed_frames, 100);
+	}
+
+	EXPECT_EQ(executor.executed_bytes, expected_bytes);
+}
+
+TEST(FramePipelineTests, Submit_CommandList_TakenWithoutCopying) {
+	SavingRenderExecutor executor;
+	platform::FramePipeline pipeline(&executor);
+	platform::RenderCommandList command_list = make_frame(1.0f);
+
+	pipeline.submit({}, &command_list);
+
+	EXPECT_TRUE(command_list.commands.empty());
+}
+
+TEST(FramePipelineTests, Submit_MaxFramesInFlight_BlocksUntilFrameExecuted) {
+	SavingRenderExecutor executor;
+	platform::FramePipeline pipeline(&executor, 1);
+	executor.is_blocked = true;
+	platform::RenderCommandList first_frame = make_frame(1.0f);
+	pipeline.submit({}, &first_frame);
+
+	auto second_submit = std::async(std::launch::async, [&]() {
+		platform::RenderCommandList second_frame = make_frame(2.0f);
+		pipeline.submit({}, &second_frame);
+	});
+
+	EXPECT_EQ(second_submit.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+	executor.is_blocked = false;
+	second_submit.wait();
+	pipeline.flush();
+	EXPECT_EQ(executor.executed_bytes.size(), 2);
+}
+
+TEST(FramePipelineTests, VertexStreamStats_AfterSubmit_LastExecutedFrame) {
+	SavingRenderExecutor executor;
+	platform::FramePipeline pipeline(&executor, 2);
+	platform::RenderCommandList command_list;
+
+	const size_t num_resizes_before = pipeline.vertex_stream_stats().num_resizes;
+	command_list = make_frame(1.0f);
+	pipeline.submit({}, &command_list);
+	pipeline.flush();
+	command_list = make_frame(2.0f);
+	pipeline.submit({}, &command_list);
+	const size_t num_resizes_after = pipeline.vertex_stream_stats().num_resizes;
+
+	EXPECT_EQ(num_resizes_before, 0);
+	EXPECT_EQ(num_resizes_after, 1);
+}
+
+TEST(FramePipelineTests, Render_RendererSubmittingToPipeline_SameCommandsAsExecutingDirectly) {
+	NiceMock<MockOpenGLContext> gl_context;
+	SavingRenderExecutor direct_executor;
+	SavingRenderExecutor pipelined_executor;
+	platform::FramePipeline pipeline(&pipelined_executor, 2);
+	auto draw_frame = [](platform::Renderer* renderer, int frame) {
+		renderer->draw_rect_fill({ { 0.0f, 0.0f }, { (float)frame, 8.0f } }, platform::Color::red);
+		renderer->draw_line({ 0.0f, 0.0f }, { 8.0f, (float)frame }, platform::Color::green);
+	};
+
+	platform::Renderer direct_renderer(&gl_context);
+	platform::Renderer pipelined_renderer(&gl_context);
+	direct_renderer.set_executor(&direct_executor);
+	pipelined_renderer.set_executor(&pipeline);
+	for (int frame = 0; frame < 3; frame++) {
+		draw_frame(&direct_renderer, frame);
+		direct_renderer.render({});
+		draw_frame(&pipelined_renderer, frame);
+		pipelined_renderer.render({});
+	}
+	pipeline.flush();
+
+	EXPECT_EQ(pipelined_executor.executed_bytes, direct_executor.executed_bytes);
+}
@@ -0,0 +1,172 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/glyph_cache.h>
+#include <platform/graphics/renderer.h>
+#include <platform/graphics/software_gl_context.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+
+using namespace testing;
+
+static platform::FontFace load_test_font_face() {
+	return platform::load_font_face(std::filesystem::current_path() / "test/platform/test_data/test_font.ttf").value();
+}
+
+class GlyphCacheTests : public Test {
+protected:
+	GlyphCacheTests()
+		: m_gl_context(64, 64) {
+	}
+
+	platform::SoftwareOpenGLContext m_gl_context;
+};
+
+TEST_F(GlyphCacheTests, Glyph_Latin1Codepoint_RasterizedAtConstruction) {
+	platform::GlyphCache glyph_cache(&m_gl_context, load_test_font_face(), 16);
+
+	const std::optional<platform::CachedGlyph> glyph = glyph_cache.glyph(U'\u00E9');
+
+	ASSERT_TRUE(glyph.has_value());
+	EXPECT_GT(glyph->glyph.advance, 0);
+	EXPECT_EQ(glyph_cache.stats().num_glyphs, 0);
+	EXPECT_EQ(glyph_cache.stats().num_pages, 1);
+}
+
+TEST_F(GlyphCacheTests, Glyph_FromLatinGlyphs_SameAsRasterizedAtConstruction) {
+	const std::filesystem::path font_path = std::filesystem::current_path() / "test/platform/test_data/test_font.ttf";
+	platform::GlyphCache rasterized(&m_gl_context, load_test_font_face(), 16);
+	platform::GlyphCache from_latin_glyphs(&m_gl_context, font_path, 16, platform::rasterize_latin_glyphs(load_test_font_face(), 16));
+
+	const std::optional<platform::CachedGlyph> expected = rasterized.glyph(U'\u00E9');
+	const std::optional<platform::CachedGlyph> glyph = from_latin_glyphs.glyph(U'\u00E9');
+
+	ASSERT_TRUE(expected.has_value());
+	ASSERT_TRUE(glyph.has_value());
+	EXPECT_EQ(glyph->glyph.atlas_pos, expected->glyph.atlas_pos);
+	EXPECT_EQ(glyph->glyph.size, expected->glyph.size);
+	EXPECT_EQ(glyph->glyph.bearing, expected->glyph.bearing);
+	EXPECT_EQ(glyph->glyph.advance, expected->glyph.advance);
+	EXPECT_TRUE(from_latin_glyphs.glyph(U'\u65E5').has_value());
+}
+
+TEST_F(GlyphCacheTests, Glyph_FromLatinGlyphsWithoutFontFile_OnlyLatinGlyphs) {
+	platform::GlyphCache glyph_cache(&m_gl_context, "missing_font.ttf", 16, platform::rasterize_latin_glyphs(load_test_font_face(), 16));
+
+	EXPECT_TRUE(glyph_cache.glyph(U'\u00E9').has_value());
+	EXPECT_FALSE(glyph_cache.glyph(U'\u65E5').has_value());
+}
+
+TEST_F(GlyphCacheTests, Glyph_SameCodepointTwice_AddedOnce) {
+	platform::GlyphCache glyph_cache(&m_gl_context, load_test_font_face(), 16);
+	const size_t num_page_updates = glyph_cache.stats().num_page_updates;
+
+	const std::optional<platform::CachedGlyph> first = glyph_cache.glyph(U'\u65E5');
+	const std::optional<platform::CachedGlyph> second = glyph_cache.glyph(U'\u65E5');
+
+	ASSERT_TRUE(first.has_value());
+	ASSERT_TRUE(second.has_value());
+	EXPECT_EQ(first->glyph.atlas_pos, second->glyph.atlas_pos);
+	EXPECT_EQ(glyph_cache.stats().num_glyphs, 1);
+	EXPECT_LE(glyph_cache.stats().num_page_updates, num_page_updates + 1);
+}
+
+TEST_F(GlyphCacheTests, Glyph_PageFull_AddsPage) {
+	platform::GlyphCache glyph_cache(&m_gl_context, load_test_font_face(), 16, 64);
+	const size_t num_pages = glyph_cache.stats().num_pages;
+
+	std::optional<platform::CachedGlyph> first = glyph_cache.glyph(0x100);
+	std::optional<platform::CachedGlyph> last;
+	for (char32_t codepoint = 0x101; codepoint < 0x180; codepoint++) {
+		last = glyph_cache.glyph(codepoint);
+	}
+
+	ASSERT_TRUE(first.has_value());
+	ASSERT_TRUE(last.has_value());
+	EXPECT_GT(glyph_cache.stats().num_pages, num_pages);
+	EXPECT_NE(first->texture.id, last->texture.id);
+	EXPECT_EQ(glyph_cache.glyph(0x100)->texture.id, first->texture.id);
+}
+
+TEST_F(GlyphCacheTests, Glyph_OtherThread_OnlyGetsGlyphsAlreadyAdded) {
+	platform::GlyphCache glyph_cache(&m_gl_context, load_test_font_face(), 16);
+	auto glyph_on_other_thread = [&](char32_t codepoint) {
+		std::optional<platform::CachedGlyph> glyph;
+		std::thread([&]() { glyph = glyph_cache.glyph(codepoint); }).join();
+		return glyph;
+	};
+
+	const std::optional<platform::CachedGlyph> before_adding = glyph_on_other_thread(U'\u65E5');
+	glyph_cache.glyph(U'\u65E5');
+	const std::optional<platform::CachedGlyph> after_adding = glyph_on_other_thread(U'\u65E5');
+
+	EXPECT_FALSE(before_adding.has_value());
+	EXPECT_TRUE(after_adding.has_value());
+	EXPECT_EQ(glyph_cache.stats().num_missed_off_thread, 1);
+}
+
+TEST_F(GlyphCacheTests, Render_NonAsciiText_DrawnFromCachePage) {
+	platform::FontFace face = load_test_font_face();
+	platform::Font font = platform::create_font_from_atlas(&m_gl_context, platform::generate_font_atlas(face, 16));
+	font.glyph_cache = std::make_shared<platform::GlyphCache>(&m_gl_context, std::move(face), 16);
+	platform::ShaderProgram shader_program = m_gl_context.add_shader_program("", "").value();
+	platform::Renderer renderer(&m_gl_context);
+	platform::Canvas canvas = m_gl_context.add_canvas(64, 32);
+
+	renderer.set_render_canvas(canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 64.0f, 32.0f } }, platform::Color::white);
+	renderer.draw_text(font, "a\xC3\xA9" "a", { 4.0f, 20.0f }, platform::Color::black);
+	renderer.render(shader_program);
+
+	// atlas, cache page and atlas again
+	EXPECT_EQ(renderer.debug_data().num_raw_sections, 4);
+	const platform::RasterImage& pixels = m_gl_context.canvas_pixels(canvas);
+	const uint32_t white = platform::pack_color(platform::Color::white);
+	EXPECT_TRUE(std::any_of(pixels.pixels.begin(), pixels.pixels.end(), [&](uint32_t pixel) { return pixel != white; }));
+}
+
+TEST_F(GlyphCacheTests, DrawParallel_NonLatinTextInSeveralChunks_SameAsDrawingDirectly) {
+	auto make_font = [&]() {
+		platform::FontFace face = load_test_font_face();
+		platform::Font font = platform::create_font_from_atlas(&m_gl_context, platform::generate_font_atlas(face, 16));
+		font.glyph_cache = std::make_shared<platform::GlyphCache>(&m_gl_context, std::move(face), 16);
+		return font;
+	};
+	auto draw_nodes = [](auto* target, const platform::Font& font, size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			const glm::vec2 pos = { 2.0f + 16.0f * (float)(i % 4), 14.0f + 16.0f * (float)(i / 4) };
+			target->draw_text(font, "\xE6\x97\xA5", pos, platform::Color::black);
+		}
+	};
+	const platform::Font parallel_font = make_font();
+	const platform::Font direct_font = make_font();
+	platform::ShaderProgram shader_program = m_gl_context.add_shader_program("", "").value();
+	platform::Renderer renderer(&m_gl_context);
+	renderer.set_max_draw_threads(4);
+	platform::Canvas parallel_canvas = m_gl_context.add_canvas(64, 64);
+	platform::Canvas direct_canvas = m_gl_context.add_canvas(64, 64);
+
+	renderer.set_render_canvas(parallel_canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 64.0f, 64.0f } }, platform::Color::white);
+	renderer.draw_parallel(16, 4, [&](platform::DrawRecorder* recorder, size_t first, size_t last) {
+		draw_nodes(recorder, parallel_font, first, last);
+	});
+	renderer.render(shader_program);
+	renderer.set_render_canvas(direct_canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 64.0f, 64.0f } }, platform::Color::white);
+	draw_nodes(&renderer, direct_font, 0, 16);
+	renderer.render(shader_program);
+
+	// every chunk is drawn on a worker thread, where the glyph can't be added
+	EXPECT_GT(parallel_font.glyph_cache->stats().num_missed_off_thread, 0);
+	EXPECT_EQ(parallel_font.glyph_cache->stats().num_glyphs, 1);
+	const platform::RasterImage& parallel_pixels = m_gl_context.canvas_pixels(parallel_canvas);
+	const platform::RasterImage& direct_pixels = m_gl_context.canvas_pixels(direct_canvas);
+	const uint32_t white = platform::pack_color(platform::Color::white);
+	EXPECT_TRUE(std::any_of(direct_pixels.pixels.begin(), direct_pixels.pixels.end(), [&](uint32_t pixel) { return pixel != white; }));
+	EXPECT_EQ(parallel_pixels.pixels, direct_pixels.pixels);
+}
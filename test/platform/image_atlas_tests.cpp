@@ -0,0 +1,88 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/image_atlas.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+// Filled with one color, allocated like images read by stb_image
+static platform::Image make_image(int width, int height, uint8_t value) {
+	const size_t num_bytes = (size_t)width * height * 4;
+	unsigned char* data = (unsigned char*)malloc(num_bytes);
+	memset(data, value, num_bytes);
+	return platform::Image { .data = platform::ImageData(data), .width = width, .height = height, .num_channels = 4 };
+}
+
+static uint8_t atlas_value(const platform::ImageAtlas& atlas, int x, int y) {
+	return atlas.pixels[((size_t)y * atlas.size.x + x) * 4];
+}
+
+TEST(ImageAtlasTests, PackImageAtlases_SmallImages_SharesOneAtlas) {
+	platform::Image a = make_image(8, 8, 1);
+	platform::Image b = make_image(16, 4, 2);
+
+	platform::PackedImageAtlases packed = platform::pack_image_atlases({ &a, &b }, { .size = 64 });
+
+	ASSERT_EQ(packed.atlases.size(), 1);
+	ASSERT_TRUE(packed.regions[0].has_value());
+	ASSERT_TRUE(packed.regions[1].has_value());
+	EXPECT_EQ(packed.regions[0]->size, glm::ivec2(8, 8));
+	EXPECT_EQ(packed.regions[1]->size, glm::ivec2(16, 4));
+}
+
+TEST(ImageAtlasTests, PackImageAtlases_Image_CopiedWithExtrudedEdgesAndPadding) {
+	platform::Image image = make_image(4, 4, 7);
+
+	platform::PackedImageAtlases packed = platform::pack_image_atlases({ &image }, { .size = 16, .padding = 1, .extrusion = 2 });
+
+	ASSERT_TRUE(packed.regions[0].has_value());
+	const glm::ivec2 pos = packed.regions[0]->pos;
+	EXPECT_EQ(pos, glm::ivec2(2, 2));
+	for (int y = pos.y - 2; y < pos.y + 4 + 2; y++) {
+		for (int x = pos.x - 2; x < pos.x + 4 + 2; x++) {
+			EXPECT_EQ(atlas_value(packed.atlases[0], x, y), 7) << "x = " << x << ", y = " << y;
+		}
+	}
+	EXPECT_EQ(atlas_value(packed.atlases[0], pos.x + 4 + 2, pos.y), 0); // padding
+}
+
+TEST(ImageAtlasTests, PackImageAtlases_Image_UvsCoverItsRegion) {
+	platform::Image image = make_image(8, 4, 1);
+
+	platform::PackedImageAtlases packed = platform::pack_image_atlases({ &image }, { .size = 32, .padding = 0, .extrusion = 0 });
+
+	ASSERT_TRUE(packed.regions[0].has_value());
+	EXPECT_EQ(packed.regions[0]->uv.bottom_left, glm::vec2(0.0f, 0.0f));
+	EXPECT_EQ(packed.regions[0]->uv.top_right, glm::vec2(0.25f, 0.125f));
+}
+
+TEST(ImageAtlasTests, PackImageAtlases_ImageLargerThanMaxSize_NotPacked) {
+	platform::Image small = make_image(8, 8, 1);
+	platform::Image large = make_image(40, 8, 2);
+
+	platform::PackedImageAtlases packed = platform::pack_image_atlases({ &small, &large }, { .size = 64, .max_image_size = 32 });
+
+	EXPECT_TRUE(packed.regions[0].has_value());
+	EXPECT_FALSE(packed.regions[1].has_value());
+}
+
+TEST(ImageAtlasTests, PackImageAtlases_ImagesDontFitInOneAtlas_AddsAtlases) {
+	std::vector<platform::Image> images;
+	for (int i = 0; i < 5; i++) {
+		images.push_back(make_image(30, 30, (uint8_t)(i + 1)));
+	}
+	std::vector<const platform::Image*> image_ptrs;
+	for (const platform::Image& image : images) {
+		image_ptrs.push_back(&image);
+	}
+
+	platform::PackedImageAtlases packed = platform::pack_image_atlases(image_ptrs, { .size = 64, .padding = 1, .extrusion = 0 });
+
+	ASSERT_EQ(packed.atlases.size(), 2);
+	for (size_t i = 0; i < images.size(); i++) {
+		ASSERT_TRUE(packed.regions[i].has_value());
+		const platform::AtlasRegion& region = *packed.regions[i];
+		EXPECT_EQ(atlas_value(packed.atlases[region.atlas_index], region.pos.x, region.pos.y), i + 1);
+	}
+}
@@ -0,0 +1,24 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/quad.h>
+
+using namespace testing;
+
+TEST(QuadTests, GenerateQuadIndices_ZeroQuads_Empty) {
+	EXPECT_TRUE(platform::generate_quad_indices(0).empty());
+}
+
+TEST(QuadTests, GenerateQuadIndices_TwoQuads_TwoTrianglesPerQuad) {
+	std::vector<uint32_t> indices = platform::generate_quad_indices(2);
+
+	std::vector<uint32_t> expected = {
+		0, 1, 2, 1, 2, 3,
+		4, 5, 6, 5, 6, 7,
+	};
+	EXPECT_EQ(indices, expected);
+}
+
+TEST(QuadTests, NumQuadIndices_VerticesOfThreeQuads_EighteenIndices) {
+	EXPECT_EQ(platform::num_quad_indices(3 * platform::VERTICES_PER_QUAD), 18);
+}
@@ -0,0 +1,88 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/render_capture.h>
+
+using namespace testing;
+
+static platform::RenderCommandList make_command_list() {
+	platform::RenderCommandList command_list;
+	command_list.vertices = {
+		platform::Vertex { .pos = { 1.0f, 2.0f }, .color = platform::Color::red, .uv = { 0.5f, 0.25f } },
+		platform::Vertex { .pos = { 3.0f, 4.0f }, .color = platform::Color::blue, .uv = { 1.0f, 0.0f } },
+	};
+	command_list.commands = {
+		platform::cmd::render::SetProjection { glm::mat4(2.0f) },
+		platform::cmd::render::BindCanvas { platform::Canvas { .framebuffer = 1, .texture = { .id = 3, .size = { 64, 32 } } } },
+		platform::cmd::render::BindTexture { platform::Texture { .id = 2, .size = { 8, 8 } } },
+		platform::cmd::render::DrawArrays { .mode = GL_LINES, .first = 0, .count = 2 },
+		platform::cmd::render::UnbindCanvas {},
+	};
+	return command_list;
+}
+
+TEST(RenderCaptureTests, Deserialize_SerializedCommandList_RoundTrips) {
+	const platform::RenderCommandList command_list = make_command_list();
+
+	auto result = platform::deserialize_command_list(platform::serialize_command_list(command_list));
+
+	ASSERT_TRUE(result.has_value());
+	ASSERT_EQ(result->vertices.size(), 2);
+	EXPECT_EQ(result->vertices[1].pos, glm::vec2(3.0f, 4.0f));
+	EXPECT_EQ(result->vertices[1].color, platform::Color::blue);
+	ASSERT_EQ(result->commands.size(), 5);
+	EXPECT_EQ(std::get<platform::cmd::render::SetProjection>(result->commands[0]).projection, glm::mat4(2.0f));
+	EXPECT_EQ(std::get<platform::cmd::render::BindCanvas>(result->commands[1]).canvas.texture.size, glm::vec2(64, 32));
+	EXPECT_EQ(std::get<platform::cmd::render::DrawArrays>(result->commands[3]).count, 2);
+	EXPECT_EQ(result->commands[4].tag(), platform::RenderCommandType::UnbindCanvas);
+}
+
+TEST(RenderCaptureTests, Deserialize_TruncatedData_ReturnsError) {
+	std::vector<uint8_t> bytes = platform::serialize_command_list(make_command_list());
+	bytes.resize(bytes.size() - 1);
+
+	auto result = platform::deserialize_command_list(bytes);
+
+	EXPECT_EQ(result.error(), platform::RenderCaptureError::UnexpectedEndOfData);
+}
+
+TEST(RenderCaptureTests, Deserialize_NotACapture_ReturnsError) {
+	std::vector<uint8_t> bytes = { 'n', 'o', 'p', 'e', 0, 0, 0, 0 };
+
+	auto result = platform::deserialize_command_list(bytes);
+
+	EXPECT_EQ(result.error(), platform::RenderCaptureError::InvalidHeader);
+}
+
+TEST(RenderCaptureTests, Deserialize_QuadInstances_RoundTrips) {
+	platform::RenderCommandList command_list;
+	command_list.quad_instances = { platform::QuadInstance { .pos0 = { 1.0f, 2.0f }, .pos1 = { 3.0f, 4.0f }, .uv = { 0, 1, 2, 3 }, .color = 0xFF0000FF } };
+	command_list.commands = { platform::cmd::render::DrawQuadInstances { .first = 0, .count = 1, .uv_scale = 2.0f } };
+
+	auto result = platform::deserialize_command_list(platform::serialize_command_list(command_list));
+
+	ASSERT_TRUE(result.has_value());
+	ASSERT_EQ(result->quad_instances.size(), 1);
+	EXPECT_EQ(result->quad_instances[0].pos1, glm::vec2(3.0f, 4.0f));
+	EXPECT_EQ(result->quad_instances[0].color, 0xFF0000FF);
+	ASSERT_EQ(result->commands.size(), 1);
+	EXPECT_EQ(std::get<platform::cmd::render::DrawQuadInstances>(result->commands[0]).uv_scale, 2.0f);
+}
+
+TEST(RenderCaptureTests, Deserialize_ScissorCommands_RoundTrip) {
+	platform::RenderCommandList command_list;
+	command_list.commands = {
+		platform::cmd::render::SetScissor { platform::ScissorRect { .pos = { 1, 2 }, .size = { 30, 40 } } },
+		platform::cmd::render::DisableScissor {},
+	};
+
+	auto result = platform::deserialize_command_list(platform::serialize_command_list(command_list));
+
+	ASSERT_TRUE(result.has_value());
+	ASSERT_EQ(result->commands.size(), 2);
+	const platform::ScissorRect rect = std::get<platform::cmd::render::SetScissor>(result->commands[0]).rect;
+	EXPECT_EQ(rect.pos, glm::ivec2(1, 2));
+	EXPECT_EQ(rect.size, glm::ivec2(30, 40));
+	EXPECT_EQ(result->commands[1].tag(), platform::RenderCommandType::DisableScissor);
+}
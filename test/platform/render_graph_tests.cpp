@@ -0,0 +1,108 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <mock_gl_context.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/render_graph.h>
+#include <platform/graphics/renderer.h>
+
+using namespace testing;
+
+static platform::Canvas make_canvas(GLuint framebuffer) {
+	return platform::Canvas { .framebuffer = framebuffer, .texture = { .id = framebuffer + 10, .size = { 16, 16 } } };
+}
+
+static void draw_fill(platform::Renderer* renderer) {
+	renderer->draw_rect_fill({ { 0.0f, 0.0f }, { 16.0f, 16.0f } }, platform::Color::red);
+}
+
+class RenderGraphTests : public Test {
+protected:
+	NiceMock<MockOpenGLContext> m_gl_context;
+	platform::ShaderProgram m_shader_program = {};
+	platform::Renderer m_renderer { &m_gl_context };
+	platform::RenderGraph m_render_graph;
+};
+
+TEST_F(RenderGraphTests, Execute_PassesAddedBeforeTheirInputs_DrawnInDependencyOrderWithOneBindEach) {
+	const platform::Canvas a = make_canvas(1);
+	const platform::Canvas b = make_canvas(2);
+	const platform::Canvas c = make_canvas(3);
+	m_render_graph.add_pass({ .name = "c", .target = c, .inputs = { b }, .draw = draw_fill });
+	m_render_graph.add_pass({ .name = "b", .target = b, .inputs = { a }, .draw = draw_fill });
+	m_render_graph.add_pass({ .name = "a", .target = a, .draw = draw_fill });
+
+	ASSERT_TRUE(m_render_graph.execute(&m_renderer).has_value());
+
+	InSequence sequence;
+	EXPECT_CALL(m_gl_context, bind_canvas(Field(&platform::Canvas::framebuffer, 1))).Times(1);
+	EXPECT_CALL(m_gl_context, bind_canvas(Field(&platform::Canvas::framebuffer, 2))).Times(1);
+	EXPECT_CALL(m_gl_context, bind_canvas(Field(&platform::Canvas::framebuffer, 3))).Times(1);
+	m_renderer.render(m_shader_program);
+}
+
+TEST_F(RenderGraphTests, Execute_SameVersionNextFrame_PassSkipped) {
+	int num_draws = 0;
+	auto add_pass = [&]() {
+		m_render_graph.add_pass({ .name = "a", .target = make_canvas(1), .version = 7, .draw = [&](platform::Renderer*) { num_draws++; } });
+	};
+
+	add_pass();
+	ASSERT_TRUE(m_render_graph.execute(&m_renderer).has_value());
+	m_renderer.render(m_shader_program);
+	add_pass();
+	ASSERT_TRUE(m_render_graph.execute(&m_renderer).has_value());
+	m_renderer.render(m_shader_program);
+
+	EXPECT_EQ(num_draws, 1);
+	const platform::RenderDebugData debug_data = m_renderer.debug_data();
+	ASSERT_EQ(debug_data.passes.size(), 1);
+	EXPECT_EQ(debug_data.passes[0].name, "a");
+	EXPECT_TRUE(debug_data.passes[0].skipped);
+	EXPECT_EQ(debug_data.passes[0].num_skipped_frames, 1);
+}
+
+TEST_F(RenderGraphTests, Execute_SkippedAfterBeingRedrawn_CountsSkippedFramesSinceRedraw) {
+	for (uint64_t version : { 1, 1, 1, 2, 2 }) {
+		m_render_graph.add_pass({ .name = "a", .target = make_canvas(1), .version = version, .draw = draw_fill });
+		ASSERT_TRUE(m_render_graph.execute(&m_renderer).has_value());
+		m_renderer.render(m_shader_program);
+	}
+
+	const platform::RenderDebugData debug_data = m_renderer.debug_data();
+	ASSERT_EQ(debug_data.passes.size(), 1);
+	EXPECT_TRUE(debug_data.passes[0].skipped);
+	EXPECT_EQ(debug_data.passes[0].num_skipped_frames, 1);
+}
+
+TEST_F(RenderGraphTests, Execute_VersionChanged_PassDrawnAgain) {
+	int num_draws = 0;
+	for (uint64_t version : { 1, 2 }) {
+		m_render_graph.add_pass({ .name = "a", .target = make_canvas(1), .version = version, .draw = [&](platform::Renderer*) { num_draws++; } });
+		ASSERT_TRUE(m_render_graph.execute(&m_renderer).has_value());
+	}
+
+	EXPECT_EQ(num_draws, 2);
+}
+
+TEST_F(RenderGraphTests, Execute_InputDrawnThisFrame_PassDrawnDespiteSameVersion) {
+	int num_draws = 0;
+	for (int frame = 0; frame < 2; frame++) {
+		m_render_graph.add_pass({ .name = "a", .target = make_canvas(1), .draw = draw_fill });
+		m_render_graph.add_pass({ .name = "b", .target = make_canvas(2), .inputs = { make_canvas(1) }, .version = 1, .draw = [&](platform::Renderer*) { num_draws++; } });
+		ASSERT_TRUE(m_render_graph.execute(&m_renderer).has_value());
+	}
+
+	EXPECT_EQ(num_draws, 2);
+}
+
+TEST_F(RenderGraphTests, Execute_PassesDependOnEachOther_ReturnsDependencyCycle) {
+	m_render_graph.add_pass({ .name = "a", .target = make_canvas(1), .inputs = { make_canvas(2) }, .draw = draw_fill });
+	m_render_graph.add_pass({ .name = "b", .target = make_canvas(2), .inputs = { make_canvas(1) }, .draw = draw_fill });
+
+	auto result = m_render_graph.execute(&m_renderer);
+
+	ASSERT_FALSE(result.has_value());
+	EXPECT_EQ(result.error(), platform::RenderGraphError::DependencyCycle);
+}
@@ -0,0 +1,92 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/render_stats.h>
+
+#include <nlohmann/json.hpp>
+
+static platform::RenderDebugData make_frame(uint64_t render_ns) {
+	return platform::RenderDebugData { .num_draw_calls = 2, .render_ns = render_ns };
+}
+
+TEST(RenderStatsTests, Summarize_HundredFrames_NearestRankPercentiles) {
+	platform::RenderStatsHistory history(100);
+	for (uint64_t i = 1; i <= 100; i++) {
+		history.add_frame(make_frame(i));
+	}
+
+	platform::RenderStatSummary summary = history.summarize(platform::RenderStat::RenderNs);
+
+	EXPECT_EQ(summary.p50, 50.0);
+	EXPECT_EQ(summary.p95, 95.0);
+	EXPECT_EQ(summary.p99, 99.0);
+	EXPECT_EQ(summary.worst, 100.0);
+}
+
+TEST(RenderStatsTests, AddFrame_MoreThanMaxFrames_OldestFramesDropped) {
+	platform::RenderStatsHistory history(3);
+	for (uint64_t render_ns : { 1000, 1, 2, 3 }) {
+		history.add_frame(make_frame(render_ns));
+	}
+
+	ASSERT_EQ(history.num_frames(), 3);
+	EXPECT_EQ(history.frame(0).render_ns, 1);
+	EXPECT_EQ(history.frame(0).frame, 1);
+	EXPECT_EQ(history.frame(2).render_ns, 3);
+	EXPECT_EQ(history.summarize(platform::RenderStat::RenderNs).worst, 3.0);
+}
+
+TEST(RenderStatsTests, SummarizePass_SkippedInSomeFrames_OnlyDrawnFramesCounted) {
+	platform::RenderStatsHistory history;
+	platform::RenderDebugData drawn = make_frame(10);
+	drawn.passes = { { .name = "scene", .record_ns = 40 } };
+	platform::RenderDebugData skipped = make_frame(10);
+	skipped.passes = { { .name = "scene", .skipped = true, .num_skipped_frames = 1 } };
+	history.add_frame(drawn);
+	history.add_frame(skipped);
+	history.add_frame(skipped);
+
+	platform::RenderStatSummary summary = history.summarize_pass("scene");
+
+	EXPECT_EQ(summary.p50, 40.0);
+	EXPECT_EQ(summary.worst, 40.0);
+	EXPECT_EQ(history.summarize(platform::RenderStat::RecordNs).worst, 40.0);
+}
+
+TEST(RenderStatsTests, Summarize_NoFrames_ReturnsZeros) {
+	platform::RenderStatsHistory history;
+
+	platform::RenderStatSummary summary = history.summarize(platform::RenderStat::DrawCalls);
+
+	EXPECT_EQ(summary.p50, 0.0);
+	EXPECT_EQ(summary.worst, 0.0);
+}
+
+TEST(RenderStatsTests, ToCsv_TwoFrames_HeaderAndRowPerFrame) {
+	platform::RenderStatsHistory history;
+	platform::RenderDebugData frame = make_frame(7);
+	frame.passes = { { .name = "a", .record_ns = 3 } };
+	history.add_frame(frame);
+	frame.passes[0] = { .name = "a", .skipped = true };
+	history.add_frame(frame);
+
+	const std::string csv = history.to_csv();
+
+	EXPECT_EQ(csv,
+		"frame,render_ns,record_ns,upload_bytes,draw_calls,texture_binds,canvas_binds,program_binds,merged_sections,\"pass a record_ns\"\n"
+		"0,7,3,0,2,0,0,0,0,3\n"
+		"1,7,0,0,2,0,0,0,0,\n");
+}
+
+TEST(RenderStatsTests, ToJson_Frames_HasSummaryAndFrames) {
+	platform::RenderStatsHistory history;
+	history.add_frame(make_frame(5));
+	history.add_frame(make_frame(9));
+
+	const nlohmann::json json = nlohmann::json::parse(history.to_json());
+
+	EXPECT_EQ(json["num_frames"], 2);
+	EXPECT_EQ(json["summary"]["render_ns"]["worst"], 9.0);
+	ASSERT_EQ(json["frames"].size(), 2);
+	EXPECT_EQ(json["frames"][1]["render_ns"], 9);
+}
@@ -0,0 +1,715 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <mock_gl_context.h>
+#include <test_font.h>
+
+#include <platform/graphics/quad.h>
+#include <platform/graphics/render_capture.h>
+#include <platform/graphics/renderer.h>
+
+#include <thread>
+
+using namespace testing;
+
+constexpr platform::Texture WHITE_TEXTURE = platform::Texture { .id = 1, .size = { 1, 1 } };
+constexpr platform::Texture ATLAS_TEXTURE = platform::Texture { .id = 2, .size = { 128, 128 } };
+constexpr GLuint QUAD_INDEX_BUFFER_ID = 5;
+
+class RendererTests : public Test {
+protected:
+	void SetUp() override {
+		ON_CALL(m_gl_context, add_texture).WillByDefault(Return(WHITE_TEXTURE));
+		ON_CALL(m_gl_context, add_index_buffer).WillByDefault([](const std::vector<uint32_t>& indices) {
+			return platform::IndexBuffer { .id = QUAD_INDEX_BUFFER_ID, .num_indices = indices.size() };
+		});
+	}
+
+	NiceMock<MockOpenGLContext> m_gl_context;
+	platform::ShaderProgram m_shader_program = {};
+};
+
+TEST_F(RendererTests, DrawText_ThousandGlyphs_RenderedWithSingleDrawCall) {
+	platform::Renderer renderer(&m_gl_context);
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+
+	renderer.draw_text(font, std::string(1000, 'a'), { 0.0f, 0.0f }, platform::Color::white);
+
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 6000, 0)).Times(1);
+	EXPECT_CALL(m_gl_context, draw_arrays).Times(0);
+	renderer.render(m_shader_program);
+
+	platform::RenderDebugData debug_data = renderer.debug_data();
+	EXPECT_EQ(debug_data.num_draw_calls, 1);
+	EXPECT_EQ(debug_data.num_sections, 1);
+	EXPECT_EQ(debug_data.num_raw_sections, 1); // the text is laid out as one run
+	EXPECT_EQ(debug_data.num_vertices, 4000);
+}
+
+TEST_F(RendererTests, DrawText_SameAsDrawingEachCharacter) {
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+	platform::Renderer text_renderer(&m_gl_context);
+	platform::Renderer character_renderer(&m_gl_context);
+	std::vector<platform::Vertex> text_vertices;
+	std::vector<platform::Vertex> character_vertices;
+
+	text_renderer.draw_text(font, "a b", { 10.0f, 20.0f }, platform::Color::red);
+	character_renderer.draw_character(font, 'a', { 10.0f, 8.0f }, platform::Color::red);
+	character_renderer.draw_character(font, 'b', { 28.0f, 8.0f }, platform::Color::red);
+
+	EXPECT_CALL(m_gl_context, upload_vertices).WillOnce(SaveArg<1>(&text_vertices)).WillOnce(SaveArg<1>(&character_vertices));
+	text_renderer.render(m_shader_program);
+	character_renderer.render(m_shader_program);
+
+	ASSERT_EQ(text_vertices.size(), character_vertices.size());
+	for (size_t i = 0; i < text_vertices.size(); i++) {
+		EXPECT_EQ(text_vertices[i].pos, character_vertices[i].pos);
+		EXPECT_EQ(text_vertices[i].uv, character_vertices[i].uv);
+		EXPECT_EQ(text_vertices[i].color, character_vertices[i].color);
+	}
+}
+
+TEST_F(RendererTests, DrawText_SameTextNextFrame_TextRunHit) {
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+	platform::Renderer renderer(&m_gl_context);
+
+	for (int frame = 0; frame < 2; frame++) {
+		renderer.draw_text(font, "Hello", { 0.0f, (float)frame }, platform::Color::white);
+		renderer.render(m_shader_program);
+	}
+
+	EXPECT_EQ(renderer.debug_data().text_runs.num_hits, 1);
+	EXPECT_EQ(renderer.debug_data().text_runs.num_misses, 0);
+}
+
+TEST_F(RendererTests, DrawRectFill_InterleavedWithText_NotMerged) {
+	platform::Renderer renderer(&m_gl_context);
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.draw_text(font, "ab", { 0.0f, 0.0f }, platform::Color::white);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+
+	InSequence sequence;
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 6, 0));
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 12, 4));
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 6, 12));
+	renderer.render(m_shader_program);
+
+	EXPECT_EQ(renderer.debug_data().num_sections, 3);
+	EXPECT_EQ(renderer.debug_data().num_raw_sections, 3);
+}
+
+TEST_F(RendererTests, DrawRect_LineLoops_NotMerged) {
+	platform::Renderer renderer(&m_gl_context);
+
+	renderer.draw_rect({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.draw_rect({ { 20.0f, 20.0f }, { 30.0f, 30.0f } }, platform::Color::red);
+
+	EXPECT_CALL(m_gl_context, draw_arrays(GL_LINE_LOOP, _, 4)).Times(2);
+	renderer.render(m_shader_program);
+}
+
+TEST_F(RendererTests, DrawRectFill_DifferentCanvases_NotMerged) {
+	platform::Renderer renderer(&m_gl_context);
+	const platform::Canvas canvas_a = { .framebuffer = 1, .texture = { .id = 3, .size = { 64, 64 } } };
+	const platform::Canvas canvas_b = { .framebuffer = 2, .texture = { .id = 4, .size = { 64, 64 } } };
+
+	renderer.push_draw_canvas(canvas_a);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.pop_draw_canvas();
+	renderer.push_draw_canvas(canvas_b);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.pop_draw_canvas();
+
+	EXPECT_CALL(m_gl_context, bind_canvas(_)).Times(2);
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 6, _)).Times(2);
+	renderer.render(m_shader_program);
+}
+
+TEST_F(RendererTests, Render_TextBetweenFills_CountsStateChanges) {
+	platform::Renderer renderer(&m_gl_context);
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+	const platform::Canvas canvas = { .framebuffer = 1, .texture = { .id = 3, .size = { 64, 64 } } };
+
+	renderer.push_draw_canvas(canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.draw_text(font, "a", { 0.0f, 0.0f }, platform::Color::white);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.pop_draw_canvas();
+	renderer.render(m_shader_program);
+
+	platform::RenderDebugData debug_data = renderer.debug_data();
+	EXPECT_EQ(debug_data.num_texture_binds, 3);
+	EXPECT_EQ(debug_data.num_canvas_binds, 1);
+	EXPECT_EQ(debug_data.num_program_binds, 1);
+}
+
+TEST_F(RendererTests, SortedDrawOrder_InterleavedLayers_GroupedByLayer) {
+	platform::Renderer renderer(&m_gl_context);
+	renderer.set_draw_order(platform::DrawOrder::Sorted);
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+
+	for (int i = 0; i < 100; i++) {
+		renderer.push_draw_layer(1);
+		renderer.draw_text(font, "abc", { 0.0f, 0.0f }, platform::Color::white);
+		renderer.pop_draw_layer();
+		renderer.push_draw_layer(2);
+		renderer.draw_line({ 0.0f, 0.0f }, { 10.0f, 10.0f }, platform::Color::red);
+		renderer.pop_draw_layer();
+	}
+
+	InSequence sequence;
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 100 * 3 * 6, 0));
+	EXPECT_CALL(m_gl_context, draw_arrays(GL_LINES, 100 * 3 * 4, 100 * 2));
+	renderer.render(m_shader_program);
+
+	EXPECT_EQ(renderer.debug_data().num_draw_calls, 2);
+}
+
+TEST_F(RendererTests, SortedDrawOrder_SameLayer_KeepsSubmissionOrderPerTexture) {
+	platform::Renderer renderer(&m_gl_context);
+	renderer.set_draw_order(platform::DrawOrder::Sorted);
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.draw_text(font, "a", { 0.0f, 0.0f }, platform::Color::white);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::blue);
+
+	std::vector<platform::Vertex> uploaded_vertices;
+	EXPECT_CALL(m_gl_context, upload_vertices).WillOnce(SaveArg<1>(&uploaded_vertices));
+	renderer.render(m_shader_program);
+
+	// both rects share the white texture and are drawn together, in order
+	ASSERT_EQ(uploaded_vertices.size(), 12);
+	EXPECT_EQ(uploaded_vertices[0].color, platform::Color::red);
+	EXPECT_EQ(uploaded_vertices[4].color, platform::Color::blue);
+	EXPECT_EQ(renderer.debug_data().num_draw_calls, 2);
+}
+
+TEST_F(RendererTests, SortedDrawOrder_NestedCanvas_DrawnBeforeOuterCanvas) {
+	platform::Renderer renderer(&m_gl_context);
+	renderer.set_draw_order(platform::DrawOrder::Sorted);
+	const platform::Canvas outer_canvas = { .framebuffer = 1, .texture = { .id = 3, .size = { 64, 64 } } };
+	const platform::Canvas inner_canvas = { .framebuffer = 2, .texture = { .id = 4, .size = { 64, 64 } } };
+
+	renderer.push_draw_canvas(outer_canvas);
+	{
+		renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+		renderer.push_draw_canvas(inner_canvas);
+		renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::blue);
+		renderer.pop_draw_canvas();
+		renderer.draw_texture(inner_canvas.texture, { { 0.0f, 0.0f }, { 10.0f, 10.0f } });
+	}
+	renderer.pop_draw_canvas();
+
+	InSequence sequence;
+	EXPECT_CALL(m_gl_context, bind_canvas(Field(&platform::Canvas::framebuffer, inner_canvas.framebuffer)));
+	EXPECT_CALL(m_gl_context, bind_canvas(Field(&platform::Canvas::framebuffer, outer_canvas.framebuffer)));
+	renderer.render(m_shader_program);
+}
+
+TEST_F(RendererTests, Render_AfterDrawCalls_VerticesFenced) {
+	platform::Renderer renderer(&m_gl_context);
+
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+
+	InSequence sequence;
+	EXPECT_CALL(m_gl_context, upload_vertices);
+	EXPECT_CALL(m_gl_context, draw_elements);
+	EXPECT_CALL(m_gl_context, fence_vertices);
+	renderer.render(m_shader_program);
+}
+
+TEST_F(RendererTests, DrawRectFill_MoreQuadsThanIndexBuffer_IndexBufferGrown) {
+	platform::Renderer renderer(&m_gl_context);
+
+	for (int i = 0; i < 3000; i++) {
+		renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	}
+
+	EXPECT_CALL(m_gl_context, free_index_buffer(Field(&platform::IndexBuffer::num_indices, 1024 * 6)));
+	EXPECT_CALL(m_gl_context, add_index_buffer(SizeIs(4096 * 6)));
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, Field(&platform::IndexBuffer::num_indices, 4096 * 6), 3000 * 6, 0));
+	renderer.render(m_shader_program);
+}
+
+TEST_F(RendererTests, DrawTexture_QuadVertices_MatchQuadIndexOrder) {
+	platform::Renderer renderer(&m_gl_context);
+
+	renderer.draw_texture(ATLAS_TEXTURE, { { 0.0f, 0.0f }, { 10.0f, 20.0f } });
+
+	std::vector<platform::Vertex> uploaded_vertices;
+	EXPECT_CALL(m_gl_context, upload_vertices).WillOnce(SaveArg<1>(&uploaded_vertices));
+	renderer.render(m_shader_program);
+
+	ASSERT_EQ(uploaded_vertices.size(), platform::VERTICES_PER_QUAD);
+	EXPECT_EQ(uploaded_vertices[0].pos, glm::vec2(0.0f, 0.0f));
+	EXPECT_EQ(uploaded_vertices[1].pos, glm::vec2(0.0f, 20.0f));
+	EXPECT_EQ(uploaded_vertices[2].pos, glm::vec2(10.0f, 0.0f));
+	EXPECT_EQ(uploaded_vertices[3].pos, glm::vec2(10.0f, 20.0f));
+	EXPECT_EQ(uploaded_vertices[0].uv, glm::vec2(0.0f, 1.0f));
+	EXPECT_EQ(uploaded_vertices[3].uv, glm::vec2(1.0f, 0.0f));
+}
+
+TEST_F(RendererTests, PackedVertexFormat_Text_UploadsHalfTheBytes) {
+	platform::Renderer renderer(&m_gl_context, platform::VertexFormat::Packed);
+	m_shader_program.vertex_format = platform::VertexFormat::Packed;
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+
+	renderer.draw_text(font, std::string(100, 'a'), { 0.0f, 0.0f }, platform::Color::white);
+
+	std::vector<platform::PackedVertex> uploaded_vertices;
+	EXPECT_CALL(m_gl_context, upload_vertices).Times(0);
+	EXPECT_CALL(m_gl_context, upload_packed_vertices).WillOnce(SaveArg<1>(&uploaded_vertices));
+	renderer.render(m_shader_program);
+
+	EXPECT_EQ(uploaded_vertices.size(), 400);
+	EXPECT_EQ(uploaded_vertices[0].color, 0xFFFFFFFF);
+	EXPECT_EQ(renderer.debug_data().num_vertex_bytes, 400 * 16);
+}
+
+TEST_F(RendererTests, PackedVertexFormat_RepeatingUv_UvScaleSetForSection) {
+	platform::Renderer renderer(&m_gl_context, platform::VertexFormat::Packed);
+	m_shader_program.vertex_format = platform::VertexFormat::Packed;
+
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.draw_texture_clipped(ATLAS_TEXTURE, { { 0.0f, 0.0f }, { 10.0f, 10.0f } }, { { 0.0f, 0.0f }, { 3.0f, 2.0f } });
+
+	std::vector<platform::PackedVertex> uploaded_vertices;
+	EXPECT_CALL(m_gl_context, upload_packed_vertices).WillOnce(SaveArg<1>(&uploaded_vertices));
+	InSequence sequence;
+	EXPECT_CALL(m_gl_context, set_uv_scale(_, 1.0f));
+	EXPECT_CALL(m_gl_context, set_uv_scale(_, 4.0f));
+	renderer.render(m_shader_program);
+
+	// top right corner of texture, uv (3, 2) stored as (3 / 4, 2 / 4)
+	ASSERT_EQ(uploaded_vertices.size(), 8);
+	EXPECT_EQ(uploaded_vertices[6].uv[0], 0xBFFF);
+	EXPECT_EQ(uploaded_vertices[6].uv[1], 0x8000);
+}
+
+TEST_F(RendererTests, StaticBatch_DrawnTwoFrames_VerticesUploadedOnce) {
+	platform::Renderer renderer(&m_gl_context);
+	platform::DrawRecorder recorder = renderer.make_static_batch_recorder();
+	recorder.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+
+	const platform::VertexBuffer vertex_buffer = { .id = 7, .num_vertices = 4, .vertex_format = platform::VertexFormat::Standard };
+	EXPECT_CALL(m_gl_context, add_vertex_buffer(SizeIs(4))).WillOnce(Return(vertex_buffer));
+	const platform::StaticBatch batch = renderer.add_static_batch(recorder);
+
+	EXPECT_CALL(m_gl_context, bind_vertex_buffer(_, Field(&platform::VertexBuffer::id, 7))).Times(2);
+	for (int frame = 0; frame < 2; frame++) {
+		renderer.draw_static_batch(batch);
+		renderer.render(m_shader_program);
+	}
+
+	EXPECT_EQ(renderer.debug_data().num_static_vertices, 4);
+	EXPECT_EQ(renderer.debug_data().num_vertices, 0);
+}
+
+TEST_F(RendererTests, StaticBatch_BetweenDynamicDraws_StreamedVerticesBoundAgain) {
+	platform::Renderer renderer(&m_gl_context);
+	platform::DrawRecorder recorder = renderer.make_static_batch_recorder();
+	recorder.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	ON_CALL(m_gl_context, add_vertex_buffer).WillByDefault(Return(platform::VertexBuffer { .id = 7, .num_vertices = 4 }));
+	const platform::StaticBatch batch = renderer.add_static_batch(recorder);
+
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.draw_static_batch(batch);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+
+	InSequence sequence;
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 6, 0));
+	EXPECT_CALL(m_gl_context, bind_vertex_buffer);
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 6, 0));
+	EXPECT_CALL(m_gl_context, bind_streamed_vertices);
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 6, 4));
+	renderer.render(m_shader_program);
+}
+
+TEST_F(RendererTests, Shutdown_WithStaticBatch_FreesBuffersAndWhiteTexture) {
+	platform::Renderer renderer(&m_gl_context);
+	platform::DrawRecorder recorder = renderer.make_static_batch_recorder();
+	recorder.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	ON_CALL(m_gl_context, add_vertex_buffer).WillByDefault(Return(platform::VertexBuffer { .id = 7, .num_vertices = 4 }));
+	renderer.add_static_batch(recorder);
+
+	EXPECT_CALL(m_gl_context, free_vertex_buffer(Field(&platform::VertexBuffer::id, 7)));
+	EXPECT_CALL(m_gl_context, free_index_buffer(Field(&platform::IndexBuffer::id, QUAD_INDEX_BUFFER_ID)));
+	EXPECT_CALL(m_gl_context, free_texture(Field(&platform::Texture::id, WHITE_TEXTURE.id)));
+	renderer.shutdown(&m_gl_context);
+}
+
+TEST_F(RendererTests, Shutdown_StaticBatchFreedBefore_NotFreedAgain) {
+	platform::Renderer renderer(&m_gl_context);
+	platform::DrawRecorder recorder = renderer.make_static_batch_recorder();
+	recorder.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	ON_CALL(m_gl_context, add_vertex_buffer).WillByDefault(Return(platform::VertexBuffer { .id = 7, .num_vertices = 4 }));
+	const platform::StaticBatch batch = renderer.add_static_batch(recorder);
+
+	EXPECT_CALL(m_gl_context, free_vertex_buffer).Times(1);
+	renderer.free_static_batch(batch);
+	renderer.shutdown(&m_gl_context);
+}
+
+class MockRenderExecutor : public platform::IRenderExecutor {
+public:
+	MOCK_METHOD(void, execute, (const platform::ShaderProgram& shader_program, const platform::RenderCommandList& command_list), (override));
+};
+
+static std::vector<platform::RenderCommandType> command_types(const platform::RenderCommandList& command_list) {
+	std::vector<platform::RenderCommandType> types;
+	for (const platform::RenderCommand& command : command_list.commands) {
+		types.push_back(command.tag());
+	}
+	return types;
+}
+
+TEST_F(RendererTests, SetExecutor_CanvasAndProjection_RecordedAsCommands) {
+	using platform::RenderCommandType;
+	platform::Renderer renderer(&m_gl_context);
+	MockRenderExecutor executor;
+	renderer.set_executor(&executor);
+	const platform::Canvas canvas = { .framebuffer = 1, .texture = { .id = 3, .size = { 64, 64 } } };
+
+	renderer.set_projection(glm::mat4(1.0f));
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.push_draw_canvas(canvas);
+	renderer.draw_line({ 0.0f, 0.0f }, { 10.0f, 10.0f }, platform::Color::red);
+	renderer.pop_draw_canvas();
+
+	platform::RenderCommandList command_list;
+	EXPECT_CALL(executor, execute).WillOnce(SaveArg<1>(&command_list));
+	EXPECT_CALL(m_gl_context, draw_elements).Times(0);
+	renderer.render(m_shader_program);
+
+	EXPECT_THAT(command_types(command_list), ElementsAre(
+		RenderCommandType::SetProjection,
+		RenderCommandType::BindTexture,
+		RenderCommandType::DrawQuads,
+		RenderCommandType::BindCanvas,
+		RenderCommandType::SetProjection,
+		RenderCommandType::DrawArrays
+	));
+	EXPECT_EQ(command_list.vertices.size(), 6);
+	EXPECT_EQ(std::get<platform::cmd::render::DrawArrays>(command_list.commands[5]).first, 4);
+}
+
+TEST_F(RendererTests, SetExecutor_Null_DefaultExecutorUsed) {
+	platform::Renderer renderer(&m_gl_context);
+	MockRenderExecutor executor;
+	renderer.set_executor(&executor);
+	renderer.set_executor(nullptr);
+
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+
+	EXPECT_CALL(executor, execute).Times(0);
+	EXPECT_CALL(m_gl_context, draw_elements);
+	renderer.render(m_shader_program);
+}
+
+TEST_F(RendererTests, NullRenderExecutor_Render_AllCommandsVisited) {
+	platform::Renderer renderer(&m_gl_context);
+	platform::NullRenderExecutor executor;
+	renderer.set_executor(&executor);
+
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.draw_line({ 0.0f, 0.0f }, { 10.0f, 10.0f }, platform::Color::red);
+
+	EXPECT_CALL(m_gl_context, upload_vertices).Times(0);
+	renderer.render(m_shader_program);
+
+	// bind texture, draw quads, draw arrays
+	EXPECT_EQ(executor.num_executed_commands(), 3);
+}
+
+// Draws to either a Renderer or a DrawRecorder
+template <typename Target>
+static void draw_mixed_nodes(Target* target, const platform::Font& font, int first, int last) {
+	for (int i = first; i < last; i++) {
+		const glm::vec2 pos = { (float)(i % 10) * 40.0f, (float)(i / 10) * 20.0f };
+		target->draw_text(font, "node " + std::to_string(i), pos, platform::Color::white);
+		if (i % 3 == 0) {
+			target->draw_rect_fill({ pos, pos + glm::vec2 { 8.0f, 8.0f } }, platform::Color::red);
+		}
+		if (i % 7 == 0) {
+			target->push_draw_layer(2);
+			target->draw_line(pos, pos + glm::vec2 { 8.0f, 0.0f }, platform::Color::green);
+			target->pop_draw_layer();
+		}
+	}
+}
+
+TEST_F(RendererTests, Submit_RecordersFilledOnThreads_SameCommandsAsDrawingDirectly) {
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+	const int num_nodes = 100;
+	const int num_recorders = 4;
+	MockRenderExecutor executor;
+	std::vector<uint8_t> direct_bytes;
+	std::vector<uint8_t> recorded_bytes;
+	EXPECT_CALL(executor, execute)
+		.WillOnce([&](const platform::ShaderProgram&, const platform::RenderCommandList& command_list) { direct_bytes = platform::serialize_command_list(command_list); })
+		.WillOnce([&](const platform::ShaderProgram&, const platform::RenderCommandList& command_list) { recorded_bytes = platform::serialize_command_list(command_list); });
+
+	/* Draw directly */
+	{
+		platform::Renderer renderer(&m_gl_context);
+		renderer.set_executor(&executor);
+		draw_mixed_nodes(&renderer, font, 0, num_nodes);
+		renderer.render(m_shader_program);
+	}
+
+	/* Draw with recorders on separate threads */
+	{
+		platform::Renderer renderer(&m_gl_context);
+		renderer.set_executor(&executor);
+		std::vector<platform::DrawRecorder> recorders(num_recorders, renderer.make_recorder());
+		std::vector<std::thread> threads;
+		for (int i = 0; i < num_recorders; i++) {
+			threads.emplace_back([&, i]() {
+				draw_mixed_nodes(&recorders[i], font, i * num_nodes / num_recorders, (i + 1) * num_nodes / num_recorders);
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		for (platform::DrawRecorder& recorder : recorders) {
+			renderer.submit(&recorder);
+		}
+		renderer.render(m_shader_program);
+	}
+
+	EXPECT_FALSE(direct_bytes.empty());
+	EXPECT_EQ(recorded_bytes, direct_bytes);
+}
+
+TEST_F(RendererTests, Submit_AdjacentTextInRecorders_MergedIntoOneDrawCall) {
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+	platform::Renderer renderer(&m_gl_context);
+	platform::DrawRecorder first = renderer.make_recorder();
+	platform::DrawRecorder second = renderer.make_recorder();
+
+	renderer.draw_text(font, "abc", { 0.0f, 0.0f }, platform::Color::white);
+	first.draw_text(font, "def", { 0.0f, 20.0f }, platform::Color::white);
+	second.draw_text(font, "ghi", { 0.0f, 40.0f }, platform::Color::white);
+	renderer.submit(&first);
+	renderer.submit(&second);
+
+	EXPECT_CALL(m_gl_context, draw_elements).Times(1);
+	renderer.render(m_shader_program);
+
+	EXPECT_EQ(renderer.debug_data().num_raw_sections, 3);
+	EXPECT_EQ(first.num_vertices(), 0);
+}
+
+TEST_F(RendererTests, MakeRecorder_InsidePushedCanvas_DrawsToCanvas) {
+	platform::Renderer renderer(&m_gl_context);
+	const platform::Canvas canvas = { .framebuffer = 1, .texture = { .id = 3, .size = { 64, 64 } } };
+
+	renderer.push_draw_canvas(canvas);
+	platform::DrawRecorder recorder = renderer.make_recorder();
+	renderer.pop_draw_canvas();
+	recorder.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.submit(&recorder);
+
+	EXPECT_CALL(m_gl_context, bind_canvas(Field(&platform::Canvas::framebuffer, 1)));
+	renderer.render(m_shader_program);
+}
+
+TEST_F(RendererTests, DrawParallel_ManyItems_SameCommandsAsDrawingDirectly) {
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+	const int num_nodes = 100;
+	MockRenderExecutor executor;
+	std::vector<uint8_t> direct_bytes;
+	std::vector<uint8_t> parallel_bytes;
+	EXPECT_CALL(executor, execute)
+		.WillOnce([&](const platform::ShaderProgram&, const platform::RenderCommandList& command_list) { direct_bytes = platform::serialize_command_list(command_list); })
+		.WillOnce([&](const platform::ShaderProgram&, const platform::RenderCommandList& command_list) { parallel_bytes = platform::serialize_command_list(command_list); });
+
+	platform::Renderer renderer(&m_gl_context);
+	renderer.set_executor(&executor);
+	renderer.set_max_draw_threads(4);
+	draw_mixed_nodes(&renderer, font, 0, num_nodes);
+	renderer.render(m_shader_program);
+	renderer.draw_parallel(num_nodes, 10, [&](platform::DrawRecorder* recorder, size_t first, size_t last) {
+		draw_mixed_nodes(recorder, font, (int)first, (int)last);
+	});
+	renderer.render(m_shader_program);
+
+	EXPECT_FALSE(direct_bytes.empty());
+	EXPECT_EQ(parallel_bytes, direct_bytes);
+}
+
+TEST_F(RendererTests, Render_InstancedQuadMode_GlyphsDrawnAsOneInstanceEach) {
+	platform::Renderer renderer(&m_gl_context, platform::VertexFormat::Standard, platform::QuadMode::Instanced);
+	const platform::ShaderProgram shader_program = { .quad_instances = platform::QuadInstanceProgram {} };
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+
+	renderer.draw_text(font, "abcd", { 0.0f, 0.0f }, platform::Color::white);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+
+	EXPECT_CALL(m_gl_context, upload_quad_instances(_, SizeIs(4))).Times(1);
+	EXPECT_CALL(m_gl_context, upload_vertices(_, SizeIs(4))).Times(1);
+	EXPECT_CALL(m_gl_context, draw_quad_instances(_, 0, 4, 1.0f)).Times(1);
+	EXPECT_CALL(m_gl_context, draw_elements).Times(1);
+	renderer.render(shader_program);
+
+	platform::RenderDebugData debug_data = renderer.debug_data();
+	EXPECT_EQ(debug_data.num_quad_instances, 4);
+	EXPECT_EQ(debug_data.num_quad_instance_bytes, 4 * sizeof(platform::QuadInstance));
+	EXPECT_EQ(debug_data.num_draw_calls, 2);
+}
+
+TEST_F(RendererTests, Render_InstancedQuadsSorted_InstancesGatheredWithSections) {
+	platform::Renderer renderer(&m_gl_context, platform::VertexFormat::Standard, platform::QuadMode::Instanced);
+	const platform::ShaderProgram shader_program = { .quad_instances = platform::QuadInstanceProgram {} };
+	const platform::Texture other_texture = { .id = 3, .size = { 8, 8 } };
+	std::vector<platform::QuadInstance> instances;
+	ON_CALL(m_gl_context, upload_quad_instances).WillByDefault(SaveArg<1>(&instances));
+
+	renderer.set_draw_order(platform::DrawOrder::Sorted);
+	renderer.draw_texture(other_texture, { { 0.0f, 0.0f }, { 1.0f, 1.0f } });
+	renderer.draw_texture(ATLAS_TEXTURE, { { 0.0f, 0.0f }, { 2.0f, 2.0f } });
+	renderer.draw_texture(other_texture, { { 0.0f, 0.0f }, { 3.0f, 3.0f } });
+	renderer.render(shader_program);
+
+	// atlas texture has the lower id, so its quad goes first
+	ASSERT_EQ(instances.size(), 3);
+	EXPECT_EQ(instances[0].pos1, glm::vec2(2.0f, 2.0f));
+	EXPECT_EQ(instances[1].pos1, glm::vec2(1.0f, 1.0f));
+	EXPECT_EQ(instances[2].pos1, glm::vec2(3.0f, 3.0f));
+	EXPECT_EQ(renderer.debug_data().num_draw_calls, 2);
+}
+
+TEST_F(RendererTests, Render_DrawsOutsideCanvas_CulledBeforeUpload) {
+	platform::Renderer renderer(&m_gl_context);
+	const platform::Canvas canvas = { .framebuffer = 1, .texture = { .id = 3, .size = { 64, 64 } } };
+
+	renderer.push_draw_canvas(canvas);
+	renderer.draw_rect_fill({ { 10.0f, 10.0f }, { 20.0f, 20.0f } }, platform::Color::red);
+	renderer.draw_rect_fill({ { 100.0f, 10.0f }, { 120.0f, 20.0f } }, platform::Color::red);
+	renderer.draw_line({ -50.0f, -10.0f }, { 200.0f, -10.0f }, platform::Color::red);
+	renderer.draw_circle_fill({ 32.0f, 80.0f }, 8.0f, platform::Color::red);
+	renderer.draw_texture(ATLAS_TEXTURE, { { 0.0f, 200.0f }, { 64.0f, 264.0f } });
+	renderer.pop_draw_canvas();
+
+	EXPECT_CALL(m_gl_context, upload_vertices(_, SizeIs(4))).Times(1);
+	renderer.render(m_shader_program);
+
+	EXPECT_EQ(renderer.debug_data().num_culled, 4);
+}
+
+TEST_F(RendererTests, PushClipRect_TextCrossingEdge_OnlyVisibleGlyphsUploaded) {
+	platform::Renderer renderer(&m_gl_context);
+	const platform::Font font = make_test_font(ATLAS_TEXTURE);
+
+	// glyphs are 8 wide with an advance of 9, so the first three overlap the rect
+	renderer.push_clip_rect({ { 0.0f, 0.0f }, { 20.0f, 100.0f } });
+	renderer.draw_text(font, "abcdef", { 0.0f, 50.0f }, platform::Color::white);
+	renderer.pop_clip_rect();
+
+	EXPECT_CALL(m_gl_context, upload_vertices(_, SizeIs(3 * 4))).Times(1);
+	renderer.render(m_shader_program);
+
+	EXPECT_EQ(renderer.debug_data().num_culled, 3);
+}
+
+TEST_F(RendererTests, PopClipRect_DrawOutsidePoppedRect_NotCulled) {
+	platform::Renderer renderer(&m_gl_context);
+
+	renderer.push_clip_rect({ { 0.0f, 0.0f }, { 10.0f, 10.0f } });
+	renderer.pop_clip_rect();
+	renderer.draw_rect_fill({ { 100.0f, 100.0f }, { 110.0f, 110.0f } }, platform::Color::red);
+
+	EXPECT_CALL(m_gl_context, upload_vertices(_, SizeIs(4))).Times(1);
+	renderer.render(m_shader_program);
+
+	EXPECT_EQ(renderer.debug_data().num_culled, 0);
+}
+
+TEST_F(RendererTests, MakeRecorder_InsidePushedClipRect_RecorderCulls) {
+	platform::Renderer renderer(&m_gl_context);
+
+	renderer.push_clip_rect({ { 0.0f, 0.0f }, { 10.0f, 10.0f } });
+	platform::DrawRecorder recorder = renderer.make_recorder();
+	renderer.pop_clip_rect();
+	recorder.draw_rect_fill({ { 100.0f, 100.0f }, { 110.0f, 110.0f } }, platform::Color::red);
+	renderer.submit(&recorder);
+	renderer.render(m_shader_program);
+
+	EXPECT_EQ(renderer.debug_data().num_culled, 1);
+	EXPECT_EQ(renderer.debug_data().num_vertices, 0);
+}
+
+TEST_F(RendererTests, PushClipRect_TexturedQuadCrossingEdge_ClippedWithUvs) {
+	platform::Renderer renderer(&m_gl_context);
+	std::vector<platform::Vertex> vertices;
+	ON_CALL(m_gl_context, upload_vertices).WillByDefault(SaveArg<1>(&vertices));
+
+	renderer.push_clip_rect({ { 0.0f, 0.0f }, { 10.0f, 10.0f } });
+	renderer.draw_texture(ATLAS_TEXTURE, { { -10.0f, 0.0f }, { 10.0f, 20.0f } });
+	renderer.pop_clip_rect();
+	renderer.render(m_shader_program);
+
+	// uvs go from (0, 1) in the top left to (1, 0) in the bottom right
+	ASSERT_EQ(vertices.size(), 4);
+	EXPECT_EQ(vertices[0].pos, glm::vec2(0.0f, 0.0f));
+	EXPECT_EQ(vertices[0].uv, glm::vec2(0.5f, 1.0f));
+	EXPECT_EQ(vertices[3].pos, glm::vec2(10.0f, 10.0f));
+	EXPECT_EQ(vertices[3].uv, glm::vec2(1.0f, 0.5f));
+}
+
+TEST_F(RendererTests, PushClipRect_LineCrossingEdge_DrawnWithScissor) {
+	platform::Renderer renderer(&m_gl_context);
+	const platform::Canvas canvas = { .framebuffer = 1, .texture = { .id = 3, .size = { 64, 64 } } };
+
+	renderer.push_draw_canvas(canvas);
+	renderer.push_clip_rect({ { 8.0f, 8.0f }, { 24.0f, 16.0f } });
+	renderer.draw_line({ 10.0f, 12.0f }, { 20.0f, 12.0f }, platform::Color::red);
+	renderer.draw_line({ 0.0f, 12.0f }, { 40.0f, 12.0f }, platform::Color::red);
+	renderer.pop_clip_rect();
+	renderer.pop_draw_canvas();
+
+	// scissor rects have their origin in the bottom left
+	InSequence sequence;
+	EXPECT_CALL(m_gl_context, draw_arrays(GL_LINES, 0, 2));
+	EXPECT_CALL(m_gl_context, set_scissor(AllOf(Field(&platform::ScissorRect::pos, glm::ivec2(8, 48)), Field(&platform::ScissorRect::size, glm::ivec2(16, 8)))));
+	EXPECT_CALL(m_gl_context, draw_arrays(GL_LINES, 2, 2));
+	EXPECT_CALL(m_gl_context, disable_scissor());
+	renderer.render(m_shader_program);
+}
+
+TEST_F(RendererTests, Render_DistanceFieldText_DistanceFieldSetOnlyAroundIt) {
+	platform::Renderer renderer(&m_gl_context);
+	platform::Font font = make_test_font(ATLAS_TEXTURE);
+	font.distance_field = true;
+
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+	renderer.draw_text(font, "ab", { 0.0f, 0.0f }, platform::Color::white);
+	renderer.draw_text(platform::scale_font(font, 32), "ab", { 0.0f, 20.0f }, platform::Color::white);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 10.0f, 10.0f } }, platform::Color::red);
+
+	// both sizes share the atlas and are drawn together
+	InSequence sequence;
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 6, 0));
+	EXPECT_CALL(m_gl_context, set_distance_field(_, true));
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 24, 4));
+	EXPECT_CALL(m_gl_context, set_distance_field(_, false));
+	EXPECT_CALL(m_gl_context, draw_elements(GL_TRIANGLES, _, 6, 20));
+	renderer.render(m_shader_program);
+}
+
+TEST_F(RendererTests, Render_DistanceFieldTextLast_DistanceFieldUnsetAtEndOfFrame) {
+	platform::Renderer renderer(&m_gl_context);
+	platform::Font font = make_test_font(ATLAS_TEXTURE);
+	font.distance_field = true;
+
+	renderer.draw_text(font, "ab", { 0.0f, 0.0f }, platform::Color::white);
+
+	InSequence sequence;
+	EXPECT_CALL(m_gl_context, set_distance_field(_, true));
+	EXPECT_CALL(m_gl_context, draw_elements);
+	EXPECT_CALL(m_gl_context, set_distance_field(_, false));
+	renderer.render(m_shader_program);
+}
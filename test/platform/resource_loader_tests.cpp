@@ -5,6 +5,7 @@
 #include <test_helper.h>
 
 #include <platform/file/resource_loader.h>
+#include <platform/graphics/font_atlas_cache.h>
 
 #include <platform/debug/logging.h>
 
@@ -90,3 +91,134 @@ TEST(ResourceLoaderTests, LoadManifest_WithInvalidPaths_GivesErrors) {
 	const platform::ResourceLoadError error2 = { .error_msg = "error message 2", .path = image_path };
 	EXPECT_THAT(payload->errors, UnorderedElementsAre(error1, error2));
 }
+
+TEST(ResourceLoaderTests, LoadManifest_FontFileInSeveralSizes_EachSizeLoaded) {
+	platform::ResourceFileIO file_io;
+	NiceMock<testing::MockOpenGLContext> mock_gl_context;
+	platform::ResourceLoader resource_loader(&file_io);
+	const std::filesystem::path font_path = std::filesystem::current_path() / "test/platform/test_data/test_font.ttf";
+	platform::ResourceManifest manifest = {
+		.fonts = {
+			platform::FontDeclaration { .name = "small", .path = font_path, .size = 12 },
+			platform::FontDeclaration { .name = "large", .path = font_path, .size = 24 },
+		},
+	};
+
+	std::shared_ptr<const platform::ResourceLoadPayload> payload = resource_loader.load_manifest(manifest);
+	WAIT_FOR(payload->is_done(), std::chrono::seconds(5)) {
+		resource_loader.update(&mock_gl_context);
+	}
+
+	ASSERT_TRUE(payload->fonts.contains("small"));
+	ASSERT_TRUE(payload->fonts.contains("large"));
+	EXPECT_EQ(payload->fonts.at("small").size, 12);
+	EXPECT_EQ(payload->fonts.at("large").size, 24);
+	EXPECT_LT(payload->fonts.at("small").line_height, payload->fonts.at("large").line_height);
+}
+
+TEST(ResourceLoaderTests, LoadFonts_WithAtlasCache_SecondLoadFromCache) {
+	const std::filesystem::path cache_directory = std::filesystem::temp_directory_path() / "resource_loader_tests_font_cache";
+	std::filesystem::remove_all(cache_directory);
+	platform::FontAtlasCache atlas_cache(cache_directory);
+	platform::ResourceFileIO file_io(&atlas_cache);
+	const std::filesystem::path font_path = std::filesystem::current_path() / "test/platform/test_data/test_font.ttf";
+	const std::vector<platform::FontDeclaration> fonts = {
+		platform::FontDeclaration { .name = "small", .path = font_path, .size = 12 },
+		platform::FontDeclaration { .name = "large", .path = font_path, .size = 24 },
+	};
+
+	const std::vector<std::expected<platform::FontAtlas, platform::ResourceLoadError>> baked = file_io.load_fonts(fonts);
+	const std::vector<std::expected<platform::FontAtlas, platform::ResourceLoadError>> cached = file_io.load_fonts(fonts);
+	std::filesystem::remove_all(cache_directory);
+
+	ASSERT_EQ(cached.size(), 2);
+	for (size_t i = 0; i < fonts.size(); i++) {
+		ASSERT_TRUE(baked[i].has_value());
+		ASSERT_TRUE(cached[i].has_value());
+		EXPECT_EQ(cached[i]->size, fonts[i].size);
+		EXPECT_EQ(cached[i]->width, baked[i]->width);
+		EXPECT_EQ(cached[i]->height, baked[i]->height);
+	}
+	EXPECT_EQ(atlas_cache.stats().num_stores, 2);
+	EXPECT_EQ(atlas_cache.stats().num_hits, 2);
+}
+
+TEST(ResourceLoaderTests, LoadManifest_WithImageAtlas_SmallImagesShareAtlasTexture) {
+	MockResourceFileIO mock_file_io;
+	NiceMock<testing::MockOpenGLContext> mock_gl_context;
+	platform::ResourceLoader resource_loader(&mock_file_io);
+	platform::ResourceManifest manifest = {
+		.images = {
+			platform::ImageDeclaration { .name = "a", .path = "a.png" },
+			platform::ImageDeclaration { .name = "b", .path = "b.png" },
+		},
+		.image_atlas = platform::ImageAtlasSettings { .size = 64 },
+	};
+
+	EXPECT_CALL(mock_file_io, load_image).WillRepeatedly([](std::filesystem::path) -> std::expected<platform::Image, platform::ResourceLoadError> {
+		unsigned char* data = (unsigned char*)calloc(8 * 8, 4);
+		return platform::Image { .data = platform::ImageData(data), .width = 8, .height = 8, .num_channels = 4 };
+	});
+	EXPECT_CALL(mock_gl_context, add_texture(_, 64, 64, _, _)).Times(1).WillOnce(Return(platform::Texture { .id = 5, .size = { 64, 64 } }));
+	std::shared_ptr<const platform::ResourceLoadPayload> payload = resource_loader.load_manifest(manifest);
+	WAIT_FOR(payload->is_done(), std::chrono::seconds(1)) {
+		resource_loader.update(&mock_gl_context);
+	}
+
+	ASSERT_EQ(payload->atlases.size(), 1);
+	EXPECT_EQ(payload->textures.at("a").id, 5);
+	EXPECT_EQ(payload->textures.at("b").id, 5);
+	EXPECT_NE(payload->uvs.at("a").bottom_left, payload->uvs.at("b").bottom_left);
+}
+
+static std::expected<platform::Image, platform::ResourceLoadError> make_image_8x8(std::filesystem::path) {
+	unsigned char* data = (unsigned char*)calloc(8 * 8, 4);
+	return platform::Image { .data = platform::ImageData(data), .width = 8, .height = 8, .num_channels = 4 };
+}
+
+static platform::ResourceManifest make_image_manifest(size_t num_images) {
+	platform::ResourceManifest manifest;
+	for (size_t i = 0; i < num_images; i++) {
+		manifest.images.push_back({ .name = "image" + std::to_string(i), .path = "image" + std::to_string(i) + ".png" });
+	}
+	return manifest;
+}
+
+TEST(ResourceLoaderTests, Update_UploadsOverByteBudget_SpreadOverFrames) {
+	MockResourceFileIO mock_file_io;
+	NiceMock<testing::MockOpenGLContext> mock_gl_context;
+	platform::ResourceLoader resource_loader(&mock_file_io, { .max_bytes_per_frame = 2 * 8 * 8 * 4, .max_ns_per_frame = UINT64_MAX });
+
+	EXPECT_CALL(mock_file_io, load_image).WillRepeatedly(make_image_8x8);
+	EXPECT_CALL(mock_gl_context, add_texture).Times(5);
+	std::shared_ptr<const platform::ResourceLoadPayload> payload = resource_loader.load_manifest(make_image_manifest(5));
+	size_t max_uploads_per_frame = 0;
+	WAIT_FOR(payload->is_done(), std::chrono::seconds(1)) {
+		const size_t num_uploaded = payload->num_loaded_resources();
+		resource_loader.update(&mock_gl_context);
+		max_uploads_per_frame = std::max(max_uploads_per_frame, payload->num_loaded_resources() - num_uploaded);
+	}
+
+	EXPECT_EQ(max_uploads_per_frame, 2);
+	EXPECT_EQ(payload->num_uploaded_bytes, 5 * 8 * 8 * 4);
+	EXPECT_EQ(payload->num_pending_upload_bytes, 0);
+}
+
+TEST(ResourceLoaderTests, Update_UploadLargerThanBudget_OneUploadPerFrame) {
+	MockResourceFileIO mock_file_io;
+	NiceMock<testing::MockOpenGLContext> mock_gl_context;
+	platform::ResourceLoader resource_loader(&mock_file_io, { .max_bytes_per_frame = 1, .max_ns_per_frame = UINT64_MAX });
+
+	EXPECT_CALL(mock_file_io, load_image).WillRepeatedly(make_image_8x8);
+	std::shared_ptr<const platform::ResourceLoadPayload> payload = resource_loader.load_manifest(make_image_manifest(3));
+	WAIT_FOR(payload->is_decoded(), std::chrono::seconds(1)) {
+		const size_t num_uploaded = payload->num_loaded_resources();
+		resource_loader.update(&mock_gl_context);
+		ASSERT_LE(payload->num_loaded_resources() - num_uploaded, 1);
+	}
+	WAIT_FOR(payload->is_done(), std::chrono::seconds(1)) {
+		resource_loader.update(&mock_gl_context);
+	}
+
+	EXPECT_EQ(resource_loader.num_pending_uploads(), 0);
+}
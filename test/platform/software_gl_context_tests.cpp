@@ -0,0 +1,317 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <golden_image.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/font.h>
+#include <platform/graphics/renderer.h>
+#include <platform/graphics/software_gl_context.h>
+
+#include <filesystem>
+
+using namespace testing;
+
+static std::filesystem::path golden_image_path(const char* name) {
+	return std::filesystem::current_path() / "test/platform/test_data/golden" / name;
+}
+
+class SoftwareOpenGLContextTests : public Test {
+protected:
+	SoftwareOpenGLContextTests()
+		: m_gl_context(64, 64)
+		, m_shader_program(m_gl_context.add_shader_program("", "").value()) {
+	}
+
+	platform::SoftwareOpenGLContext m_gl_context;
+	platform::ShaderProgram m_shader_program;
+};
+
+TEST_F(SoftwareOpenGLContextTests, Render_RectFill_DrawnTopDownInCanvas) {
+	platform::Renderer renderer(&m_gl_context);
+	platform::Canvas canvas = m_gl_context.add_canvas(4, 4);
+
+	renderer.set_render_canvas(canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 4.0f, 1.0f } }, platform::Color::red);
+	renderer.render(m_shader_program);
+
+	// pixel coordinates start in the top left, canvas rows in the bottom left
+	const platform::RasterImage& pixels = m_gl_context.canvas_pixels(canvas);
+	EXPECT_THAT(std::vector<uint32_t>(pixels.pixels.end() - 4, pixels.pixels.end()), Each(platform::pack_color(platform::Color::red)));
+	EXPECT_EQ(std::count(pixels.pixels.begin(), pixels.pixels.end(), 0u), 12);
+}
+
+TEST_F(SoftwareOpenGLContextTests, UpdateTexture_Region_OnlyRegionReplaced) {
+	const uint32_t red = platform::pack_color(platform::Color::red);
+	const uint32_t blue = platform::pack_color(platform::Color::blue);
+	const std::vector<uint32_t> red_pixels(16, red);
+	const std::vector<uint32_t> blue_pixels(2, blue);
+	platform::Texture texture = m_gl_context.add_texture((const unsigned char*)red_pixels.data(), 4, 4);
+	platform::Renderer renderer(&m_gl_context);
+	platform::Canvas canvas = m_gl_context.add_canvas(4, 4);
+
+	m_gl_context.update_texture(texture, { 1, 0 }, { 2, 1 }, (const unsigned char*)blue_pixels.data());
+	renderer.set_render_canvas(canvas);
+	renderer.draw_texture(texture, { { 0.0f, 0.0f }, { 4.0f, 4.0f } });
+	renderer.render(m_shader_program);
+
+	// texture rows start at the bottom, like the canvas
+	const platform::RasterImage& pixels = m_gl_context.canvas_pixels(canvas);
+	EXPECT_THAT(std::vector<uint32_t>(pixels.pixels.begin(), pixels.pixels.begin() + 4), ElementsAre(red, blue, blue, red));
+	EXPECT_EQ(std::count(pixels.pixels.begin(), pixels.pixels.end(), red), 14);
+}
+
+TEST_F(SoftwareOpenGLContextTests, Render_PackedVertices_SameAsStandardVertices) {
+	platform::ShaderProgram packed_shader_program = m_gl_context.add_shader_program("", "", platform::VertexFormat::Packed).value();
+	platform::Canvas standard_canvas = m_gl_context.add_canvas(32, 32);
+	platform::Canvas packed_canvas = m_gl_context.add_canvas(32, 32);
+	platform::Canvas grid_canvas = m_gl_context.add_canvas(4, 4, platform::TextureWrapping::Repeat);
+
+	auto draw = [&](platform::Renderer* renderer, platform::Canvas canvas) {
+		renderer->push_draw_canvas(grid_canvas);
+		renderer->draw_rect_fill({ { 0.0f, 0.0f }, { 2.0f, 2.0f } }, platform::Color::blue);
+		renderer->pop_draw_canvas();
+		renderer->set_render_canvas(canvas);
+		renderer->draw_texture_clipped(grid_canvas.texture, { { 0.0f, 0.0f }, { 32.0f, 32.0f } }, { { 0.0f, 0.0f }, { 8.0f, 8.0f } });
+		renderer->draw_circle_fill({ 16.0f, 16.0f }, 6.0f, platform::Color::rgba(255, 0, 0, 128));
+		renderer->draw_rect({ { 2.0f, 2.0f }, { 30.0f, 30.0f } }, platform::Color::green);
+	};
+	platform::Renderer standard_renderer(&m_gl_context);
+	platform::Renderer packed_renderer(&m_gl_context, platform::VertexFormat::Packed);
+
+	draw(&standard_renderer, standard_canvas);
+	standard_renderer.render(m_shader_program);
+	draw(&packed_renderer, packed_canvas);
+	packed_renderer.render(packed_shader_program);
+
+	EXPECT_EQ(m_gl_context.canvas_pixels(packed_canvas).pixels, m_gl_context.canvas_pixels(standard_canvas).pixels);
+}
+
+TEST_F(SoftwareOpenGLContextTests, Render_InstancedQuads_SameAsPackedVertices) {
+	// Instances store uvs like packed vertices, so the output is identical
+	platform::FontFace face = platform::load_font_face(std::filesystem::current_path() / "test/platform/test_data/test_font.ttf").value();
+	platform::Font font = platform::create_font_from_atlas(&m_gl_context, platform::generate_font_atlas(face, 16));
+	platform::ShaderProgram packed_shader_program = m_gl_context.add_shader_program("", "", platform::VertexFormat::Packed).value();
+	packed_shader_program.quad_instances = m_gl_context.add_quad_instance_program("", "").value();
+	platform::Canvas vertices_canvas = m_gl_context.add_canvas(96, 48);
+	platform::Canvas instances_canvas = m_gl_context.add_canvas(96, 48);
+	platform::Canvas grid_canvas = m_gl_context.add_canvas(4, 4, platform::TextureWrapping::Repeat);
+
+	auto draw = [&](platform::Renderer* renderer, platform::Canvas canvas) {
+		renderer->push_draw_canvas(grid_canvas);
+		renderer->draw_rect_fill({ { 0.0f, 0.0f }, { 2.0f, 2.0f } }, platform::Color::blue);
+		renderer->pop_draw_canvas();
+		renderer->set_render_canvas(canvas);
+		renderer->draw_texture_clipped(grid_canvas.texture, { { 0.0f, 0.0f }, { 96.0f, 48.0f } }, { { 0.0f, 0.0f }, { 24.0f, 12.0f } });
+		renderer->draw_text(font, "Instances", { 4.0f, 20.0f }, platform::Color::white);
+		renderer->draw_texture_clipped_with_color(font.atlas, { { 70.0f, 40.0f }, { 90.0f, 26.0f } }, { { 1.0f, 1.0f }, { 0.0f, 0.0f } }, platform::Color::red);
+	};
+	platform::Renderer vertices_renderer(&m_gl_context, platform::VertexFormat::Packed);
+	platform::Renderer instances_renderer(&m_gl_context, platform::VertexFormat::Packed, platform::QuadMode::Instanced);
+
+	draw(&vertices_renderer, vertices_canvas);
+	vertices_renderer.render(packed_shader_program);
+	draw(&instances_renderer, instances_canvas);
+	instances_renderer.render(packed_shader_program);
+
+	EXPECT_GT(instances_renderer.debug_data().num_quad_instances, 0);
+	EXPECT_EQ(m_gl_context.canvas_pixels(instances_canvas).pixels, m_gl_context.canvas_pixels(vertices_canvas).pixels);
+}
+
+TEST_F(SoftwareOpenGLContextTests, Render_StaticBatch_SameAsDrawingDirectly) {
+	platform::ShaderProgram packed_shader_program = m_gl_context.add_shader_program("", "", platform::VertexFormat::Packed).value();
+	platform::Canvas direct_canvas = m_gl_context.add_canvas(32, 32);
+	platform::Canvas batch_canvas = m_gl_context.add_canvas(32, 32);
+	platform::Canvas grid_canvas = m_gl_context.add_canvas(4, 4, platform::TextureWrapping::Repeat);
+
+	auto draw_background = [&](platform::DrawRecorder* recorder) {
+		recorder->draw_texture_clipped(grid_canvas.texture, { { 0.0f, 0.0f }, { 32.0f, 32.0f } }, { { 0.0f, 0.0f }, { 8.0f, 8.0f } });
+		recorder->draw_rect({ { 2.0f, 2.0f }, { 30.0f, 30.0f } }, platform::Color::green);
+	};
+	platform::Renderer renderer(&m_gl_context, platform::VertexFormat::Packed);
+	renderer.push_draw_canvas(grid_canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 2.0f, 2.0f } }, platform::Color::blue);
+	renderer.pop_draw_canvas();
+	renderer.render(packed_shader_program);
+	platform::DrawRecorder batch_recorder = renderer.make_static_batch_recorder();
+	draw_background(&batch_recorder);
+	const platform::StaticBatch batch = renderer.add_static_batch(batch_recorder);
+
+	renderer.push_draw_canvas(direct_canvas);
+	platform::DrawRecorder direct_recorder = renderer.make_recorder();
+	draw_background(&direct_recorder);
+	renderer.submit(&direct_recorder);
+	renderer.draw_circle_fill({ 16.0f, 16.0f }, 6.0f, platform::Color::rgba(255, 0, 0, 128));
+	renderer.pop_draw_canvas();
+	renderer.push_draw_canvas(batch_canvas);
+	renderer.draw_static_batch(batch);
+	renderer.draw_circle_fill({ 16.0f, 16.0f }, 6.0f, platform::Color::rgba(255, 0, 0, 128));
+	renderer.pop_draw_canvas();
+	renderer.render(packed_shader_program);
+
+	EXPECT_EQ(m_gl_context.canvas_pixels(batch_canvas).pixels, m_gl_context.canvas_pixels(direct_canvas).pixels);
+}
+
+TEST_F(SoftwareOpenGLContextTests, Render_ClipRect_SameAsDrawingDirectlyInsideRect) {
+	platform::Canvas direct_canvas = m_gl_context.add_canvas(32, 32);
+	platform::Canvas clipped_canvas = m_gl_context.add_canvas(32, 32);
+	platform::Canvas grid_canvas = m_gl_context.add_canvas(4, 4, platform::TextureWrapping::Repeat);
+
+	auto draw_scene = [&](platform::Renderer* renderer) {
+		renderer->draw_texture_clipped(grid_canvas.texture, { { 0.0f, 0.0f }, { 32.0f, 32.0f } }, { { 0.0f, 0.0f }, { 8.0f, 8.0f } });
+		renderer->draw_rect_fill({ { 4.0f, 20.0f }, { 14.0f, 30.0f } }, platform::Color::rgba(0, 255, 0, 128));
+		renderer->draw_rect({ { 2.0f, 2.0f }, { 30.0f, 30.0f } }, platform::Color::green);
+		renderer->draw_line({ 0.0f, 12.5f }, { 32.0f, 12.5f }, platform::Color::white);
+		renderer->draw_circle_fill({ 20.0f, 20.0f }, 6.0f, platform::Color::rgba(255, 0, 0, 128));
+	};
+	platform::Renderer renderer(&m_gl_context);
+	renderer.push_draw_canvas(grid_canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 2.0f, 2.0f } }, platform::Color::blue);
+	renderer.pop_draw_canvas();
+	renderer.render(m_shader_program);
+
+	renderer.push_draw_canvas(direct_canvas);
+	draw_scene(&renderer);
+	renderer.pop_draw_canvas();
+	renderer.push_draw_canvas(clipped_canvas);
+	renderer.push_clip_rect({ { 8.0f, 8.0f }, { 24.0f, 24.0f } });
+	draw_scene(&renderer);
+	renderer.pop_clip_rect();
+	renderer.pop_draw_canvas();
+	renderer.render(m_shader_program);
+
+	// the clip rect is symmetric, so flipped canvas rows don't matter
+	const platform::RasterImage& direct_pixels = m_gl_context.canvas_pixels(direct_canvas);
+	const platform::RasterImage& clipped_pixels = m_gl_context.canvas_pixels(clipped_canvas);
+	for (int y = 0; y < 32; y++) {
+		for (int x = 0; x < 32; x++) {
+			const bool is_inside = x >= 8 && x < 24 && y >= 8 && y < 24;
+			EXPECT_EQ(clipped_pixels.pixel(x, y), is_inside ? direct_pixels.pixel(x, y) : 0u) << "at " << x << ", " << y;
+		}
+	}
+}
+
+TEST_F(SoftwareOpenGLContextTests, Render_CanvasDrawnToFramebuffer_FramebufferMatchesCanvas) {
+	// Same steps as the main loop: draw to a window sized canvas, then draw
+	// the canvas to the window with a normalized device coordinate projection
+	platform::Renderer renderer(&m_gl_context);
+	platform::Canvas window_canvas = m_gl_context.add_canvas(64, 64);
+
+	renderer.set_render_canvas(window_canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 64.0f, 64.0f } }, platform::Color::light_grey);
+	renderer.draw_circle_fill({ 20.0f, 12.0f }, 8.0f, platform::Color::red);
+	renderer.draw_line({ 0.0f, 40.0f }, { 64.0f, 50.0f }, platform::Color::blue);
+	renderer.render(m_shader_program);
+	renderer.reset_render_canvas();
+
+	renderer.set_projection(glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f));
+	renderer.draw_texture(window_canvas.texture, core::Rect { { -1.0f, 1.0f }, { 1.0f, -1.0f } });
+	renderer.render(m_shader_program);
+
+	EXPECT_EQ(m_gl_context.framebuffer().pixels, m_gl_context.canvas_pixels(window_canvas).pixels);
+}
+
+TEST_F(SoftwareOpenGLContextTests, Render_DrawText_MatchesGoldenImage) {
+	platform::FontFace face = platform::load_font_face(std::filesystem::current_path() / "test/platform/test_data/test_font.ttf").value();
+	platform::Font font = platform::create_font_from_atlas(&m_gl_context, platform::generate_font_atlas(face, 16));
+	platform::Renderer renderer(&m_gl_context);
+	platform::Canvas canvas = m_gl_context.add_canvas(160, 48);
+
+	renderer.set_render_canvas(canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 160.0f, 48.0f } }, platform::Color::white);
+	renderer.draw_text(font, "Hello, world!", { 4.0f, 16.0f }, platform::Color::black);
+	renderer.draw_text_centered(font, "engine2024", { 80.0f, 46.0f }, platform::Color::rgba(40, 80, 200, 255));
+	renderer.render(m_shader_program);
+
+	EXPECT_TRUE(matches_golden_image(m_gl_context.canvas_pixels(canvas), golden_image_path("draw_text.pam")));
+}
+
+TEST_F(SoftwareOpenGLContextTests, Render_DistanceFieldTextScaledUp_EdgesStaySharp) {
+	platform::FontFace face = platform::load_font_face(std::filesystem::current_path() / "test/platform/test_data/test_font.ttf").value();
+	const platform::FontAtlasSettings settings = { .mode = platform::FontAtlasMode::DistanceField };
+	platform::Font font = platform::create_font_from_atlas(&m_gl_context, platform::generate_font_atlas(face, 16, settings));
+	platform::Renderer renderer(&m_gl_context);
+	platform::Canvas canvas = m_gl_context.add_canvas(64, 64);
+
+	// a vertical stroke, 4x its atlas size
+	renderer.set_render_canvas(canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 64.0f, 64.0f } }, platform::Color::black);
+	renderer.draw_text(platform::scale_font(font, 64), "l", { 16.0f, 60.0f }, platform::Color::white);
+	renderer.render(m_shader_program);
+
+	// antialiased over about a pixel on either side, not over the 4 pixels
+	// each texel is stretched across
+	const std::vector<uint32_t>& pixels = m_gl_context.canvas_pixels(canvas).pixels;
+	const uint32_t black = platform::pack_color(platform::Color::black);
+	const uint32_t white = platform::pack_color(platform::Color::white);
+	const size_t num_white = std::count(pixels.begin(), pixels.end(), white);
+	const size_t num_edge = pixels.size() - num_white - std::count(pixels.begin(), pixels.end(), black);
+	EXPECT_GT(num_white, 64u);
+	EXPECT_LT(num_edge, num_white / 2);
+}
+
+TEST_F(SoftwareOpenGLContextTests, Render_DrawCircleFill_MatchesGoldenImage) {
+	platform::Renderer renderer(&m_gl_context);
+	platform::Canvas canvas = m_gl_context.add_canvas(64, 64);
+
+	renderer.set_render_canvas(canvas);
+	renderer.draw_rect_fill({ { 0.0f, 0.0f }, { 64.0f, 64.0f } }, platform::Color::white);
+	renderer.draw_circle_fill({ 28.0f, 28.0f }, 20.0f, platform::Color::red);
+	renderer.draw_circle_fill({ 42.0f, 42.0f }, 12.0f, platform::Color::rgba(0, 0, 255, 128));
+	renderer.draw_circle_fill({ 8.0f, 56.0f }, 3.0f, platform::Color::black);
+	renderer.render(m_shader_program);
+
+	EXPECT_TRUE(matches_golden_image(m_gl_context.canvas_pixels(canvas), golden_image_path("draw_circle_fill.pam")));
+}
+
+// Same drawing as the scene window grid in the editor
+static platform::Canvas draw_editor_grid(platform::OpenGLContext* gl_context, platform::Renderer* renderer, platform::TextureFilter filter) {
+	constexpr int GRID_SIZE = 32;
+	platform::Canvas grid_canvas = gl_context->add_canvas(GRID_SIZE * 2, GRID_SIZE * 2, platform::TextureWrapping::Repeat);
+	platform::Canvas scene_canvas = gl_context->add_canvas(200, 120);
+	const glm::vec2 scene_canvas_size = scene_canvas.texture.size;
+	gl_context->set_texture_filter(grid_canvas.texture, filter);
+
+	renderer->set_draw_order(platform::DrawOrder::Sorted);
+	renderer->set_render_canvas(scene_canvas);
+	renderer->push_draw_canvas(grid_canvas);
+	{
+		glm::vec4 dark = platform::Color::rgba(138, 83, 83, 255);
+		glm::vec4 light = platform::Color::rgba(167, 107, 107, 255);
+		renderer->draw_rect_fill({ { 0, 0 }, { GRID_SIZE * 2, GRID_SIZE * 2 } }, dark);
+		renderer->draw_rect_fill({ { GRID_SIZE, 0 }, { 2 * GRID_SIZE, GRID_SIZE } }, light);
+		renderer->draw_rect_fill({ { 0, GRID_SIZE }, { GRID_SIZE, 2 * GRID_SIZE } }, light);
+	}
+	renderer->pop_draw_canvas();
+
+	core::FlipRect uv = { { 0, 0 }, scene_canvas_size / (float)GRID_SIZE };
+	renderer->push_draw_layer(1);
+	renderer->draw_texture_clipped(grid_canvas.texture, { { 0, 0 }, scene_canvas_size }, uv);
+	renderer->pop_draw_layer();
+
+	renderer->push_draw_layer(2);
+	renderer->draw_line({ 0.0f, scene_canvas_size.y / 2.0f }, { scene_canvas_size.x + 1.0f, scene_canvas_size.y / 2.0f }, platform::Color::red);
+	renderer->draw_line({ scene_canvas_size.x / 2.0f, 0.0f }, { scene_canvas_size.x / 2.0f, scene_canvas_size.y + 1.0f }, platform::Color::green);
+	renderer->pop_draw_layer();
+
+	return scene_canvas;
+}
+
+TEST_F(SoftwareOpenGLContextTests, Render_EditorGrid_MatchesGoldenImage) {
+	platform::Renderer renderer(&m_gl_context);
+
+	platform::Canvas scene_canvas = draw_editor_grid(&m_gl_context, &renderer, platform::TextureFilter::Nearest);
+	renderer.render(m_shader_program);
+
+	EXPECT_TRUE(matches_golden_image(m_gl_context.canvas_pixels(scene_canvas), golden_image_path("editor_grid.pam")));
+}
+
+TEST_F(SoftwareOpenGLContextTests, Render_EditorGridZoomedOut_MatchesGoldenImage) {
+	// the grid is filtered linearly when zoomed out
+	platform::Renderer renderer(&m_gl_context);
+
+	platform::Canvas scene_canvas = draw_editor_grid(&m_gl_context, &renderer, platform::TextureFilter::Linear);
+	renderer.render(m_shader_program);
+
+	EXPECT_TRUE(matches_golden_image(m_gl_context.canvas_pixels(scene_canvas), golden_image_path("editor_grid_linear.pam")));
+}
@@ -0,0 +1,185 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/software_rasterizer.h>
+#include <platform/graphics/vertex.h>
+
+#include <random>
+
+using namespace testing;
+
+static platform::RasterImage make_white_image() {
+	return platform::RasterImage(1, 1, 0xFFFFFFFF);
+}
+
+static std::vector<platform::RasterVertex> make_quad(glm::vec2 min, glm::vec2 max, glm::vec4 color) {
+	const platform::RasterVertex v0 = { .pos = { min.x, min.y }, .color = color };
+	const platform::RasterVertex v1 = { .pos = { min.x, max.y }, .color = color };
+	const platform::RasterVertex v2 = { .pos = { max.x, min.y }, .color = color };
+	const platform::RasterVertex v3 = { .pos = { max.x, max.y }, .color = color };
+	return { v0, v1, v2, v1, v2, v3 };
+}
+
+TEST(SoftwareRasterizerTests, BlendPixel_OpaqueSource_ReplacesDestination) {
+	EXPECT_EQ(platform::blend_pixel(0xFF00FF00, 0xFF0000FF), 0xFF0000FF);
+}
+
+TEST(SoftwareRasterizerTests, BlendPixel_TransparentSource_KeepsDestination) {
+	EXPECT_EQ(platform::blend_pixel(0xFF00FF00, 0x000000FF), 0xFF00FF00);
+}
+
+TEST(SoftwareRasterizerTests, BlendPixel_HalfAlpha_AveragesColors) {
+	const uint32_t result = platform::blend_pixel(platform::pack_color({ 0.0f, 0.0f, 0.0f, 1.0f }), platform::pack_color({ 1.0f, 1.0f, 1.0f, 0.5f }));
+
+	EXPECT_EQ(result & 0xFF, 128);
+}
+
+TEST(SoftwareRasterizerTests, BlendSpan_AnyLength_MatchesBlendPixel) {
+	std::mt19937 rng(1234);
+	for (uint32_t src : { 0x00FFFFFFu, 0x01204080u, 0x80FF8040u, 0xFEFFFFFFu, 0xFF102030u }) {
+		for (size_t length = 0; length < 11; length++) {
+			std::vector<uint32_t> pixels(length);
+			for (uint32_t& pixel : pixels) {
+				pixel = rng();
+			}
+			std::vector<uint32_t> expected = pixels;
+			for (uint32_t& pixel : expected) {
+				pixel = platform::blend_pixel(pixel, src);
+			}
+
+			platform::blend_span(pixels.data(), pixels.size(), src);
+
+			EXPECT_EQ(pixels, expected) << "src " << src << ", length " << length;
+		}
+	}
+}
+
+TEST(SoftwareRasterizerTests, SampleTexture_RepeatWrapping_Wraps) {
+	platform::RasterImage image(2, 1);
+	image.pixel(0, 0) = 0xFF0000FF;
+	image.pixel(1, 0) = 0xFF00FF00;
+	platform::RasterTexture texture = { .image = &image, .wrapping = platform::TextureWrapping::Repeat };
+
+	EXPECT_EQ(platform::pack_color(platform::sample_texture(texture, { 1.25f, 0.5f })), 0xFF0000FF);
+	EXPECT_EQ(platform::pack_color(platform::sample_texture(texture, { -0.25f, 0.5f })), 0xFF00FF00);
+}
+
+TEST(SoftwareRasterizerTests, SampleTexture_ClampToBorderOutside_Transparent) {
+	platform::RasterImage image = make_white_image();
+	platform::RasterTexture texture = { .image = &image, .wrapping = platform::TextureWrapping::ClampToBorder };
+
+	EXPECT_EQ(platform::pack_color(platform::sample_texture(texture, { 1.5f, 0.5f })), 0u);
+}
+
+TEST(SoftwareRasterizerTests, SampleTexture_LinearBetweenTexels_Interpolated) {
+	platform::RasterImage image(2, 1);
+	image.pixel(0, 0) = 0xFF000000;
+	image.pixel(1, 0) = 0xFF0000FF;
+	platform::RasterTexture texture = { .image = &image, .filter = platform::TextureFilter::Linear };
+
+	const glm::vec4 color = platform::sample_texture(texture, { 0.5f, 0.5f });
+
+	EXPECT_FLOAT_EQ(color.r, 0.5f);
+}
+
+TEST(SoftwareRasterizerTests, Flush_QuadWithHalfAlpha_SharedEdgeBlendedOnce) {
+	platform::RasterImage white = make_white_image();
+	platform::RasterImage target(8, 8, 0xFF000000);
+	platform::SoftwareRasterizer rasterizer;
+
+	rasterizer.draw(platform::RasterPrimitive::Triangles, { .image = &white }, make_quad({ 0.0f, 0.0f }, { 8.0f, 8.0f }, { 1.0f, 1.0f, 1.0f, 0.5f }));
+	rasterizer.flush(&target);
+
+	EXPECT_THAT(target.pixels, Each(target.pixels[0]));
+	EXPECT_EQ(target.pixels[0] & 0xFF, 128);
+}
+
+TEST(SoftwareRasterizerTests, Flush_AdjacentQuads_NoGapsOrOverlap) {
+	platform::RasterImage white = make_white_image();
+	platform::RasterImage target(8, 8, 0xFF000000);
+	platform::SoftwareRasterizer rasterizer;
+	const glm::vec4 half_white = { 1.0f, 1.0f, 1.0f, 0.5f };
+
+	rasterizer.draw(platform::RasterPrimitive::Triangles, { .image = &white }, make_quad({ 0.0f, 0.0f }, { 3.3f, 8.0f }, half_white));
+	rasterizer.draw(platform::RasterPrimitive::Triangles, { .image = &white }, make_quad({ 3.3f, 0.0f }, { 8.0f, 8.0f }, half_white));
+	rasterizer.flush(&target);
+
+	EXPECT_THAT(target.pixels, Each(target.pixels[0]));
+}
+
+TEST(SoftwareRasterizerTests, Flush_Line_LastPixelExcluded) {
+	platform::RasterImage white = make_white_image();
+	platform::RasterImage target(8, 1, 0);
+	platform::SoftwareRasterizer rasterizer;
+	const std::vector<platform::RasterVertex> line = {
+		{ .pos = { 0.0f, 0.5f }, .color = platform::Color::white },
+		{ .pos = { 4.0f, 0.5f }, .color = platform::Color::white },
+	};
+
+	rasterizer.draw(platform::RasterPrimitive::Lines, { .image = &white }, line);
+	rasterizer.flush(&target);
+
+	EXPECT_THAT(target.pixels, ElementsAre(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0, 0, 0, 0));
+}
+
+TEST(SoftwareRasterizerTests, Flush_Point_PixelContainingPointDrawn) {
+	platform::RasterImage white = make_white_image();
+	platform::RasterImage target(4, 4, 0);
+	platform::SoftwareRasterizer rasterizer;
+	const platform::RasterVertex point = { .pos = { 2.9f, 1.1f }, .color = platform::Color::white };
+
+	rasterizer.draw(platform::RasterPrimitive::Points, { .image = &white }, std::span(&point, 1));
+	rasterizer.flush(&target);
+
+	EXPECT_EQ(target.pixel(2, 1), 0xFFFFFFFF);
+	EXPECT_EQ(std::count(target.pixels.begin(), target.pixels.end(), 0xFFFFFFFF), 1);
+}
+
+TEST(SoftwareRasterizerTests, SetScissor_QuadCoveringTarget_OnlyPixelsInScissorDrawn) {
+	platform::RasterImage white = make_white_image();
+	platform::RasterImage target(8, 8, 0);
+	platform::SoftwareRasterizer rasterizer;
+
+	rasterizer.set_scissor(platform::ScissorRect { .pos = { 2, 1 }, .size = { 3, 4 } });
+	rasterizer.draw(platform::RasterPrimitive::Triangles, { .image = &white }, make_quad({ 0.0f, 0.0f }, { 8.0f, 8.0f }, platform::Color::white));
+	rasterizer.set_scissor(std::nullopt);
+	rasterizer.flush(&target);
+
+	EXPECT_EQ(target.pixel(2, 1), 0xFFFFFFFF);
+	EXPECT_EQ(target.pixel(4, 4), 0xFFFFFFFF);
+	EXPECT_EQ(target.pixel(1, 1), 0u);
+	EXPECT_EQ(target.pixel(2, 5), 0u);
+	EXPECT_EQ(std::count(target.pixels.begin(), target.pixels.end(), 0xFFFFFFFF), 12);
+}
+
+TEST(SoftwareRasterizerTests, Flush_ManyThreads_SameAsSingleThread) {
+	platform::RasterImage texture_image(4, 4);
+	for (size_t i = 0; i < texture_image.pixels.size(); i++) {
+		texture_image.pixels[i] = 0x80000000 | (uint32_t)(i * 0x102030);
+	}
+	const platform::RasterTexture texture = { .image = &texture_image, .wrapping = platform::TextureWrapping::Repeat, .filter = platform::TextureFilter::Linear };
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> coordinate(-20.0f, 276.0f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::vector<platform::RasterVertex> triangles;
+	for (int i = 0; i < 3 * 200; i++) {
+		triangles.push_back(platform::RasterVertex {
+			.pos = { coordinate(rng), coordinate(rng) },
+			.color = { unit(rng), unit(rng), unit(rng), unit(rng) },
+			.uv = { 4.0f * unit(rng), 4.0f * unit(rng) },
+		});
+	}
+
+	auto render = [&](size_t num_threads) {
+		platform::RasterImage target(256, 256, 0xFF000000);
+		platform::SoftwareRasterizer rasterizer(num_threads);
+		rasterizer.draw(platform::RasterPrimitive::Triangles, texture, triangles);
+		rasterizer.draw(platform::RasterPrimitive::Lines, texture, triangles);
+		rasterizer.flush(&target);
+		return target.pixels;
+	};
+
+	EXPECT_EQ(render(4), render(1));
+}
@@ -0,0 +1,165 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/streaming_buffer.h>
+
+#include <string.h>
+#include <vector>
+
+using namespace testing;
+
+class FakeStreamingBufferBackend : public platform::IStreamingBufferBackend {
+public:
+	void resize(size_t capacity) override {
+		data = std::vector<unsigned char>(capacity);
+		resized_capacities.push_back(capacity);
+	}
+
+	void write(size_t offset, const void* src, size_t size) override {
+		ASSERT_LE(offset + size, data.size());
+		memcpy(data.data() + offset, src, size);
+	}
+
+	uint64_t insert_fence() override {
+		return ++num_fences;
+	}
+
+	void wait_fence(uint64_t fence) override {
+		waited_fences.push_back(fence);
+	}
+
+	std::vector<unsigned char> data;
+	std::vector<size_t> resized_capacities;
+	uint64_t num_fences = 0;
+	std::vector<uint64_t> waited_fences;
+};
+
+static std::vector<unsigned char> bytes(size_t size, unsigned char value) {
+	return std::vector<unsigned char>(size, value);
+}
+
+TEST(StreamingBufferTests, Constructor_AllocatesAllFrames) {
+	FakeStreamingBufferBackend backend;
+	platform::StreamingBuffer buffer(&backend, 3, 64);
+
+	EXPECT_THAT(backend.resized_capacities, ElementsAre(3 * 64));
+	EXPECT_EQ(buffer.stats().capacity, 3 * 64);
+	EXPECT_EQ(buffer.stats().frame_capacity, 64);
+}
+
+TEST(StreamingBufferTests, Push_SeveralFrames_WrittenAfterEachOther) {
+	FakeStreamingBufferBackend backend;
+	platform::StreamingBuffer buffer(&backend, 3, 64);
+
+	std::vector<size_t> offsets;
+	for (unsigned char i = 0; i < 3; i++) {
+		offsets.push_back(buffer.push(bytes(48, i).data(), 48, 16));
+		buffer.fence();
+	}
+
+	EXPECT_THAT(offsets, ElementsAre(0, 48, 96));
+	EXPECT_EQ(backend.data[48], 1);
+	EXPECT_THAT(backend.waited_fences, IsEmpty());
+}
+
+TEST(StreamingBufferTests, Push_UnalignedHead_OffsetAlignedUp) {
+	FakeStreamingBufferBackend backend;
+	platform::StreamingBuffer buffer(&backend, 3, 64);
+
+	buffer.push(bytes(10, 0).data(), 10, 1);
+	size_t offset = buffer.push(bytes(32, 0).data(), 32, 32);
+
+	EXPECT_EQ(offset, 32);
+}
+
+TEST(StreamingBufferTests, Push_RingFull_WrapsAroundAndWaitsForOldestFence) {
+	FakeStreamingBufferBackend backend;
+	platform::StreamingBuffer buffer(&backend, 3, 64);
+
+	for (int i = 0; i < 3; i++) {
+		buffer.push(bytes(64, 0).data(), 64, 1);
+		buffer.fence();
+	}
+	size_t offset = buffer.push(bytes(64, 0).data(), 64, 1);
+
+	EXPECT_EQ(offset, 0);
+	EXPECT_THAT(backend.waited_fences, ElementsAre(1));
+	EXPECT_EQ(buffer.stats().num_fence_waits, 1);
+}
+
+TEST(StreamingBufferTests, Push_DoesNotFitBeforeEnd_WaitsOnlyForOverlappedFrames) {
+	FakeStreamingBufferBackend backend;
+	platform::StreamingBuffer buffer(&backend, 3, 64);
+
+	for (int i = 0; i < 5; i++) {
+		buffer.push(bytes(40, 0).data(), 40, 1);
+		buffer.fence();
+	}
+
+	// 5th push doesn't fit in [160, 192) and wraps to [0, 40), which was
+	// only used by the 1st push
+	EXPECT_THAT(backend.waited_fences, ElementsAre(1));
+}
+
+TEST(StreamingBufferTests, Push_LargerThanFrameCapacity_GrowsToNextPowerOfTwo) {
+	FakeStreamingBufferBackend backend;
+	platform::StreamingBuffer buffer(&backend, 3, 64);
+	buffer.push(bytes(64, 0).data(), 64, 1);
+	buffer.fence();
+
+	size_t offset = buffer.push(bytes(200, 7).data(), 200, 1);
+
+	EXPECT_EQ(offset, 0);
+	EXPECT_THAT(backend.resized_capacities, ElementsAre(3 * 64, 3 * 256));
+	EXPECT_THAT(backend.waited_fences, ElementsAre(1));
+	EXPECT_EQ(backend.data[199], 7);
+	EXPECT_EQ(buffer.stats().frame_capacity, 256);
+	EXPECT_EQ(buffer.stats().num_resizes, 1);
+}
+
+TEST(StreamingBufferTests, Push_OverlapsUnfencedData_FencesPendingDataFirst) {
+	FakeStreamingBufferBackend backend;
+	platform::StreamingBuffer buffer(&backend, 2, 64);
+
+	for (int i = 0; i < 3; i++) {
+		buffer.push(bytes(64, 0).data(), 64, 1);
+	}
+
+	EXPECT_EQ(backend.num_fences, 1);
+	EXPECT_THAT(backend.waited_fences, ElementsAre(1));
+}
+
+TEST(StreamingBufferTests, Reserve_PushesLargerThanFrameCapacity_GrowsOnceBeforeFirstPush) {
+	FakeStreamingBufferBackend backend;
+	platform::StreamingBuffer buffer(&backend, 3, 64);
+
+	buffer.reserve(48 + 100);
+	size_t first = buffer.push(bytes(48, 1).data(), 48, 16);
+	size_t second = buffer.push(bytes(100, 2).data(), 100, 4);
+
+	EXPECT_EQ(first, 0);
+	EXPECT_EQ(second, 48);
+	EXPECT_THAT(backend.resized_capacities, ElementsAre(3 * 64, 3 * 256));
+	EXPECT_EQ(backend.data[0], 1);
+	EXPECT_EQ(backend.num_fences, 0);
+}
+
+TEST(StreamingBufferTests, Reserve_DoesNotFitBeforeEnd_PushesWrapTogether) {
+	FakeStreamingBufferBackend backend;
+	platform::StreamingBuffer buffer(&backend, 3, 64);
+	for (int i = 0; i < 3; i++) {
+		buffer.push(bytes(56, 0).data(), 56, 1);
+		buffer.fence();
+	}
+
+	buffer.reserve(24 + 24);
+	size_t first = buffer.push(bytes(24, 1).data(), 24, 8);
+	size_t second = buffer.push(bytes(24, 2).data(), 24, 8);
+
+	// without the reservation the 1st push would fit in [168, 192) and the
+	// 2nd would wrap, fencing the 1st before it's drawn
+	EXPECT_EQ(first, 0);
+	EXPECT_EQ(second, 24);
+	EXPECT_EQ(backend.num_fences, 3);
+	EXPECT_EQ(backend.data[0], 1);
+}
@@ -0,0 +1,163 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <test_font.h>
+
+#include <platform/graphics/glyph_cache.h>
+#include <platform/graphics/software_gl_context.h>
+#include <platform/graphics/text_run_cache.h>
+
+#include <thread>
+
+using namespace testing;
+
+static platform::Font make_atlas_font(GLuint atlas_id) {
+	return make_test_font(platform::Texture { .id = atlas_id, .size = { 128, 128 } }, { 32, 0 }, { 1, 12 });
+}
+
+TEST(TextRunCacheTests, LayoutTextRun_TwoGlyphs_QuadsAdvanceFromBaseline) {
+	const platform::Font font = make_atlas_font(1);
+
+	std::vector<platform::GlyphQuad> quads = platform::layout_text_run(font, "ab");
+
+	ASSERT_EQ(quads.size(), 2);
+	EXPECT_EQ(quads[0].pos0, glm::vec2(1.0f, -12.0f));
+	EXPECT_EQ(quads[0].pos1, glm::vec2(9.0f, 0.0f));
+	EXPECT_EQ(quads[1].pos0, glm::vec2(10.0f, -12.0f));
+	EXPECT_EQ(quads[0].uv0, glm::vec2(0.25f, 1.0f));
+	EXPECT_EQ(quads[0].uv1, glm::vec2(0.3125f, 1.0f - 12.0f / 128.0f));
+}
+
+TEST(TextRunCacheTests, LayoutTextRun_Spaces_AdvanceWithoutQuads) {
+	const platform::Font font = make_atlas_font(1);
+
+	std::vector<platform::GlyphQuad> quads = platform::layout_text_run(font, "a b");
+
+	ASSERT_EQ(quads.size(), 2);
+	EXPECT_EQ(quads[1].pos0.x, 19.0f);
+}
+
+TEST(TextRunCacheTests, LayoutTextRun_GlyphMissingFromFont_SkippedAndComplete) {
+	const platform::Font font = make_atlas_font(1);
+	bool is_complete;
+
+	// U+00E9 as UTF-8, the font has no glyph cache to find it in, so it
+	// never will be
+	std::vector<platform::GlyphQuad> quads = platform::layout_text_run(font, "a\xC3\xA9" "b", &is_complete);
+
+	ASSERT_EQ(quads.size(), 2);
+	EXPECT_EQ(quads[1].pos0.x, 10.0f);
+	EXPECT_EQ(quads[1].texture.id, 1);
+	EXPECT_TRUE(is_complete);
+}
+
+TEST(TextRunCacheTests, LayoutTextRun_ScaledFont_PositionsScaledWithSameUvs) {
+	platform::Font font = make_atlas_font(1);
+	font.distance_field = true;
+	const platform::Font scaled = platform::scale_font(font, 32);
+
+	std::vector<platform::GlyphQuad> quads = platform::layout_text_run(scaled, "ab");
+
+	ASSERT_EQ(quads.size(), 2);
+	EXPECT_EQ(quads[0].pos0, glm::vec2(2.0f, -24.0f));
+	EXPECT_EQ(quads[0].pos1, glm::vec2(18.0f, 0.0f));
+	EXPECT_EQ(quads[1].pos0, glm::vec2(20.0f, -24.0f));
+	EXPECT_EQ(quads[0].uv0, glm::vec2(0.25f, 1.0f));
+	EXPECT_EQ(scaled.line_height, 36);
+}
+
+TEST(TextRunCacheTests, Quads_SameTextTwice_LaidOutOnce) {
+	platform::TextRunCache cache;
+	const platform::Font font = make_atlas_font(1);
+
+	const std::vector<platform::GlyphQuad>* first = &cache.quads(font, "Hello");
+	const std::vector<platform::GlyphQuad>* second = &cache.quads(font, "Hello");
+
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(cache.num_runs(), 1);
+	EXPECT_EQ(cache.stats().num_hits, 1);
+	EXPECT_EQ(cache.stats().num_misses, 1);
+}
+
+TEST(TextRunCacheTests, Quads_SameTextDifferentFonts_CachedSeparately) {
+	platform::TextRunCache cache;
+
+	cache.quads(make_atlas_font(1), "Hello");
+	cache.quads(make_atlas_font(2), "Hello");
+
+	EXPECT_EQ(cache.num_runs(), 2);
+	EXPECT_EQ(cache.stats().num_misses, 2);
+}
+
+TEST(TextRunCacheTests, Quads_AtlasIdReusedByAnotherFont_CachedSeparately) {
+	platform::TextRunCache cache;
+	platform::Font freed_font = make_atlas_font(1);
+	freed_font.generation = 1;
+	platform::Font font = make_atlas_font(1);
+	font.generation = 2;
+	font.glyphs['H'].advance = 20;
+
+	cache.quads(freed_font, "Hi");
+	const std::vector<platform::GlyphQuad> quads = cache.quads(font, "Hi");
+
+	ASSERT_EQ(quads.size(), 2);
+	EXPECT_EQ(quads[1].pos0.x, 21.0f);
+	EXPECT_EQ(cache.stats().num_misses, 2);
+}
+
+TEST(TextRunCacheTests, Quads_SameAtlasDifferentSizes_CachedSeparately) {
+	platform::TextRunCache cache;
+	platform::Font font = make_atlas_font(1);
+	font.distance_field = true;
+
+	const float width_16 = cache.quads(font, "Hello").back().pos1.x;
+	const float width_32 = cache.quads(platform::scale_font(font, 32), "Hello").back().pos1.x;
+
+	EXPECT_EQ(cache.num_runs(), 2);
+	EXPECT_EQ(width_32, 2.0f * width_16);
+}
+
+TEST(TextRunCacheTests, Quads_ExceedsMaxQuads_LeastRecentlyDrawnEvicted) {
+	platform::TextRunCache cache(10);
+	const platform::Font font = make_atlas_font(1);
+
+	cache.quads(font, "aaaa");
+	cache.quads(font, "bbbb");
+	cache.quads(font, "aaaa");
+	cache.quads(font, "cccc");
+
+	EXPECT_EQ(cache.num_runs(), 2);
+	EXPECT_EQ(cache.num_quads(), 8);
+	EXPECT_EQ(cache.stats().num_evictions, 1);
+	cache.quads(font, "aaaa");
+	EXPECT_EQ(cache.stats().num_hits, 2);
+}
+
+TEST(TextRunCacheTests, Quads_LongerThanMaxQuads_LaidOutButNotKept) {
+	platform::TextRunCache cache(4);
+	const platform::Font font = make_atlas_font(1);
+
+	EXPECT_EQ(cache.quads(font, "aaaaaaaa").size(), 8);
+	EXPECT_EQ(cache.num_runs(), 0);
+	EXPECT_EQ(cache.num_quads(), 0);
+}
+
+TEST(TextRunCacheTests, Quads_GlyphMissedOffThread_LaidOutButNotKept) {
+	platform::SoftwareOpenGLContext gl_context(64, 64);
+	platform::TextRunCache cache;
+	platform::Font font = make_atlas_font(1);
+	const std::vector<platform::GlyphBitmap> latin_glyphs(platform::GlyphCache::LATIN_END - platform::GlyphCache::LATIN_FIRST);
+	font.glyph_cache = std::make_shared<platform::GlyphCache>(&gl_context, "missing_font.ttf", 16, latin_glyphs);
+	bool is_complete = true;
+
+	// U+65E5 as UTF-8, which the glyph cache only tries to add on this thread
+	std::thread([&]() {
+		cache.quads(font, "a\xE6\x97\xA5", &is_complete);
+		cache.quads(font, "a\xE6\x97\xA5");
+	}).join();
+
+	EXPECT_FALSE(is_complete);
+	EXPECT_EQ(cache.num_runs(), 0);
+	EXPECT_EQ(cache.stats().num_misses, 2);
+	EXPECT_EQ(cache.stats().num_incomplete, 2);
+}
@@ -0,0 +1,57 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <platform/graphics/color.h>
+#include <platform/graphics/vertex.h>
+
+using namespace testing;
+
+TEST(VertexTests, PackColor_Red_RedInLowestByte) {
+	EXPECT_EQ(platform::pack_color(platform::Color::red), 0xFF0000FF);
+}
+
+TEST(VertexTests, PackColor_OutOfRange_Clamped) {
+	EXPECT_EQ(platform::pack_color({ 2.0f, -1.0f, 0.5f, 1.0f }), 0xFF8000FF);
+}
+
+TEST(VertexTests, UnpackColor_PackedColor_RoundTrips) {
+	const uint32_t color = 0x80FF4020;
+
+	EXPECT_EQ(platform::pack_color(platform::unpack_color(color)), color);
+}
+
+TEST(VertexTests, PackVertex_UvInRange_NormalizedTo16Bit) {
+	platform::Vertex vertex = { .pos = { 1.5f, -2.0f }, .color = platform::Color::white, .uv = { 0.0f, 1.0f } };
+
+	platform::PackedVertex packed = platform::pack_vertex(vertex, 1.0f);
+
+	EXPECT_EQ(packed.pos, vertex.pos);
+	EXPECT_EQ(packed.color, 0xFFFFFFFF);
+	EXPECT_EQ(packed.uv[0], 0);
+	EXPECT_EQ(packed.uv[1], 0xFFFF);
+}
+
+TEST(VertexTests, PackVertex_UvScale_UvDividedByScale) {
+	platform::Vertex vertex = { .pos = { 0.0f, 0.0f }, .color = platform::Color::white, .uv = { 2.0f, 4.0f } };
+
+	platform::PackedVertex packed = platform::pack_vertex(vertex, 4.0f);
+
+	EXPECT_EQ(packed.uv[0], 0x8000);
+	EXPECT_EQ(packed.uv[1], 0xFFFF);
+}
+
+TEST(VertexTests, VertexSize_Packed_HalfOfStandard) {
+	EXPECT_EQ(platform::vertex_size(platform::VertexFormat::Standard), 32);
+	EXPECT_EQ(platform::vertex_size(platform::VertexFormat::Packed), 16);
+}
+
+TEST(VertexTests, PackQuad_UvScale_CornersNormalized) {
+	platform::Quad quad = { .pos0 = { 1.0f, 2.0f }, .pos1 = { 3.0f, 4.0f }, .uv0 = { 0.0f, 2.0f }, .uv1 = { 1.0f, 0.0f }, .color = platform::Color::red };
+
+	platform::QuadInstance instance = platform::pack_quad(quad, 2.0f);
+
+	EXPECT_EQ(instance.pos0, quad.pos0);
+	EXPECT_EQ(instance.pos1, quad.pos1);
+	EXPECT_THAT(instance.uv, ElementsAre(0, 0xFFFF, 0x8000, 0));
+	EXPECT_EQ(instance.color, 0xFF0000FF);
+}
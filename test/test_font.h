@@ -0,0 +1,24 @@
+#pragma once
+
+#include <platform/graphics/font.h>
+#include <platform/graphics/texture.h>
+
+#include <glm/glm.hpp>
+
+// Font whose glyphs are all the same 8x12 cell at `atlas_pos`, so tests can
+// lay out text without loading a font file
+inline platform::Font make_test_font(platform::Texture atlas, glm::ivec2 atlas_pos = { 0, 0 }, glm::ivec2 bearing = { 0, 12 }) {
+	platform::Font font = {};
+	font.atlas = atlas;
+	font.size = 16;
+	font.line_height = 18;
+	for (platform::Glyph& glyph : font.glyphs) {
+		glyph = platform::Glyph {
+			.atlas_pos = atlas_pos,
+			.size = { 8, 12 },
+			.bearing = bearing,
+			.advance = 9,
+		};
+	}
+	return font;
+}